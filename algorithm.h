@@ -62,6 +62,7 @@
 // The various things we look to take advantage of in order to implement
 // optimizations include:
 //    - Taking advantage of random access iterators.
+//    - Taking advantage of segmented iterators (e.g. deque) by working one contiguous segment at a time.
 //    - Taking advantage of trivially copyable data types (types for which it is safe to memcpy or memmove).
 //    - Taking advantage of type_traits in general.
 //    - Reducing branching and taking advantage of likely branch predictions.
@@ -246,8 +247,10 @@
 #include <eastl/internal/move_help.h>
 #include <eastl/internal/copy_help.h>
 #include <eastl/internal/fill_help.h>
+#include <eastl/internal/scan_help.h>
 #include <eastl/initializer_list.h>
 #include <eastl/iterator.h>
+#include <eastl/numeric.h> // is_constant_evaluated
 #include <eastl/functional.h>
 #include <eastl/utility.h>
 #include <eastl/random.h>
@@ -309,6 +312,9 @@ namespace eastl
 	template <typename ForwardIterator>
 	ForwardIterator minElement(ForwardIterator first, ForwardIterator last)
 	{
+		if(eastl::internal::scan_min_element(first, last, first)) // Vectorized for pointers to arithmetic types.
+			return first;
+
 		if(first != last)
 		{
 			ForwardIterator currentMin = first;
@@ -373,6 +379,9 @@ namespace eastl
 	template <typename ForwardIterator>
 	ForwardIterator maxElement(ForwardIterator first, ForwardIterator last)
 	{
+		if(eastl::internal::scan_max_element(first, last, first)) // Vectorized for pointers to arithmetic types.
+			return first;
+
 		if(first != last)
 		{
 			ForwardIterator currentMax = first;
@@ -739,6 +748,10 @@ namespace eastl
 	{
 		typedef typename eastl::iterator_traits<ForwardIterator>::value_type value_type;
 
+		eastl::pair<ForwardIterator, ForwardIterator> result(first, first);
+		if(eastl::internal::scan_minmax_element(first, last, result)) // Vectorized for pointers to arithmetic types.
+			return result;
+
 		return eastl::minmaxElement(first, last, eastl::less<value_type>());
 	}
 
@@ -1357,6 +1370,9 @@ namespace eastl
 	{
 		typename eastl::iterator_traits<InputIterator>::difference_type result = 0;
 
+		if(eastl::internal::scan_count(first, last, value, result)) // Vectorized for pointers to arithmetic types.
+			return result;
+
 		for(; first != last; ++first)
 		{
 			if(*first == value)
@@ -1425,13 +1441,42 @@ namespace eastl
 	/// Note: The predicate version of find is findIf and not another variation of find.
 	/// This is because both versions would have three parameters and there could be ambiguity.
 	///
+	namespace internal
+	{
+		template <typename InputIterator, typename T>
+		inline InputIterator find_segmented(InputIterator first, InputIterator last, const T& value, false_type)
+		{
+			if(eastl::internal::scan_find(first, last, value, first)) // memchr or vectorized for pointers to arithmetic types.
+				return first;
+
+			while((first != last) && !(*first == value)) // Note that we always express value comparisons in terms of < or ==.
+				++first;
+			return first;
+		}
+
+		template <typename T>
+		struct segmented_find_op
+		{
+			const T& mValue;
+
+			template <typename LocalIterator>
+			LocalIterator operator()(LocalIterator first, LocalIterator last)
+				{ return eastl::internal::find_segmented(first, last, mValue, false_type()); }
+		};
+
+		template <typename InputIterator, typename T>
+		inline InputIterator find_segmented(InputIterator first, InputIterator last, const T& value, true_type)
+		{
+			segmented_find_op<T> op = { value };
+			return eastl::internal::segmented_walk(first, last, op);
+		}
+	}
+
 	template <typename InputIterator, typename T>
 	inline InputIterator
 	find(InputIterator first, InputIterator last, const T& value)
 	{
-		while((first != last) && !(*first == value)) // Note that we always express value comparisons in terms of < or ==.
-			++first;
-		return first;
+		return eastl::internal::find_segmented(first, last, value, typename eastl::segmented_iterator_traits<InputIterator>::is_segmented_iterator());
 	}
 
 
@@ -1463,13 +1508,39 @@ namespace eastl
 	/// Note: The non-predicate version of findIf is find and not another variation of findIf.
 	/// This is because both versions would have three parameters and there could be ambiguity.
 	///
+	namespace internal
+	{
+		template <typename InputIterator, typename Predicate>
+		inline InputIterator findIf_segmented(InputIterator first, InputIterator last, Predicate& predicate, false_type)
+		{
+			while((first != last) && !predicate(*first))
+				++first;
+			return first;
+		}
+
+		template <typename Predicate>
+		struct segmented_findIf_op
+		{
+			Predicate& mPredicate;
+
+			template <typename LocalIterator>
+			LocalIterator operator()(LocalIterator first, LocalIterator last)
+				{ return eastl::internal::findIf_segmented(first, last, mPredicate, false_type()); }
+		};
+
+		template <typename InputIterator, typename Predicate>
+		inline InputIterator findIf_segmented(InputIterator first, InputIterator last, Predicate& predicate, true_type)
+		{
+			segmented_findIf_op<Predicate> op = { predicate };
+			return eastl::internal::segmented_walk(first, last, op);
+		}
+	}
+
 	template <typename InputIterator, typename Predicate>
 	inline InputIterator
 	findIf(InputIterator first, InputIterator last, Predicate predicate)
 	{
-		while((first != last) && !predicate(*first))
-			++first;
-		return first;
+		return eastl::internal::findIf_segmented(first, last, predicate, typename eastl::segmented_iterator_traits<InputIterator>::is_segmented_iterator());
 	}
 
 
@@ -1727,12 +1798,42 @@ namespace eastl
 	///
 	/// Note: If function returns a result, the result is ignored.
 	///
+	namespace internal
+	{
+		template <typename InputIterator, typename Function>
+		inline void forEach_segmented(InputIterator first, InputIterator last, Function& function, false_type)
+		{
+			for(; first != last; ++first)
+				function(*first);
+		}
+
+		template <typename Function>
+		struct segmented_forEach_op
+		{
+			Function& mFunction;
+
+			template <typename LocalIterator>
+			LocalIterator operator()(LocalIterator first, LocalIterator last)
+			{
+				for(; first != last; ++first)
+					mFunction(*first);
+				return last;
+			}
+		};
+
+		template <typename InputIterator, typename Function>
+		inline void forEach_segmented(InputIterator first, InputIterator last, Function& function, true_type)
+		{
+			segmented_forEach_op<Function> op = { function };
+			eastl::internal::segmented_walk(first, last, op);
+		}
+	}
+
 	template <typename InputIterator, typename Function>
 	inline Function
 	forEach(InputIterator first, InputIterator last, Function function)
 	{
-		for(; first != last; ++first)
-			function(*first);
+		eastl::internal::forEach_segmented(first, last, function, typename eastl::segmented_iterator_traits<InputIterator>::is_segmented_iterator());
 		return function;
 	}
 
@@ -1857,13 +1958,22 @@ namespace eastl
 	///
 	/// Complexity: At most last1 first1 applications of the corresponding predicate.
 	///
-	/// To consider: Make specializations of this for scalar types and random access
-	/// iterators that uses memcmp or some trick memory comparison function.
-	/// We should verify that such a thing results in an improvement.
+	/// Pointers to integral types are compared with memcmp and pointers to floating
+	/// point types with a vectorized mismatch (see internal/scan_help.h). As memcmp
+	/// can't be called during constant evaluation, this requires is_constant_evaluated.
 	///
 	template <typename InputIterator1, typename InputIterator2>
 	EA_CPP14_CONSTEXPR inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
 	{
+		#if defined(__cpp_lib_is_constant_evaluated)
+			if(!eastl::is_constant_evaluated())
+			{
+				bool result = false;
+				if(eastl::internal::scan_equal(first1, last1, first2, result))
+					return result;
+			}
+		#endif
+
 		for(; first1 != last1; ++first1, ++first2)
 		{
 			if(!(*first1 == *first2)) // Note that we always express value comparisons in terms of < or ==.
@@ -1872,45 +1982,6 @@ namespace eastl
 		return true;
 	}
 
-	/* Enable the following if there was shown to be some benefit. A glance and Microsoft VC++ memcmp
-		shows that it is not optimized in any way, much less one that would benefit us here.
-
-	inline bool equal(const bool* first1, const bool* last1, const bool* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const char* first1, const char* last1, const char* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const unsigned char* first1, const unsigned char* last1, const unsigned char* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const signed char* first1, const signed char* last1, const signed char* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	#ifndef EASTL_WCHAR_T_NON_NATIVE
-		inline bool equal(const wchar_t* first1, const wchar_t* last1, const wchar_t* first2)
-			{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-	#endif
-
-	inline bool equal(const int16_t* first1, const int16_t* last1, const int16_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const uint16_t* first1, const uint16_t* last1, const uint16_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const int32_t* first1, const int32_t* last1, const int32_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const uint32_t* first1, const uint32_t* last1, const uint32_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const int64_t* first1, const int64_t* last1, const int64_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-
-	inline bool equal(const uint64_t* first1, const uint64_t* last1, const uint64_t* first2)
-		{ return (memcmp(first1, first2, (size_t)((uintptr_t)last1 - (uintptr_t)first1)) == 0); }
-	*/
-
 
 
 	/// equal
@@ -2195,6 +2266,10 @@ namespace eastl
 	mismatch(InputIterator1 first1, InputIterator1 last1,
 			 InputIterator2 first2) // , InputIterator2 last2)
 	{
+		eastl::pair<InputIterator1, InputIterator2> result(first1, first2);
+		if(eastl::internal::scan_mismatch(first1, last1, first2, result)) // Vectorized for pointers to arithmetic types.
+			return result;
+
 		while((first1 != last1) && (*first1 == *first2)) // && (first2 != last2) <- C++ standard mismatch function doesn't check first2/last2.
 		{
 			++first1;
@@ -32,6 +32,12 @@ EA_DISABLE_ALL_VC_WARNINGS();
 #include <stddef.h>
 #include <string.h>
 
+#if EA_AVX2
+	#include <immintrin.h>
+#elif EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+
 EA_RESTORE_ALL_VC_WARNINGS();
 
 #if EASTL_EXCEPTIONS_ENABLED
@@ -203,7 +209,8 @@ namespace eastl
 		enum {
 			kBitsPerWord      = (8 * sizeof(word_type)),
 			kBitsPerWordMask  = (kBitsPerWord - 1),
-			kBitsPerWordShift = ((kBitsPerWord == 8) ? 3 : ((kBitsPerWord == 16) ? 4 : ((kBitsPerWord == 32) ? 5 : (((kBitsPerWord == 64) ? 6 : 7)))))
+			kBitsPerWordShift = ((kBitsPerWord == 8) ? 3 : ((kBitsPerWord == 16) ? 4 : ((kBitsPerWord == 32) ? 5 : (((kBitsPerWord == 64) ? 6 : 7))))),
+			kUseSimd          = ((NW * kBitsPerWord) >= EASTL_BITSET_SIMD_THRESHOLD) // Whether bulk operations go through the detail::Bitset*Words primitives.
 		};
 
 	public:
@@ -557,6 +564,15 @@ namespace eastl
 		// Finds the index of the last "on" bit before last_find, returns kSize if none are set.
 		size_type findPrev(size_type last_find) const;
 
+		// Calls f(i) with the index of each "on" bit, in increasing order. Cheaper than a
+		// findFirst/findNext loop, as each word is read only once.
+		template <typename Function>
+		void forEachSetBit(Function f) const;
+
+		// Returns (*this & x).count() and (*this & x).any() without building the temporary.
+		size_type countAnd(const this_type& x) const;
+		bool      intersects(const this_type& x) const;
+
 	}; // bitset
 
 
@@ -853,6 +869,356 @@ namespace eastl
 	#endif
 
 
+	/// BitsetPopCount
+	///
+	/// Returns the number of set bits in x, using the compiler's population count
+	/// intrinsic where there is one. With -mpopcnt (or an equivalent -march), GCC
+	/// and Clang compile this to a single POPCNT instruction.
+	///
+	template<typename WordType>
+	eastl::enable_if_t<detail::is_word_type_v<WordType> && (sizeof(WordType) <= 8), uint32_t> BitsetPopCount(WordType x)
+	{
+		#if (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+			if(sizeof(WordType) <= sizeof(unsigned int))
+				return (uint32_t)__builtin_popcount((unsigned int)x);
+			return (uint32_t)__builtin_popcountll((unsigned long long)x);
+		#else
+			return BitsetCountBits(x);
+		#endif
+	}
+
+	#if EASTL_INT128_SUPPORTED
+		inline uint32_t BitsetPopCount(eastl_uint128_t x)
+		{
+			return BitsetPopCount((uint64_t)x) + BitsetPopCount((uint64_t)(x >> 64));
+		}
+	#endif
+
+
+	namespace detail
+	{
+		// Word array primitives shared by bitset and bitvector. They work on the memory of
+		// the array rather than on individual words, so with AVX2 (or SSE2) they look at 32
+		// (or 16) bytes per step whatever the word type is. Callers deal with any unused bits
+		// in the last word.
+
+		/// BitsetCountWords
+		///
+		/// Returns the number of set bits in the words [pWords, pWords + nWordCount).
+		/// With AVX2 this uses the nibble lookup table method (vpshufb + vpsadbw) described
+		/// by Mula, Kurz and Lemire in "Faster Population Counts Using AVX2 Instructions".
+		///
+		template<typename WordType>
+		size_t BitsetCountWords(const WordType* pWords, size_t nWordCount)
+		{
+			size_t n = 0;
+			size_t i = 0;
+
+			#if EA_AVX2
+				const size_t kWordsPerVector = 32 / sizeof(WordType);
+				const size_t nVectorEnd      = nWordCount - (nWordCount % kWordsPerVector);
+
+				if(nWordCount >= (4 * kWordsPerVector)) // Below this the scalar loop is as fast.
+				{
+					const __m256i lookup  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+															 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+					const __m256i lowMask = _mm256_set1_epi8(0x0f);
+					__m256i       total   = _mm256_setzero_si256();
+
+					for(; i < nVectorEnd; i += kWordsPerVector)
+					{
+						const __m256i v      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + i));
+						const __m256i lo     = _mm256_and_si256(v, lowMask);
+						const __m256i hi     = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+						const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+
+						total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+					}
+
+					alignas(32) uint64_t lanes[4];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+					n = (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+				}
+			#endif
+
+			for(; i < nWordCount; ++i)
+				n += BitsetPopCount(pWords[i]);
+
+			return n;
+		}
+
+
+		/// BitsetFindNonZeroWord
+		///
+		/// Returns the index of the first non-zero word in [nFirst, nLast), or nLast if all are zero.
+		///
+		template<typename WordType>
+		size_t BitsetFindNonZeroWord(const WordType* pWords, size_t nFirst, size_t nLast)
+		{
+			size_t i = nFirst;
+
+			#if EA_AVX2
+				const size_t kWordsPerVector = 32 / sizeof(WordType);
+
+				for(; (i + kWordsPerVector) <= nLast; i += kWordsPerVector)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + i));
+
+					if(!_mm256_testz_si256(v, v))
+						break;
+				}
+			#elif EASTL_SSE2
+				const size_t kWordsPerVector = 16 / sizeof(WordType);
+
+				for(; (i + kWordsPerVector) <= nLast; i += kWordsPerVector)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + i));
+
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF)
+						break;
+				}
+			#else
+				// OR together a few words per step, which lets the compiler use wide loads
+				// and keeps the branch count down on long runs of zero words.
+				for(; (i + 4) <= nLast; i += 4)
+				{
+					if(pWords[i] | pWords[i + 1] | pWords[i + 2] | pWords[i + 3])
+						break;
+				}
+			#endif
+
+			for(; i < nLast; ++i)
+			{
+				if(pWords[i])
+					return i;
+			}
+
+			return nLast;
+		}
+
+
+		/// BitsetFindNonZeroWordReverse
+		///
+		/// Returns the index of the last non-zero word in [nFirst, nLast), or nLast if all are zero.
+		///
+		template<typename WordType>
+		size_t BitsetFindNonZeroWordReverse(const WordType* pWords, size_t nFirst, size_t nLast)
+		{
+			size_t i = nLast;
+
+			#if EA_AVX2
+				const size_t kWordsPerVector = 32 / sizeof(WordType);
+
+				for(; (i - nFirst) >= kWordsPerVector; i -= kWordsPerVector)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + i - kWordsPerVector));
+
+					if(!_mm256_testz_si256(v, v))
+						break;
+				}
+			#elif EASTL_SSE2
+				const size_t kWordsPerVector = 16 / sizeof(WordType);
+
+				for(; (i - nFirst) >= kWordsPerVector; i -= kWordsPerVector)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + i - kWordsPerVector));
+
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF)
+						break;
+				}
+			#else
+				for(; (i - nFirst) >= 4; i -= 4)
+				{
+					if(pWords[i - 1] | pWords[i - 2] | pWords[i - 3] | pWords[i - 4])
+						break;
+				}
+			#endif
+
+			while(i > nFirst)
+			{
+				if(pWords[--i])
+					return i;
+			}
+
+			return nLast;
+		}
+
+
+		/// BitsetCountAndWords
+		///
+		/// Returns the number of bits set in both [pWords1, pWords1 + nWordCount) and the
+		/// corresponding words of pWords2.
+		///
+		template<typename WordType>
+		size_t BitsetCountAndWords(const WordType* pWords1, const WordType* pWords2, size_t nWordCount)
+		{
+			size_t n = 0;
+			size_t i = 0;
+
+			#if EA_AVX2
+				const size_t kWordsPerVector = 32 / sizeof(WordType);
+				const size_t nVectorEnd      = nWordCount - (nWordCount % kWordsPerVector);
+
+				if(nWordCount >= (4 * kWordsPerVector))
+				{
+					const __m256i lookup  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+															 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+					const __m256i lowMask = _mm256_set1_epi8(0x0f);
+					__m256i       total   = _mm256_setzero_si256();
+
+					for(; i < nVectorEnd; i += kWordsPerVector)
+					{
+						const __m256i v      = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords1 + i)),
+																_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords2 + i)));
+						const __m256i lo     = _mm256_and_si256(v, lowMask);
+						const __m256i hi     = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+						const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+
+						total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+					}
+
+					alignas(32) uint64_t lanes[4];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+					n = (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+				}
+			#endif
+
+			for(; i < nWordCount; ++i)
+				n += BitsetPopCount((WordType)(pWords1[i] & pWords2[i]));
+
+			return n;
+		}
+
+
+		/// BitsetIntersectsWords
+		///
+		/// Returns true if any bit is set in both [pWords1, pWords1 + nWordCount) and the
+		/// corresponding words of pWords2.
+		///
+		template<typename WordType>
+		bool BitsetIntersectsWords(const WordType* pWords1, const WordType* pWords2, size_t nWordCount)
+		{
+			size_t i = 0;
+
+			#if EA_AVX2
+				const size_t kWordsPerVector = 32 / sizeof(WordType);
+				const size_t nVectorEnd      = nWordCount - (nWordCount % kWordsPerVector);
+
+				for(; i < nVectorEnd; i += kWordsPerVector)
+				{
+					if(!_mm256_testz_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords1 + i)),
+										   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords2 + i))))
+						return true;
+				}
+			#elif EASTL_SSE2
+				const size_t kWordsPerVector = 16 / sizeof(WordType);
+				const size_t nVectorEnd      = nWordCount - (nWordCount % kWordsPerVector);
+
+				for(; i < nVectorEnd; i += kWordsPerVector)
+				{
+					const __m128i v = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords1 + i)),
+													_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords2 + i)));
+
+					if(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF)
+						return true;
+				}
+			#endif
+
+			for(; i < nWordCount; ++i)
+			{
+				if(pWords1[i] & pWords2[i])
+					return true;
+			}
+
+			return false;
+		}
+
+
+		/// BitsetAndOp / BitsetOrOp / BitsetXorOp / BitsetAndNotOp
+		///
+		/// The operations BitsetApplyWords can apply, on words and on SIMD registers.
+		///
+		struct BitsetAndOp
+		{
+			template<typename WordType> WordType operator()(WordType a, WordType b) const { return (WordType)(a & b); }
+			#if EA_AVX2
+				__m256i operator()(__m256i a, __m256i b) const { return _mm256_and_si256(a, b); }
+			#elif EASTL_SSE2
+				__m128i operator()(__m128i a, __m128i b) const { return _mm_and_si128(a, b); }
+			#endif
+		};
+
+		struct BitsetOrOp
+		{
+			template<typename WordType> WordType operator()(WordType a, WordType b) const { return (WordType)(a | b); }
+			#if EA_AVX2
+				__m256i operator()(__m256i a, __m256i b) const { return _mm256_or_si256(a, b); }
+			#elif EASTL_SSE2
+				__m128i operator()(__m128i a, __m128i b) const { return _mm_or_si128(a, b); }
+			#endif
+		};
+
+		struct BitsetXorOp
+		{
+			template<typename WordType> WordType operator()(WordType a, WordType b) const { return (WordType)(a ^ b); }
+			#if EA_AVX2
+				__m256i operator()(__m256i a, __m256i b) const { return _mm256_xor_si256(a, b); }
+			#elif EASTL_SSE2
+				__m128i operator()(__m128i a, __m128i b) const { return _mm_xor_si128(a, b); }
+			#endif
+		};
+
+		struct BitsetAndNotOp
+		{
+			template<typename WordType> WordType operator()(WordType a, WordType b) const { return (WordType)(a & ~b); }
+			#if EA_AVX2
+				__m256i operator()(__m256i a, __m256i b) const { return _mm256_andnot_si256(b, a); }
+			#elif EASTL_SSE2
+				__m128i operator()(__m128i a, __m128i b) const { return _mm_andnot_si128(b, a); }
+			#endif
+		};
+
+
+		/// BitsetApplyWords
+		///
+		/// Does pDest[i] = op(pDest[i], pSource[i]) for each of the nWordCount words.
+		///
+		template<typename WordType, typename Op>
+		void BitsetApplyWords(WordType* pDest, const WordType* pSource, size_t nWordCount, Op op)
+		{
+			size_t i = 0;
+
+			#if EA_AVX2
+				const size_t kWordsPerVector = 32 / sizeof(WordType);
+				const size_t nVectorEnd      = nWordCount - (nWordCount % kWordsPerVector);
+
+				for(; i < nVectorEnd; i += kWordsPerVector)
+				{
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDest + i));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSource + i));
+
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDest + i), op(a, b));
+				}
+			#elif EASTL_SSE2
+				const size_t kWordsPerVector = 16 / sizeof(WordType);
+				const size_t nVectorEnd      = nWordCount - (nWordCount % kWordsPerVector);
+
+				for(; i < nVectorEnd; i += kWordsPerVector)
+				{
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDest + i));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + i), op(a, b));
+				}
+			#endif
+
+			for(; i < nWordCount; ++i)
+				pDest[i] = op(pDest[i], pSource[i]);
+		}
+
+	} // namespace detail
+
+
 
 
 	///////////////////////////////////////////////////////////////////////////
@@ -872,24 +1238,39 @@ namespace eastl
 	template <size_t NW, typename WordType>
 	inline void BitsetBase<NW, WordType>::operator&=(const this_type& x)
 	{
-		for(size_t i = 0; i < NW; i++)
-			mWord[i] &= x.mWord[i];
+		EA_CONSTEXPR_IF(kUseSimd)
+			detail::BitsetApplyWords(mWord, x.mWord, NW, detail::BitsetAndOp());
+		else
+		{
+			for(size_t i = 0; i < NW; i++)
+				mWord[i] &= x.mWord[i];
+		}
 	}
 
 
 	template <size_t NW, typename WordType>
 	inline void BitsetBase<NW, WordType>::operator|=(const this_type& x)
 	{
-		for(size_t i = 0; i < NW; i++)
-			mWord[i] |= x.mWord[i];
+		EA_CONSTEXPR_IF(kUseSimd)
+			detail::BitsetApplyWords(mWord, x.mWord, NW, detail::BitsetOrOp());
+		else
+		{
+			for(size_t i = 0; i < NW; i++)
+				mWord[i] |= x.mWord[i];
+		}
 	}
 
 
 	template <size_t NW, typename WordType>
 	inline void BitsetBase<NW, WordType>::operator^=(const this_type& x)
 	{
-		for(size_t i = 0; i < NW; i++)
-			mWord[i] ^= x.mWord[i];
+		EA_CONSTEXPR_IF(kUseSimd)
+			detail::BitsetApplyWords(mWord, x.mWord, NW, detail::BitsetXorOp());
+		else
+		{
+			for(size_t i = 0; i < NW; i++)
+				mWord[i] ^= x.mWord[i];
+		}
 	}
 
 
@@ -994,6 +1375,9 @@ namespace eastl
 	template <size_t NW, typename WordType>
 	inline bool BitsetBase<NW, WordType>::any() const
 	{
+		EA_CONSTEXPR_IF(kUseSimd)
+			return detail::BitsetFindNonZeroWord(mWord, 0, NW) != NW;
+
 		for(size_t i = 0; i < NW; i++)
 		{
 			if(mWord[i])
@@ -1007,6 +1391,9 @@ namespace eastl
 	inline typename BitsetBase<NW, WordType>::size_type
 	BitsetBase<NW, WordType>::count() const
 	{
+		EA_CONSTEXPR_IF(kUseSimd)
+			return (size_type)detail::BitsetCountWords(mWord, NW);
+
 		size_type n = 0;
 
 		for(size_t i = 0; i < NW; i++)
@@ -1054,6 +1441,16 @@ namespace eastl
 	inline typename BitsetBase<NW, WordType>::size_type 
 	BitsetBase<NW, WordType>::DoFindFirst() const
 	{
+		EA_CONSTEXPR_IF(kUseSimd)
+		{
+			const size_t word_index = detail::BitsetFindNonZeroWord(mWord, 0, NW);
+
+			if(word_index != NW)
+				return (size_type)(word_index * kBitsPerWord) + GetFirstBit(mWord[word_index]);
+
+			return (size_type)NW * kBitsPerWord;
+		}
+
 		for(size_type word_index = 0; word_index < NW; ++word_index)
 		{
 			const size_type fbiw = GetFirstBit(mWord[word_index]);
@@ -1087,6 +1484,21 @@ EA_DISABLE_GCC_WARNING(-Warray-bounds)
 			// Mask off previous bits of the word so our search becomes a "find first".
 			word_type this_word = mWord[word_index] & (static_cast<word_type>(~0) << bit_index);
 
+			EA_CONSTEXPR_IF(kUseSimd)
+			{
+				if(!this_word)
+				{
+					word_index = (size_type)detail::BitsetFindNonZeroWord(mWord, word_index + 1, NW);
+
+					if(word_index == NW)
+						return (size_type)NW * kBitsPerWord;
+
+					this_word = mWord[word_index];
+				}
+
+				return (word_index * kBitsPerWord) + GetFirstBit(this_word);
+			}
+
 			for(;;)
 			{
 				const size_type fbiw = GetFirstBit(this_word);
@@ -1114,6 +1526,16 @@ EA_RESTORE_GCC_WARNING()
 	inline typename BitsetBase<NW, WordType>::size_type 
 	BitsetBase<NW, WordType>::DoFindLast() const
 	{
+		EA_CONSTEXPR_IF(kUseSimd)
+		{
+			const size_t word_index = detail::BitsetFindNonZeroWordReverse(mWord, 0, NW);
+
+			if(word_index != NW)
+				return (size_type)(word_index * kBitsPerWord) + GetLastBit(mWord[word_index]);
+
+			return (size_type)NW * kBitsPerWord;
+		}
+
 		for(size_type word_index = (size_type)NW; word_index > 0; --word_index)
 		{
 			const size_type lbiw = GetLastBit(mWord[word_index - 1]);
@@ -1144,6 +1566,22 @@ EA_RESTORE_GCC_WARNING()
 			word_type mask      = (static_cast<word_type>(~static_cast<word_type>(0)) >> (kBitsPerWord - 1 - bit_index)) >> 1;
 			word_type this_word = mWord[word_index] & mask;
 
+			EA_CONSTEXPR_IF(kUseSimd)
+			{
+				if(!this_word)
+				{
+					const size_t prev_index = detail::BitsetFindNonZeroWordReverse(mWord, 0, word_index);
+
+					if(prev_index == word_index)
+						return (size_type)NW * kBitsPerWord;
+
+					word_index = (size_type)prev_index;
+					this_word  = mWord[word_index];
+				}
+
+				return (word_index * kBitsPerWord) + GetLastBit(this_word);
+			}
+
 			for(;;)
 			{
 				const size_type lbiw = GetLastBit(this_word);
@@ -2074,6 +2512,51 @@ EA_RESTORE_GCC_WARNING()
 	}
 
 
+	template <size_t N, typename WordType>
+	template <typename Function>
+	inline void bitset<N, WordType>::forEachSetBit(Function f) const
+	{
+		// The unused high bits of the last word are always 0, so no index reaches kSize.
+		for(size_t i = 0; i < kWordCount; i++)
+		{
+			for(word_type w = mWord[i]; w; w = (word_type)(w & (w - 1)))
+				f((size_type)(i * kBitsPerWord) + GetFirstBit(w));
+		}
+	}
+
+
+	template <size_t N, typename WordType>
+	inline typename bitset<N, WordType>::size_type
+	bitset<N, WordType>::countAnd(const this_type& x) const
+	{
+		EA_CONSTEXPR_IF((size_t)kWordCount * kBitsPerWord >= EASTL_BITSET_SIMD_THRESHOLD)
+			return (size_type)detail::BitsetCountAndWords(mWord, x.mWord, kWordCount);
+
+		size_type n = 0;
+
+		for(size_t i = 0; i < kWordCount; i++)
+			n += (size_type)BitsetPopCount((word_type)(mWord[i] & x.mWord[i]));
+
+		return n;
+	}
+
+
+	template <size_t N, typename WordType>
+	inline bool bitset<N, WordType>::intersects(const this_type& x) const
+	{
+		EA_CONSTEXPR_IF((size_t)kWordCount * kBitsPerWord >= EASTL_BITSET_SIMD_THRESHOLD)
+			return detail::BitsetIntersectsWords(mWord, x.mWord, kWordCount);
+
+		for(size_t i = 0; i < kWordCount; i++)
+		{
+			if(mWord[i] & x.mWord[i])
+				return true;
+		}
+
+		return false;
+	}
+
+
 
 	///////////////////////////////////////////////////////////////////////////
 	// global operators
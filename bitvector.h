@@ -24,6 +24,9 @@
 #if EASTL_EXCEPTIONS_ENABLED
 #include <stdexcept>
 #endif
+#if EA_BMI2
+#include <immintrin.h>
+#endif
 
 EA_DISABLE_VC_WARNING(4480); // nonstandard extension used: specifying underlying type for enum
 
@@ -297,18 +300,15 @@ namespace eastl
 		reference       operator[](size_type n);            // behavior is undefined if n is invalid.
 		const_reference operator[](size_type n) const;
 
-		/*
-		Work in progress:
-		template <bool value = true> iterator findFirst();                                 // Finds the lowest "on" bit.
-		template <bool value = true> iterator findNext(const_iterator it);                 // Finds the next lowest "on" bit after it.
-		template <bool value = true> iterator findLast();                                  // Finds the index of the last "on" bit, returns size if none are set.
-		template <bool value = true> iterator findPrev(const_iterator it);                 // Finds the index of the last "on" bit before last_find, returns size if none are set.
+		// These work a word (or with AVX2, 32 bytes) at a time rather than bit by bit.
+		size_type count() const;                                    // Returns the number of "on" bits.
+		bool      any() const;                                      // Returns true if any bit is "on".
+		bool      none() const;                                     // Returns true if no bit is "on".
 
-		template <bool value = true> const_iterator findFirst() const;                     // Finds the lowest "on" bit.
-		template <bool value = true> const_iterator findNext(const_iterator it) const;     // Finds the next lowest "on" bit after it.
-		template <bool value = true> const_iterator findLast() const;                      // Finds the index of the last "on" bit, returns size if none are set.
-		template <bool value = true> const_iterator findPrev(const_iterator it) const;     // Finds the index of the last "on" bit before last_find, returns size if none are set.
-		*/
+		size_type findFirst() const;                                // Finds the index of the first "on" bit, returns size() if none are set.
+		size_type findNext(size_type last_find) const;              // Finds the index of the next "on" bit after last_find, returns size() if none are set.
+		size_type findLast() const;                                 // Finds the index of the last "on" bit, returns size() if none are set.
+		size_type findPrev(size_type last_find) const;              // Finds the index of the last "on" bit before last_find, returns size() if none are set.
 
 		element_type*       data() EASTL_NOEXCEPT;
 		const element_type* data() const EASTL_NOEXCEPT;
@@ -333,6 +333,9 @@ namespace eastl
 
 		bool validate() const;
 		int  validateIterator(const_iterator i) const;
+
+	protected:
+		element_type DoGetLastWordMask() const;
 	};
 
 
@@ -1100,26 +1103,122 @@ namespace eastl
 	}
 
 
-/*
 	template <typename Allocator, typename Element, typename Container>
-	template <bool value>
-	typename bitvector<Allocator, Element, Container>::iterator 
-	bitvector<Allocator, Element, Container>::findFirst()
+	inline typename bitvector<Allocator, Element, Container>::element_type
+	bitvector<Allocator, Element, Container>::DoGetLastWordMask() const
 	{
-		return begin();
+		// The bits past size() in the last word are unspecified (e.g. popBack doesn't clear them).
+		return (element_type)((element_type)~element_type(0) >> mFreeBitCount);
 	}
 
-	template <bool value> iterator findNext(const_iterator it);
-	template <bool value> iterator findLast();
-	template <bool value> iterator findPrev(const_iterator it);
-						
-	template <bool value> const_iterator findFirst() const;
-	template <bool value> const_iterator findNext(const_iterator it) const;
-	template <bool value> const_iterator findLast() const;
-	template <bool value> const_iterator findPrev(const_iterator it) const;
-*/
 
+	template <typename Allocator, typename Element, typename Container>
+	typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::count() const
+	{
+		const size_type nWordCount = (size_type)mContainer.size();
+
+		if(nWordCount == 0)
+			return 0;
+
+		const element_type* const pWords = mContainer.data();
+
+		return (size_type)detail::BitsetCountWords(pWords, nWordCount - 1) + BitsetPopCount((element_type)(pWords[nWordCount - 1] & DoGetLastWordMask()));
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline bool bitvector<Allocator, Element, Container>::any() const
+	{
+		return findFirst() != size();
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline bool bitvector<Allocator, Element, Container>::none() const
+	{
+		return !any();
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::findFirst() const
+	{
+		return findNext(npos);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::findNext(size_type last_find) const
+	{
+		const size_type nSize = size();
+
+		// Start looking from the next bit. npos wraps around to 0, which findFirst relies on.
+		if(++last_find >= nSize)
+			return nSize;
+
+		const element_type* const pWords     = mContainer.data();
+		const size_type           nWordCount = (size_type)mContainer.size();
+		size_type                 nWord      = last_find / kBitCount;
+
+		// Mask off previous bits of the word so our search becomes a "find first".
+		const element_type firstWord = (element_type)(pWords[nWord] & (element_type)((element_type)~element_type(0) << (last_find % kBitCount)));
+
+		if(!firstWord)
+		{
+			nWord = (size_type)detail::BitsetFindNonZeroWord(pWords, nWord + 1, nWordCount);
+
+			if(nWord == nWordCount)
+				return nSize;
+		}
+
+		const size_type n = (nWord * kBitCount) + GetFirstBit(firstWord ? firstWord : pWords[nWord]);
+
+		return (n < nSize) ? n : nSize; // A hit past the end can only come from the unused bits of the last word.
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::findLast() const
+	{
+		return findPrev(size());
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::findPrev(size_type last_find) const
+	{
+		const size_type nSize = size();
+
+		if(last_find > nSize)
+			last_find = nSize;
+
+		if(last_find == 0)
+			return nSize;
+
+		// Look at bits [0, last_find). The last of these is in word nWord.
+		const element_type* const pWords = mContainer.data();
+		const size_type           nLast  = last_find - 1;
+		size_type                 nWord  = nLast / kBitCount;
 
+		// Mask off subsequent bits of the word so our search becomes a "find last". This also masks
+		// off the unused bits of the last word, as last_find <= size().
+		const element_type lastWord = (element_type)(pWords[nWord] & (element_type)((element_type)~element_type(0) >> (kBitCount - 1 - (nLast % kBitCount))));
+
+		if(lastWord)
+			return (nWord * kBitCount) + GetLastBit(lastWord);
+
+		nWord = (size_type)detail::BitsetFindNonZeroWordReverse(pWords, 0, nWord);
+
+		if(nWord == (nLast / kBitCount))
+			return nSize;
+
+		return (nWord * kBitCount) + GetLastBit(pWords[nWord]);
+	}
 
 
 	template <typename Allocator, typename Element, typename Container>
@@ -1403,6 +1502,308 @@ namespace eastl
 
 
 
+	/// bitvector_rank_select
+	///
+	/// An index over a bitvector which answers rank queries (how many bits are "on"
+	/// before a position) in O(1) and select queries (where is the k-th "on" bit) in
+	/// close to O(1). It uses Vigna's rank9 layout ("Broadword Implementation of
+	/// Rank/Select Queries", 2008): for every 512-bit block it stores the number of
+	/// "on" bits before the block in one 64-bit word, and the counts before each of
+	/// the block's eight 64-bit sub-blocks, relative to the block, as seven 9-bit
+	/// fields in a second word. That costs 25% of the size of the bitvector. select
+	/// also records the block of every kSelectSampleRate-th "on" bit, so that it only
+	/// has to binary search the blocks between two samples.
+	///
+	/// The index doesn't track changes to the bitvector; call rebuild() after
+	/// modifying the bitvector and before querying again.
+	///
+	/// Example usage:
+	///     bitvector<> bv(100000000);
+	///     ...
+	///     bitvector_rank_select<> index(bv);
+	///
+	///     size_t nOnBefore = index.rank(5000000); // Number of "on" bits in [0, 5000000).
+	///     size_t nPosition = index.select(17);    // Index of the 18th "on" bit.
+	///
+	template <typename Allocator = EASTLAllocatorType, 
+			  typename Element   = BitvectorWordType, 
+			  typename Container = eastl::vector<Element, Allocator> >
+	class bitvector_rank_select
+	{
+	public:
+		typedef bitvector_rank_select<Allocator, Element, Container>  this_type;
+		typedef bitvector<Allocator, Element, Container>              bitvector_type;
+		typedef Allocator                                             allocator_type;
+		typedef Element                                               element_type;
+		typedef eastl_size_t                                          size_type;
+
+		static_assert(((8 * sizeof(Element)) <= 64) && ((64 % (8 * sizeof(Element))) == 0), "bitvector_rank_select requires a word type of at most 64 bits.");
+
+		enum
+		{
+			kBitsPerChunk      = 64,     // The size of a sub-block.
+			kChunksPerBlock    = 8,
+			kSelectSampleRate  = 4096    // select keeps one sample per this many "on" bits.
+		};
+
+	public:
+		explicit bitvector_rank_select(const allocator_type& allocator = EASTL_BITVECTOR_DEFAULT_ALLOCATOR);
+		explicit bitvector_rank_select(const bitvector_type& bv, const allocator_type& allocator = EASTL_BITVECTOR_DEFAULT_ALLOCATOR);
+
+		void rebuild();                               // Rebuilds the index from the bitvector it was last built from. O(n).
+		void rebuild(const bitvector_type& bv);       // Builds the index from bv, which is referenced until the next rebuild. O(n).
+
+		size_type size() const EASTL_NOEXCEPT;        // The size of the bitvector as of the last rebuild.
+		size_type count() const EASTL_NOEXCEPT;       // The number of "on" bits as of the last rebuild.
+
+		size_type rank(size_type i) const;            // Returns the number of "on" bits in [0, i). i must be <= size().
+		size_type rank0(size_type i) const;           // Returns the number of "off" bits in [0, i). i must be <= size().
+		size_type select(size_type k) const;          // Returns the index of the "on" bit with rank k (the first has k = 0), or size() if k >= count().
+
+	protected:
+		uint64_t         DoGetChunk(size_type nChunk) const; // Returns bits [nChunk * 64, nChunk * 64 + 64), with bits past size() cleared.
+		static size_type DoSelectInChunk(uint64_t chunk, size_type k);
+
+	protected:
+		const bitvector_type*               mpBitvector;
+		size_type                           mnSize;
+		size_type                           mnCount;
+		eastl::vector<uint64_t, Allocator>  mBlocks;         // For each block, followed by a sentinel block: the absolute count, then the packed relative counts.
+		eastl::vector<size_type, Allocator> mSelectSamples;  // mSelectSamples[j] is the block holding the "on" bit of rank j * kSelectSampleRate, followed by the last block.
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// bitvector_rank_select
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Allocator, typename Element, typename Container>
+	inline bitvector_rank_select<Allocator, Element, Container>::bitvector_rank_select(const allocator_type& allocator)
+		: mpBitvector(NULL)
+		, mnSize(0)
+		, mnCount(0)
+		, mBlocks(allocator)
+		, mSelectSamples(allocator)
+	{
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline bitvector_rank_select<Allocator, Element, Container>::bitvector_rank_select(const bitvector_type& bv, const allocator_type& allocator)
+		: mpBitvector(NULL)
+		, mnSize(0)
+		, mnCount(0)
+		, mBlocks(allocator)
+		, mSelectSamples(allocator)
+	{
+		rebuild(bv);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline void bitvector_rank_select<Allocator, Element, Container>::rebuild()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mpBitvector == NULL))
+				EASTL_FAIL_MSG("bitvector_rank_select::rebuild -- no bitvector to rebuild from");
+		#endif
+
+		rebuild(*mpBitvector);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	void bitvector_rank_select<Allocator, Element, Container>::rebuild(const bitvector_type& bv)
+	{
+		mpBitvector = &bv;
+		mnSize      = bv.size();
+
+		const size_type nChunkCount = (mnSize + kBitsPerChunk - 1) / kBitsPerChunk;
+		const size_type nBlockCount = (nChunkCount + kChunksPerBlock - 1) / kChunksPerBlock;
+
+		// The vectors are sized exactly up front, as they can get large.
+		mBlocks.resize(2 * (nBlockCount + 1));
+
+		uint64_t nTotal = 0;
+
+		for(size_type nBlock = 0; nBlock < nBlockCount; ++nBlock)
+		{
+			uint64_t nRelative = 0;
+			uint64_t nPacked   = 0;
+
+			for(size_type t = 0; t < kChunksPerBlock; ++t)
+			{
+				if(t)
+					nPacked |= nRelative << (9 * (t - 1));
+
+				const size_type nChunk = (nBlock * kChunksPerBlock) + t;
+
+				if(nChunk < nChunkCount)
+					nRelative += BitsetPopCount(DoGetChunk(nChunk));
+			}
+
+			mBlocks[2 * nBlock]     = nTotal;
+			mBlocks[2 * nBlock + 1] = nPacked;
+			nTotal += nRelative;
+		}
+
+		mBlocks[2 * nBlockCount]     = nTotal;
+		mBlocks[2 * nBlockCount + 1] = 0;
+		mnCount = (size_type)nTotal;
+
+		const size_type nSampleCount = (mnCount + kSelectSampleRate - 1) / kSelectSampleRate;
+
+		mSelectSamples.resize(nSampleCount + 1);
+
+		for(size_type nBlock = 0, j = 0; j < nSampleCount; ++nBlock)
+		{
+			// Record every sampled rank which falls before the end of this block.
+			while((j < nSampleCount) && ((uint64_t)j * kSelectSampleRate < mBlocks[2 * (nBlock + 1)]))
+				mSelectSamples[j++] = nBlock;
+		}
+
+		mSelectSamples[nSampleCount] = nBlockCount ? (nBlockCount - 1) : 0;
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector_rank_select<Allocator, Element, Container>::size_type
+	bitvector_rank_select<Allocator, Element, Container>::size() const EASTL_NOEXCEPT
+	{
+		return mnSize;
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector_rank_select<Allocator, Element, Container>::size_type
+	bitvector_rank_select<Allocator, Element, Container>::count() const EASTL_NOEXCEPT
+	{
+		return mnCount;
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector_rank_select<Allocator, Element, Container>::size_type
+	bitvector_rank_select<Allocator, Element, Container>::rank(size_type i) const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(i > mnSize))
+				EASTL_FAIL_MSG("bitvector_rank_select::rank -- out of range");
+		#endif
+
+		const size_type       nChunk  = i / kBitsPerChunk;
+		const size_type       t       = nChunk % kChunksPerBlock;
+		const uint64_t* const pBlock  = &mBlocks[2 * (nChunk / kChunksPerBlock)];
+		size_type             n       = (size_type)pBlock[0];
+
+		if(t)
+			n += (size_type)((pBlock[1] >> (9 * (t - 1))) & 0x1FF);
+
+		if(i % kBitsPerChunk)
+			n += BitsetPopCount(DoGetChunk(nChunk) & ((UINT64_C(1) << (i % kBitsPerChunk)) - 1));
+
+		return n;
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector_rank_select<Allocator, Element, Container>::size_type
+	bitvector_rank_select<Allocator, Element, Container>::rank0(size_type i) const
+	{
+		return i - rank(i);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	typename bitvector_rank_select<Allocator, Element, Container>::size_type
+	bitvector_rank_select<Allocator, Element, Container>::select(size_type k) const
+	{
+		if(k >= mnCount)
+			return mnSize;
+
+		// The block holding rank k lies between the blocks of the samples around it.
+		size_type nLow  = mSelectSamples[k / kSelectSampleRate];
+		size_type nHigh = mSelectSamples[(k / kSelectSampleRate) + 1];
+
+		while(nLow < nHigh) // Find the last block which starts at or before rank k.
+		{
+			const size_type nMid = nLow + ((nHigh - nLow + 1) / 2);
+
+			if(mBlocks[2 * nMid] <= k)
+				nLow = nMid;
+			else
+				nHigh = nMid - 1;
+		}
+
+		// Find the last sub-block which starts at or before rank k. Sub-blocks past the
+		// end of the bitvector have the block's full count, which is greater than k.
+		const uint64_t nPacked = mBlocks[2 * nLow + 1];
+		size_type      r       = k - (size_type)mBlocks[2 * nLow];
+		size_type      t       = 0;
+
+		while((t < (kChunksPerBlock - 1)) && (((nPacked >> (9 * t)) & 0x1FF) <= r))
+			++t;
+
+		if(t)
+			r -= (size_type)((nPacked >> (9 * (t - 1))) & 0x1FF);
+
+		const size_type nChunk = (nLow * kChunksPerBlock) + t;
+
+		return (nChunk * kBitsPerChunk) + DoSelectInChunk(DoGetChunk(nChunk), r);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline uint64_t bitvector_rank_select<Allocator, Element, Container>::DoGetChunk(size_type nChunk) const
+	{
+		const size_type           kWordBits     = bitvector_type::kBitCount;
+		const size_type           kWordsInChunk = kBitsPerChunk / kWordBits;
+		const element_type* const pWords        = mpBitvector->data();
+		const size_type           nFirstWord    = nChunk * kWordsInChunk;
+		const size_type           nFirstBit     = nChunk * kBitsPerChunk;
+		uint64_t                  chunk         = 0;
+
+		if(kWordsInChunk == 1)
+			chunk = (uint64_t)pWords[nFirstWord];
+		else
+		{
+			const size_type nWordCount = (mnSize + kWordBits - 1) / kWordBits;
+
+			for(size_type j = 0; (j < kWordsInChunk) && ((nFirstWord + j) < nWordCount); ++j)
+				chunk |= (uint64_t)pWords[nFirstWord + j] << ((j * kWordBits) % kBitsPerChunk); // The modulo only silences shift warnings for 64-bit words.
+		}
+
+		if((mnSize - nFirstBit) < kBitsPerChunk) // Clear the unused bits of the last chunk.
+			chunk &= (UINT64_C(1) << (mnSize - nFirstBit)) - 1;
+
+		return chunk;
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	inline typename bitvector_rank_select<Allocator, Element, Container>::size_type
+	bitvector_rank_select<Allocator, Element, Container>::DoSelectInChunk(uint64_t chunk, size_type k)
+	{
+		#if EA_BMI2
+			// Deposit a single bit at the position of the k-th set bit of chunk.
+			return (size_type)GetFirstBit((uint64_t)_pdep_u64(UINT64_C(1) << k, chunk));
+		#else
+			size_type n = 0;
+
+			// Skip whole bytes, then clear the lowest remaining set bits.
+			for(uint32_t c; k >= (c = BitsetPopCount((uint32_t)(chunk & 0xFF))); chunk >>= 8, n += 8)
+				k -= c;
+
+			for(; k; --k)
+				chunk &= chunk - 1;
+
+			return n + GetFirstBit(chunk);
+		#endif
+	}
+
+
+
 	///////////////////////////////////////////////////////////////////////
 	// global operators
 	///////////////////////////////////////////////////////////////////////
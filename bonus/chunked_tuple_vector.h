@@ -0,0 +1,666 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// chunked_tuple_vector is a variant of tuple_vector with an "array of
+// structures of arrays" (AoSoA) layout: elements are stored in fixed-size
+// chunks of ChunkSize elements, and within a chunk each tuple element has
+// its own contiguous column, e.g. for chunked_tuple_vector<4, float, int>:
+//
+//     chunk 0: f f f f i i i i     chunk 1: f f f f i i i i     ...
+//
+// Compared to tuple_vector, this trades a little indexing arithmetic for two
+// things. First, the columns of one element are never more than a chunk
+// apart, so code which touches several columns of an element touches
+// nearby memory instead of N distant arrays. Second, growth never relocates
+// elements: it only allocates another chunk, so references to elements stay
+// valid while pushing back, and elements need not be movable to grow.
+//
+// Chunks which are no longer used (after popBack, resize or clear) are kept
+// and reused by later growth, until shrink_to_fit releases them. Columns
+// are aligned per type just like in tuple_vector (see
+// tuplevec_column_alignment), and the inner loops of bulk operations should
+// be written per chunk, with forEachChunk, where each column is a plain array:
+//
+//     eastl::chunked_tuple_vector<64, float, float> particles; // x, vx
+//
+//     particles.forEachChunk<0, 1>([dt](size_t n, float* pX, float* pVX)
+//     {
+//         for (size_t i = 0; i < n; ++i)
+//             pX[i] += pVX[i] * dt;
+//     });
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_CHUNKEDTUPLEVECTOR_H
+#define EASTL_CHUNKEDTUPLEVECTOR_H
+
+#include <eastl/bonus/tuple_vector.h>
+#include <eastl/internal/config.h>
+#include <eastl/iterator.h>
+#include <eastl/memory.h>
+#include <eastl/tuple.h>
+#include <eastl/utility.h>
+#include <eastl/vector.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+EA_DISABLE_VC_WARNING(4623) // warning C4623: default constructor was implicitly defined as deleted
+EA_DISABLE_VC_WARNING(4625) // warning C4625: copy constructor was implicitly defined as deleted
+
+namespace eastl
+{
+	/// EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_NAME
+	#define EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " chunked-tuple-vector" // Unless the user overrides something, this is "EASTL chunked-tuple-vector".
+	#endif
+
+
+	/// EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_ALLOCATOR
+	#define EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_ALLOCATOR allocator_type(EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_NAME)
+	#endif
+
+namespace TupleVecInternal
+{
+
+// The byte offset of column I within a chunk of ChunkSize elements. Columns are laid out in order,
+// each one aligned as in tuple_vector.
+template <eastl_size_t ChunkSize, eastl_size_t I, typename... Ts>
+struct ChunkColumnOffset
+{
+	typedef tuplevec_element_t<I - 1, Ts...> PrevElement;
+	static const eastl_size_t kAlignment = tuplevec_column_alignment<tuplevec_element_t<I, Ts...>>::value;
+	static const eastl_size_t kPrevEnd = ChunkColumnOffset<ChunkSize, I - 1, Ts...>::value + sizeof(PrevElement) * ChunkSize;
+	static const eastl_size_t value = (kPrevEnd + kAlignment - 1) & (~kAlignment + 1);
+};
+
+template <eastl_size_t ChunkSize, typename... Ts>
+struct ChunkColumnOffset<ChunkSize, 0, Ts...>
+{
+	static const eastl_size_t value = 0;
+};
+
+
+template <typename Container, typename Reference>
+struct ChunkedTupleVecIter;
+
+template <typename Allocator, eastl_size_t ChunkSize, typename Indices, typename... Ts>
+class ChunkedTupleVecImpl;
+
+template <typename Allocator, eastl_size_t ChunkSize, eastl_size_t... Indices, typename... Ts>
+class ChunkedTupleVecImpl<Allocator, ChunkSize, integer_sequence<eastl_size_t, Indices...>, Ts...>
+{
+	typedef ChunkedTupleVecImpl<Allocator, ChunkSize, integer_sequence<eastl_size_t, Indices...>, Ts...> this_type;
+
+	static_assert(ChunkSize > 0, "chunked_tuple_vector requires a ChunkSize of at least 1");
+	static_assert(sizeof...(Ts) > 0, "chunked_tuple_vector requires at least one element type");
+
+public:
+	typedef eastl_size_t size_type;
+	typedef ptrdiff_t difference_type;
+	typedef Allocator allocator_type;
+
+	typedef eastl::tuple<Ts...> value_tuple;
+	typedef eastl::tuple<Ts&...> reference_tuple;
+	typedef eastl::tuple<const Ts&...> const_reference_tuple;
+
+	typedef ChunkedTupleVecIter<this_type, reference_tuple> iterator;
+	typedef ChunkedTupleVecIter<const this_type, const_reference_tuple> const_iterator;
+	typedef eastl::reverse_iterator<iterator> reverse_iterator;
+	typedef eastl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	static const size_type kChunkSize = ChunkSize;
+
+public:
+	ChunkedTupleVecImpl()
+		: mChunks(EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_ALLOCATOR), mNumElements(0)
+	{}
+
+	explicit ChunkedTupleVecImpl(const allocator_type& allocator)
+		: mChunks(allocator), mNumElements(0)
+	{}
+
+	explicit ChunkedTupleVecImpl(size_type n, const allocator_type& allocator = EASTL_CHUNKED_TUPLE_VECTOR_DEFAULT_ALLOCATOR)
+		: mChunks(allocator), mNumElements(0)
+	{
+		resize(n);
+	}
+
+	ChunkedTupleVecImpl(const this_type& x)
+		: mChunks(x.mChunks.getAllocator()), mNumElements(0)
+	{
+		DoCopyFrom(x);
+	}
+
+	ChunkedTupleVecImpl(const this_type& x, const allocator_type& allocator)
+		: mChunks(allocator), mNumElements(0)
+	{
+		DoCopyFrom(x);
+	}
+
+	// Elements are never moved individually: the chunks change hands.
+	ChunkedTupleVecImpl(this_type&& x)
+		: mChunks(x.mChunks.getAllocator()), mNumElements(0)
+	{
+		swap(x);
+	}
+
+	~ChunkedTupleVecImpl()
+	{
+		clear();
+		shrink_to_fit();
+	}
+
+	this_type& operator=(const this_type& x)
+	{
+		if (this != &x)
+		{
+			clear();
+			DoCopyFrom(x);
+		}
+		return *this;
+	}
+
+	this_type& operator=(this_type&& x)
+	{
+		if (this != &x)
+		{
+			clear();
+			swap(x);
+		}
+		return *this;
+	}
+
+	void swap(this_type& x)
+	{
+		mChunks.swap(x.mChunks);
+		eastl::swap(mNumElements, x.mNumElements);
+	}
+
+	bool empty() const EASTL_NOEXCEPT { return mNumElements == 0; }
+	size_type size() const EASTL_NOEXCEPT { return mNumElements; }
+	size_type capacity() const EASTL_NOEXCEPT { return mChunks.size() * ChunkSize; }
+
+	// The number of chunks which hold elements, and the number of elements in chunk c. All chunks
+	// but the last one are full.
+	size_type chunkCount() const EASTL_NOEXCEPT { return (mNumElements + ChunkSize - 1) / ChunkSize; }
+	size_type chunkSize(size_type c) const EASTL_NOEXCEPT { return eastl::min(mNumElements - c * ChunkSize, (size_type)ChunkSize); }
+
+	// The start of column I in chunk c. Valid for every allocated chunk, not only for the used ones.
+	template <size_type I>
+	tuplevec_element_t<I, Ts...>* chunkData(size_type c) EASTL_NOEXCEPT
+	{
+		return DoColumn<I>(mChunks[c]);
+	}
+
+	template <size_type I>
+	const tuplevec_element_t<I, Ts...>* chunkData(size_type c) const EASTL_NOEXCEPT
+	{
+		return DoColumn<I>(mChunks[c]);
+	}
+
+	// Calls f(n, pColumnI, pColumnJ, ...) once per used chunk, where n is the number of elements in
+	// the chunk and the pointers are the chunk's columns Is...
+	template <size_type... Is, typename Function>
+	void forEachChunk(Function f)
+	{
+		for (size_type c = 0, nChunkCount = chunkCount(); c < nChunkCount; ++c)
+			f(chunkSize(c), DoColumn<Is>(mChunks[c])...);
+	}
+
+	template <size_type... Is, typename Function>
+	void forEachChunk(Function f) const
+	{
+		for (size_type c = 0, nChunkCount = chunkCount(); c < nChunkCount; ++c)
+			f(chunkSize(c), static_cast<const tuplevec_element_t<Is, Ts...>*>(DoColumn<Is>(mChunks[c]))...);
+	}
+
+	template <size_type I>
+	tuplevec_element_t<I, Ts...>& get(size_type n)
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::get -- out of range");
+#endif
+		return DoColumn<I>(mChunks[n / ChunkSize])[n % ChunkSize];
+	}
+
+	template <size_type I>
+	const tuplevec_element_t<I, Ts...>& get(size_type n) const
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::get -- out of range");
+#endif
+		return DoColumn<I>(mChunks[n / ChunkSize])[n % ChunkSize];
+	}
+
+	reference_tuple operator[](size_type n)
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::operator[] -- out of range");
+#endif
+		return DoElement(n);
+	}
+
+	const_reference_tuple operator[](size_type n) const
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::operator[] -- out of range");
+#endif
+		return DoElement(n);
+	}
+
+	reference_tuple at(size_type n)
+	{
+#if EASTL_EXCEPTIONS_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			throw std::out_of_range("chunked_tuple_vector::at -- out of range");
+#elif EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::at -- out of range");
+#endif
+		return DoElement(n);
+	}
+
+	const_reference_tuple at(size_type n) const
+	{
+#if EASTL_EXCEPTIONS_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			throw std::out_of_range("chunked_tuple_vector::at -- out of range");
+#elif EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::at -- out of range");
+#endif
+		return DoElement(n);
+	}
+
+	reference_tuple front() { return operator[](0); }
+	const_reference_tuple front() const { return operator[](0); }
+	reference_tuple back() { return operator[](mNumElements - 1); }
+	const_reference_tuple back() const { return operator[](mNumElements - 1); }
+
+	iterator begin() EASTL_NOEXCEPT { return iterator(this, 0); }
+	const_iterator begin() const EASTL_NOEXCEPT { return const_iterator(this, 0); }
+	const_iterator cbegin() const EASTL_NOEXCEPT { return const_iterator(this, 0); }
+	iterator end() EASTL_NOEXCEPT { return iterator(this, mNumElements); }
+	const_iterator end() const EASTL_NOEXCEPT { return const_iterator(this, mNumElements); }
+	const_iterator cend() const EASTL_NOEXCEPT { return const_iterator(this, mNumElements); }
+	reverse_iterator rbegin() EASTL_NOEXCEPT { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const EASTL_NOEXCEPT { return const_reverse_iterator(end()); }
+	reverse_iterator rend() EASTL_NOEXCEPT { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const EASTL_NOEXCEPT { return const_reverse_iterator(begin()); }
+
+	reference_tuple pushBack()
+	{
+		void* pChunk = DoGrowByOne();
+		const size_type i = mNumElements % ChunkSize;
+		ElementGuard guard(pChunk, i);
+		int unused[] = { 0, (::new (DoColumn<Indices>(pChunk) + i) Ts(), ++guard.mnConstructed, 0)... };
+		(void)unused;
+		guard.mpChunk = nullptr;
+		++mNumElements;
+		return back();
+	}
+
+	void pushBack(const Ts&... args)
+	{
+		void* pChunk = DoGrowByOne();
+		const size_type i = mNumElements % ChunkSize;
+		ElementGuard guard(pChunk, i);
+		int unused[] = { 0, (::new (DoColumn<Indices>(pChunk) + i) Ts(args), ++guard.mnConstructed, 0)... };
+		(void)unused;
+		guard.mpChunk = nullptr;
+		++mNumElements;
+	}
+
+	void pushBack(Ts&&... args)
+	{
+		emplace_back(eastl::forward<Ts>(args)...);
+	}
+
+	void pushBack(const_reference_tuple tup) { pushBack(eastl::get<Indices>(tup)...); }
+
+	reference_tuple emplace_back(Ts&&... args)
+	{
+		void* pChunk = DoGrowByOne();
+		const size_type i = mNumElements % ChunkSize;
+		ElementGuard guard(pChunk, i);
+		int unused[] = { 0, (::new (DoColumn<Indices>(pChunk) + i) Ts(eastl::forward<Ts>(args)), ++guard.mnConstructed, 0)... };
+		(void)unused;
+		guard.mpChunk = nullptr;
+		++mNumElements;
+		return back();
+	}
+
+	void popBack()
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mNumElements == 0))
+			EASTL_FAIL_MSG("chunked_tuple_vector::popBack -- container is empty");
+#endif
+		--mNumElements;
+		void* pChunk = mChunks[mNumElements / ChunkSize];
+		const size_type i = mNumElements % ChunkSize;
+		swallow((eastl::destruct(DoColumn<Indices>(pChunk) + i), 0)...);
+	}
+
+	// Replaces the element at pos with the last element, so that no other element moves.
+	iterator erase_unsorted(const_iterator pos)
+	{
+		const size_type n = pos.mnIndex;
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(pos.mpContainer != this || n >= mNumElements))
+			EASTL_FAIL_MSG("chunked_tuple_vector::erase_unsorted -- invalid iterator");
+#endif
+		if (n != mNumElements - 1)
+		{
+			void* pChunk = mChunks[n / ChunkSize];
+			void* pLastChunk = mChunks[(mNumElements - 1) / ChunkSize];
+			const size_type i = n % ChunkSize, iLast = (mNumElements - 1) % ChunkSize;
+			swallow((DoColumn<Indices>(pChunk)[i] = eastl::move(DoColumn<Indices>(pLastChunk)[iLast]), 0)...);
+		}
+		popBack();
+		return iterator(this, n);
+	}
+
+	void clear() EASTL_NOEXCEPT
+	{
+		DoDestruct(0, mNumElements);
+		mNumElements = 0;
+	}
+
+	void resize(size_type n)
+	{
+		if (n > mNumElements)
+		{
+			reserve(n);
+			DoForEachRange(mNumElements, n, [](void* pChunk, size_type first, size_type last)
+			{
+				swallow((eastl::uninitialized_value_construct_n(DoColumn<Indices>(pChunk) + first, last - first), 0)...);
+			});
+			mNumElements = n;
+		}
+		else
+		{
+			DoDestruct(n, mNumElements);
+			mNumElements = n;
+		}
+	}
+
+	void resize(size_type n, const Ts&... args)
+	{
+		if (n > mNumElements)
+		{
+			reserve(n);
+			DoForEachRange(mNumElements, n, [&](void* pChunk, size_type first, size_type last)
+			{
+				swallow((eastl::uninitializedFill(DoColumn<Indices>(pChunk) + first, DoColumn<Indices>(pChunk) + last, args), 0)...);
+			});
+			mNumElements = n;
+		}
+		else
+		{
+			DoDestruct(n, mNumElements);
+			mNumElements = n;
+		}
+	}
+
+	// Allocates chunks until n elements fit. Existing elements never move.
+	void reserve(size_type n)
+	{
+		const size_type nChunkCount = (n + ChunkSize - 1) / ChunkSize;
+
+		if (nChunkCount > mChunks.size())
+		{
+			mChunks.reserve(nChunkCount);
+			while (mChunks.size() < nChunkCount)
+				mChunks.pushBack(DoAllocateChunk());
+		}
+	}
+
+	// Frees the chunks which hold no elements.
+	void shrink_to_fit()
+	{
+		const size_type nChunkCount = chunkCount();
+
+		while (mChunks.size() > nChunkCount)
+		{
+			DoFreeChunk(mChunks.back());
+			mChunks.popBack();
+		}
+		mChunks.shrink_to_fit();
+	}
+
+	const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mChunks.getAllocator(); }
+	allocator_type& getAllocator() EASTL_NOEXCEPT { return mChunks.getAllocator(); }
+
+	void setAllocator(const allocator_type& allocator)
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(!mChunks.empty()))
+			EASTL_FAIL_MSG("chunked_tuple_vector::setAllocator -- chunks must be freed before changing the allocator");
+#endif
+		mChunks.setAllocator(allocator);
+	}
+
+	bool validate() const EASTL_NOEXCEPT
+	{
+		if (chunkCount() > mChunks.size())
+			return false;
+		for (size_type c = 0; c < mChunks.size(); ++c)
+		{
+			if (!mChunks[c] || ((uintptr_t)mChunks[c] & (kChunkAlignment - 1)))
+				return false;
+		}
+		return true;
+	}
+
+	int validateIterator(const_iterator i) const EASTL_NOEXCEPT
+	{
+		if (i.mpContainer != this || i.mnIndex > mNumElements)
+			return isf_none;
+		if (i.mnIndex == mNumElements)
+			return (isf_valid | isf_current);
+		return (isf_valid | isf_current | isf_can_dereference);
+	}
+
+protected:
+	template <typename Container, typename Reference>
+	friend struct ChunkedTupleVecIter;
+
+	static const size_type kChunkAlignment = TupleRecurser<Ts...>::GetTotalAlignment();
+	static const size_type kChunkBytes = TupleRecurser<Ts...>::GetTotalAllocationSize(ChunkSize, 0);
+
+	template <size_type I>
+	static tuplevec_element_t<I, Ts...>* DoColumn(void* pChunk) EASTL_NOEXCEPT
+	{
+		return (tuplevec_element_t<I, Ts...>*)((char*)pChunk + ChunkColumnOffset<ChunkSize, I, Ts...>::value);
+	}
+
+	// Destroys the columns of a new element constructed so far, unless mpChunk is cleared once the
+	// whole element is constructed. The braced lists in pushBack construct the columns in order, so
+	// if one throws, the columns before it are the ones to destroy.
+	struct ElementGuard
+	{
+		ElementGuard(void* pChunk, size_type i) : mpChunk(pChunk), mnIndex(i), mnConstructed(0) { }
+
+		~ElementGuard()
+		{
+			if (mpChunk)
+				swallow(((Indices < mnConstructed) ? (eastl::destruct(DoColumn<Indices>(mpChunk) + mnIndex), 0) : 0)...);
+		}
+
+		void* mpChunk;
+		size_type mnIndex;
+		size_type mnConstructed;
+	};
+
+	reference_tuple DoElement(size_type n) EASTL_NOEXCEPT
+	{
+		void* pChunk = mChunks[n / ChunkSize];
+		const size_type i = n % ChunkSize;
+		return reference_tuple(DoColumn<Indices>(pChunk)[i]...);
+	}
+
+	const_reference_tuple DoElement(size_type n) const EASTL_NOEXCEPT
+	{
+		void* pChunk = mChunks[n / ChunkSize];
+		const size_type i = n % ChunkSize;
+		return const_reference_tuple(DoColumn<Indices>(pChunk)[i]...);
+	}
+
+	void* DoAllocateChunk()
+	{
+		void* pChunk = allocate_memory(mChunks.getAllocator(), kChunkBytes, kChunkAlignment, 0);
+
+	#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(((uintptr_t)pChunk & (kChunkAlignment - 1)) != 0))
+			EASTL_FAIL_MSG("chunked_tuple_vector::DoAllocateChunk -- memory not aligned at requested alignment");
+	#endif
+
+		return pChunk;
+	}
+
+	void DoFreeChunk(void* pChunk)
+	{
+		EASTLFree(mChunks.getAllocator(), pChunk, kChunkBytes);
+	}
+
+	// Returns the chunk that the next element goes to, allocating it if the chunks are full.
+	void* DoGrowByOne()
+	{
+		const size_type c = mNumElements / ChunkSize;
+		if (c == mChunks.size())
+			mChunks.pushBack(DoAllocateChunk());
+		return mChunks[c];
+	}
+
+	// Calls f(pChunk, first, last) for the part [first, last) of each chunk that [begin, end) overlaps.
+	template <typename Function>
+	void DoForEachRange(size_type begin, size_type end, Function f)
+	{
+		while (begin < end)
+		{
+			const size_type c = begin / ChunkSize;
+			const size_type first = begin % ChunkSize;
+			const size_type last = eastl::min(end - c * ChunkSize, (size_type)ChunkSize);
+			f(mChunks[c], first, last);
+			begin = c * ChunkSize + last;
+		}
+	}
+
+	void DoDestruct(size_type begin, size_type end) EASTL_NOEXCEPT
+	{
+		DoForEachRange(begin, end, [](void* pChunk, size_type first, size_type last)
+		{
+			swallow((eastl::destruct(DoColumn<Indices>(pChunk) + first, DoColumn<Indices>(pChunk) + last), 0)...);
+		});
+	}
+
+	void DoCopyFrom(const this_type& x)
+	{
+		reserve(x.mNumElements);
+		for (size_type c = 0, nChunkCount = x.chunkCount(); c < nChunkCount; ++c)
+		{
+			void* pChunk = mChunks[c];
+			void* pSourceChunk = x.mChunks[c];
+			const size_type n = x.chunkSize(c);
+			swallow((eastl::uninitializedCopy(DoColumn<Indices>(pSourceChunk), DoColumn<Indices>(pSourceChunk) + n, DoColumn<Indices>(pChunk)), 0)...);
+			mNumElements += n;
+		}
+	}
+
+	// One chunk pointer per allocated chunk. The first chunkCount() are in use, the rest are
+	// kept for reuse. The vector's allocator is the container's allocator.
+	eastl::vector<void*, Allocator> mChunks;
+	size_type mNumElements;
+};
+
+
+// A random access iterator over the elements of a chunked_tuple_vector. It dereferences to a tuple
+// of references, like tuple_vector's iterator. Every access divides by the chunk size, so loops
+// which care for speed should use forEachChunk instead.
+template <typename Container, typename Reference>
+struct ChunkedTupleVecIter
+{
+	typedef ChunkedTupleVecIter<Container, Reference> this_type;
+	typedef eastl_size_t size_type;
+
+	typedef eastl::random_access_iterator_tag iterator_category;
+	typedef typename Container::value_tuple value_type;
+	typedef ptrdiff_t difference_type;
+	typedef Reference reference;
+	typedef void pointer;
+
+	ChunkedTupleVecIter() = default;
+	ChunkedTupleVecIter(Container* pContainer, size_type index)
+		: mpContainer(pContainer), mnIndex(index) {}
+
+	// iterator -> const_iterator
+	template <typename OtherContainer, typename OtherReference, typename = enable_if_t<is_same<const OtherContainer, Container>::value>>
+	ChunkedTupleVecIter(const ChunkedTupleVecIter<OtherContainer, OtherReference>& x)
+		: mpContainer(x.mpContainer), mnIndex(x.mnIndex) {}
+
+	reference operator*() const { return mpContainer->DoElement(mnIndex); }
+	reference operator[](difference_type n) const { return mpContainer->DoElement(mnIndex + n); }
+
+	this_type& operator++() { ++mnIndex; return *this; }
+	this_type operator++(int) { this_type temp = *this; ++mnIndex; return temp; }
+	this_type& operator--() { --mnIndex; return *this; }
+	this_type operator--(int) { this_type temp = *this; --mnIndex; return temp; }
+	this_type& operator+=(difference_type n) { mnIndex += n; return *this; }
+	this_type& operator-=(difference_type n) { mnIndex -= n; return *this; }
+	this_type operator+(difference_type n) const { return this_type(mpContainer, mnIndex + n); }
+	this_type operator-(difference_type n) const { return this_type(mpContainer, mnIndex - n); }
+	friend this_type operator+(difference_type n, const this_type& x) { return x + n; }
+
+	difference_type operator-(const this_type& x) const { return (difference_type)mnIndex - (difference_type)x.mnIndex; }
+
+	bool operator==(const this_type& x) const { return mnIndex == x.mnIndex; }
+	bool operator!=(const this_type& x) const { return mnIndex != x.mnIndex; }
+	bool operator<(const this_type& x) const { return mnIndex < x.mnIndex; }
+	bool operator>(const this_type& x) const { return mnIndex > x.mnIndex; }
+	bool operator<=(const this_type& x) const { return mnIndex <= x.mnIndex; }
+	bool operator>=(const this_type& x) const { return mnIndex >= x.mnIndex; }
+
+	Container* mpContainer = nullptr;
+	size_type mnIndex = 0;
+};
+
+}  // namespace TupleVecInternal
+
+
+// External interface of chunked_tuple_vector
+template <eastl_size_t ChunkSize, typename... Ts>
+class chunked_tuple_vector : public TupleVecInternal::ChunkedTupleVecImpl<EASTLAllocatorType, ChunkSize, make_index_sequence<sizeof...(Ts)>, Ts...>
+{
+	typedef TupleVecInternal::ChunkedTupleVecImpl<EASTLAllocatorType, ChunkSize, make_index_sequence<sizeof...(Ts)>, Ts...> base_type;
+	using base_type::base_type;
+};
+
+// Variant of chunked_tuple_vector that allows a user-defined allocator type. Both the chunks and
+// the table of chunk pointers are allocated from it.
+template <typename AllocatorType, eastl_size_t ChunkSize, typename... Ts>
+class chunked_tuple_vector_alloc
+	: public TupleVecInternal::ChunkedTupleVecImpl<AllocatorType, ChunkSize, make_index_sequence<sizeof...(Ts)>, Ts...>
+{
+	typedef TupleVecInternal::ChunkedTupleVecImpl<AllocatorType, ChunkSize, make_index_sequence<sizeof...(Ts)>, Ts...> base_type;
+	using base_type::base_type;
+};
+
+}  // namespace eastl
+
+EA_RESTORE_VC_WARNING()
+EA_RESTORE_VC_WARNING()
+
+#endif  // EASTL_CHUNKEDTUPLEVECTOR_H
@@ -0,0 +1,1007 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// concurrent_cache is a thread safe variant of lru_cache, meant to front
+// expensive operations, such as calls to a backend, which many threads make
+// at once.
+//
+// The cache is split into a power of two number of shards, selected by the
+// hash of the key. Each shard has its own lock, hash index, eviction policy
+// list and expiry wheel, so threads which use different shards never
+// contend. Each shard lives on its own cache lines.
+//
+// Instead of a number of entries, the cache has a budget: the sum of the
+// weights of its entries, as computed by the weigh callback (for example the
+// size in bytes of a value), may not exceed it. Without a weigh callback each
+// entry weighs 1 and the budget is an entry count. Each shard gets an equal
+// share of the budget, and evicts from its own entries to stay within it.
+//
+// Entries can have a time to live. An expired entry is never returned: it is
+// removed when it is accessed, or by sweep(), which removes all expired
+// entries in time proportional to their number, as the entries with a time
+// to live are kept in a timing_wheel.
+//
+// get() makes concurrent misses on the same key call the creator only once:
+// the first thread to miss loads the value, without holding any lock, and
+// the others wait for it and return its result (single-flight loading). If
+// the creator throws, the exception goes to the loading thread only; a
+// waiting thread then tries to load the value itself.
+//
+// Values are returned by value, as an entry may be evicted by another thread
+// as soon as the shard is unlocked. Large or shared values should be held
+// through a smart pointer such as shared_ptr.
+//
+// The create callback is called without any lock held. The delete and weigh
+// callbacks are called with the entry's shard locked, and must not access
+// the cache. The callbacks and the default time to live must be set before
+// the cache is shared between threads. The allocator must be thread safe.
+//
+// Example usage:
+//     eastl::concurrent_cache<eastl::string, eastl::shared_ptr<Texture>> textures(
+//         64 * 1024 * 1024, 16, EASTLAllocatorType("textures"),
+//         [](eastl::string name) { return LoadTexture(name); },           // creator
+//         nullptr,                                                        // deletor
+//         [](const eastl::shared_ptr<Texture>& p) { return p->bytes(); }); // weigh
+//     textures.setDefaultTimeToLive(eastl::chrono::minutes(10));
+//
+//     eastl::shared_ptr<Texture> pTexture = textures.get("rock.dds");
+//     ...
+//     textures.sweep(); // Periodically, e.g. from a maintenance thread.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_CONCURRENT_CACHE_H
+#define EASTL_CONCURRENT_CACHE_H
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+#pragma once
+#endif
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/thread_support.h>
+#include <eastl/allocator.h>
+#include <eastl/chrono.h>
+#include <eastl/optional.h>
+#include <eastl/utility.h> // for pair
+#include <eastl/functional.h> // for function, hash, equal_to
+#include <eastl/timing_wheel.h>
+#include <eastl/bonus/eviction_policy.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace eastl
+{
+	/// EASTL_CONCURRENT_CACHE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CONCURRENT_CACHE_DEFAULT_NAME
+	#define EASTL_CONCURRENT_CACHE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " concurrent_cache" // Unless the user overrides something, this is "EASTL concurrent_cache".
+	#endif
+
+
+	/// EASTL_CONCURRENT_CACHE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CONCURRENT_CACHE_DEFAULT_ALLOCATOR
+	#define EASTL_CONCURRENT_CACHE_DEFAULT_ALLOCATOR allocator_type(EASTL_CONCURRENT_CACHE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_CONCURRENT_CACHE_MAX_POLICY_CAPACITY
+	///
+	/// Defines the largest entry count which a shard gives its eviction policy. The policies
+	/// size their own state (ghost table, frequency sketch) from it.
+	///
+	#ifndef EASTL_CONCURRENT_CACHE_MAX_POLICY_CAPACITY
+	#define EASTL_CONCURRENT_CACHE_MAX_POLICY_CAPACITY (1 << 20)
+	#endif
+
+
+	/// concurrent_cache_node
+	///
+	/// A cache entry: the eviction policy's list links, the expiry timer, the hash chain link,
+	/// the entry's weight and the key/value pair.
+	///
+	/// Both bases have mpNext and mpPrev links. The node's own are those of the timer, which
+	/// intrusive_list uses; the cache and the policies use the others through lru_cache_node_base.
+	///
+	template <typename T>
+	struct concurrent_cache_node : public lru_cache_node_base, public timing_wheel_node
+	{
+		using timing_wheel_node::mpNext;
+		using timing_wheel_node::mpPrev;
+
+		template <typename... Args>
+		concurrent_cache_node(size_t hashCode, Args&&... args)
+			: mpHashNext(nullptr), mnWeight(0), mValue(eastl::forward<Args>(args)...)
+		{
+			mnHashCode = hashCode;
+			mnQueue = 0;
+			mnCounter = 0;
+		}
+
+		concurrent_cache_node* mpHashNext;
+		eastl_size_t           mnWeight;
+		T                      mValue;     // This is a pair of key/value.
+	};
+
+
+	/// concurrent_cache
+	///
+	/// Key, Value, Allocator, Hash and Predicate are as for lru_cache. EvictionPolicy is one of the policies
+	/// of eviction_policy.h; policies which size their queues by a number of entries are given the budget of
+	/// a shard, which is exact when there is no weigh callback. Clock provides the current time for the
+	/// expiry of entries, which is measured in TickDuration units.
+	///
+	/// Algorithmic Performance:
+	///		insert(), get(), touch(), erase() -> O(1) on average, plus the evictions they cause
+	///		sweep() -> O(number of expired entries), plus O(1) per shard
+	///		size(), weight() -> O(number of shards)
+	///
+	/// Nodes of erased entries are kept by their shard and reused, so a cache which stays at its budget
+	/// doesn't allocate, except for a small record of each load by get(), which lets other threads wait for it.
+	template <typename Key,
+	          typename Value,
+	          typename Allocator = EASTLAllocatorType,
+	          typename Hash = eastl::hash<Key>,
+	          typename Predicate = eastl::equal_to<Key>,
+	          typename EvictionPolicy = eastl::lru_eviction_policy,
+	          typename Clock = eastl::chrono::steady_clock,
+	          typename TickDuration = eastl::chrono::milliseconds>
+	class concurrent_cache
+	{
+	public:
+		using key_type = Key;
+		using value_type = Value;
+		using mapped_type = Value;
+		using entry_type = eastl::pair<const Key, Value>;
+		using allocator_type = Allocator;
+		using hasher = Hash;
+		using key_equal = Predicate;
+		using eviction_policy_type = EvictionPolicy;
+		using clock_type = Clock;
+		using time_point = typename Clock::time_point;
+		using tick_duration = TickDuration;
+		using size_type = eastl_size_t;
+		using node_type = concurrent_cache_node<entry_type>;
+		using this_type = concurrent_cache<Key, Value, Allocator, Hash, Predicate, EvictionPolicy, Clock, TickDuration>;
+		using create_callback_type = eastl::function<value_type(key_type)>;
+		using delete_callback_type = eastl::function<void(const value_type &)>;
+		using weigh_callback_type = eastl::function<size_type(const value_type &)>;
+
+	protected:
+		// Six bits of slots on four levels span 2^24 ticks, which is 4.6 hours of milliseconds; later expiries
+		// wait in the wheel's overflow list. This keeps the wheel of a shard at 4 KB on 64-bit platforms.
+		using wheel_type = eastl::timing_wheel<node_type, TickDuration, 6, 4>;
+		using tick_type = typename wheel_type::tick_type;
+		using mutex_type = Internal::mutex;
+		using lock_type = Internal::auto_mutex;
+
+		// A value which a thread is loading, and which other threads wait for by locking mMutex.
+		// The loading thread holds mMutex while it calls the creator.
+		struct load_type
+		{
+			load_type*                  mpNext;
+			const key_type*             mpKey;       // Points to the key given to the loading thread.
+			size_t                      mnHashCode;
+			size_type                   mnRefCount;  // The loading thread and the waiting ones.
+			eastl::optional<value_type> mResult;     // Set if the load succeeded and someone waits for it.
+			mutex_type                  mMutex;
+		};
+
+		struct alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) shard_type
+		{
+			shard_type(tick_type nowTick, size_type budget, size_type policyCapacity)
+				: m_buckets(nullptr), m_bucket_count(0), m_bucket_shift(0), m_free_nodes(nullptr)
+				, m_size(0), m_weight(0), m_budget(budget), m_loads(nullptr), m_wheel(nowTick)
+			{
+				m_anchor.mpNext = &m_anchor;
+				m_anchor.mpPrev = &m_anchor;
+				m_anchor.mnHashCode = 0;
+				m_anchor.mnQueue = 0;
+				m_anchor.mnCounter = 0;
+				m_policy.attach(&m_anchor, policyCapacity);
+			}
+
+			mutex_type				m_mutex;
+			lru_cache_node_base		m_anchor;
+			eviction_policy_type	m_policy;
+			node_type**				m_buckets;
+			size_type				m_bucket_count;
+			size_type				m_bucket_shift;
+			lru_cache_node_base*	m_free_nodes;   // Nodes of erased entries, chained through mpNext.
+			size_type				m_size;
+			size_type				m_weight;
+			size_type				m_budget;
+			load_type*				m_loads;        // The loads in progress.
+			wheel_type				m_wheel;        // The entries which have a time to live.
+		};
+
+	public:
+		/// concurrent_cache constructor
+		///
+		/// Creates a cache which holds entries of a total weight of up to budget, in shardCount shards
+		/// (rounded up to a power of two, but no more than the budget). A good shard count is a few times the number of threads which use the cache.
+		explicit concurrent_cache(size_type budget,
+		                          size_type shardCount = 16,
+		                          const allocator_type& allocator = EASTL_CONCURRENT_CACHE_DEFAULT_ALLOCATOR,
+		                          create_callback_type creator = nullptr,
+		                          delete_callback_type deletor = nullptr,
+		                          weigh_callback_type weigh = nullptr)
+		    : m_shards(nullptr)
+		    , m_shard_count(1)
+		    , m_budget(budget)
+		    , m_default_ttl(0)
+		    , m_allocator(allocator)
+		    , m_create_callback(creator)
+		    , m_delete_callback(deletor)
+		    , m_weigh_callback(weigh)
+		{
+			// No more shards than the budget, so that every shard can hold an entry.
+			while ((m_shard_count < shardCount) && ((m_shard_count * 2) <= budget))
+				m_shard_count *= 2;
+
+			const tick_type nowTick = now_tick(clock_type::now());
+
+			m_shards = static_cast<shard_type*>(allocate_memory(m_allocator, m_shard_count * sizeof(shard_type), alignof(shard_type), 0));
+			for (size_type i = 0; i < m_shard_count; ++i)
+				::new(static_cast<void*>(m_shards + i)) shard_type(nowTick, shard_budget(budget, i), policy_capacity(shard_budget(budget, i), 0));
+		}
+
+		/// concurrent_cache destructor
+		///
+		/// Calls the deletor for every entry. No other thread may use the cache any more.
+		~concurrent_cache()
+		{
+			clear();
+
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				EASTLFree(m_allocator, m_shards[i].m_buckets, m_shards[i].m_bucket_count * sizeof(node_type*));
+				m_shards[i].~shard_type();
+			}
+
+			EASTLFree(m_allocator, m_shards, m_shard_count * sizeof(shard_type));
+		}
+
+		concurrent_cache(const this_type&) = delete;
+		this_type &operator=(const this_type&) = delete;
+
+		/// insert
+		///
+		/// insert key k with value v, which expires after the default time to live.
+		/// If key already exists, no change is made and the return value is false.
+		/// If the key doesn't exist, the data is added to the cache and the return value is true.
+		/// The entry may be evicted right away if it weighs more than the budget of a shard.
+		bool insert(const key_type& k, const value_type& v)
+		{
+			return insert_ticks(k, v, m_default_ttl);
+		}
+
+		/// insert
+		///
+		/// As above, with the entry expiring after ttl instead.
+		template <typename Rep, typename Period>
+		bool insert(const key_type& k, const value_type& v, const chrono::duration<Rep, Period>& ttl)
+		{
+			return insert_ticks(k, v, ttl_ticks(ttl));
+		}
+
+		/// insert_or_assign
+		///
+		/// Same as insert, but replaces the data at key k, if it exists, with the new entry v
+		/// Note that the deletor for the old v will be called before it's replaced with the new value of v.
+		/// The entry's time to live starts anew.
+		void insert_or_assign(const key_type& k, const value_type& v)
+		{
+			insert_or_assign_ticks(k, v, m_default_ttl);
+		}
+
+		template <typename Rep, typename Period>
+		void insert_or_assign(const key_type& k, const value_type& v, const chrono::duration<Rep, Period>& ttl)
+		{
+			insert_or_assign_ticks(k, v, ttl_ticks(ttl));
+		}
+
+		/// contains
+		///
+		/// Returns true if key k exists in the cache and hasn't expired.
+		bool contains(const key_type& k)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			return find_live_node(shard, k, h) != nullptr;
+		}
+
+		/// at
+		///
+		/// Retrives a copy of the data for key k, or nullopt if k does not exist.
+		/// Like lru_cache::at, this doesn't count as an access for the eviction policy.
+		eastl::optional<value_type> at(const key_type& k)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			if (node_type* pNode = find_live_node(shard, k, h))
+				return pNode->mValue.second;
+			return eastl::nullopt;
+		}
+
+		/// tryGet
+		///
+		/// Retrives a copy of the data for key k, or nullopt if k does not exist. Unlike get(),
+		/// this never creates the data, but it does count as an access.
+		eastl::optional<value_type> tryGet(const key_type& k)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			if (node_type* pNode = find_live_node(shard, k, h))
+			{
+				shard.m_policy.onHit(pNode);
+				return pNode->mValue.second;
+			}
+			return eastl::nullopt;
+		}
+
+		/// get
+		///
+		/// Retrives a copy of the data for key k.  If no data exists, it will be created by calling the
+		/// creator, once for all threads which miss on k at the same time, and inserted with the
+		/// default time to live.
+		value_type get(const key_type& k)
+		{
+			return get_or_load(k, m_create_callback);
+		}
+
+		/// get
+		///
+		/// As above, with creator (callable as value_type(const key_type&)) used instead of the create callback.
+		template <typename Creator>
+		value_type get(const key_type& k, Creator&& creator)
+		{
+			return get_or_load(k, creator);
+		}
+
+		/// erase
+		///
+		/// erases key k from the cache.
+		/// If k does not exist, returns false.  If k exists, returns true.
+		bool erase(const key_type& k)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			if (node_type* pNode = find_live_node(shard, k, h))
+			{
+				erase_node(shard, pNode);
+				return true;
+			}
+
+			return false;
+		}
+
+		/// erase_oldest
+		///
+		/// Removes the entry which the eviction policy of k's shard would evict next.
+		/// Returns false if that shard is empty.
+		bool erase_oldest(const key_type& k)
+		{
+			shard_type& shard = shard_for(m_hash(k));
+			lock_type lock(shard.m_mutex);
+
+			if (!shard.m_size)
+				return false;
+
+			erase_node(shard, static_cast<node_type*>(shard.m_policy.victim()));
+			return true;
+		}
+
+		/// touch
+		///
+		/// Touches key k, marking it as accessed for the eviction policy.
+		/// If k does not exist, returns false.  If the touch was successful, returns true.
+		bool touch(const key_type& k)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			if (node_type* pNode = find_live_node(shard, k, h))
+			{
+				shard.m_policy.onHit(pNode);
+				return true;
+			}
+
+			return false;
+		}
+
+		/// sweep
+		///
+		/// Removes all entries which expired at or before now and returns how many there were.
+		/// Locks one shard at a time.
+		size_type sweep(time_point now)
+		{
+			const tick_type nowTick = now_tick(now);
+			size_type n = 0;
+
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				shard_type& shard = m_shards[i];
+				lock_type lock(shard.m_mutex);
+				typename wheel_type::list_type expired;
+
+				shard.m_wheel.advance(nowTick, expired);
+
+				while (!expired.empty())
+				{
+					node_type& node = expired.front();
+
+					expired.popFront();
+					erase_node(shard, &node);
+					++n;
+				}
+			}
+
+			return n;
+		}
+
+		size_type sweep() { return sweep(clock_type::now()); }
+
+		/// clear
+		///
+		/// Erases all entries, calling the deletor for each, and frees the memory of the nodes.
+		void clear()
+		{
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				shard_type& shard = m_shards[i];
+				lock_type lock(shard.m_mutex);
+
+				for (lru_cache_node_base* p = shard.m_anchor.mpPrev; shard.m_size; )
+				{
+					lru_cache_node_base* const pPrev = p->mpPrev;
+
+					if (p->mnQueue != lru_cache_node_base::kQueueBoundary)
+						erase_node(shard, static_cast<node_type*>(p));
+					p = pPrev;
+				}
+
+				while (shard.m_free_nodes)
+				{
+					lru_cache_node_base* const pFree = shard.m_free_nodes;
+
+					shard.m_free_nodes = pFree->mpNext;
+					EASTLFree(m_allocator, pFree, sizeof(node_type));
+				}
+			}
+		}
+
+		/// setBudget
+		///
+		/// Changes the budget, evicting entries from shards which are over their new share.
+		void setBudget(size_type budget)
+		{
+			m_budget = budget;
+
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				shard_type& shard = m_shards[i];
+				lock_type lock(shard.m_mutex);
+
+				shard.m_budget = shard_budget(budget, i);
+				evict_over_budget(shard);
+				shard.m_policy.setCapacity(policy_capacity(shard));
+			}
+		}
+
+		/// Sets the time to live of entries inserted without one. Zero, the default, means that they don't expire.
+		template <typename Rep, typename Period>
+		void setDefaultTimeToLive(const chrono::duration<Rep, Period>& ttl) { m_default_ttl = ttl_ticks(ttl); }
+
+		void setCreateCallback(create_callback_type callback) { m_create_callback = callback; }
+		void setDeleteCallback(delete_callback_type callback) { m_delete_callback = callback; }
+		void setWeighCallback(weigh_callback_type callback)
+		{
+			m_weigh_callback = callback;
+
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				lock_type lock(m_shards[i].m_mutex);
+				m_shards[i].m_policy.setCapacity(policy_capacity(m_shards[i]));
+			}
+		}
+
+		// These lock each shard in turn, so they are only a snapshot when other threads use the cache.
+		size_type size() const    { return sum_over_shards(&shard_type::m_size); }
+		size_type weight() const  { return sum_over_shards(&shard_type::m_weight); }
+		bool empty() const        { return size() == 0; }
+
+		size_type budget() const      EASTL_NOEXCEPT { return m_budget; }
+		size_type shardCount() const  EASTL_NOEXCEPT { return m_shard_count; }
+
+		// EASTL extensions
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return m_allocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return m_allocator; }
+
+		bool validate() const
+		{
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				shard_type& shard = m_shards[i];
+				lock_type lock(shard.m_mutex);
+				size_type n = 0, nWeight = 0, nScheduled = 0;
+
+				for (const lru_cache_node_base* p = shard.m_anchor.mpNext; p != &shard.m_anchor; p = p->mpNext)
+				{
+					if (p->mpNext->mpPrev != p)
+						return false;
+					if (p->mnQueue == lru_cache_node_base::kQueueBoundary)
+						continue;
+
+					const node_type* const pNode = static_cast<const node_type*>(p);
+
+					if ((n++ >= shard.m_size) || (&shard_for(pNode->mnHashCode) != &shard) ||
+					    (pNode->mnHashCode != m_hash(pNode->mValue.first)) || (find_node(shard, pNode->mValue.first, pNode->mnHashCode) != pNode))
+						return false;
+
+					nWeight += pNode->mnWeight;
+					nScheduled += pNode->isScheduled() ? 1 : 0;
+				}
+
+				if ((n != shard.m_size) || (nWeight != shard.m_weight) || (nScheduled != shard.m_wheel.size()))
+					return false;
+				if (((shard.m_weight > shard.m_budget) && (shard.m_size > 1)) || (shard.m_size > shard.m_bucket_count))
+					return false;
+				if (!shard.m_policy.validate() || !shard.m_wheel.validate())
+					return false;
+			}
+
+			return true;
+		}
+
+	protected:
+		static tick_type now_tick(time_point now)
+		{
+			return static_cast<tick_type>(chrono::duration_cast<TickDuration>(now.time_since_epoch()).count());
+		}
+
+		template <typename Rep, typename Period>
+		static tick_type ttl_ticks(const chrono::duration<Rep, Period>& ttl)
+		{
+			return (ttl.count() > 0) ? wheel_type::toTicks(ttl) : 0;
+		}
+
+		// The budget of shard i. The first budget % m_shard_count shards get one unit more than the others,
+		// so that the shard budgets add up to the budget exactly, even when it is below the shard count.
+		size_type shard_budget(size_type budget, size_type i) const
+		{
+			return (budget / m_shard_count) + ((i < (budget % m_shard_count)) ? 1 : 0);
+		}
+
+		// The eviction policies take a capacity in entries, not in weight. Without a weigh callback
+		// the budget is an entry count. Otherwise the bucket count, which grows with the number of
+		// entries, stands in for it.
+		size_type policy_capacity(size_type shardBudget, size_type bucketCount) const
+		{
+			const size_type n = m_weigh_callback ? bucketCount : shardBudget;
+
+			if (n < 8)
+				return 8;
+			return (n < (size_type)EASTL_CONCURRENT_CACHE_MAX_POLICY_CAPACITY) ? n : (size_type)EASTL_CONCURRENT_CACHE_MAX_POLICY_CAPACITY;
+		}
+
+		size_type policy_capacity(const shard_type& shard) const
+		{
+			return policy_capacity(shard.m_budget, shard.m_bucket_count);
+		}
+
+		shard_type& shard_for(size_t h) const
+		{
+			// Not the bits which select the bucket within the shard.
+			return m_shards[static_cast<size_type>(Internal::MixCacheHash(h, UINT64_C(0x8cb92ba72f3d8dd7))) & (m_shard_count - 1)];
+		}
+
+		static size_type bucket_index(const shard_type& shard, size_t h)
+		{
+			// Fibonacci hashing: scramble the hash code and take its top bits.
+			return static_cast<size_type>((static_cast<uint64_t>(h) * UINT64_C(0x9E3779B97F4A7C15)) >> shard.m_bucket_shift);
+		}
+
+		size_type sum_over_shards(size_type shard_type::* pMember) const
+		{
+			size_type n = 0;
+
+			for (size_type i = 0; i < m_shard_count; ++i)
+			{
+				lock_type lock(m_shards[i].m_mutex);
+				n += m_shards[i].*pMember;
+			}
+
+			return n;
+		}
+
+		node_type* find_node(const shard_type& shard, const key_type& k, size_t h) const
+		{
+			if (shard.m_buckets)
+			{
+				for (node_type* pNode = shard.m_buckets[bucket_index(shard, h)]; pNode; pNode = pNode->mpHashNext)
+				{
+					if ((pNode->mnHashCode == h) && m_predicate(k, pNode->mValue.first))
+						return pNode;
+				}
+			}
+
+			return nullptr;
+		}
+
+		// As find_node, but an expired entry is erased and not found.
+		node_type* find_live_node(shard_type& shard, const key_type& k, size_t h)
+		{
+			node_type* const pNode = find_node(shard, k, h);
+
+			if (pNode && pNode->isScheduled() && (pNode->expiry() <= now_tick(clock_type::now())))
+			{
+				erase_node(shard, pNode);
+				return nullptr;
+			}
+
+			return pNode;
+		}
+
+		void link_bucket(shard_type& shard, node_type* pNode)
+		{
+			node_type** const ppBucket = shard.m_buckets + bucket_index(shard, pNode->mnHashCode);
+
+			pNode->mpHashNext = *ppBucket;
+			*ppBucket = pNode;
+		}
+
+		void unlink_bucket(shard_type& shard, node_type* pNode)
+		{
+			node_type** ppNode = shard.m_buckets + bucket_index(shard, pNode->mnHashCode);
+
+			while (*ppNode != pNode)
+				ppNode = &(*ppNode)->mpHashNext;
+			*ppNode = pNode->mpHashNext;
+		}
+
+		// Doubles the buckets of the shard, keeping at least one bucket per entry.
+		void grow_buckets(shard_type& shard)
+		{
+			node_type** const pOldBuckets = shard.m_buckets;
+			const size_type nOldBucketCount = shard.m_bucket_count;
+			const size_type nBucketCount = nOldBucketCount ? (nOldBucketCount * 2) : 8;
+
+			shard.m_buckets = static_cast<node_type**>(allocate_memory(m_allocator, nBucketCount * sizeof(node_type*), EASTL_ALIGN_OF(node_type*), 0));
+			shard.m_bucket_count = nBucketCount;
+			shard.m_bucket_shift = nOldBucketCount ? (shard.m_bucket_shift - 1) : 61;
+
+			for (size_type i = 0; i < nBucketCount; ++i)
+				shard.m_buckets[i] = nullptr;
+
+			for (size_type i = 0; i < nOldBucketCount; ++i)
+			{
+				for (node_type* pNode = pOldBuckets[i]; pNode; )
+				{
+					node_type* const pNext = pNode->mpHashNext;
+
+					link_bucket(shard, pNode);
+					pNode = pNext;
+				}
+			}
+
+			if (pOldBuckets)
+				EASTLFree(m_allocator, pOldBuckets, nOldBucketCount * sizeof(node_type*));
+
+			if (m_weigh_callback)
+				shard.m_policy.setCapacity(policy_capacity(shard));
+		}
+
+		// Frees the memory of a node which insert_node couldn't complete, destroying the node if it was constructed.
+		struct node_guard
+		{
+			node_guard(this_type& cache, void* pMemory)
+				: mCache(cache), mpMemory(pMemory), mpNode(nullptr) { }
+
+			~node_guard()
+			{
+				if (mpMemory)
+				{
+					if (mpNode)
+						mpNode->~node_type();
+					EASTLFree(mCache.m_allocator, mpMemory, sizeof(node_type));
+				}
+			}
+
+			this_type& mCache;
+			void*      mpMemory;
+			node_type* mpNode;
+		};
+
+		// Constructs a new entry from args, in a node reused from the shard or newly allocated, and evicts
+		// entries while the shard is over its budget. ttl is in ticks, 0 for none.
+		template <typename... Args>
+		void insert_node(shard_type& shard, tick_type ttl, size_t h, Args&&... args)
+		{
+			if (shard.m_size >= shard.m_bucket_count)
+				grow_buckets(shard);
+
+			void* pMemory = shard.m_free_nodes;
+
+			if (pMemory)
+				shard.m_free_nodes = shard.m_free_nodes->mpNext;
+			else
+				pMemory = allocate_memory(m_allocator, sizeof(node_type), EASTL_ALIGN_OF(node_type), 0);
+
+			// The node is freed if its construction or the weigh callback throws.
+			node_guard guard(*this, pMemory);
+
+			node_type* const pNode = ::new(pMemory) node_type(h, eastl::forward<Args>(args)...);
+			guard.mpNode = pNode;
+			pNode->mnWeight = m_weigh_callback ? m_weigh_callback(pNode->mValue.second) : 1;
+			guard.mpMemory = nullptr;
+
+			link_bucket(shard, pNode);
+			shard.m_policy.onInsert(pNode);
+			++shard.m_size;
+			shard.m_weight += pNode->mnWeight;
+
+			if (ttl)
+				shard.m_wheel.schedule(*pNode, now_tick(clock_type::now()) + ttl);
+
+			evict_over_budget(shard);
+		}
+
+		void erase_node(shard_type& shard, node_type* pNode)
+		{
+			if (m_delete_callback)
+				m_delete_callback(pNode->mValue.second);
+
+			unlink_bucket(shard, pNode);
+			shard.m_policy.onErase(pNode);
+			shard.m_wheel.cancel(*pNode);
+			--shard.m_size;
+			shard.m_weight -= pNode->mnWeight;
+
+			pNode->~node_type();
+
+			lru_cache_node_base* const pFree = ::new(static_cast<void*>(pNode)) lru_cache_node_base;
+			pFree->mpNext = shard.m_free_nodes;
+			shard.m_free_nodes = pFree;
+		}
+
+		void evict_over_budget(shard_type& shard)
+		{
+			while ((shard.m_weight > shard.m_budget) && shard.m_size)
+				erase_node(shard, static_cast<node_type*>(shard.m_policy.victim()));
+		}
+
+		bool insert_ticks(const key_type& k, const value_type& v, tick_type ttl)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			if (find_live_node(shard, k, h))
+				return false;
+
+			insert_node(shard, ttl, h, k, v);
+			return true;
+		}
+
+		void insert_or_assign_ticks(const key_type& k, const value_type& v, tick_type ttl)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			lock_type lock(shard.m_mutex);
+
+			if (node_type* pNode = find_live_node(shard, k, h))
+			{
+				if (m_delete_callback)
+					m_delete_callback(pNode->mValue.second);
+				shard.m_policy.onHit(pNode);
+				pNode->mValue.second = v;
+
+				const size_type nWeight = m_weigh_callback ? m_weigh_callback(pNode->mValue.second) : 1;
+				shard.m_weight = shard.m_weight - pNode->mnWeight + nWeight;
+				pNode->mnWeight = nWeight;
+
+				if (ttl)
+					shard.m_wheel.schedule(*pNode, now_tick(clock_type::now()) + ttl);
+				else
+					shard.m_wheel.cancel(*pNode);
+
+				evict_over_budget(shard);
+			}
+			else
+				insert_node(shard, ttl, h, k, v);
+		}
+
+		load_type* find_load(shard_type& shard, const key_type& k, size_t h) const
+		{
+			for (load_type* pLoad = shard.m_loads; pLoad; pLoad = pLoad->mpNext)
+			{
+				if ((pLoad->mnHashCode == h) && m_predicate(k, *pLoad->mpKey))
+					return pLoad;
+			}
+
+			return nullptr;
+		}
+
+		// Unlinks the load from the shard, so that later misses start a new one.
+		static void unlink_load(shard_type& shard, load_type* pLoad)
+		{
+			load_type** ppLoad = &shard.m_loads;
+
+			while (*ppLoad != pLoad)
+				ppLoad = &(*ppLoad)->mpNext;
+			*ppLoad = pLoad->mpNext;
+		}
+
+		// Ends a load of the calling thread: unlinks it if that isn't done yet, then lets the waiting threads
+		// continue. They take the result if there is one, and otherwise load the value themselves.
+		struct load_guard
+		{
+			load_guard(this_type& cache, shard_type& shard, load_type* pLoad)
+				: mCache(cache), mShard(shard), mpLoad(pLoad), mbLinked(true) { }
+
+			~load_guard()
+			{
+				lock_type lock(mShard.m_mutex);
+
+				if (mbLinked)
+					unlink_load(mShard, mpLoad);
+				mpLoad->mMutex.unlock();
+				mCache.release_load(mpLoad);
+			}
+
+			this_type&  mCache;
+			shard_type& mShard;
+			load_type*  mpLoad;
+			bool        mbLinked;
+		};
+
+		// Drops a reference to the load. The shard must be locked.
+		void release_load(load_type* pLoad)
+		{
+			if (--pLoad->mnRefCount == 0)
+			{
+				pLoad->~load_type();
+				EASTLFree(m_allocator, pLoad, sizeof(load_type));
+			}
+		}
+
+		// Frees a load which was made but not needed.
+		void discard_load(load_type* pLoad)
+		{
+			if (pLoad)
+			{
+				pLoad->mMutex.unlock();
+				pLoad->~load_type();
+				EASTLFree(m_allocator, pLoad, sizeof(load_type));
+			}
+		}
+
+		// Either returns the cached value, waits for another thread which loads it, or loads it with creator.
+		template <typename Creator>
+		value_type get_or_load(const key_type& k, Creator& creator)
+		{
+			const size_t h = m_hash(k);
+			shard_type& shard = shard_for(h);
+			load_type* pLoad;
+			load_type* pNewLoad = nullptr; // Made and locked without the shard lock, so that lock order stays shard -> none.
+
+			for (;;)
+			{
+				{
+					lock_type lock(shard.m_mutex);
+
+					if (node_type* pNode = find_live_node(shard, k, h))
+					{
+						shard.m_policy.onHit(pNode);
+						discard_load(pNewLoad);
+						return pNode->mValue.second;
+					}
+
+					pLoad = find_load(shard, k, h);
+
+					if (!pLoad && pNewLoad)
+					{
+						// This thread loads the value; register the load so that others wait for it.
+						pLoad = pNewLoad;
+						pLoad->mpNext = shard.m_loads;
+						pLoad->mpKey = &k;
+						pLoad->mnHashCode = h;
+						shard.m_loads = pLoad;
+						break;
+					}
+
+					if (pLoad)
+						++pLoad->mnRefCount;
+				}
+
+				if (!pLoad)
+				{
+					pNewLoad = ::new(allocate_memory(m_allocator, sizeof(load_type), EASTL_ALIGN_OF(load_type), 0)) load_type;
+					pNewLoad->mnRefCount = 1;
+					pNewLoad->mMutex.lock();
+					continue;
+				}
+
+				// Another thread loads the value. It holds the load's mutex until it is done.
+				pLoad->mMutex.lock();
+				pLoad->mMutex.unlock();
+
+				{
+					lock_type lock(shard.m_mutex);
+
+					if (pLoad->mResult)
+					{
+						value_type result(*pLoad->mResult);
+						release_load(pLoad);
+						discard_load(pNewLoad);
+						return result;
+					}
+
+					release_load(pLoad);
+				}
+
+				// The load failed; try again, if need be by loading it in this thread.
+			}
+
+			// The creator is called without any lock held. Whether it returns or throws, the guard
+			// then wakes the waiting threads.
+			load_guard guard(*this, shard, pLoad);
+			value_type value(create_value(creator, k));
+
+			{
+				lock_type lock(shard.m_mutex);
+
+				unlink_load(shard, pLoad);
+				guard.mbLinked = false;
+
+				if (pLoad->mnRefCount > 1)
+					pLoad->mResult = value;
+
+				if (!find_live_node(shard, k, h)) // It may have been inserted by insert() meanwhile.
+					insert_node(shard, m_default_ttl, h, k, value);
+			}
+
+			return value;
+		}
+
+		static value_type create_value(create_callback_type& creator, const key_type& k)
+		{
+			return creator ? creator(k) : value_type();
+		}
+
+		template <typename Creator>
+		static value_type create_value(Creator& creator, const key_type& k)
+		{
+			return creator(k);
+		}
+
+	protected:
+		shard_type*				m_shards;
+		size_type				m_shard_count;
+		size_type				m_budget;
+		tick_type				m_default_ttl;   // In ticks; 0 means no expiry.
+		hasher					m_hash;
+		key_equal				m_predicate;
+		allocator_type			m_allocator;
+		create_callback_type	m_create_callback;
+		delete_callback_type	m_delete_callback;
+		weigh_callback_type		m_weigh_callback;
+	};
+}
+
+
+
+#endif
@@ -0,0 +1,675 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Eviction policies for lru_cache.
+//
+// A policy decides where a new entry goes, what a hit does to an entry and
+// which entry is evicted next. The cache owns the entries and their hash
+// index; the policy only orders them. All entries are linked into a single
+// circular list which starts and ends at the cache's anchor node. A policy
+// which needs several queues (segments) splits this list with boundary nodes
+// it owns, so iterating the cache still visits every entry exactly once.
+//
+// The policies provided are:
+//     lru_eviction_policy       Strict least recently used. A hit moves the
+//                               entry to the front. This is the default.
+//     clock_eviction_policy     CLOCK (second chance). A hit only sets a
+//                               reference bit; eviction gives referenced
+//                               entries another round instead.
+//     s3fifo_eviction_policy    S3-FIFO: new entries go to a small FIFO queue
+//                               and only move to the main queue when they are
+//                               hit again before they reach its end, which
+//                               makes the cache resistant to scans. A ghost
+//                               table remembers recently evicted keys, so
+//                               they skip the small queue when they return.
+//     tinylfu_eviction_policy   W-TinyLFU: a small LRU window in front of a
+//                               segmented LRU main area. An entry leaving the
+//                               window only displaces the main area's victim
+//                               if a count-min sketch estimates that it is
+//                               used more often.
+//
+// CLOCK and S3-FIFO never reorder entries on a hit, which makes hits nearly
+// free; the reordering is done by eviction instead.
+//
+// A policy is a class with the following members. The nodes passed in are
+// entries of the cache, the lru_cache_node_base fields mnQueue and mnCounter
+// belong to the policy, and mnHashCode is the hash code of the key.
+//
+//     void attach(lru_cache_node_base* pAnchor, size_type capacity);
+//         Called for an empty cache. Links the policy's boundary nodes, if
+//         any, into the list of pAnchor and resets the policy's state.
+//     void setCapacity(size_type capacity);
+//         Called when the cache's capacity changes.
+//     void onInsert(lru_cache_node_base* pNode);
+//         Links a new entry into the list.
+//     void onHit(lru_cache_node_base* pNode);
+//         Called when an existing entry is accessed (get, touch, assign).
+//     void onErase(lru_cache_node_base* pNode);
+//         Unlinks an entry from the list, whether it is evicted or erased.
+//     lru_cache_node_base* victim();
+//         Returns the entry to evict next. The cache is not empty. The policy
+//         may reorder entries while it looks for it.
+//     bool validate() const;
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_EVICTION_POLICY_H
+#define EASTL_EVICTION_POLICY_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/vector.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+	/// EASTL_EVICTION_POLICY_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_EVICTION_POLICY_DEFAULT_NAME
+		#define EASTL_EVICTION_POLICY_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " eviction_policy" // Unless the user overrides something, this is "EASTL eviction_policy".
+	#endif
+
+
+	/// lru_cache_node_base
+	///
+	/// The part of a cache entry which the eviction policy works with: the
+	/// links of the cache's entry list, the hash code of the key and two bytes
+	/// of policy state. The cache's anchor node and the policies' boundary
+	/// nodes are of this type, so they don't carry a key or value. Free nodes
+	/// in the cache's pool are chained through mpNext.
+	///
+	struct lru_cache_node_base
+	{
+		static const uint8_t kQueueBoundary = 0xff;  // mnQueue of a policy's boundary node. Iteration skips these.
+
+		lru_cache_node_base* mpNext;      // Towards the entry that is evicted next.
+		lru_cache_node_base* mpPrev;
+		size_t               mnHashCode;
+		uint8_t              mnQueue;     // The policy's segment which holds the entry.
+		uint8_t              mnCounter;   // Reference bit or access frequency, depending on the policy.
+	};
+
+
+	/// lru_cache_segment
+	///
+	/// A queue of entries: the part of the entry list between two boundary
+	/// nodes (or the anchor). The front holds the newest entries, the back the
+	/// one which is evicted first.
+	///
+	struct lru_cache_segment
+	{
+		typedef eastl_size_t size_type;
+
+		lru_cache_node_base* mpBegin;  // The node before the front.
+		lru_cache_node_base* mpEnd;    // The node after the back.
+		size_type            mnSize;
+
+		void reset(lru_cache_node_base* pBegin, lru_cache_node_base* pEnd)
+		{
+			mpBegin = pBegin;
+			mpEnd = pEnd;
+			mnSize = 0;
+		}
+
+		bool                 empty() const { return mnSize == 0; }
+		size_type            size() const  { return mnSize; }
+		lru_cache_node_base* back() const  { return mpEnd->mpPrev; }
+
+		void pushFront(lru_cache_node_base* pNode)
+		{
+			link(pNode);
+			++mnSize;
+		}
+
+		void remove(lru_cache_node_base* pNode)
+		{
+			unlink(pNode);
+			--mnSize;
+		}
+
+		void moveToFront(lru_cache_node_base* pNode)
+		{
+			if (mpBegin->mpNext != pNode)
+			{
+				unlink(pNode);
+				link(pNode);
+			}
+		}
+
+		bool validate(uint8_t nQueue) const
+		{
+			size_type n = 0;
+
+			for (const lru_cache_node_base* p = mpBegin->mpNext; p != mpEnd; p = p->mpNext, ++n)
+			{
+				if ((p->mnQueue != nQueue) || (n >= mnSize))
+					return false;
+			}
+
+			return n == mnSize;
+		}
+
+	private:
+		void link(lru_cache_node_base* pNode)
+		{
+			pNode->mpNext = mpBegin->mpNext;
+			pNode->mpPrev = mpBegin;
+			mpBegin->mpNext->mpPrev = pNode;
+			mpBegin->mpNext = pNode;
+		}
+
+		static void unlink(lru_cache_node_base* pNode)
+		{
+			pNode->mpPrev->mpNext = pNode->mpNext;
+			pNode->mpNext->mpPrev = pNode->mpPrev;
+		}
+	};
+
+
+	namespace Internal
+	{
+		// Links a boundary node after pPos.
+		inline void LinkCacheBoundary(lru_cache_node_base* pBoundary, lru_cache_node_base* pPos)
+		{
+			pBoundary->mpNext = pPos->mpNext;
+			pBoundary->mpPrev = pPos;
+			pBoundary->mnHashCode = 0;
+			pBoundary->mnQueue = lru_cache_node_base::kQueueBoundary;
+			pBoundary->mnCounter = 0;
+			pPos->mpNext->mpPrev = pBoundary;
+			pPos->mpNext = pBoundary;
+		}
+
+		// Scrambles a hash code, so that its bits are usable as independent indexes.
+		inline uint64_t MixCacheHash(uint64_t h, uint64_t seed)
+		{
+			h = (h ^ seed) * UINT64_C(0x9E3779B97F4A7C15);
+			return h ^ (h >> 29);
+		}
+
+		inline eastl_size_t CacheCeilPow2(eastl_size_t n)
+		{
+			eastl_size_t result = 1;
+			while (result < n)
+				result *= 2;
+			return result;
+		}
+	}
+
+
+	/// lru_eviction_policy
+	///
+	/// Evicts the least recently used entry. Iteration goes from the most to
+	/// the least recently used entry.
+	///
+	class lru_eviction_policy
+	{
+	public:
+		typedef eastl_size_t size_type;
+
+		void attach(lru_cache_node_base* pAnchor, size_type) { mEntries.reset(pAnchor, pAnchor); }
+		void setCapacity(size_type)                          { }
+
+		void onInsert(lru_cache_node_base* pNode)            { pNode->mnQueue = 0; mEntries.pushFront(pNode); }
+		void onHit(lru_cache_node_base* pNode)               { mEntries.moveToFront(pNode); }
+		void onErase(lru_cache_node_base* pNode)             { mEntries.remove(pNode); }
+		lru_cache_node_base* victim()                        { return mEntries.back(); }
+
+		bool validate() const                                { return mEntries.validate(0); }
+
+	protected:
+		lru_cache_segment mEntries;
+	};
+
+
+	/// clock_eviction_policy
+	///
+	/// CLOCK, also known as second chance. A hit sets the entry's reference bit
+	/// and doesn't touch the list. The victim is searched from the back: an
+	/// entry with its bit set has it cleared and goes round to the front again.
+	/// Requeuing at the front is equivalent to advancing the hand of a clock
+	/// past it, without the need to keep a hand which points into the cache.
+	///
+	class clock_eviction_policy
+	{
+	public:
+		typedef eastl_size_t size_type;
+
+		void attach(lru_cache_node_base* pAnchor, size_type) { mEntries.reset(pAnchor, pAnchor); }
+		void setCapacity(size_type)                          { }
+
+		void onInsert(lru_cache_node_base* pNode)            { pNode->mnQueue = 0; pNode->mnCounter = 0; mEntries.pushFront(pNode); }
+		void onHit(lru_cache_node_base* pNode)               { pNode->mnCounter = 1; }
+		void onErase(lru_cache_node_base* pNode)             { mEntries.remove(pNode); }
+
+		lru_cache_node_base* victim()
+		{
+			lru_cache_node_base* pNode = mEntries.back();
+
+			while (pNode->mnCounter)
+			{
+				pNode->mnCounter = 0;
+				mEntries.moveToFront(pNode);
+				pNode = mEntries.back();
+			}
+
+			return pNode;
+		}
+
+		bool validate() const                                { return mEntries.validate(0); }
+
+	protected:
+		lru_cache_segment mEntries;
+	};
+
+
+	/// lru_cache_ghost_table
+	///
+	/// Remembers the hash codes of the last capacity() keys recorded, as needed
+	/// for the ghost queue of S3-FIFO. It is a direct mapped table which is
+	/// twice that size, stamped with the insertion count, so a key is forgotten
+	/// when it is older than capacity() insertions or when another key lands
+	/// in its slot. This makes contains() a single probe, at the cost of
+	/// occasionally forgetting a key early.
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class lru_cache_ghost_table
+	{
+	public:
+		typedef Allocator    allocator_type;
+		typedef eastl_size_t size_type;
+
+		lru_cache_ghost_table(const allocator_type& allocator = allocator_type(EASTL_EVICTION_POLICY_DEFAULT_NAME))
+			: mSlots(allocator), mnCapacity(0), mnMask(0), mnStamp(0) { }
+
+		void setCapacity(size_type capacity)
+		{
+			mnCapacity = capacity;
+			mnMask = Internal::CacheCeilPow2(capacity * 2) - 1;
+			mnStamp = 0;
+			mSlots.assign(mnMask + 1, Slot());
+		}
+
+		size_type capacity() const { return mnCapacity; }
+
+		void insert(size_t h)
+		{
+			Slot& slot = mSlots[index(h)];
+			slot.mnHashCode = h;
+			slot.mnStamp = ++mnStamp;
+		}
+
+		// Returns whether h is remembered, and forgets it.
+		bool remove(size_t h)
+		{
+			Slot& slot = mSlots[index(h)];
+
+			if ((slot.mnHashCode == h) && slot.mnStamp && ((mnStamp - slot.mnStamp) < mnCapacity))
+			{
+				slot.mnStamp = 0;
+				return true;
+			}
+
+			return false;
+		}
+
+	protected:
+		struct Slot
+		{
+			size_t   mnHashCode = 0;
+			uint64_t mnStamp = 0;  // 0 means the slot is empty.
+		};
+
+		size_type index(size_t h) const { return static_cast<size_type>(Internal::MixCacheHash(h, 0) >> 32) & mnMask; }
+
+		eastl::vector<Slot, Allocator> mSlots;
+		size_type                      mnCapacity;
+		size_type                      mnMask;
+		uint64_t                       mnStamp;
+	};
+
+
+	/// s3fifo_eviction_policy
+	///
+	/// S3-FIFO (Yang et al., "FIFO queues are all you need for cache eviction",
+	/// SOSP 2023). New entries go to the small queue, which holds about 10% of
+	/// the capacity. An entry which reaches the back of the small queue moves
+	/// to the main queue if it was hit meanwhile, and is evicted otherwise; its
+	/// key is then remembered in the ghost table, and if it is inserted again
+	/// while still remembered it goes straight to the main queue. The main
+	/// queue is a CLOCK with a two bit access count. Hits only increment the
+	/// count. Iteration visits the small queue, then the main queue.
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class s3fifo_eviction_policy
+	{
+	public:
+		typedef Allocator    allocator_type;
+		typedef eastl_size_t size_type;
+
+		static const uint8_t kQueueSmall = 0;
+		static const uint8_t kQueueMain  = 1;
+		static const uint8_t kMaxCount   = 3;
+
+		s3fifo_eviction_policy(const allocator_type& allocator = allocator_type(EASTL_EVICTION_POLICY_DEFAULT_NAME))
+			: mGhost(allocator), mnSmallCapacity(1) { }
+
+		void attach(lru_cache_node_base* pAnchor, size_type capacity)
+		{
+			Internal::LinkCacheBoundary(&mBoundary, pAnchor);
+			mSmall.reset(pAnchor, &mBoundary);
+			mMain.reset(&mBoundary, pAnchor);
+			setCapacity(capacity);
+		}
+
+		void setCapacity(size_type capacity)
+		{
+			mnSmallCapacity = (capacity / 10) ? (capacity / 10) : 1;
+			mGhost.setCapacity(capacity > mnSmallCapacity ? capacity - mnSmallCapacity : 1);
+		}
+
+		void onInsert(lru_cache_node_base* pNode)
+		{
+			pNode->mnCounter = 0;
+
+			if (mGhost.remove(pNode->mnHashCode))
+			{
+				pNode->mnQueue = kQueueMain;
+				mMain.pushFront(pNode);
+			}
+			else
+			{
+				pNode->mnQueue = kQueueSmall;
+				mSmall.pushFront(pNode);
+			}
+		}
+
+		void onHit(lru_cache_node_base* pNode)
+		{
+			if (pNode->mnCounter < kMaxCount)
+				++pNode->mnCounter;
+		}
+
+		void onErase(lru_cache_node_base* pNode)
+		{
+			(pNode->mnQueue == kQueueSmall ? mSmall : mMain).remove(pNode);
+		}
+
+		lru_cache_node_base* victim()
+		{
+			for (;;)
+			{
+				if (!mSmall.empty() && ((mSmall.size() >= mnSmallCapacity) || mMain.empty()))
+				{
+					lru_cache_node_base* const pNode = mSmall.back();
+
+					if (pNode->mnCounter == 0)
+					{
+						mGhost.insert(pNode->mnHashCode);
+						return pNode;
+					}
+
+					// Hit while in the small queue: promote it.
+					mSmall.remove(pNode);
+					pNode->mnQueue = kQueueMain;
+					pNode->mnCounter = 0;
+					mMain.pushFront(pNode);
+				}
+				else
+				{
+					lru_cache_node_base* const pNode = mMain.back();
+
+					if (pNode->mnCounter == 0)
+						return pNode;
+
+					--pNode->mnCounter;
+					mMain.moveToFront(pNode);
+				}
+			}
+		}
+
+		bool validate() const { return mSmall.validate(kQueueSmall) && mMain.validate(kQueueMain); }
+
+	protected:
+		lru_cache_segment                mSmall;
+		lru_cache_segment                mMain;
+		lru_cache_node_base              mBoundary;
+		lru_cache_ghost_table<Allocator> mGhost;
+		size_type                        mnSmallCapacity;
+	};
+
+
+	/// count_min_sketch
+	///
+	/// Estimates how often hash codes were added, in 4 bit saturating counters.
+	/// Each hash code maps to one counter in each of four rows and its estimate
+	/// is the smallest of them, so collisions can only make estimates too high.
+	/// The table has about one 64 bit word (16 counters) per expected distinct
+	/// key. Once ten times that many additions were made, all counters are
+	/// halved, so the estimates follow recent popularity rather than all-time
+	/// popularity. Used by tinylfu_eviction_policy.
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class count_min_sketch
+	{
+	public:
+		typedef Allocator    allocator_type;
+		typedef eastl_size_t size_type;
+
+		static const uint32_t kMaxFrequency = 15;
+
+		count_min_sketch(const allocator_type& allocator = allocator_type(EASTL_EVICTION_POLICY_DEFAULT_NAME))
+			: mTable(allocator), mnMask(0), mnAdditions(0), mnSampleSize(0) { }
+
+		/// Sizes the sketch for capacity distinct keys and clears it.
+		void setCapacity(size_type capacity)
+		{
+			const size_type nWords = Internal::CacheCeilPow2(capacity < 8 ? 8 : capacity);
+
+			mTable.assign(nWords, 0);
+			mnMask = nWords - 1;
+			mnAdditions = 0;
+			mnSampleSize = nWords * 10;
+		}
+
+		void clear()
+		{
+			mTable.assign(mTable.size(), 0);
+			mnAdditions = 0;
+		}
+
+		uint32_t frequency(size_t h) const
+		{
+			uint32_t nMin = kMaxFrequency;
+
+			for (uint64_t i = 0; i < kRowCount; ++i)
+			{
+				const uint64_t x = Internal::MixCacheHash(h, kSeeds[i]);
+				const uint32_t n = static_cast<uint32_t>(mTable[static_cast<size_type>(x) & mnMask] >> shift(x)) & 0xf;
+
+				if (n < nMin)
+					nMin = n;
+			}
+
+			return nMin;
+		}
+
+		void add(size_t h)
+		{
+			bool bIncremented = false;
+
+			for (uint64_t i = 0; i < kRowCount; ++i)
+			{
+				const uint64_t x = Internal::MixCacheHash(h, kSeeds[i]);
+				uint64_t& word = mTable[static_cast<size_type>(x) & mnMask];
+
+				if (((word >> shift(x)) & 0xf) != kMaxFrequency)
+				{
+					word += uint64_t(1) << shift(x);
+					bIncremented = true;
+				}
+			}
+
+			if (bIncremented && (++mnAdditions >= mnSampleSize))
+				age();
+		}
+
+	protected:
+		static const uint64_t kRowCount = 4;
+		static const uint64_t kSeeds[kRowCount];
+
+		// The word is selected by the low bits of the mixed hash code and the counter within it by the top four.
+		static uint32_t shift(uint64_t x) { return static_cast<uint32_t>(x >> 60) * 4; }
+
+		void age()
+		{
+			for (size_type i = 0, n = mTable.size(); i < n; ++i)
+				mTable[i] = (mTable[i] >> 1) & UINT64_C(0x7777777777777777);
+			mnAdditions /= 2;
+		}
+
+		eastl::vector<uint64_t, Allocator> mTable;
+		size_type                          mnMask;
+		size_type                          mnAdditions;
+		size_type                          mnSampleSize;
+	};
+
+	template <typename Allocator>
+	const uint64_t count_min_sketch<Allocator>::kSeeds[count_min_sketch<Allocator>::kRowCount] =
+		{ UINT64_C(0xc3a5c85c97cb3127), UINT64_C(0xb492b66fbe98f273), UINT64_C(0x9ae16a3b2f90404f), UINT64_C(0xcbf29ce484222325) };
+
+
+	/// tinylfu_eviction_policy
+	///
+	/// W-TinyLFU (Einziger et al., "TinyLFU: A Highly Efficient Cache Admission
+	/// Policy"). New entries go to an LRU window of about 1% of the capacity.
+	/// The rest is a segmented LRU: entries which leave the window enter its
+	/// probation segment, and a hit there promotes them to the protected
+	/// segment (about 80% of it), whose least recently used entry is demoted
+	/// back to probation when it overflows. When the cache is full and the
+	/// window is about to overflow, the window's oldest entry competes with the
+	/// oldest entry of probation, and the one with the lower estimated access
+	/// frequency is evicted. Every access, including the one inserting a key,
+	/// is added to the frequency sketch, so keys which missed often win
+	/// against one-off keys from a scan. Iteration visits the window, then
+	/// probation, then protected.
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class tinylfu_eviction_policy
+	{
+	public:
+		typedef Allocator    allocator_type;
+		typedef eastl_size_t size_type;
+
+		static const uint8_t kQueueWindow    = 0;
+		static const uint8_t kQueueProbation = 1;
+		static const uint8_t kQueueProtected = 2;
+
+		tinylfu_eviction_policy(const allocator_type& allocator = allocator_type(EASTL_EVICTION_POLICY_DEFAULT_NAME))
+			: mSketch(allocator), mnWindowCapacity(1), mnProtectedCapacity(0) { }
+
+		void attach(lru_cache_node_base* pAnchor, size_type capacity)
+		{
+			Internal::LinkCacheBoundary(&mBoundary[1], pAnchor);
+			Internal::LinkCacheBoundary(&mBoundary[0], pAnchor);
+			mSegment[kQueueWindow].reset(pAnchor, &mBoundary[0]);
+			mSegment[kQueueProbation].reset(&mBoundary[0], &mBoundary[1]);
+			mSegment[kQueueProtected].reset(&mBoundary[1], pAnchor);
+			setCapacity(capacity);
+		}
+
+		void setCapacity(size_type capacity)
+		{
+			mnWindowCapacity = (capacity / 100) ? (capacity / 100) : 1;
+			mnProtectedCapacity = (capacity > mnWindowCapacity) ? ((capacity - mnWindowCapacity) * 4 / 5) : 0;
+			mSketch.setCapacity(capacity);
+		}
+
+		void onInsert(lru_cache_node_base* pNode)
+		{
+			mSketch.add(pNode->mnHashCode);
+
+			pNode->mnQueue = kQueueWindow;
+			mSegment[kQueueWindow].pushFront(pNode);
+
+			if (mSegment[kQueueWindow].size() > mnWindowCapacity)
+				moveTo(mSegment[kQueueWindow].back(), kQueueProbation);
+		}
+
+		void onHit(lru_cache_node_base* pNode)
+		{
+			mSketch.add(pNode->mnHashCode);
+
+			if (pNode->mnQueue == kQueueProbation)
+			{
+				moveTo(pNode, kQueueProtected);
+
+				if (mSegment[kQueueProtected].size() > mnProtectedCapacity)
+					moveTo(mSegment[kQueueProtected].back(), kQueueProbation);
+			}
+			else
+				mSegment[pNode->mnQueue].moveToFront(pNode);
+		}
+
+		void onErase(lru_cache_node_base* pNode)
+		{
+			mSegment[pNode->mnQueue].remove(pNode);
+		}
+
+		lru_cache_node_base* victim()
+		{
+			lru_cache_segment& window = mSegment[kQueueWindow];
+			lru_cache_segment& main   = mSegment[kQueueProbation].empty() ? mSegment[kQueueProtected] : mSegment[kQueueProbation];
+
+			if (main.empty())
+				return window.back();
+
+			if (window.size() < mnWindowCapacity)
+				return main.back();
+
+			// The window's oldest entry is about to leave it; admit it only if it is used more often than the main victim.
+			lru_cache_node_base* const pCandidate = window.back();
+			lru_cache_node_base* const pVictim    = main.back();
+
+			return (mSketch.frequency(pCandidate->mnHashCode) > mSketch.frequency(pVictim->mnHashCode)) ? pVictim : pCandidate;
+		}
+
+		bool validate() const
+		{
+			return mSegment[kQueueWindow].validate(kQueueWindow) && mSegment[kQueueProbation].validate(kQueueProbation) &&
+			       mSegment[kQueueProtected].validate(kQueueProtected);
+		}
+
+		const count_min_sketch<Allocator>& sketch() const { return mSketch; }
+
+	protected:
+		void moveTo(lru_cache_node_base* pNode, uint8_t nQueue)
+		{
+			mSegment[pNode->mnQueue].remove(pNode);
+			pNode->mnQueue = nQueue;
+			mSegment[nQueue].pushFront(pNode);
+		}
+
+		lru_cache_segment           mSegment[3];
+		lru_cache_node_base         mBoundary[2];
+		count_min_sketch<Allocator> mSketch;
+		size_type                   mnWindowCapacity;
+		size_type                   mnProtectedCapacity;
+	};
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// intrusive_lockfree_stack is a lock-free LIFO stack (a Treiber stack) of
+// user-allocated elements which any number of threads may push to and pop
+// from concurrently. Like intrusive_slist, it never allocates: elements
+// derive from intrusive_lockfree_node and are linked through it. A typical
+// use is a free list of pooled objects that is shared between threads.
+//
+// A pop reads the next pointer of the current top and then swaps the top
+// for it with a compare-and-swap. That alone suffers from the ABA problem:
+// between the read and the swap another thread may pop the top, pop its
+// successor and push the top back, and the swap would then install a
+// successor which is no longer in the stack. To rule this out the top
+// pointer is paired with a counter which each pop increments, and the pair
+// is swapped as a unit. On 64-bit platforms this relies on a 128-bit
+// compare-and-swap (cmpxchg16b on x64, ldxp/stxp or casp on ARM64).
+//
+// A pop may read the next pointer of a node which another thread has just
+// popped. The memory of an element must therefore remain readable while
+// other threads may still be popping from the stack; recycling elements
+// through the stack itself, or through pools which don't return memory to
+// the system, satisfies this.
+//
+// Example usage:
+//     struct Buffer : public eastl::intrusive_lockfree_node { char mData[4096]; };
+//
+//     eastl::intrusive_lockfree_stack<Buffer> freeBuffers;
+//
+//     freeBuffers.push(*pBuffer);              // any thread
+//     Buffer* pBuffer = freeBuffers.pop();     // any thread; NULL if empty
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTRUSIVE_LOCKFREE_STACK_H
+#define EASTL_INTRUSIVE_LOCKFREE_STACK_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/atomic.h>
+#include <eastl/type_traits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// intrusive_lockfree_node
+	///
+	/// The hook through which intrusive_lockfree_stack and intrusive_mpsc_queue
+	/// link their elements. The link is atomic because those containers read it
+	/// while other threads may be writing it. Copying a node doesn't copy its
+	/// link, as the link belongs to the container the node is in.
+	///
+	struct intrusive_lockfree_node
+	{
+		eastl::atomic<intrusive_lockfree_node*> mpNext;
+
+		intrusive_lockfree_node() EASTL_NOEXCEPT
+			: mpNext(nullptr) { }
+
+		intrusive_lockfree_node(const intrusive_lockfree_node&) EASTL_NOEXCEPT
+			: mpNext(nullptr) { }
+
+		intrusive_lockfree_node& operator=(const intrusive_lockfree_node&) EASTL_NOEXCEPT
+			{ return *this; }
+	};
+
+
+
+	/// intrusive_lockfree_stack
+	///
+	template <typename T = intrusive_lockfree_node>
+	class intrusive_lockfree_stack
+	{
+	public:
+		typedef intrusive_lockfree_stack<T>  this_type;
+		typedef T                            node_type;
+		typedef T                            value_type;
+		typedef T&                           reference;
+		typedef T*                           pointer;
+
+		static_assert(is_base_of<intrusive_lockfree_node, T>::value, "intrusive_lockfree_stack elements must derive from intrusive_lockfree_node.");
+
+	public:
+		intrusive_lockfree_stack() EASTL_NOEXCEPT;
+
+		// Neither copyable nor movable, as other threads may be referring to the stack.
+		intrusive_lockfree_stack(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		void push(value_type& value) EASTL_NOEXCEPT;
+
+		// Pushes the chain first -> ... -> last, which the caller has linked with setNext,
+		// with a single compare-and-swap. first ends up on top.
+		void pushChain(value_type& first, value_type& last) EASTL_NOEXCEPT;
+
+		// Returns NULL if the stack is empty.
+		pointer pop() EASTL_NOEXCEPT;
+
+		// Detaches all elements at once and returns the former top, or NULL if the stack
+		// was empty. The rest of the elements can be reached with next().
+		pointer popAll() EASTL_NOEXCEPT;
+
+		// The result may be stale by the time it is returned.
+		bool empty() const EASTL_NOEXCEPT;
+
+		// Walk and build chains of elements which are not (or no longer) in a stack.
+		static pointer next(const value_type& value) EASTL_NOEXCEPT;
+		static void    setNext(value_type& value, pointer pNext) EASTL_NOEXCEPT;
+
+	protected:
+		// The top of the stack and the number of pops done so far, which is what defeats ABA.
+		struct alignas(2 * sizeof(void*)) TaggedPointer
+		{
+			intrusive_lockfree_node* mpNode;
+			uintptr_t                mnTag;
+		};
+
+		#if (EA_PLATFORM_PTR_SIZE == 8) && !defined(EASTL_ATOMIC_HAS_128BIT)
+			static_assert(!is_same<T, T>::value, "intrusive_lockfree_stack requires a 128-bit atomic compare-and-swap on 64-bit platforms.");
+		#endif
+
+		alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) eastl::atomic<TaggedPointer> mTop;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// intrusive_lockfree_stack
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	inline intrusive_lockfree_stack<T>::intrusive_lockfree_stack() EASTL_NOEXCEPT
+		: mTop(TaggedPointer{ nullptr, 0 })
+	{
+	}
+
+
+	template <typename T>
+	inline void intrusive_lockfree_stack<T>::push(value_type& value) EASTL_NOEXCEPT
+	{
+		pushChain(value, value);
+	}
+
+
+	template <typename T>
+	inline void intrusive_lockfree_stack<T>::pushChain(value_type& first, value_type& last) EASTL_NOEXCEPT
+	{
+		intrusive_lockfree_node* const pFirst = &first;
+		TaggedPointer top = mTop.load(eastl::memory_order_relaxed);
+		TaggedPointer newTop;
+
+		// Pushing can't cause ABA, so the tag is left alone.
+		do
+		{
+			static_cast<intrusive_lockfree_node&>(last).mpNext.store(top.mpNode, eastl::memory_order_relaxed);
+			newTop.mpNode = pFirst;
+			newTop.mnTag  = top.mnTag;
+		}
+		while(!mTop.compare_exchange_weak(top, newTop, eastl::memory_order_release, eastl::memory_order_relaxed));
+	}
+
+
+	template <typename T>
+	inline typename intrusive_lockfree_stack<T>::pointer
+	intrusive_lockfree_stack<T>::pop() EASTL_NOEXCEPT
+	{
+		TaggedPointer top = mTop.load(eastl::memory_order_acquire);
+		TaggedPointer newTop;
+
+		while(top.mpNode)
+		{
+			// If another thread pops top.mpNode first, this reads a stale link, but then the tag
+			// has changed and the compare-and-swap fails.
+			newTop.mpNode = top.mpNode->mpNext.load(eastl::memory_order_relaxed);
+			newTop.mnTag  = top.mnTag + 1;
+
+			if(mTop.compare_exchange_weak(top, newTop, eastl::memory_order_acquire, eastl::memory_order_acquire))
+				return static_cast<pointer>(top.mpNode);
+		}
+
+		return nullptr;
+	}
+
+
+	template <typename T>
+	inline typename intrusive_lockfree_stack<T>::pointer
+	intrusive_lockfree_stack<T>::popAll() EASTL_NOEXCEPT
+	{
+		TaggedPointer top = mTop.load(eastl::memory_order_acquire);
+		TaggedPointer newTop;
+
+		while(top.mpNode)
+		{
+			newTop.mpNode = nullptr;
+			newTop.mnTag  = top.mnTag + 1;
+
+			if(mTop.compare_exchange_weak(top, newTop, eastl::memory_order_acquire, eastl::memory_order_acquire))
+				return static_cast<pointer>(top.mpNode);
+		}
+
+		return nullptr;
+	}
+
+
+	template <typename T>
+	inline bool intrusive_lockfree_stack<T>::empty() const EASTL_NOEXCEPT
+	{
+		return mTop.load(eastl::memory_order_relaxed).mpNode == nullptr;
+	}
+
+
+	template <typename T>
+	inline typename intrusive_lockfree_stack<T>::pointer
+	intrusive_lockfree_stack<T>::next(const value_type& value) EASTL_NOEXCEPT
+	{
+		return static_cast<pointer>(static_cast<const intrusive_lockfree_node&>(value).mpNext.load(eastl::memory_order_relaxed));
+	}
+
+
+	template <typename T>
+	inline void intrusive_lockfree_stack<T>::setNext(value_type& value, pointer pNext) EASTL_NOEXCEPT
+	{
+		static_cast<intrusive_lockfree_node&>(value).mpNext.store(pNext, eastl::memory_order_relaxed);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
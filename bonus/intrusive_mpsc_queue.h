@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// intrusive_mpsc_queue is an unbounded FIFO queue of user-allocated elements
+// which any number of producer threads may push to while a single consumer
+// thread pops from it. It is an implementation of Dmitry Vyukov's intrusive
+// MPSC node-based queue. It never allocates: elements derive from
+// intrusive_lockfree_node (see intrusive_lockfree_stack.h) and are linked
+// through it. A typical use is handing completion notifications from worker
+// threads to an owning thread.
+//
+// A push is a single atomic exchange followed by a store, so producers never
+// retry and never wait on each other or on the consumer. The consumer keeps
+// its end of the queue to itself. The price is that a producer which has
+// done its exchange but not yet its store briefly hides the elements pushed
+// after it: pop returns NULL until that store lands, even though the queue
+// isn't empty. Callers which poll simply try again later.
+//
+// Example usage:
+//     struct Completion : public eastl::intrusive_lockfree_node { Job* mpJob; };
+//
+//     eastl::intrusive_mpsc_queue<Completion> completions;
+//
+//     // any worker thread                 // the owning thread
+//     completions.push(*pCompletion);      while(Completion* pCompletion = completions.pop())
+//                                              OnCompleted(pCompletion->mpJob);
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTRUSIVE_MPSC_QUEUE_H
+#define EASTL_INTRUSIVE_MPSC_QUEUE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/atomic.h>
+#include <eastl/type_traits.h>
+#include <eastl/bonus/intrusive_lockfree_stack.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// intrusive_mpsc_queue
+	///
+	template <typename T = intrusive_lockfree_node>
+	class intrusive_mpsc_queue
+	{
+	public:
+		typedef intrusive_mpsc_queue<T>  this_type;
+		typedef T                        node_type;
+		typedef T                        value_type;
+		typedef T&                       reference;
+		typedef T*                       pointer;
+
+		static_assert(is_base_of<intrusive_lockfree_node, T>::value, "intrusive_mpsc_queue elements must derive from intrusive_lockfree_node.");
+
+	public:
+		intrusive_mpsc_queue() EASTL_NOEXCEPT;
+
+		// Neither copyable nor movable, as the queue links to its own stub node.
+		intrusive_mpsc_queue(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		// May be called by any thread.
+		void push(value_type& value) EASTL_NOEXCEPT;
+
+		// May only be called by the consumer thread. Returns NULL if the queue is empty, or
+		// if the next element's producer hasn't finished linking it in yet.
+		pointer pop() EASTL_NOEXCEPT;
+
+		// May only be called by the consumer thread. Returns true if there is nothing to pop,
+		// not counting elements whose producers haven't finished pushing them.
+		bool empty() const EASTL_NOEXCEPT;
+
+	protected:
+		void DoPush(intrusive_lockfree_node* pNode) EASTL_NOEXCEPT;
+
+	protected:
+		// Producers exchange their element into mpHead; the consumer pops from mpTail. The
+		// queue always contains at least one node, so that the two ends never meet at NULL.
+		// When it would otherwise run dry, mStub is pushed to fill that role.
+		alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) eastl::atomic<intrusive_lockfree_node*> mpHead;
+		alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) intrusive_lockfree_node*                mpTail;
+		intrusive_lockfree_node                                                              mStub;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// intrusive_mpsc_queue
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	inline intrusive_mpsc_queue<T>::intrusive_mpsc_queue() EASTL_NOEXCEPT
+		: mpHead(&mStub)
+		, mpTail(&mStub)
+		, mStub()
+	{
+	}
+
+
+	template <typename T>
+	inline void intrusive_mpsc_queue<T>::push(value_type& value) EASTL_NOEXCEPT
+	{
+		DoPush(&value);
+	}
+
+
+	template <typename T>
+	inline void intrusive_mpsc_queue<T>::DoPush(intrusive_lockfree_node* pNode) EASTL_NOEXCEPT
+	{
+		pNode->mpNext.store(nullptr, eastl::memory_order_relaxed);
+
+		// Until the second store, pNode (and anything pushed after it) is unreachable from mpTail.
+		intrusive_lockfree_node* const pPrev = mpHead.exchange(pNode, eastl::memory_order_acq_rel);
+		pPrev->mpNext.store(pNode, eastl::memory_order_release);
+	}
+
+
+	template <typename T>
+	typename intrusive_mpsc_queue<T>::pointer
+	intrusive_mpsc_queue<T>::pop() EASTL_NOEXCEPT
+	{
+		intrusive_lockfree_node* pTail = mpTail;
+		intrusive_lockfree_node* pNext = pTail->mpNext.load(eastl::memory_order_acquire);
+
+		if(pTail == &mStub) // Skip over the stub.
+		{
+			if(!pNext)
+				return nullptr;
+
+			mpTail = pNext;
+			pTail  = pNext;
+			pNext  = pNext->mpNext.load(eastl::memory_order_acquire);
+		}
+
+		if(pNext) // pTail isn't the last node, so it can be handed out.
+		{
+			mpTail = pNext;
+			return static_cast<pointer>(pTail);
+		}
+
+		// pTail looks like the last node. If it isn't, a producer is between its two steps.
+		if(pTail != mpHead.load(eastl::memory_order_acquire))
+			return nullptr;
+
+		// Push the stub behind pTail so that pTail can be handed out without emptying the queue.
+		DoPush(&mStub);
+
+		pNext = pTail->mpNext.load(eastl::memory_order_acquire);
+
+		if(pNext)
+		{
+			mpTail = pNext;
+			return static_cast<pointer>(pTail);
+		}
+
+		return nullptr;
+	}
+
+
+	template <typename T>
+	inline bool intrusive_mpsc_queue<T>::empty() const EASTL_NOEXCEPT
+	{
+		const intrusive_lockfree_node* const pTail = mpTail;
+
+		return (pTail == &mStub) && (mStub.mpNext.load(eastl::memory_order_acquire) == nullptr);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
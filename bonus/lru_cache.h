@@ -7,15 +7,25 @@
 // Basically, you give the container a key, like a string, and the data you want.
 // The container provides callback mechanisms to generate data if it's missing
 // as well as delete data when it's purged from the cache.  This container
-// uses a least recently used method: whatever the oldest item is will be 
+// uses a least recently used method: whatever the oldest item is will be
 // replaced with a new entry.
 //
-// Algorithmically, the container is a combination of a map and a list.
-// The list stores the age of the entries by moving the entry to the head
-// of the list on each access, either by a call to get() or to touch().
-// The map is just the map as one would expect.
+// Algorithmically, each entry is a single node which is linked into two
+// intrusive structures at once: a doubly linked list, which the eviction
+// policy keeps in eviction order, and a chained hash index, in which the
+// node is linked into its bucket. The key is stored once, a hit costs one
+// hash lookup plus whatever the policy does on a hit, and an eviction simply
+// reuses the evicted node. With the default lru_eviction_policy the list is
+// the recency list: an entry is moved to the head on each access (get() or
+// touch()). See eviction_policy.h for the scan resistant CLOCK, S3-FIFO and
+// W-TinyLFU policies.
 //
-// This is useful for caching off data that is expensive to generate, 
+// All nodes and the hash buckets come from a single block which is allocated
+// up front for capacity() entries. Once that block exists, inserting, hitting,
+// evicting and erasing never allocate; only resize() and setAllocator()
+// reallocate the block.
+//
+// This is useful for caching off data that is expensive to generate,
 // for example text to speech wave files that are dynamically generated,
 // but that will need to be reused, as is the case in narration of menu
 // entries as a user scrolls through the entries.
@@ -28,11 +38,17 @@
 #pragma once
 #endif
 
-#include <eastl/list.h>
-#include <eastl/unordered_map.h>
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/iterator.h>
 #include <eastl/optional.h>
+#include <eastl/tuple.h>
+#include <eastl/type_traits.h>
 #include <eastl/utility.h> // for pair
 #include <eastl/functional.h> // for function, hash, equal_to
+#include <eastl/bonus/eviction_policy.h>
+#include <stddef.h>
+#include <stdint.h>
 
 namespace eastl
 {
@@ -51,18 +67,115 @@ namespace eastl
 	#define EASTL_LRUCACHE_DEFAULT_ALLOCATOR allocator_type(EASTL_LRUCACHE_DEFAULT_NAME)
 	#endif
 
+
+	/// lru_cache_node
+	///
+	/// A cache entry: the list links and policy state, the hash chain link and the key/value pair.
+	/// The hash code is cached so that lookups rarely compare keys and so that
+	/// rebuilding the index never calls the hash function.
+	///
+	template <typename T>
+	struct lru_cache_node : public lru_cache_node_base
+	{
+		template <typename... Args>
+		lru_cache_node(size_t hashCode, Args&&... args)
+			: mpHashNext(nullptr), mValue(eastl::forward<Args>(args)...)
+		{
+			mnHashCode = hashCode;
+			mnQueue = 0;
+			mnCounter = 0;
+		}
+
+		lru_cache_node* mpHashNext;
+		T               mValue;       // This is a pair of key/value.
+	};
+
+
+	/// lru_cache_iterator
+	///
+	/// Iterates the entries in the order of the eviction policy's list, skipping the policy's boundary nodes.
+	/// For lru_eviction_policy this is from the most to the least recently used.
+	///
+	template <typename T, typename Pointer, typename Reference>
+	struct lru_cache_iterator
+	{
+		typedef lru_cache_iterator<T, Pointer, Reference>    this_type;
+		typedef lru_cache_iterator<T, T*, T&>                iterator;
+		typedef lru_cache_iterator<T, const T*, const T&>    const_iterator;
+		typedef eastl_size_t                                 size_type;
+		typedef ptrdiff_t                                    difference_type;
+		typedef T                                            value_type;
+		typedef lru_cache_node_base                          base_node_type;
+		typedef lru_cache_node<T>                            node_type;
+		typedef Pointer                                      pointer;
+		typedef Reference                                    reference;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag     iterator_category;
+
+	public:
+		base_node_type* mpNode;
+
+	public:
+		lru_cache_iterator() : mpNode(nullptr) { }
+		explicit lru_cache_iterator(const base_node_type* pNode) : mpNode(const_cast<base_node_type*>(pNode)) { }
+
+		// This is the converting constructor of a non-const iterator to a const iterator.
+		template <typename This = this_type, enable_if_t<!is_same_v<This, iterator>, bool> = true>
+		lru_cache_iterator(const iterator& x) : mpNode(x.mpNode) { }
+
+		reference operator*() const  { return static_cast<node_type*>(mpNode)->mValue; }
+		pointer   operator->() const { return &static_cast<node_type*>(mpNode)->mValue; }
+
+		this_type& operator++()
+		{
+			do
+				mpNode = mpNode->mpNext;
+			while (mpNode->mnQueue == base_node_type::kQueueBoundary);
+			return *this;
+		}
+
+		this_type operator++(int) { this_type temp(*this); ++*this; return temp; }
+
+		this_type& operator--()
+		{
+			do
+				mpNode = mpNode->mpPrev;
+			while (mpNode->mnQueue == base_node_type::kQueueBoundary);
+			return *this;
+		}
+
+		this_type operator--(int) { this_type temp(*this); --*this; return temp; }
+	};
+
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator==(const lru_cache_iterator<T, PointerA, ReferenceA>& a, const lru_cache_iterator<T, PointerB, ReferenceB>& b)
+	{
+		return a.mpNode == b.mpNode;
+	}
+
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator!=(const lru_cache_iterator<T, PointerA, ReferenceA>& a, const lru_cache_iterator<T, PointerB, ReferenceB>& b)
+	{
+		return a.mpNode != b.mpNode;
+	}
+
+
 	/// lru_cache
 	///
 	/// Implements a caching map based off of a key and data.
-	/// LRUList parameter is any container that guarantees the validity of its iterator even after a modification (e.g. list)
-	/// LRUMap is any associative container that can map a key to some data.  By default, we use unordered_map, but it might be better
-	/// to use hashMap or some other structure depending on your key/data combination.  For example, you may want to swap the 
-	/// map backing if using strings as keys or if the data objects are small.  In any case, unordered_map is a good default and should
-	/// work well enough since the purpose of this class is to cache results of expensive, order of milliseconds, operations
+	/// Hash and Predicate are used to index the keys, as with unordered_map. The index is a power of two sized
+	/// bucket array with at least one bucket per entry, and the hash codes are scrambled before they are reduced
+	/// to a bucket, so identity hashes such as eastl::hash<int> and hashes of aligned pointers work well.
+	///
+	/// EvictionPolicy decides which entry is evicted when the cache is full and what an access does; see
+	/// eviction_policy.h. Whatever the policy, erase_oldest() evicts the entry the policy would evict next.
+	/// Iteration visits the entries in the policy's order; with the default lru_eviction_policy that is from
+	/// the most recently used to the least recently used. The iterators dereference to a pair<const Key, Value>.
 	///
-	/// Algorithmic Performance (default data structures):
-	///		touch() -> O(1)
-	///		insert() / update(), get() / operator[] -> equivalent to unordered_map (O(1) on average, O(n) worst)
+	/// Algorithmic Performance:
+	///		touch() -> O(1) (amortized for policies which reorder on eviction)
+	///		insert() / update(), get() / operator[] -> O(1) on average, O(n) worst, no allocation
+	///		erase(), erase_oldest() -> O(1) on average, no deallocation
+	///		resize() -> O(n), reallocates
 	///		size() -> O(1)
 	///
 	/// All accesses to a given key (insert, update, get) will push that key to most recently used.
@@ -71,25 +184,27 @@ namespace eastl
 	template <typename Key,
 	          typename Value,
 	          typename Allocator = EASTLAllocatorType,
-	          typename list_type = eastl::list<Key, Allocator>,
-	          typename map_type = eastl::unordered_map<Key,
-	                                                   eastl::pair<Value, typename list_type::iterator>,
-	                                                   eastl::hash<Key>,
-	                                                   eastl::equal_to<Key>,
-	                                                   Allocator>>
+	          typename Hash = eastl::hash<Key>,
+	          typename Predicate = eastl::equal_to<Key>,
+	          typename EvictionPolicy = eastl::lru_eviction_policy>
 	class lru_cache
 	{
 	public:
 		using key_type = Key;
 		using value_type = Value;
+		using mapped_type = Value;
+		using entry_type = eastl::pair<const Key, Value>;
 		using allocator_type = Allocator;
+		using hasher = Hash;
+		using key_equal = Predicate;
+		using eviction_policy_type = EvictionPolicy;
 		using size_type = eastl_size_t;
-		using list_iterator = typename list_type::iterator;
-		using map_iterator = typename map_type::iterator;
-		using data_container_type = eastl::pair<value_type, list_iterator>;
-		using iterator = typename map_type::iterator;
-		using const_iterator = typename map_type::const_iterator;
-		using this_type = lru_cache<key_type, value_type, Allocator, list_type, map_type>;
+		using node_type = lru_cache_node<entry_type>;
+		using iterator = lru_cache_iterator<entry_type, entry_type*, entry_type&>;
+		using const_iterator = lru_cache_iterator<entry_type, const entry_type*, const entry_type&>;
+		using reverse_iterator = eastl::reverse_iterator<iterator>;
+		using const_reverse_iterator = eastl::reverse_iterator<const_iterator>;
+		using this_type = lru_cache<key_type, value_type, Allocator, Hash, Predicate, EvictionPolicy>;
 		using create_callback_type = eastl::function<value_type(key_type)>;
 		using delete_callback_type = eastl::function<void(const value_type &)>;
 
@@ -98,16 +213,41 @@ namespace eastl
 		/// Creates a Key / Value map that only stores size Value objects until it deletes them.
 		/// For complex objects or operations, the creator and deletor callbacks can be used.
 		/// This works just like a regular map object: on access, the Value will be created if it doesn't exist, returned otherwise.
+		/// The memory for all size entries is allocated here.
 		explicit lru_cache(size_type size,
 		                   const allocator_type& allocator = EASTL_LRUCACHE_DEFAULT_ALLOCATOR,
 		                   create_callback_type creator = nullptr,
 		                   delete_callback_type deletor = nullptr)
-		    : m_list(allocator)
-		    , m_map(allocator)
+		    : m_buckets(nullptr)
+		    , m_pool(nullptr)
+		    , m_free_list(nullptr)
+		    , m_pool_used(0)
+		    , m_size(0)
 		    , m_capacity(size)
+		    , m_bucket_count(0)
+		    , m_bucket_shift(0)
+		    , m_allocator(allocator)
 		    , m_create_callback(creator)
 		    , m_delete_callback(deletor)
 		{
+			reset_anchor();
+			m_policy.attach(&m_anchor, m_capacity);
+			allocate_pool();
+		}
+
+		/// lru_cache constructor
+		///
+		/// As above, with an eviction policy object, e.g. one which uses a specific allocator.
+		lru_cache(size_type size,
+		          const eviction_policy_type& policy,
+		          const allocator_type& allocator = EASTL_LRUCACHE_DEFAULT_ALLOCATOR,
+		          create_callback_type creator = nullptr,
+		          delete_callback_type deletor = nullptr)
+		    : lru_cache(size, allocator, creator, deletor)
+		{
+			m_policy = policy;
+			reset_anchor();
+			m_policy.attach(&m_anchor, m_capacity);
 		}
 
 		/// lru_cache destructor
@@ -116,11 +256,8 @@ namespace eastl
 		~lru_cache()
 		{
 			// Destruct everything we have cached
-			for (auto& iter : m_map)
-			{
-				if (m_delete_callback)
-					m_delete_callback(iter.second.first);
-			}
+			clear();
+			free_pool();
 		}
 
 		lru_cache(std::initializer_list<eastl::pair<Key, Value>> il)
@@ -130,24 +267,22 @@ namespace eastl
 				insert_or_assign(p.first, p.second);
 		}
 
-		// TODO(rparolin):  Why do we prevent copies? And what about moves?
+		// The entries are linked to an anchor node which lives in the cache object itself.
 		lru_cache(const this_type&) = delete;
 		this_type &operator=(const this_type&) = delete;
 
 		/// insert
-		/// 
+		///
 		/// insert key k with value v.
 		/// If key already exists, no change is made and the return value is false.
 		/// If the key doesn't exist, the data is added to the map and the return value is true.
 		bool insert(const key_type& k, const value_type& v)
 		{
-			if (m_map.find(k) == m_map.end())
-			{
-				make_space();
-
-				m_list.pushFront(k);
-				m_map[k] = data_container_type(v, m_list.begin());
+			const size_t h = m_hash(k);
 
+			if (!find_node(k, h))
+			{
+				emplace_node(h, k, v);
 				return true;
 			}
 			else
@@ -157,24 +292,24 @@ namespace eastl
 		}
 
 		/// emplace
-		/// 
+		///
 		/// Places a new object in place k created with args
 		/// If the key already exists, no change is made.
 		/// return value is a pair of the iterator to the emplaced or already-existing element and a bool denoting whether insertion took place.
 		template <typename... Args>
 		eastl::pair<iterator, bool> emplace(const key_type& k, Args&&... args)
 		{
-			auto it = m_map.find(k);
-			if (it == m_map.end())
-			{
-				make_space();
+			const size_t h = m_hash(k);
+			node_type* pNode = find_node(k, h);
 
-				m_list.pushFront(k);
-				return m_map.emplace(k, data_container_type(piecewise_construct, eastl::forward_as_tuple(eastl::forward<Args>(args)...), make_tuple(m_list.begin())));
+			if (!pNode)
+			{
+				pNode = emplace_node(h, eastl::piecewise_construct, eastl::forward_as_tuple(k), eastl::forward_as_tuple(eastl::forward<Args>(args)...));
+				return makePair(iterator(pNode), true);
 			}
 			else
 			{
-				return makePair(it, false);
+				return makePair(iterator(pNode), false);
 			}
 		}
 
@@ -184,24 +319,41 @@ namespace eastl
 		/// Note that the deletor for the old v will be called before it's replaced with the new value of v
 		void insert_or_assign(const key_type& k, const value_type& v)
 		{
-			auto iter = m_map.find(k);
+			const size_t h = m_hash(k);
+			node_type* pNode = find_node(k, h);
 
-			if (m_map.find(k) != m_map.end())
+			if (pNode)
 			{
-				assign(iter, v);
+				assign_node(pNode, v);
 			}
 			else
 			{
-				insert(k, v);
+				emplace_node(h, k, v);
 			}
 		}
 
 		/// contains
-		/// 
+		///
 		/// Returns true if key k exists in the cache
 		bool contains(const key_type& k) const
 		{
-			return m_map.find(k) != m_map.end();
+			return find_node(k, m_hash(k)) != nullptr;
+		}
+
+		/// find
+		///
+		/// Returns an iterator to the entry for key k, or end() if there is none.
+		/// Unlike get(), this does not change the age of the entry.
+		iterator find(const key_type& k)
+		{
+			node_type* pNode = find_node(k, m_hash(k));
+			return pNode ? iterator(pNode) : end();
+		}
+
+		const_iterator find(const key_type& k) const
+		{
+			node_type* pNode = find_node(k, m_hash(k));
+			return pNode ? const_iterator(pNode) : end();
 		}
 
 		/// at
@@ -209,11 +361,11 @@ namespace eastl
 		/// Retrives the data for key k, not valid if k does not exist
 		eastl::optional<value_type> at(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			node_type* pNode = find_node(k, m_hash(k));
 
-			if (iter != m_map.end())
+			if (pNode)
 			{
-				return iter->second.first;
+				return pNode->mValue.second;
 			}
 			else
 			{
@@ -227,21 +379,21 @@ namespace eastl
 		/// creator.
 		value_type& get(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			const size_t h = m_hash(k);
+			node_type* pNode = find_node(k, h);
 
 			// The entry exists in the cache
-			if (iter != m_map.end())
+			if (pNode)
 			{
-				touch(k);
-				return iter->second.first;
+				m_policy.onHit(pNode);
+				return pNode->mValue.second;
 			}
 			else // The entry doesn't exist in the cache, so create one
 			{
-				// Add the entry to the map
-				insert(k, m_create_callback ? m_create_callback(k) : value_type());
-
-				// return the new data
-				return m_map[k].first;
+				// Add the entry to the map and return the new data
+				if (m_create_callback)
+					return emplace_node(h, k, m_create_callback(k))->mValue.second;
+				return emplace_node(h, k, value_type())->mValue.second;
 			}
 		}
 
@@ -254,14 +406,12 @@ namespace eastl
 		/// If k does not exist, returns false.  If k exists, returns true.
 		bool erase(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			node_type* pNode = find_node(k, m_hash(k));
 
-			if (iter != m_map.end())
+			if (pNode)
 			{
-				m_list.erase(iter->second.second);
-
 				// Delete the actual entry
-				map_erase(iter);
+				erase_node(pNode);
 
 				return true;
 			}
@@ -269,17 +419,30 @@ namespace eastl
 			return false;
 		}
 
+		/// erase
+		///
+		/// erases the entry at position pos and returns an iterator to the next older entry.
+		iterator erase(const_iterator pos)
+		{
+			iterator next(pos.mpNode);
+
+			++next;
+			erase_node(static_cast<node_type*>(pos.mpNode));
+			return next;
+		}
+
 		/// erase_oldest
 		///
-		/// Removes the oldest entry from the cache.
+		/// Removes the oldest entry from the cache: the one the eviction policy picks next.
 		void erase_oldest()
 		{
-			auto key = m_list.back();
-			m_list.popBack();
+			#if EASTL_ASSERT_ENABLED
+				if (EASTL_UNLIKELY(m_size == 0))
+					EASTL_FAIL_MSG("lru_cache::erase_oldest -- empty cache");
+			#endif
 
 			// Delete the actual entry
-			auto iter = m_map.find(key);
-			map_erase(iter);
+			erase_node(static_cast<node_type*>(m_policy.victim()));
 		}
 
 		/// touch
@@ -288,11 +451,11 @@ namespace eastl
 		/// If k does not exist, returns false.  If the touch was successful, returns true.
 		bool touch(const key_type& k)
 		{
-			auto iter = m_map.find(k);
+			node_type* pNode = find_node(k, m_hash(k));
 
-			if (iter != m_map.end())
+			if (pNode)
 			{
-				touch(iter);
+				m_policy.onHit(pNode);
 				return true;
 			}
 
@@ -304,11 +467,7 @@ namespace eastl
 		/// Touches key at iterator iter, moving it to most recently used position
 		void touch(iterator& iter)
 		{
-			auto listRef = iter->second.second;
-
-			m_list.erase(listRef);
-			m_list.pushFront(iter->first);
-			iter->second.second = m_list.begin();
+			m_policy.onHit(iter.mpNode);
 		}
 
 		/// assign
@@ -318,11 +477,11 @@ namespace eastl
 		/// If key k exists, existing data has its deletor called and key k's data is replaced with new v data
 		bool assign(const key_type& k, const value_type& v)
 		{
-			auto iter = m_map.find(k);
+			node_type* pNode = find_node(k, m_hash(k));
 
-			if (iter != m_map.end())
+			if (pNode)
 			{
-				assign(iter, v);
+				assign_node(pNode, v);
 				return true;
 			}
 
@@ -334,37 +493,40 @@ namespace eastl
 		/// Updates data at spot iter with data v.
 		void assign(iterator& iter, const value_type& v)
 		{
-			if (m_delete_callback)
-				m_delete_callback(iter->second.first);
-			touch(iter);
-			iter->second.first = v;
+			assign_node(static_cast<node_type*>(iter.mpNode), v);
 		}
 
 		// standard container functions
-		iterator begin()               EASTL_NOEXCEPT { return m_map.begin(); }
-		iterator end()                 EASTL_NOEXCEPT { return m_map.end(); }
-		iterator rbegin()              EASTL_NOEXCEPT { return m_map.rbegin(); }
-		iterator rend()                EASTL_NOEXCEPT { return m_map.rend(); }
-		const_iterator begin() const   EASTL_NOEXCEPT { return m_map.begin(); }
-		const_iterator cbegin() const  EASTL_NOEXCEPT { return m_map.cbegin(); }
-		const_iterator crbegin() const EASTL_NOEXCEPT { return m_map.crbegin(); }
-		const_iterator end() const     EASTL_NOEXCEPT { return m_map.end(); }
-		const_iterator cend() const    EASTL_NOEXCEPT { return m_map.cend(); }
-		const_iterator crend() const   EASTL_NOEXCEPT { return m_map.crend(); }
-
-		bool empty() const             EASTL_NOEXCEPT { return m_map.empty(); }
-		size_type size() const         EASTL_NOEXCEPT { return m_map.size(); }
+		iterator begin()                        EASTL_NOEXCEPT { return ++iterator(&m_anchor); }
+		iterator end()                          EASTL_NOEXCEPT { return iterator(&m_anchor); }
+		reverse_iterator rbegin()               EASTL_NOEXCEPT { return reverse_iterator(end()); }
+		reverse_iterator rend()                 EASTL_NOEXCEPT { return reverse_iterator(begin()); }
+		const_iterator begin() const            EASTL_NOEXCEPT { return ++const_iterator(&m_anchor); }
+		const_iterator cbegin() const           EASTL_NOEXCEPT { return ++const_iterator(&m_anchor); }
+		const_reverse_iterator crbegin() const  EASTL_NOEXCEPT { return const_reverse_iterator(cend()); }
+		const_iterator end() const              EASTL_NOEXCEPT { return const_iterator(&m_anchor); }
+		const_iterator cend() const             EASTL_NOEXCEPT { return const_iterator(&m_anchor); }
+		const_reverse_iterator crend() const    EASTL_NOEXCEPT { return const_reverse_iterator(cbegin()); }
+
+		bool empty() const             EASTL_NOEXCEPT { return m_size == 0; }
+		size_type size() const         EASTL_NOEXCEPT { return m_size; }
 		size_type capacity() const     EASTL_NOEXCEPT { return m_capacity; }
 
 		void clear() EASTL_NOEXCEPT
 		{
-			// Since we have a delete callback, we want to reuse the trim function by cheating the max
-			// size to clear all the entries to avoid duplicating code.
-			auto old_max = m_capacity;
+			// Erase in list order rather than asking the policy for victims, which may reorder entries.
+			for (lru_cache_node_base* p = m_anchor.mpPrev; m_size; )
+			{
+				lru_cache_node_base* const pPrev = p->mpPrev;
 
-			m_capacity = 0;
-			trim();
-			m_capacity = old_max;
+				if (p->mnQueue != lru_cache_node_base::kQueueBoundary)
+					erase_node(static_cast<node_type*>(p));
+				p = pPrev;
+			}
+
+			// All nodes are free again, so hand them out in address order from now on.
+			m_free_list = nullptr;
+			m_pool_used = 0;
 		}
 
 		/// resize
@@ -372,34 +534,186 @@ namespace eastl
 		/// Resizes the cache.  Can be used to either expand or contract the cache.
 		/// In the case of a contraction, the oldest entries will be evicted with their respective
 		/// deletors called before completing.
-		void resize(size_type newSize)	
+		/// The remaining entries are moved into a newly allocated block sized for newSize entries.
+		void resize(size_type newSize)
 		{
-			m_capacity = newSize;
-			trim();
+			trim(newSize);
+
+			if (newSize != m_capacity)
+			{
+				rebuild(newSize, m_allocator);
+				m_policy.setCapacity(newSize);
+			}
 		}
-		
+
 		void setCreateCallback(create_callback_type callback) { m_create_callback = callback; }
 		void setDeleteCallback(delete_callback_type callback) { m_delete_callback = callback; }
 
+		const eviction_policy_type& getEvictionPolicy() const EASTL_NOEXCEPT { return m_policy; }
+
 		// EASTL extensions
-		const allocator_type& getAllocator() const EASTL_NOEXCEPT					{ return m_map.getAllocator(); }
-		allocator_type&       getAllocator() EASTL_NOEXCEPT						{ return m_map.getAllocator(); }
-		void                  setAllocator(const allocator_type& allocator)	{ m_map.setAllocator(allocator); m_list.setAllocator(allocator); }
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT					{ return m_allocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT						{ return m_allocator; }
+
+		/// Moves the entries into memory from the given allocator.
+		void                  setAllocator(const allocator_type& allocator)	{ rebuild(m_capacity, allocator); }
 
 		/// Does not reset the callbacks
-		void reset_lose_memory() EASTL_NOEXCEPT									{ m_map.reset_lose_memory(); m_list.reset_lose_memory(); }
+		/// Forgets the entries and the memory block without destroying or freeing them. A new block is
+		/// allocated by the next insertion.
+		void reset_lose_memory() EASTL_NOEXCEPT
+		{
+			reset_anchor();
+			m_policy.attach(&m_anchor, m_capacity);
+			m_buckets = nullptr;
+			m_pool = nullptr;
+			m_free_list = nullptr;
+			m_pool_used = 0;
+			m_size = 0;
+			m_bucket_count = 0;
+			m_bucket_shift = 0;
+		}
+
+		bool validate() const
+		{
+			size_type n = 0;
+
+			for (const lru_cache_node_base* p = m_anchor.mpNext; p != &m_anchor; p = p->mpNext)
+			{
+				if (p->mpNext->mpPrev != p)
+					return false;
+				if (p->mnQueue == lru_cache_node_base::kQueueBoundary)
+					continue;
+
+				const node_type* const pNode = static_cast<const node_type*>(p);
+
+				if (n++ >= m_size)
+					return false;
+				if ((pNode->mnHashCode != m_hash(pNode->mValue.first)) || (find_node(pNode->mValue.first, pNode->mnHashCode) != pNode))
+					return false;
+			}
+
+			if ((n != m_size) || (m_size > m_capacity) || !m_policy.validate())
+				return false;
+
+			for (size_type i = 0; i < m_bucket_count; ++i)
+			{
+				for (const node_type* pNode = m_buckets[i]; pNode; pNode = pNode->mpHashNext)
+				{
+					if ((bucket_index(pNode->mnHashCode) != i) || (n-- == 0))
+						return false;
+				}
+			}
+
+			return n == 0;
+		}
 
 	private:
-		inline void map_erase(map_iterator pos)
+		void reset_anchor() EASTL_NOEXCEPT
+		{
+			m_anchor.mpNext = &m_anchor;
+			m_anchor.mpPrev = &m_anchor;
+			m_anchor.mnHashCode = 0;
+			m_anchor.mnQueue = 0;
+			m_anchor.mnCounter = 0;
+		}
+
+		size_type bucket_index(size_t h) const EASTL_NOEXCEPT
+		{
+			// Fibonacci hashing: scramble the hash code and take its top bits.
+			return static_cast<size_type>((static_cast<uint64_t>(h) * UINT64_C(0x9E3779B97F4A7C15)) >> m_bucket_shift);
+		}
+
+		node_type* find_node(const key_type& k, size_t h) const
+		{
+			if (m_buckets)
+			{
+				for (node_type* pNode = m_buckets[bucket_index(h)]; pNode; pNode = pNode->mpHashNext)
+				{
+					if ((pNode->mnHashCode == h) && m_predicate(k, pNode->mValue.first))
+						return pNode;
+				}
+			}
+
+			return nullptr;
+		}
+
+		void link_bucket(node_type* pNode) EASTL_NOEXCEPT
+		{
+			node_type** const ppBucket = m_buckets + bucket_index(pNode->mnHashCode);
+
+			pNode->mpHashNext = *ppBucket;
+			*ppBucket = pNode;
+		}
+
+		void unlink_bucket(node_type* pNode) EASTL_NOEXCEPT
+		{
+			node_type** ppNode = m_buckets + bucket_index(pNode->mnHashCode);
+
+			while (*ppNode != pNode)
+				ppNode = &(*ppNode)->mpHashNext;
+			*ppNode = pNode->mpHashNext;
+		}
+
+		// Evicts the oldest entry if the cache is full, then constructs a new most recently used entry
+		// from args in a node from the pool.
+		template <typename... Args>
+		node_type* emplace_node(size_t h, Args&&... args)
+		{
+			#if EASTL_ASSERT_ENABLED
+				if (EASTL_UNLIKELY(m_capacity == 0))
+					EASTL_FAIL_MSG("lru_cache::insert -- cache has zero capacity");
+			#endif
+
+			if (EASTL_UNLIKELY(!m_buckets))
+				allocate_pool(); // Only after reset_lose_memory.
+
+			make_space();
+
+			void* const pMemory = m_free_list ? static_cast<void*>(m_free_list) : static_cast<void*>(m_pool + m_pool_used);
+			lru_cache_node_base* const pNextFree = m_free_list ? m_free_list->mpNext : nullptr; // Read before the node overwrites it.
+			node_type* const pNode = ::new(pMemory) node_type(h, eastl::forward<Args>(args)...);
+
+			// The node is only taken from the pool once its construction has succeeded.
+			if (m_free_list)
+				m_free_list = pNextFree;
+			else
+				++m_pool_used;
+
+			link_bucket(pNode);
+			m_policy.onInsert(pNode);
+			++m_size;
+
+			return pNode;
+		}
+
+		void erase_node(node_type* pNode)
+		{
+			if (m_delete_callback)
+				m_delete_callback(pNode->mValue.second);
+
+			unlink_bucket(pNode);
+			m_policy.onErase(pNode);
+			--m_size;
+
+			pNode->~node_type();
+
+			lru_cache_node_base* const pFree = ::new(static_cast<void*>(pNode)) lru_cache_node_base;
+			pFree->mpNext = m_free_list;
+			m_free_list = pFree;
+		}
+
+		void assign_node(node_type* pNode, const value_type& v)
 		{
 			if (m_delete_callback)
-				m_delete_callback(pos->second.first);
-			m_map.erase(pos);
+				m_delete_callback(pNode->mValue.second);
+			m_policy.onHit(pNode);
+			pNode->mValue.second = v;
 		}
-		
-		bool trim()
+
+		bool trim(size_type newCapacity)
 		{
-			if (size() <= m_capacity)
+			if (size() <= newCapacity)
 			{
 				return false; // No trim necessary
 			}
@@ -408,7 +722,7 @@ namespace eastl
 			do
 			{
 				erase_oldest();
-			} while (m_list.size() > m_capacity);
+			} while (size() > newCapacity);
 
 			return true;
 		}
@@ -421,10 +735,106 @@ namespace eastl
 			}
 		}
 
+		static size_type bucket_bytes(size_type bucketCount)
+		{
+			// The nodes follow the buckets in the same block.
+			const size_type alignment = EASTL_ALIGN_OF(node_type);
+			return ((bucketCount * sizeof(node_type*)) + (alignment - 1)) & ~(alignment - 1);
+		}
+
+		static size_type block_alignment()
+		{
+			return EASTL_ALIGN_OF(node_type) > EASTL_ALIGN_OF(node_type*) ? EASTL_ALIGN_OF(node_type) : EASTL_ALIGN_OF(node_type*);
+		}
+
+		// Allocates the buckets and the nodes for m_capacity entries in a single block.
+		void allocate_pool()
+		{
+			if (m_capacity == 0)
+			{
+				m_buckets = nullptr;
+				m_pool = nullptr;
+				m_bucket_count = 0;
+				return;
+			}
+
+			m_bucket_count = 2;
+			m_bucket_shift = 63;
+			while (m_bucket_count < m_capacity)
+			{
+				m_bucket_count *= 2;
+				--m_bucket_shift;
+			}
+
+			const size_type nBucketBytes = bucket_bytes(m_bucket_count);
+			char* const pBlock = static_cast<char*>(allocate_memory(m_allocator, nBucketBytes + (m_capacity * sizeof(node_type)), block_alignment(), 0));
+
+			m_buckets = reinterpret_cast<node_type**>(pBlock);
+			m_pool = reinterpret_cast<node_type*>(pBlock + nBucketBytes);
+			m_free_list = nullptr;
+			m_pool_used = 0;
+
+			for (size_type i = 0; i < m_bucket_count; ++i)
+				m_buckets[i] = nullptr;
+		}
+
+		void free_pool()
+		{
+			if (m_buckets)
+				EASTLFree(m_allocator, m_buckets, bucket_bytes(m_bucket_count) + (m_capacity * sizeof(node_type)));
+		}
+
+		// Moves the entries, which must fit, into a new block for newCapacity entries from allocator.
+		// Each new node takes the place of its old node in the list, so the policy's order and state are kept.
+		void rebuild(size_type newCapacity, const allocator_type& allocator)
+		{
+			allocator_type  oldAllocator(m_allocator);
+			node_type**     pOldBuckets     = m_buckets;
+			size_type       nOldBucketCount = m_bucket_count;
+			size_type       nOldCapacity    = m_capacity;
+
+			m_allocator = allocator;
+			m_capacity = newCapacity;
+			allocate_pool();
+
+			for (lru_cache_node_base* p = m_anchor.mpNext; p != &m_anchor; p = p->mpNext)
+			{
+				if (p->mnQueue == lru_cache_node_base::kQueueBoundary)
+					continue;
+
+				node_type* const pOld = static_cast<node_type*>(p);
+				node_type* const pNode = ::new(static_cast<void*>(m_pool + m_pool_used++)) node_type(pOld->mnHashCode, eastl::move(pOld->mValue));
+
+				pNode->mnQueue   = pOld->mnQueue;
+				pNode->mnCounter = pOld->mnCounter;
+				pNode->mpNext    = pOld->mpNext;
+				pNode->mpPrev    = pOld->mpPrev;
+				pNode->mpPrev->mpNext = pNode;
+				pNode->mpNext->mpPrev = pNode;
+				pOld->~node_type();
+
+				link_bucket(pNode);
+				p = pNode;
+			}
+
+			if (pOldBuckets)
+				EASTLFree(oldAllocator, pOldBuckets, bucket_bytes(nOldBucketCount) + (nOldCapacity * sizeof(node_type)));
+		}
+
 	private:
-		list_type				m_list;
-		map_type				m_map;
+		lru_cache_node_base		m_anchor;        // The start and end of the policy's list; m_anchor.mpPrev is usually evicted next.
+		node_type**				m_buckets;       // The start of the block, followed by the nodes.
+		node_type*				m_pool;
+		lru_cache_node_base*	m_free_list;     // Erased nodes, reused before the untouched part of the pool.
+		size_type				m_pool_used;     // Nodes of m_pool handed out at least once.
+		size_type				m_size;
 		size_type				m_capacity;
+		size_type				m_bucket_count;
+		size_type				m_bucket_shift;
+		hasher					m_hash;
+		key_equal				m_predicate;
+		eviction_policy_type	m_policy;
+		allocator_type			m_allocator;
 		create_callback_type	m_create_callback;
 		delete_callback_type	m_delete_callback;
 	};
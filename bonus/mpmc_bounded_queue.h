@@ -0,0 +1,419 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// mpmc_bounded_queue is a bounded, lock-free FIFO queue which any number of
+// producer and consumer threads may use concurrently. It is an
+// implementation of Dmitry Vyukov's bounded MPMC queue.
+//
+// The queue is a power of two sized ring of slots. Each slot carries an
+// atomic sequence number which tells which lap of the ring it is ready for:
+// a slot at position pos may be written when its sequence is pos and read
+// when its sequence is pos + 1. Producers and consumers each claim positions
+// with a compare-and-swap on a shared counter, after which they own the slot
+// outright; there is no global lock, and producers never contend with
+// consumers except on the slot they hand over. The two counters live on
+// separate cache lines.
+//
+// pushN and popN claim a run of consecutive positions with a single
+// compare-and-swap, which reduces contention on the counters when many
+// threads move elements in batches.
+//
+// The constructor of T must not throw once a slot has been claimed; if it
+// does, the slot is never published and the queue stalls at that position.
+//
+// Example usage:
+//     mpmc_bounded_queue<Job*> queue(4096);
+//
+//     // any producer thread          // any consumer thread
+//     queue.tryPush(pJob);            Job* pJob;
+//                                     if(queue.tryPop(pJob))
+//                                         pJob->Run();
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_MPMC_BOUNDED_QUEUE_H
+#define EASTL_MPMC_BOUNDED_QUEUE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/atomic.h>
+#include <eastl/memory.h>
+#include <eastl/type_traits.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+	/// EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME
+		#define EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " mpmc_bounded_queue" // Unless the user overrides something, this is "EASTL mpmc_bounded_queue".
+	#endif
+
+	/// EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR
+		#define EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR allocator_type(EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_NAME)
+	#endif
+
+
+	/// mpmc_bounded_queue
+	///
+	/// All member functions except the constructor and destructor may be
+	/// called concurrently from any number of threads.
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class mpmc_bounded_queue
+	{
+	public:
+		typedef mpmc_bounded_queue<T, Allocator> this_type;
+		typedef T                                value_type;
+		typedef T&                               reference;
+		typedef const T&                         const_reference;
+		typedef eastl_size_t                     size_type;
+		typedef Allocator                        allocator_type;
+
+	public:
+		explicit mpmc_bounded_queue(size_type nCapacity, const allocator_type& allocator = EASTL_MPMC_BOUNDED_QUEUE_DEFAULT_ALLOCATOR);
+		~mpmc_bounded_queue();
+
+		mpmc_bounded_queue(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		bool tryPush(const value_type& value);
+		bool tryPush(value_type&& value);
+
+		template <typename... Args>
+		bool tryEmplace(Args&&... args);
+
+		template <typename ForwardIterator>
+		size_type pushN(ForwardIterator first, size_type n); // Pushes up to n elements, returns the number pushed.
+
+		bool tryPop(value_type& value);
+
+		template <typename OutputIterator>
+		size_type popN(OutputIterator dest, size_type n);    // Pops up to n elements into dest, returns the number popped.
+
+		// The result may be stale by the time it is returned.
+		size_type size() const EASTL_NOEXCEPT;
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type capacity() const EASTL_NOEXCEPT;           // The capacity passed to the constructor, rounded up to a power of two.
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+		allocator_type&       getAllocator() EASTL_NOEXCEPT;
+
+		bool validate() const;
+
+	protected:
+		struct Slot
+		{
+			eastl::atomic<size_type>                               mSequence;
+			typename aligned_storage<sizeof(T), alignof(T)>::type mStorage;
+
+			T* GetValue() { return reinterpret_cast<T*>(&mStorage); }
+		};
+
+		static size_type DoGetSlotCount(size_type nCapacity);
+
+		size_type DoClaimPush(size_type& nPos, size_type n);
+		size_type DoClaimPop(size_type& nPos, size_type n);
+
+	protected:
+		// Shared, read-only after construction.
+		Slot*          mpSlots;
+		size_type      mnMask;
+		allocator_type mAllocator;
+
+		alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) eastl::atomic<size_type> mnEnqueuePos;
+		alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) eastl::atomic<size_type> mnDequeuePos;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// mpmc_bounded_queue
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Allocator>
+	inline mpmc_bounded_queue<T, Allocator>::mpmc_bounded_queue(size_type nCapacity, const allocator_type& allocator)
+		: mpSlots(NULL)
+		, mnMask(DoGetSlotCount(nCapacity) - 1)
+		, mAllocator(allocator)
+		, mnEnqueuePos(0)
+		, mnDequeuePos(0)
+	{
+		mpSlots = (Slot*)allocate_memory(mAllocator, (mnMask + 1) * sizeof(Slot), alignof(Slot), 0);
+
+		for(size_type i = 0; i <= mnMask; ++i)
+			::new((void*)&mpSlots[i].mSequence) eastl::atomic<size_type>(i);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline mpmc_bounded_queue<T, Allocator>::~mpmc_bounded_queue()
+	{
+		// There can be no concurrent users at this point, so every claimed position has been published.
+		const size_type nEnd = mnEnqueuePos.load(eastl::memory_order_acquire);
+
+		for(size_type nPos = mnDequeuePos.load(eastl::memory_order_acquire); nPos != nEnd; ++nPos)
+			mpSlots[nPos & mnMask].GetValue()->~value_type();
+
+		for(size_type i = 0; i <= mnMask; ++i)
+			mpSlots[i].mSequence.~atomic();
+
+		EASTLFree(mAllocator, mpSlots, (mnMask + 1) * sizeof(Slot));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::DoGetSlotCount(size_type nCapacity)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY((nCapacity == 0) || (nCapacity > ((size_type)1 << (sizeof(size_type) * 8 - 2)))))
+				EASTL_FAIL_MSG("mpmc_bounded_queue -- invalid capacity");
+		#endif
+
+		size_type nSlotCount = 2; // The algorithm needs at least two slots to tell a full ring from an empty one.
+
+		while(nSlotCount < nCapacity)
+			nSlotCount *= 2;
+
+		return nSlotCount;
+	}
+
+
+	// Claims up to n consecutive positions for writing, starting at the current
+	// enqueue position, which is returned in nPos. Returns the number claimed,
+	// which is zero only if the queue is full.
+	template <typename T, typename Allocator>
+	typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::DoClaimPush(size_type& nPos, size_type n)
+	{
+		nPos = mnEnqueuePos.load(eastl::memory_order_relaxed);
+
+		for(;;)
+		{
+			size_type k = 0;
+			eastl_ssize_t nDiff = 0;
+
+			// A slot is writable for position p when its sequence equals p. Stop at the first one which isn't.
+			for(; k < n; ++k)
+			{
+				const size_type nSequence = mpSlots[(nPos + k) & mnMask].mSequence.load(eastl::memory_order_acquire);
+
+				if((nDiff = (eastl_ssize_t)(nSequence - (nPos + k))) != 0)
+					break;
+			}
+
+			if(k)
+			{
+				if(mnEnqueuePos.compare_exchange_weak(nPos, nPos + k, eastl::memory_order_relaxed))
+					return k;
+				// Else nPos has been updated to the current enqueue position; try again.
+			}
+			else if(nDiff < 0) // The slot still holds an element from the previous lap.
+				return 0;
+			else               // Another producer claimed nPos before us.
+				nPos = mnEnqueuePos.load(eastl::memory_order_relaxed);
+		}
+	}
+
+
+	template <typename T, typename Allocator>
+	typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::DoClaimPop(size_type& nPos, size_type n)
+	{
+		nPos = mnDequeuePos.load(eastl::memory_order_relaxed);
+
+		for(;;)
+		{
+			size_type k = 0;
+			eastl_ssize_t nDiff = 0;
+
+			// A slot is readable for position p when its sequence equals p + 1.
+			for(; k < n; ++k)
+			{
+				const size_type nSequence = mpSlots[(nPos + k) & mnMask].mSequence.load(eastl::memory_order_acquire);
+
+				if((nDiff = (eastl_ssize_t)(nSequence - (nPos + k + 1))) != 0)
+					break;
+			}
+
+			if(k)
+			{
+				if(mnDequeuePos.compare_exchange_weak(nPos, nPos + k, eastl::memory_order_relaxed))
+					return k;
+			}
+			else if(nDiff < 0) // The slot hasn't been written for this lap yet.
+				return 0;
+			else
+				nPos = mnDequeuePos.load(eastl::memory_order_relaxed);
+		}
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::tryPush(const value_type& value)
+	{
+		return tryEmplace(value);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::tryPush(value_type&& value)
+	{
+		return tryEmplace(eastl::move(value));
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename... Args>
+	inline bool mpmc_bounded_queue<T, Allocator>::tryEmplace(Args&&... args)
+	{
+		size_type nPos = 0;
+
+		if(DoClaimPush(nPos, 1) == 0)
+			return false;
+
+		Slot& slot = mpSlots[nPos & mnMask];
+		::new((void*)slot.GetValue()) value_type(eastl::forward<Args>(args)...);
+		slot.mSequence.store(nPos + 1, eastl::memory_order_release);
+		return true;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename ForwardIterator>
+	typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::pushN(ForwardIterator first, size_type n)
+	{
+		size_type nPos = 0;
+
+		if(n)
+			n = DoClaimPush(nPos, n);
+
+		for(size_type i = 0; i < n; ++i, ++first)
+		{
+			Slot& slot = mpSlots[(nPos + i) & mnMask];
+			::new((void*)slot.GetValue()) value_type(*first);
+			slot.mSequence.store(nPos + i + 1, eastl::memory_order_release);
+		}
+
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::tryPop(value_type& value)
+	{
+		size_type nPos = 0;
+
+		if(DoClaimPop(nPos, 1) == 0)
+			return false;
+
+		Slot& slot = mpSlots[nPos & mnMask];
+		value = eastl::move(*slot.GetValue());
+		slot.GetValue()->~value_type();
+		slot.mSequence.store(nPos + mnMask + 1, eastl::memory_order_release); // Make it writable for the next lap.
+		return true;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename OutputIterator>
+	typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::popN(OutputIterator dest, size_type n)
+	{
+		size_type nPos = 0;
+
+		if(n)
+			n = DoClaimPop(nPos, n);
+
+		for(size_type i = 0; i < n; ++i, ++dest)
+		{
+			Slot& slot = mpSlots[(nPos + i) & mnMask];
+			*dest = eastl::move(*slot.GetValue());
+			slot.GetValue()->~value_type();
+			slot.mSequence.store(nPos + i + mnMask + 1, eastl::memory_order_release);
+		}
+
+		return n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::size() const EASTL_NOEXCEPT
+	{
+		const size_type nDequeuePos = mnDequeuePos.load(eastl::memory_order_acquire);
+		const size_type nEnqueuePos = mnEnqueuePos.load(eastl::memory_order_acquire);
+		const eastl_ssize_t nSize   = (eastl_ssize_t)(nEnqueuePos - nDequeuePos);
+
+		// Claimed but unpublished positions are counted, so we can briefly overshoot.
+		if(nSize < 0)
+			return 0;
+		return ((size_type)nSize > capacity()) ? capacity() : (size_type)nSize;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::empty() const EASTL_NOEXCEPT
+	{
+		return size() == 0;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::size_type
+	mpmc_bounded_queue<T, Allocator>::capacity() const EASTL_NOEXCEPT
+	{
+		return mnMask + 1;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline const typename mpmc_bounded_queue<T, Allocator>::allocator_type&
+	mpmc_bounded_queue<T, Allocator>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename mpmc_bounded_queue<T, Allocator>::allocator_type&
+	mpmc_bounded_queue<T, Allocator>::getAllocator() EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool mpmc_bounded_queue<T, Allocator>::validate() const
+	{
+		if((mnMask & (mnMask + 1)) != 0) // The slot count must be a power of two.
+			return false;
+
+		const size_type nDequeuePos = mnDequeuePos.load(eastl::memory_order_acquire);
+		const size_type nEnqueuePos = mnEnqueuePos.load(eastl::memory_order_acquire);
+
+		// Only meaningful while the queue is quiescent.
+		return (nEnqueuePos - nDequeuePos) <= capacity();
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,552 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// spsc_ring_buffer is a bounded, lock-free FIFO queue which can be used to
+// hand elements from exactly one producer thread to exactly one consumer
+// thread. Unlike ring_buffer it is safe to use concurrently from those two
+// threads without any external locking.
+//
+// The producer owns the tail index and the consumer owns the head index.
+// Each index is published with a release store and read by the other side
+// with an acquire load. The two indices live on separate cache lines, and
+// each side keeps a private cached copy of the other side's index, so that
+// in the common case a push or pop touches no cache line owned by the
+// other thread. pushN and popN move a whole batch of elements for the cost
+// of a single index update.
+//
+// The indices are free-running counters; the slot of an index is found by
+// masking it with the (power of two) slot count. The usable capacity is
+// exactly what was requested.
+//
+// Example usage:
+//     spsc_ring_buffer<Job, 1024> queue;
+//
+//     // producer thread              // consumer thread
+//     while(!queue.tryPush(job))      Job job;
+//         Yield();                    while(queue.tryPop(job))
+//                                         job.Run();
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SPSC_RING_BUFFER_H
+#define EASTL_SPSC_RING_BUFFER_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/algorithm.h>
+#include <eastl/allocator.h>
+#include <eastl/atomic.h>
+#include <eastl/memory.h>
+#include <eastl/type_traits.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+	/// EASTL_SPSC_RING_BUFFER_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_SPSC_RING_BUFFER_DEFAULT_NAME
+		#define EASTL_SPSC_RING_BUFFER_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " spsc_ring_buffer" // Unless the user overrides something, this is "EASTL spsc_ring_buffer".
+	#endif
+
+	/// EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR
+		#define EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR allocator_type(EASTL_SPSC_RING_BUFFER_DEFAULT_NAME)
+	#endif
+
+
+	namespace internal
+	{
+		// Returns the smallest power of two which is >= n.
+		EA_CONSTEXPR inline eastl_size_t spsc_ring_buffer_slot_count(eastl_size_t n, eastl_size_t nSlotCount = 1)
+		{
+			return (nSlotCount >= n) ? nSlotCount : spsc_ring_buffer_slot_count(n, nSlotCount * 2);
+		}
+
+
+		/// spsc_ring_buffer_base
+		///
+		/// Implements the queue on top of storage provided by the derived class.
+		/// The derived class is responsible for calling DoClear before it
+		/// releases the storage.
+		///
+		/// Functions are documented with the thread which may call them. The
+		/// producer functions must only ever be called by one thread at a time,
+		/// and likewise for the consumer functions.
+		///
+		template <typename T>
+		class spsc_ring_buffer_base
+		{
+		public:
+			typedef spsc_ring_buffer_base<T>  this_type;
+			typedef T                         value_type;
+			typedef T*                        pointer;
+			typedef const T*                  const_pointer;
+			typedef T&                        reference;
+			typedef const T&                  const_reference;
+			typedef eastl_size_t              size_type;
+
+		public:
+			// Producer
+			bool tryPush(const value_type& value);
+			bool tryPush(value_type&& value);
+
+			template <typename... Args>
+			bool tryEmplace(Args&&... args);
+
+			template <typename ForwardIterator>
+			size_type pushN(ForwardIterator first, size_type n); // Pushes up to n elements, returns the number pushed.
+
+			// Consumer
+			bool      tryPop(value_type& value);
+			pointer   front();                                 // Returns NULL if the queue is empty.
+			void      pop();                                   // The queue must not be empty.
+
+			template <typename OutputIterator>
+			size_type popN(OutputIterator dest, size_type n);  // Pops up to n elements into dest, returns the number popped.
+
+			// Either thread. The result may be stale by the time it is returned,
+			// but it is exact when called from the producer or the consumer while
+			// the other side is idle.
+			size_type size() const EASTL_NOEXCEPT;
+			bool      empty() const EASTL_NOEXCEPT;
+			size_type capacity() const EASTL_NOEXCEPT;
+
+			bool validate() const;
+
+		protected:
+			spsc_ring_buffer_base(pointer pBuffer, size_type nCapacity, size_type nMask);
+
+			spsc_ring_buffer_base(const this_type&) = delete;
+			this_type& operator=(const this_type&) = delete;
+
+			void      DoClear();
+			pointer   DoSlot(size_type nIndex) const { return mpBuffer + (nIndex & mnMask); }
+			size_type DoWritable(size_type nTail, size_type n);
+			size_type DoReadable(size_type nHead, size_type n);
+
+		protected:
+			// Shared, read-only after construction.
+			pointer   mpBuffer;
+			size_type mnCapacity;
+			size_type mnMask;
+
+			// Written by the producer.
+			alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) eastl::atomic<size_type> mnTail;
+			size_type mnCachedHead;
+
+			// Written by the consumer.
+			alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) eastl::atomic<size_type> mnHead;
+			size_type mnCachedTail;
+		};
+
+	} // namespace internal
+
+
+
+	/// spsc_ring_buffer
+	///
+	/// A lock-free single producer, single consumer queue with a fixed
+	/// capacity of N elements, stored inline.
+	///
+	template <typename T, size_t N>
+	class spsc_ring_buffer : public internal::spsc_ring_buffer_base<T>
+	{
+		typedef internal::spsc_ring_buffer_base<T> base_type;
+
+	public:
+		typedef spsc_ring_buffer<T, N>           this_type;
+		typedef typename base_type::value_type   value_type;
+		typedef typename base_type::size_type    size_type;
+
+		static_assert(N > 0, "spsc_ring_buffer must have a capacity of at least one element.");
+
+		static const size_type kSlotCount = internal::spsc_ring_buffer_slot_count((size_type)N);
+
+	public:
+		spsc_ring_buffer();
+		~spsc_ring_buffer();
+
+	protected:
+		typename aligned_storage<sizeof(T), alignof(T)>::type mBuffer[kSlotCount];
+	};
+
+
+
+	/// dynamic_spsc_ring_buffer
+	///
+	/// A lock-free single producer, single consumer queue whose capacity is
+	/// chosen at construction time and whose storage comes from an allocator.
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class dynamic_spsc_ring_buffer : public internal::spsc_ring_buffer_base<T>
+	{
+		typedef internal::spsc_ring_buffer_base<T> base_type;
+
+	public:
+		typedef dynamic_spsc_ring_buffer<T, Allocator> this_type;
+		typedef typename base_type::value_type         value_type;
+		typedef typename base_type::size_type          size_type;
+		typedef Allocator                              allocator_type;
+
+	public:
+		explicit dynamic_spsc_ring_buffer(size_type nCapacity, const allocator_type& allocator = EASTL_SPSC_RING_BUFFER_DEFAULT_ALLOCATOR);
+		~dynamic_spsc_ring_buffer();
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+		allocator_type&       getAllocator() EASTL_NOEXCEPT;
+
+	protected:
+		static size_type DoGetSlotCount(size_type nCapacity);
+		static T*        DoAllocate(allocator_type& allocator, size_type nSlotCount);
+
+	protected:
+		allocator_type mAllocator;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// spsc_ring_buffer_base
+	///////////////////////////////////////////////////////////////////////
+
+	namespace internal
+	{
+		template <typename T>
+		inline spsc_ring_buffer_base<T>::spsc_ring_buffer_base(pointer pBuffer, size_type nCapacity, size_type nMask)
+			: mpBuffer(pBuffer)
+			, mnCapacity(nCapacity)
+			, mnMask(nMask)
+			, mnTail(0)
+			, mnCachedHead(0)
+			, mnHead(0)
+			, mnCachedTail(0)
+		{
+		}
+
+
+		template <typename T>
+		inline void spsc_ring_buffer_base<T>::DoClear()
+		{
+			const size_type nTail = mnTail.load(eastl::memory_order_acquire);
+
+			for(size_type nHead = mnHead.load(eastl::memory_order_relaxed); nHead != nTail; ++nHead)
+				DoSlot(nHead)->~value_type();
+
+			mnHead.store(nTail, eastl::memory_order_release);
+			mnCachedTail = nTail;
+		}
+
+
+		// Returns how many of n elements can be written at nTail, refreshing
+		// our view of the consumer's head only if the cached one says we are short.
+		template <typename T>
+		inline typename spsc_ring_buffer_base<T>::size_type
+		spsc_ring_buffer_base<T>::DoWritable(size_type nTail, size_type n)
+		{
+			size_type nFree = mnCapacity - (nTail - mnCachedHead);
+
+			if(nFree < n)
+			{
+				mnCachedHead = mnHead.load(eastl::memory_order_acquire);
+				nFree = mnCapacity - (nTail - mnCachedHead);
+			}
+
+			return (nFree < n) ? nFree : n;
+		}
+
+
+		template <typename T>
+		inline typename spsc_ring_buffer_base<T>::size_type
+		spsc_ring_buffer_base<T>::DoReadable(size_type nHead, size_type n)
+		{
+			size_type nUsed = mnCachedTail - nHead;
+
+			if(nUsed < n)
+			{
+				mnCachedTail = mnTail.load(eastl::memory_order_acquire);
+				nUsed = mnCachedTail - nHead;
+			}
+
+			return (nUsed < n) ? nUsed : n;
+		}
+
+
+		template <typename T>
+		inline bool spsc_ring_buffer_base<T>::tryPush(const value_type& value)
+		{
+			return tryEmplace(value);
+		}
+
+
+		template <typename T>
+		inline bool spsc_ring_buffer_base<T>::tryPush(value_type&& value)
+		{
+			return tryEmplace(eastl::move(value));
+		}
+
+
+		template <typename T>
+		template <typename... Args>
+		inline bool spsc_ring_buffer_base<T>::tryEmplace(Args&&... args)
+		{
+			const size_type nTail = mnTail.load(eastl::memory_order_relaxed);
+
+			if(DoWritable(nTail, 1) == 0)
+				return false;
+
+			::new((void*)DoSlot(nTail)) value_type(eastl::forward<Args>(args)...);
+			mnTail.store(nTail + 1, eastl::memory_order_release);
+			return true;
+		}
+
+
+		template <typename T>
+		template <typename ForwardIterator>
+		typename spsc_ring_buffer_base<T>::size_type
+		spsc_ring_buffer_base<T>::pushN(ForwardIterator first, size_type n)
+		{
+			const size_type nTail = mnTail.load(eastl::memory_order_relaxed);
+
+			n = DoWritable(nTail, n);
+
+			if(n)
+			{
+				// The free space wraps around the end of the buffer at most once, so we
+				// copy it as (up to) two contiguous runs.
+				pointer const   pSlot  = DoSlot(nTail);
+				const size_type nFirst = eastl::minAlt(n, (size_type)(mnMask + 1 - (nTail & mnMask)));
+
+				const ForwardIterator mid(eastl::next(first, (ptrdiff_t)nFirst));
+
+				eastl::uninitializedCopy(first, mid, pSlot);
+
+				if(nFirst < n)
+				{
+					#if EASTL_EXCEPTIONS_ENABLED
+						try
+						{
+					#endif
+							eastl::uninitializedCopy(mid, eastl::next(mid, (ptrdiff_t)(n - nFirst)), mpBuffer);
+					#if EASTL_EXCEPTIONS_ENABLED
+						}
+						catch(...)
+						{
+							eastl::destruct(pSlot, pSlot + nFirst);
+							throw;
+						}
+					#endif
+				}
+
+				mnTail.store(nTail + n, eastl::memory_order_release);
+			}
+
+			return n;
+		}
+
+
+		template <typename T>
+		inline bool spsc_ring_buffer_base<T>::tryPop(value_type& value)
+		{
+			const size_type nHead = mnHead.load(eastl::memory_order_relaxed);
+
+			if(DoReadable(nHead, 1) == 0)
+				return false;
+
+			pointer const pSlot = DoSlot(nHead);
+			value = eastl::move(*pSlot);
+			pSlot->~value_type();
+			mnHead.store(nHead + 1, eastl::memory_order_release);
+			return true;
+		}
+
+
+		template <typename T>
+		inline typename spsc_ring_buffer_base<T>::pointer
+		spsc_ring_buffer_base<T>::front()
+		{
+			const size_type nHead = mnHead.load(eastl::memory_order_relaxed);
+
+			return DoReadable(nHead, 1) ? DoSlot(nHead) : NULL;
+		}
+
+
+		template <typename T>
+		inline void spsc_ring_buffer_base<T>::pop()
+		{
+			const size_type nHead = mnHead.load(eastl::memory_order_relaxed);
+
+			#if EASTL_ASSERT_ENABLED
+				if(EASTL_UNLIKELY(DoReadable(nHead, 1) == 0))
+					EASTL_FAIL_MSG("spsc_ring_buffer::pop -- empty container");
+			#endif
+
+			DoSlot(nHead)->~value_type();
+			mnHead.store(nHead + 1, eastl::memory_order_release);
+		}
+
+
+		template <typename T>
+		template <typename OutputIterator>
+		typename spsc_ring_buffer_base<T>::size_type
+		spsc_ring_buffer_base<T>::popN(OutputIterator dest, size_type n)
+		{
+			const size_type nHead = mnHead.load(eastl::memory_order_relaxed);
+
+			n = DoReadable(nHead, n);
+
+			if(n)
+			{
+				pointer const   pSlot  = DoSlot(nHead);
+				const size_type nFirst = eastl::minAlt(n, (size_type)(mnMask + 1 - (nHead & mnMask)));
+
+				dest = eastl::move(pSlot, pSlot + nFirst, dest);
+				eastl::destruct(pSlot, pSlot + nFirst);
+
+				if(nFirst < n)
+				{
+					eastl::move(mpBuffer, mpBuffer + (n - nFirst), dest);
+					eastl::destruct(mpBuffer, mpBuffer + (n - nFirst));
+				}
+
+				mnHead.store(nHead + n, eastl::memory_order_release);
+			}
+
+			return n;
+		}
+
+
+		template <typename T>
+		inline typename spsc_ring_buffer_base<T>::size_type
+		spsc_ring_buffer_base<T>::size() const EASTL_NOEXCEPT
+		{
+			// Load head first; the tail can only move forward after that, so the difference can't underflow.
+			const size_type nHead = mnHead.load(eastl::memory_order_acquire);
+			const size_type nTail = mnTail.load(eastl::memory_order_acquire);
+
+			return nTail - nHead;
+		}
+
+
+		template <typename T>
+		inline bool spsc_ring_buffer_base<T>::empty() const EASTL_NOEXCEPT
+		{
+			return size() == 0;
+		}
+
+
+		template <typename T>
+		inline typename spsc_ring_buffer_base<T>::size_type
+		spsc_ring_buffer_base<T>::capacity() const EASTL_NOEXCEPT
+		{
+			return mnCapacity;
+		}
+
+
+		template <typename T>
+		inline bool spsc_ring_buffer_base<T>::validate() const
+		{
+			if(mnCapacity > (mnMask + 1))
+				return false;
+			if((mnMask & (mnMask + 1)) != 0) // The slot count must be a power of two.
+				return false;
+			if(size() > mnCapacity)
+				return false;
+			return true;
+		}
+
+	} // namespace internal
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// spsc_ring_buffer
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t N>
+	inline spsc_ring_buffer<T, N>::spsc_ring_buffer()
+		: base_type(reinterpret_cast<T*>(mBuffer), (size_type)N, kSlotCount - 1)
+	{
+	}
+
+
+	template <typename T, size_t N>
+	inline spsc_ring_buffer<T, N>::~spsc_ring_buffer()
+	{
+		base_type::DoClear();
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// dynamic_spsc_ring_buffer
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Allocator>
+	inline dynamic_spsc_ring_buffer<T, Allocator>::dynamic_spsc_ring_buffer(size_type nCapacity, const allocator_type& allocator)
+		: base_type(NULL, nCapacity, DoGetSlotCount(nCapacity) - 1)
+		, mAllocator(allocator)
+	{
+		base_type::mpBuffer = DoAllocate(mAllocator, base_type::mnMask + 1);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline dynamic_spsc_ring_buffer<T, Allocator>::~dynamic_spsc_ring_buffer()
+	{
+		base_type::DoClear();
+		EASTLFree(mAllocator, base_type::mpBuffer, (base_type::mnMask + 1) * sizeof(T));
+	}
+
+
+	template <typename T, typename Allocator>
+	inline const typename dynamic_spsc_ring_buffer<T, Allocator>::allocator_type&
+	dynamic_spsc_ring_buffer<T, Allocator>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename dynamic_spsc_ring_buffer<T, Allocator>::allocator_type&
+	dynamic_spsc_ring_buffer<T, Allocator>::getAllocator() EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename dynamic_spsc_ring_buffer<T, Allocator>::size_type
+	dynamic_spsc_ring_buffer<T, Allocator>::DoGetSlotCount(size_type nCapacity)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY((nCapacity == 0) || (nCapacity > ((size_type)1 << (sizeof(size_type) * 8 - 2)))))
+				EASTL_FAIL_MSG("dynamic_spsc_ring_buffer -- invalid capacity");
+		#endif
+
+		return internal::spsc_ring_buffer_slot_count(nCapacity);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline T* dynamic_spsc_ring_buffer<T, Allocator>::DoAllocate(allocator_type& allocator, size_type nSlotCount)
+	{
+		return (T*)allocate_memory(allocator, nSlotCount * sizeof(T), alignof(T), 0);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -59,6 +59,31 @@ namespace eastl
 	#define EASTL_TUPLE_VECTOR_DEFAULT_ALLOCATOR allocator_type(EASTL_TUPLE_VECTOR_DEFAULT_NAME)
 	#endif
 
+
+	/// EASTL_TUPLE_VECTOR_COLUMN_ALIGNMENT
+	///
+	/// The minimum alignment of every tuple_vector column. Set it to the SIMD register or cache
+	/// line size to align all columns; see tuplevec_column_alignment to align only some of them.
+	///
+	#ifndef EASTL_TUPLE_VECTOR_COLUMN_ALIGNMENT
+	#define EASTL_TUPLE_VECTOR_COLUMN_ALIGNMENT 1
+	#endif
+
+
+	/// tuplevec_column_alignment
+	///
+	/// The alignment of the tuple_vector columns which hold values of type T. Specialize it to give
+	/// the columns of a type a SIMD or cache line alignment, e.g.:
+	///     template <> struct tuplevec_column_alignment<ParticleX> : integral_constant<size_t, 32> {};
+	///
+	/// Besides aligning the start of a column, this pads its end: the capacity is kept a multiple of
+	/// the number of elements per alignment unit, so that loops over paddedSize() elements need no
+	/// scalar tail. The alignment must be a power of two.
+	///
+	template <typename T>
+	struct tuplevec_column_alignment
+		: public integral_constant<size_t, ((size_t)EASTL_TUPLE_VECTOR_COLUMN_ALIGNMENT > alignof(T)) ? (size_t)EASTL_TUPLE_VECTOR_COLUMN_ALIGNMENT : alignof(T)> {};
+
 namespace TupleVecInternal
 {
 
@@ -158,6 +183,11 @@ struct TupleRecurser<>
 		return 0;
 	}
 
+	static EA_CONSTEXPR size_type GetCapacityGranularity()
+	{
+		return 1;
+	}
+
 	static EA_CONSTEXPR size_type GetTotalAllocationSize(size_type capacity, size_type offset)
 	{
 		EA_UNUSED(capacity);
@@ -199,9 +229,21 @@ struct TupleRecurser<T, Ts...> : TupleRecurser<Ts...>
 {
 	typedef eastl_size_t size_type;
 	
+	static_assert((tuplevec_column_alignment<T>::value & (tuplevec_column_alignment<T>::value - 1)) == 0 && tuplevec_column_alignment<T>::value >= alignof(T),
+				  "tuplevec_column_alignment must be a power of two no less than alignof(T)");
+
 	static EA_CONSTEXPR size_type GetTotalAlignment()
 	{
-		return max(static_cast<size_type>(alignof(T)), TupleRecurser<Ts...>::GetTotalAlignment());
+		return max(static_cast<size_type>(tuplevec_column_alignment<T>::value), TupleRecurser<Ts...>::GetTotalAlignment());
+	}
+
+	// The capacity must be a multiple of this for every column to end on an alignment boundary,
+	// which is the number of elements of the column that fill one alignment unit. (The lowest set
+	// bit of sizeof(T) is the largest power of two that divides it.)
+	static EA_CONSTEXPR size_type GetCapacityGranularity()
+	{
+		return max(static_cast<size_type>(tuplevec_column_alignment<T>::value / min(static_cast<size_type>(tuplevec_column_alignment<T>::value), static_cast<size_type>(sizeof(T) & (~sizeof(T) + 1)))),
+				   TupleRecurser<Ts...>::GetCapacityGranularity());
 	}
 
 	static EA_CONSTEXPR size_type GetTotalAllocationSize(size_type capacity, size_type offset)
@@ -235,7 +277,7 @@ private:
 		return CalculatAllocationOffset(offset) + sizeof(T) * capacity;
 	}
 
-	static EA_CONSTEXPR size_type CalculatAllocationOffset(size_type offset) { return (offset + alignof(T) - 1) & (~alignof(T) + 1); }
+	static EA_CONSTEXPR size_type CalculatAllocationOffset(size_type offset) { return (offset + tuplevec_column_alignment<T>::value - 1) & (~tuplevec_column_alignment<T>::value + 1); }
 };
 
 template <eastl_size_t I, typename T>
@@ -728,7 +770,7 @@ public:
 		{
 			if (newNumElements > oldNumCapacity)
 			{
-				const size_type newCapacity = eastl::max(GetNewCapacity(oldNumCapacity), newNumElements);
+				const size_type newCapacity = DoRoundCapacity(eastl::max(GetNewCapacity(oldNumCapacity), newNumElements));
 
 				void* ppNewLeaf[sizeof...(Ts)];
 				pair<void*, size_type> allocation =	TupleRecurser<Ts...>::template DoAllocate<allocator_type, 0, index_sequence_type, Ts...>(
@@ -774,7 +816,7 @@ public:
 		{
 			if (newNumElements > oldNumCapacity)
 			{
-				const size_type newCapacity = eastl::max(GetNewCapacity(oldNumCapacity), newNumElements);
+				const size_type newCapacity = DoRoundCapacity(eastl::max(GetNewCapacity(oldNumCapacity), newNumElements));
 
 				void* ppNewLeaf[sizeof...(Ts)];
 				pair<void*, size_type> allocation = TupleRecurser<Ts...>::template DoAllocate<allocator_type, 0, index_sequence_type, Ts...>(
@@ -826,7 +868,7 @@ public:
 		{
 			if (newNumElements > oldNumCapacity)
 			{
-				const size_type newCapacity = eastl::max(GetNewCapacity(oldNumCapacity), newNumElements);
+				const size_type newCapacity = DoRoundCapacity(eastl::max(GetNewCapacity(oldNumCapacity), newNumElements));
 
 				void* ppNewLeaf[sizeof...(Ts)];
 				pair<void*, size_type> allocation = TupleRecurser<Ts...>::template DoAllocate<allocator_type, 0, index_sequence_type, Ts...>(
@@ -880,7 +922,7 @@ public:
 		{
 			if (newNumElements > oldNumCapacity)
 			{
-				const size_type newCapacity = eastl::max(GetNewCapacity(oldNumCapacity), newNumElements);
+				const size_type newCapacity = DoRoundCapacity(eastl::max(GetNewCapacity(oldNumCapacity), newNumElements));
 
 				void* ppNewLeaf[sizeof...(Ts)];
 				pair<void*, size_type> allocation = TupleRecurser<Ts...>::template DoAllocate<allocator_type, 0, index_sequence_type, Ts...>(
@@ -1199,6 +1241,85 @@ public:
 		return TupleVecLeaf<Index::index, T>::mpData;
 	}
 
+	// size() rounded up to the capacity granularity of the columns (see tuplevec_column_alignment),
+	// so that a loop over paddedSize() elements of each column covers whole SIMD registers. The
+	// elements past size() are allocated but not constructed: a loop may compute on them, as long
+	// as it ignores the results. fixed_tuple_vector only guarantees this padding if its node count
+	// is itself a multiple of the granularity.
+	size_type paddedSize() const EASTL_NOEXCEPT
+	{
+		return eastl::min(DoRoundCapacity(mNumElements), mNumCapacity);
+	}
+
+	// Replaces each element x of column I with f(x). The loop is over a plain array, which the
+	// compiler can vectorize.
+	template <size_type I, typename Function>
+	void transformColumn(Function f)
+	{
+		typedef tuplevec_element_t<I, Ts...> Element;
+		Element* EASTL_RESTRICT pData = TupleVecLeaf<I, Element>::mpData;
+
+		for (size_type i = 0, n = mNumElements; i < n; ++i)
+			pData[i] = f(pData[i]);
+	}
+
+	// Calls f(size(), pColumnI, pColumnJ, ...) once with the data of columns Is..., for loops
+	// which read and write several columns at once.
+	template <size_type... Is, typename Function>
+	void forEachColumns(Function f)
+	{
+		f(mNumElements, TupleVecLeaf<Is, tuplevec_element_t<Is, Ts...>>::mpData...);
+	}
+
+	template <size_type... Is, typename Function>
+	void forEachColumns(Function f) const
+	{
+		f(mNumElements, static_cast<const tuplevec_element_t<Is, Ts...>*>(TupleVecLeaf<Is, tuplevec_element_t<Is, Ts...>>::mpData)...);
+	}
+
+	// As forEachColumns, but passes paddedSize() instead of size(), so that the loop needs no
+	// scalar tail. The padding elements are uninitialized, hence the columns must be trivially copyable.
+	template <size_type... Is, typename Function>
+	void forEachColumnsPadded(Function f)
+	{
+		static_assert(conjunction<is_trivially_copyable<tuplevec_element_t<Is, Ts...>>...>::value, "tuple_vector::forEachColumnsPadded requires trivially copyable columns");
+		f(paddedSize(), TupleVecLeaf<Is, tuplevec_element_t<Is, Ts...>>::mpData...);
+	}
+
+	// pDest[k] = column I[pIndices[k]] for k in [0, n).
+	template <size_type I, typename Index>
+	void gather(const Index* pIndices, size_type n, tuplevec_element_t<I, Ts...>* pDest) const
+	{
+		typedef tuplevec_element_t<I, Ts...> Element;
+		const Element* pData = TupleVecLeaf<I, Element>::mpData;
+
+		for (size_type k = 0; k < n; ++k)
+		{
+#if EASTL_ASSERT_ENABLED
+			if (EASTL_UNLIKELY((size_type)pIndices[k] >= mNumElements))
+				EASTL_FAIL_MSG("tuple_vector::gather -- index out of range");
+#endif
+			pDest[k] = pData[pIndices[k]];
+		}
+	}
+
+	// column I[pIndices[k]] = pSource[k] for k in [0, n). With repeated indices, the last write wins.
+	template <size_type I, typename Index>
+	void scatter(const Index* pIndices, size_type n, const tuplevec_element_t<I, Ts...>* pSource)
+	{
+		typedef tuplevec_element_t<I, Ts...> Element;
+		Element* pData = TupleVecLeaf<I, Element>::mpData;
+
+		for (size_type k = 0; k < n; ++k)
+		{
+#if EASTL_ASSERT_ENABLED
+			if (EASTL_UNLIKELY((size_type)pIndices[k] >= mNumElements))
+				EASTL_FAIL_MSG("tuple_vector::scatter -- index out of range");
+#endif
+			pData[pIndices[k]] = pSource[k];
+		}
+	}
+
 	this_type& operator=(const this_type& other)
 	{
 		if (this != &other)
@@ -1383,6 +1504,8 @@ protected:
 
 	void DoReallocate(size_type oldNumElements, size_type requiredCapacity)
 	{
+		requiredCapacity = DoRoundCapacity(requiredCapacity);
+
 		void* ppNewLeaf[sizeof...(Ts)];
 		pair<void*, size_type> allocation = TupleRecurser<Ts...>::template DoAllocate<allocator_type, 0, index_sequence_type, Ts...>(
 			*this, ppNewLeaf, requiredCapacity, 0);
@@ -1399,6 +1522,12 @@ protected:
 	{
 		return (oldNumCapacity > 0) ? (2 * oldNumCapacity) : 1;
 	}
+
+	static size_type DoRoundCapacity(size_type capacity)
+	{
+		const size_type granularity = TupleRecurser<Ts...>::GetCapacityGranularity();
+		return (capacity + granularity - 1) & ~(granularity - 1);
+	}
 };
 
 }  // namespace TupleVecInternal
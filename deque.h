@@ -129,19 +129,65 @@ namespace eastl
 	#endif
 
 
+	namespace Internal
+	{
+		// Largest power of two that is <= N, or 1 for N == 0. DequeIterator requires
+		// the subarray size to be a power of two.
+		template <size_t N>
+		struct DequeFloorPow2 { static const size_t value = 2 * DequeFloorPow2<N / 2>::value; };
+
+		template <> struct DequeFloorPow2<0> { static const size_t value = 1; };
+		template <> struct DequeFloorPow2<1> { static const size_t value = 1; };
+	}
+
+
+	/// DEQUE_SUBARRAY_SIZE_FOR_BYTES
+	///
+	/// Converts a subarray size given as a byte budget into a number of items.
+	/// The item count is rounded down to a power of two (as the deque iterator
+	/// requires), but never goes below one item per subarray. A 24 byte item with
+	/// a 4096 byte budget thus gives 128 items per subarray rather than 170.
+	/// Queue-style usage benefits from much larger subarrays than the default.
+	///
+	/// Example usage:
+	///     eastl::deque<Job, EASTLAllocatorType, DEQUE_SUBARRAY_SIZE_FOR_BYTES(Job, 4096)> jobQueue;
+	///
+	#define DEQUE_SUBARRAY_SIZE_FOR_BYTES(T, nBytes) ((unsigned)eastl::Internal::DequeFloorPow2<(size_t)(nBytes) / sizeof(T)>::value)
+
+	static_assert(DEQUE_SUBARRAY_SIZE_FOR_BYTES(char[24], 4096) == 128, "DEQUE_SUBARRAY_SIZE_FOR_BYTES must round down to a power of two.");
+	static_assert(DEQUE_SUBARRAY_SIZE_FOR_BYTES(char[24], 16) == 1, "DEQUE_SUBARRAY_SIZE_FOR_BYTES must give at least one item.");
+
+
 	/// DEQUE_DEFAULT_SUBARRAY_SIZE
 	///
 	/// Defines the default number of items in a subarray.
 	/// Note that the user has the option of specifying the subarray size
-	/// in the deque template declaration.
+	/// in the deque template declaration. If EASTL_DEQUE_DEFAULT_SUBARRAY_BYTES
+	/// is defined, the default is instead derived from that byte budget.
 	///
-	#if !defined(__GNUC__) || (__GNUC__ >= 3) // GCC 2.x can't handle the declaration below.
+	#if defined(EASTL_DEQUE_DEFAULT_SUBARRAY_BYTES)
+		#define DEQUE_DEFAULT_SUBARRAY_SIZE(T) DEQUE_SUBARRAY_SIZE_FOR_BYTES(T, EASTL_DEQUE_DEFAULT_SUBARRAY_BYTES)
+	#elif !defined(__GNUC__) || (__GNUC__ >= 3) // GCC 2.x can't handle the declaration below.
 		#define DEQUE_DEFAULT_SUBARRAY_SIZE(T) ((sizeof(T) <= 4) ? 64 : ((sizeof(T) <= 8) ? 32 : ((sizeof(T) <= 16) ? 16 : ((sizeof(T) <= 32) ? 8 : 4))))
 	#else
 		#define DEQUE_DEFAULT_SUBARRAY_SIZE(T) 16
 	#endif
 
 
+	/// EASTL_DEQUE_SUBARRAY_CACHE_SIZE
+	///
+	/// Defines the maximum number of freed subarrays which a deque holds on to
+	/// for reuse instead of returning them to its allocator. This lets a deque
+	/// used as a steady-state FIFO (pushBack + popFront) run with no allocations,
+	/// as the subarray freed at the front is recycled at the back. Cached subarrays
+	/// are linked through their own memory, so the cache costs no extra allocation.
+	/// Set to 0 to disable caching.
+	///
+	#ifndef EASTL_DEQUE_SUBARRAY_CACHE_SIZE
+		#define EASTL_DEQUE_SUBARRAY_CACHE_SIZE 2
+	#endif
+
+
 
 	/// DequeIterator
 	///
@@ -190,6 +236,9 @@ namespace eastl
 		template <typename, typename, unsigned>
 		friend class deque;
 
+		template <typename>
+		friend struct segmented_iterator_traits;
+
 		template <typename U, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, unsigned kDequeSubarraySizeU>
 		friend bool operator==(const DequeIterator<U, PointerA, ReferenceA, kDequeSubarraySizeU>&, 
 							   const DequeIterator<U, PointerB, ReferenceB, kDequeSubarraySizeU>&);
@@ -248,6 +297,41 @@ namespace eastl
 	};
 
 
+	/// segmented_iterator_traits<DequeIterator>
+	///
+	/// Exposes each deque subarray as a contiguous segment, so that algorithms
+	/// such as copy, fill, find and forEach can work on raw pointer ranges.
+	///
+	template <typename T, typename Pointer, typename Reference, unsigned kDequeSubarraySize>
+	struct segmented_iterator_traits< DequeIterator<T, Pointer, Reference, kDequeSubarraySize> >
+	{
+		typedef DequeIterator<T, Pointer, Reference, kDequeSubarraySize> iterator_type;
+		typedef true_type                                                is_segmented_iterator;
+		typedef T**                                                      segment_iterator;
+		typedef Pointer                                                  local_iterator;
+
+		static segment_iterator segment(const iterator_type& it)                             { return it.mpCurrentArrayPtr; }
+		static local_iterator   local(const iterator_type& it)                               { return it.mpCurrent; }
+		static local_iterator   segment_begin(segment_iterator s)                            { return *s; }
+		static local_iterator   segment_end(segment_iterator s)                              { return *s + kDequeSubarraySize; }
+		static local_iterator   segment_end(segment_iterator s, const iterator_type& last)   { return (s == last.mpCurrentArrayPtr) ? last.mpCurrent : (*s + kDequeSubarraySize); }
+		static bool             is_final_segment(segment_iterator s, const iterator_type& last) { return (s == last.mpCurrentArrayPtr); }
+		static segment_iterator next_segment(segment_iterator s)                             { return s + 1; }
+
+		static iterator_type compose(segment_iterator s, local_iterator l)
+		{
+			// A deque iterator never points to the end of a subarray; it points to the beginning of the next one instead.
+			if(l == (*s + kDequeSubarraySize))
+				l = *++s;
+
+			iterator_type it;
+			it.SetSubarray(s);
+			it.mpCurrent = const_cast<T*>(l);
+			return it;
+		}
+	};
+
+
 
 
 	/// DequeBase
@@ -287,6 +371,8 @@ namespace eastl
 		size_type       mnPtrArraySize;     // Possibly we should store this as T** mpArrayEnd.
 		iterator        mItBegin;           // Where within the subarrays is our beginning.
 		iterator        mItEnd;             // Where within the subarrays is our end.
+		T*              mpSubarrayCache;    // Singly linked list of freed subarrays kept for reuse. See EASTL_DEQUE_SUBARRAY_CACHE_SIZE.
+		size_type       mnSubarrayCacheSize;
 		allocator_type  mAllocator;         // To do: Use base class optimization to make this go away.
 
 	public:
@@ -303,6 +389,7 @@ namespace eastl
 		T*       DoAllocateSubarray();
 		void     DoFreeSubarray(T* p);
 		void     DoFreeSubarrays(T** pBegin, T** pEnd);
+		void     DoFreeSubarrayCache();
 
 		T**      DoAllocatePtrArray(size_type n);
 		void     DoFreePtrArray(T** p, size_t n);
@@ -367,6 +454,8 @@ namespace eastl
 		using base_type::mnPtrArraySize;
 		using base_type::mItBegin;
 		using base_type::mItEnd;
+		using base_type::mpSubarrayCache;
+		using base_type::mnSubarrayCacheSize;
 		using base_type::mAllocator;
 		using base_type::DoAllocateSubarray;
 		using base_type::DoFreeSubarray;
@@ -538,6 +627,8 @@ namespace eastl
 		  mnPtrArraySize(0),
 		  mItBegin(),
 		  mItEnd(),
+		  mpSubarrayCache(NULL),
+		  mnSubarrayCacheSize(0),
 		  mAllocator(allocator)
 	{
 		// It is assumed here that the deque subclass will init us when/as needed.
@@ -550,6 +641,8 @@ namespace eastl
 		  mnPtrArraySize(0),
 		  mItBegin(),
 		  mItEnd(),
+		  mpSubarrayCache(NULL),
+		  mnSubarrayCacheSize(0),
 		  mAllocator(EASTL_DEQUE_DEFAULT_NAME)
 	{
 		// It's important to note that DoInit creates space for elements and assigns 
@@ -565,6 +658,8 @@ namespace eastl
 		  mnPtrArraySize(0),
 		  mItBegin(),
 		  mItEnd(),
+		  mpSubarrayCache(NULL),
+		  mnSubarrayCacheSize(0),
 		  mAllocator(allocator)
 	{
 		// It's important to note that DoInit creates space for elements and assigns 
@@ -583,6 +678,8 @@ namespace eastl
 			DoFreePtrArray(mpPtrArray, mnPtrArraySize);
 			mpPtrArray = nullptr;
 		}
+
+		DoFreeSubarrayCache();
 	}
 
 
@@ -612,6 +709,7 @@ namespace eastl
 			{
 				DoFreeSubarrays(mItBegin.mpCurrentArrayPtr, mItEnd.mpCurrentArrayPtr + 1);
 				DoFreePtrArray(mpPtrArray, mnPtrArraySize);
+				DoFreeSubarrayCache(); // The cached subarrays belong to the old allocator.
 
 				mAllocator = allocator;
 				DoInit(0);
@@ -627,8 +725,19 @@ namespace eastl
 	template <typename T, typename Allocator, unsigned kDequeSubarraySize>
 	T* DequeBase<T, Allocator, kDequeSubarraySize>::DoAllocateSubarray()
 	{
-		T* p = (T*)allocate_memory(mAllocator, kDequeSubarraySize * sizeof(T), EASTL_ALIGN_OF(T), 0);
-		EASTL_ASSERT_MSG(p != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+		T* p;
+
+		if(mpSubarrayCache) // If we can recycle a previously freed subarray...
+		{
+			p = mpSubarrayCache;
+			memcpy(&mpSubarrayCache, (void*)p, sizeof(T*));
+			--mnSubarrayCacheSize;
+		}
+		else
+		{
+			p = (T*)allocate_memory(mAllocator, kDequeSubarraySize * sizeof(T), EASTL_ALIGN_OF(T), 0);
+			EASTL_ASSERT_MSG(p != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+		}
 
 		#if EASTL_DEBUG
 			memset((void*)p, 0, kDequeSubarraySize * sizeof(T));
@@ -642,7 +751,17 @@ namespace eastl
 	void DequeBase<T, Allocator, kDequeSubarraySize>::DoFreeSubarray(T* p)
 	{
 		if(p)
-			EASTLFree(mAllocator, p, kDequeSubarraySize * sizeof(T)); 
+		{
+			// The cache links subarrays through their first bytes, so it is only usable if a subarray can hold a pointer.
+			if((kDequeSubarraySize * sizeof(T) >= sizeof(T*)) && (mnSubarrayCacheSize < EASTL_DEQUE_SUBARRAY_CACHE_SIZE))
+			{
+				memcpy((void*)p, &mpSubarrayCache, sizeof(T*));
+				mpSubarrayCache = p;
+				++mnSubarrayCacheSize;
+			}
+			else
+				EASTLFree(mAllocator, p, kDequeSubarraySize * sizeof(T)); 
+		}
 	}
 
 	template <typename T, typename Allocator, unsigned kDequeSubarraySize>
@@ -652,6 +771,19 @@ namespace eastl
 			DoFreeSubarray(*pBegin++);
 	}
 
+	template <typename T, typename Allocator, unsigned kDequeSubarraySize>
+	void DequeBase<T, Allocator, kDequeSubarraySize>::DoFreeSubarrayCache()
+	{
+		while(mpSubarrayCache)
+		{
+			T* const p = mpSubarrayCache;
+			memcpy(&mpSubarrayCache, (void*)p, sizeof(T*));
+			EASTLFree(mAllocator, p, kDequeSubarraySize * sizeof(T));
+		}
+
+		mnSubarrayCacheSize = 0;
+	}
+
 	template <typename T, typename Allocator, unsigned kDequeSubarraySize>
 	T** DequeBase<T, Allocator, kDequeSubarraySize>::DoAllocatePtrArray(size_type n)
 	{
@@ -2666,6 +2798,8 @@ namespace eastl
 		eastl::swap(mnPtrArraySize, x.mnPtrArraySize);
 		eastl::swap(mItBegin,       x.mItBegin);
 		eastl::swap(mItEnd,         x.mItEnd);
+		eastl::swap(mpSubarrayCache, x.mpSubarrayCache);
+		eastl::swap(mnSubarrayCacheSize, x.mnSubarrayCacheSize);
 		eastl::swap(mAllocator,     x.mAllocator);  // We do this even if EASTL_ALLOCATOR_COPY_ENABLED is 0.
 
 	}
@@ -0,0 +1,754 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file defines execution policies like the std C++ <execution> header
+// does, and overloads of these algorithms which take one as their first
+// parameter:
+//    forEach, transform, copy_if, countIf, findIf, fill  (algorithm.h)
+//    sort                                                 (sort.h)
+//    accumulate, reduce, transform_reduce                 (numeric.h)
+//
+// With eastl::execution::seq the algorithms are the sequential ones. With
+// par and par_unseq they split the range in parts of grain size elements and
+// run them on a thread_pool (see thread_pool.h), by default the one returned
+// by getDefaultThreadPool. on(pool) returns a policy which uses another pool,
+// which may be of any type with the concurrency and invoke members of
+// thread_pool, and withGrainSize(n) one which uses another grain size:
+//    eastl::execution::par.on(pool).withGrainSize(4096)
+// Without a grain size, a range is split in about EASTL_EXECUTION_PARTS_PER_THREAD
+// parts per thread, but in parts of no fewer than EASTL_EXECUTION_MIN_GRAIN_SIZE
+// elements. A range which makes a single part, or a pool with a single
+// thread, runs the sequential algorithm on the calling thread.
+//
+// The parts are split in halves recursively with the invoke of the pool, so
+// the pool balances them over its threads by itself, and nothing is
+// allocated, except by copy_if, which stores the number of values each part
+// copies, and by sort, which is parallel_sort and ignores the grain size
+// (see parallel_sort.h).
+//
+// As with std, the function objects may be called from several threads at
+// once and must not throw. reduce and transform_reduce combine the results
+// of the parts in order, so their operation has to be associative, but not
+// commutative. accumulate with a parallel policy is reduce. par_unseq also
+// allows the calls for the values of one thread to be interleaved, so the
+// function objects must not take locks either. It currently runs the parts
+// like par does, with the sequential algorithms, which may vectorize them.
+//
+// The parallel algorithms require random access iterators, which includes
+// the result of transform and copy_if. With other iterators they run the
+// sequential algorithm.
+//
+// Example usage:
+//    eastl::vector<float> v(100000000);
+//    eastl::transform(eastl::execution::par, v.begin(), v.end(), v.begin(), [](float x) { return x * 2.f; });
+//    float fSum = eastl::reduce(eastl::execution::par_unseq, v.begin(), v.end(), 0.f);
+//
+//    eastl::thread_pool pool(3);
+//    eastl::sort(eastl::execution::par.on(pool), v.begin(), v.end());
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_EXECUTION_H
+#define EASTL_EXECUTION_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/algorithm.h>
+#include <eastl/atomic.h>
+#include <eastl/functional.h>
+#include <eastl/iterator.h>
+#include <eastl/numeric.h>
+#include <eastl/parallel_sort.h>
+#include <eastl/sort.h>
+#include <eastl/thread_pool.h>
+#include <eastl/type_traits.h>
+#include <eastl/vector.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+/// EASTL_EXECUTION_MIN_GRAIN_SIZE
+///
+/// The smallest part of a range that a parallel policy without a grain size
+/// hands to a thread.
+///
+#ifndef EASTL_EXECUTION_MIN_GRAIN_SIZE
+	#define EASTL_EXECUTION_MIN_GRAIN_SIZE 2048
+#endif
+
+/// EASTL_EXECUTION_PARTS_PER_THREAD
+///
+/// The number of parts per thread of the pool that a parallel policy without
+/// a grain size splits a range in. More parts balance better when the
+/// values take different times, fewer have less overhead.
+///
+#ifndef EASTL_EXECUTION_PARTS_PER_THREAD
+	#define EASTL_EXECUTION_PARTS_PER_THREAD 8
+#endif
+
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		// The pool of a parallel policy. Only policies for a thread_pool can do without one.
+		template <typename ThreadPool>
+		inline ThreadPool& execution_pool(ThreadPool* pPool)
+		{
+			return *pPool;
+		}
+
+		inline thread_pool& execution_pool(thread_pool* pPool)
+		{
+			return pPool ? *pPool : eastl::getDefaultThreadPool();
+		}
+	}
+
+
+	namespace execution
+	{
+		/// sequenced_policy
+		///
+		/// The type of seq: runs the sequential algorithm.
+		///
+		struct sequenced_policy
+		{
+		};
+
+
+		/// basic_parallel_policy
+		///
+		/// The type of par and par_unseq: runs the algorithm on the threads of a pool,
+		/// in parts of grainSize elements. A grain size of 0 means that the algorithm
+		/// picks one from the size of the range and the concurrency of the pool.
+		///
+		template <typename ThreadPool, bool bUnsequenced>
+		class basic_parallel_policy
+		{
+		public:
+			typedef ThreadPool thread_pool_type;
+
+			static const bool kUnsequenced = bUnsequenced;
+
+		public:
+			EA_CONSTEXPR basic_parallel_policy()
+				: mpPool(nullptr), mnGrainSize(0) {}
+
+			EA_CONSTEXPR basic_parallel_policy(ThreadPool& pool, size_t nGrainSize)
+				: mpPool(&pool), mnGrainSize(nGrainSize) {}
+
+			template <typename OtherThreadPool>
+			basic_parallel_policy<OtherThreadPool, bUnsequenced> on(OtherThreadPool& pool) const
+				{ return basic_parallel_policy<OtherThreadPool, bUnsequenced>(pool, mnGrainSize); }
+
+			basic_parallel_policy withGrainSize(size_t nGrainSize) const
+			{
+				basic_parallel_policy policy(*this);
+				policy.mnGrainSize = nGrainSize;
+				return policy;
+			}
+
+			ThreadPool& pool() const      { return Internal::execution_pool(mpPool); }
+			size_t      grainSize() const { return mnGrainSize; }
+
+		protected:
+			ThreadPool* mpPool;      // nullptr for the default thread_pool.
+			size_t      mnGrainSize;
+		};
+
+
+		typedef basic_parallel_policy<thread_pool, false> parallel_policy;
+		typedef basic_parallel_policy<thread_pool, true>  parallel_unsequenced_policy;
+
+
+		/// seq, par, par_unseq
+		///
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR sequenced_policy            seq       = sequenced_policy();
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR parallel_policy             par       = parallel_policy();
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR parallel_unsequenced_policy par_unseq = parallel_unsequenced_policy();
+
+	} // namespace execution
+
+
+	/// is_execution_policy
+	///
+	template <typename T>
+	struct is_execution_policy : public false_type {};
+
+	template <>
+	struct is_execution_policy<execution::sequenced_policy> : public true_type {};
+
+	template <typename ThreadPool, bool bUnsequenced>
+	struct is_execution_policy<execution::basic_parallel_policy<ThreadPool, bUnsequenced> > : public true_type {};
+
+	#if EASTL_VARIABLE_TEMPLATES_ENABLED
+		template <typename T>
+		EASTL_CPP17_INLINE_VARIABLE EA_CONSTEXPR bool is_execution_policy_v = is_execution_policy<T>::value;
+	#endif
+
+
+
+	namespace Internal
+	{
+		template <typename Iterator>
+		struct execution_is_random_access
+			: public is_base_of<EASTL_ITC_NS::random_access_iterator_tag, typename iterator_traits<Iterator>::iterator_category> {};
+
+		// true_type if the algorithm runs in parallel: the policy is parallel and all the iterators are random access.
+		template <typename ExecutionPolicy, typename Iterator1, typename Iterator2 = Iterator1, typename Iterator3 = Iterator1>
+		struct execution_is_parallel : public false_type {};
+
+		template <typename ThreadPool, bool bUnsequenced, typename Iterator1, typename Iterator2, typename Iterator3>
+		struct execution_is_parallel<execution::basic_parallel_policy<ThreadPool, bUnsequenced>, Iterator1, Iterator2, Iterator3>
+			: public integral_constant<bool, execution_is_random_access<Iterator1>::value &&
+			                                 execution_is_random_access<Iterator2>::value &&
+			                                 execution_is_random_access<Iterator3>::value> {};
+
+		// Used to restrict the overloads below to execution policies, so they never compete with the sequential ones.
+		template <typename ExecutionPolicy, typename T>
+		struct execution_enable_if : public enable_if<is_execution_policy<ExecutionPolicy>::value, T> {};
+
+
+		template <typename ExecutionPolicy>
+		size_t execution_grain_size(const ExecutionPolicy& policy, typename ExecutionPolicy::thread_pool_type& pool, size_t nCount)
+		{
+			const size_t nConcurrency = pool.concurrency();
+
+			if(nConcurrency <= 1)
+				return eastl::maxAlt(nCount, size_t(1));
+
+			if(policy.grainSize())
+				return policy.grainSize();
+
+			const size_t nPartCount = nConcurrency * EASTL_EXECUTION_PARTS_PER_THREAD;
+
+			return eastl::maxAlt((nCount + nPartCount - 1) / nPartCount, size_t(EASTL_EXECUTION_MIN_GRAIN_SIZE));
+		}
+
+
+		// Calls function(nBegin, nEnd) for parts of [nBegin, nEnd) of at most nGrainSize indices,
+		// splitting the range in halves over the pool.
+		template <typename ThreadPool, typename Function>
+		void execution_for(ThreadPool& pool, size_t nBegin, size_t nEnd, size_t nGrainSize, Function& function)
+		{
+			if((nEnd - nBegin) > nGrainSize)
+			{
+				const size_t nMid = nBegin + ((nEnd - nBegin) / 2);
+
+				pool.invoke([&] { Internal::execution_for(pool, nBegin, nMid, nGrainSize, function); },
+				            [&] { Internal::execution_for(pool, nMid, nEnd, nGrainSize, function); });
+			}
+			else if(nBegin != nEnd)
+				function(nBegin, nEnd);
+		}
+
+		template <typename ExecutionPolicy, typename Function>
+		void execution_for(const ExecutionPolicy& policy, size_t nCount, Function& function)
+		{
+			typename ExecutionPolicy::thread_pool_type& pool = policy.pool();
+
+			Internal::execution_for(pool, 0, nCount, Internal::execution_grain_size(policy, pool, nCount), function);
+		}
+
+
+		// Returns leaf(nBegin, nEnd, init) if the range is a single part. Otherwise the right half
+		// has no initial value of its own, so it starts with binary_op(element(nMid), element(nMid + 1)),
+		// the only way to make a T out of values which the standard guarantees. Hence parts have
+		// at least two values, and nGrainSize is at least 2.
+		template <typename T, typename ThreadPool, typename Leaf, typename Element, typename BinaryOperation>
+		T execution_reduce(ThreadPool& pool, size_t nBegin, size_t nEnd, size_t nGrainSize, T init, Leaf& leaf, Element& element, BinaryOperation& binary_op)
+		{
+			if((nEnd - nBegin) > nGrainSize)
+			{
+				const size_t nMid = nBegin + ((nEnd - nBegin) / 2);
+				T right(binary_op(element(nMid), element(nMid + 1)));
+
+				pool.invoke([&] { init  = Internal::execution_reduce(pool, nBegin,   nMid, nGrainSize, eastl::move(init),  leaf, element, binary_op); },
+				            [&] { right = Internal::execution_reduce(pool, nMid + 2, nEnd, nGrainSize, eastl::move(right), leaf, element, binary_op); });
+
+				return binary_op(eastl::move(init), eastl::move(right));
+			}
+
+			return leaf(nBegin, nEnd, eastl::move(init));
+		}
+
+		template <typename T, typename ExecutionPolicy, typename Leaf, typename Element, typename BinaryOperation>
+		T execution_reduce(const ExecutionPolicy& policy, size_t nCount, T init, Leaf& leaf, Element& element, BinaryOperation& binary_op)
+		{
+			typename ExecutionPolicy::thread_pool_type& pool = policy.pool();
+			const size_t nGrainSize = eastl::maxAlt(Internal::execution_grain_size(policy, pool, nCount), size_t(2));
+
+			return Internal::execution_reduce(pool, 0, nCount, nGrainSize, eastl::move(init), leaf, element, binary_op);
+		}
+
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename Function>
+		void forEach_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, Function& function, false_type)
+		{
+			eastl::forEach(first, last, function);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Function>
+		void forEach_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Function& function, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			auto part = [&](size_t nBegin, size_t nEnd)
+				{ eastl::forEach(first + (difference_type)nBegin, first + (difference_type)nEnd, function); };
+
+			Internal::execution_for(policy, (size_t)(last - first), part);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename OutputIterator, typename UnaryOperation>
+		OutputIterator transform_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, OutputIterator result,
+		                                   UnaryOperation& unaryOperation, false_type)
+		{
+			return eastl::transform(first, last, result, unaryOperation);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename OutputIterator, typename UnaryOperation>
+		OutputIterator transform_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, OutputIterator result,
+		                                   UnaryOperation& unaryOperation, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			auto part = [&](size_t nBegin, size_t nEnd)
+				{ eastl::transform(first + (difference_type)nBegin, first + (difference_type)nEnd, result + (difference_type)nBegin, unaryOperation); };
+
+			Internal::execution_for(policy, (size_t)(last - first), part);
+			return result + (last - first);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename OutputIterator, typename BinaryOperation>
+		OutputIterator transform_execution(const ExecutionPolicy&, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2,
+		                                   OutputIterator result, BinaryOperation& binaryOperation, false_type)
+		{
+			return eastl::transform(first1, last1, first2, result, binaryOperation);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename BinaryOperation>
+		OutputIterator transform_execution(const ExecutionPolicy& policy, RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2,
+		                                   OutputIterator result, BinaryOperation& binaryOperation, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+			auto part = [&](size_t nBegin, size_t nEnd)
+			{
+				eastl::transform(first1 + (difference_type)nBegin, first1 + (difference_type)nEnd, first2 + (difference_type)nBegin,
+				                 result + (difference_type)nBegin, binaryOperation);
+			};
+
+			Internal::execution_for(policy, (size_t)(last1 - first1), part);
+			return result + (last1 - first1);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename OutputIterator, typename Predicate>
+		OutputIterator copy_if_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, OutputIterator result,
+		                                 Predicate& predicate, false_type)
+		{
+			return eastl::copy_if(first, last, result, predicate);
+		}
+
+		// Counts the values that each part copies, then copies all parts at once to their offsets.
+		// Unlike the other algorithms, the parts are all of grain size, as their counts are stored.
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename OutputIterator, typename Predicate>
+		OutputIterator copy_if_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, OutputIterator result,
+		                                 Predicate& predicate, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			typename ExecutionPolicy::thread_pool_type& pool = policy.pool();
+
+			const size_t nCount     = (size_t)(last - first);
+			const size_t nGrainSize = Internal::execution_grain_size(policy, pool, nCount);
+			const size_t nPartCount = (nCount + nGrainSize - 1) / nGrainSize;
+
+			if(nPartCount <= 1)
+				return eastl::copy_if(first, last, result, predicate);
+
+			eastl::vector<difference_type> offsets(nPartCount + 1);
+
+			auto countPart = [&](size_t nPartBegin, size_t nPartEnd)
+			{
+				for(size_t nPart = nPartBegin; nPart != nPartEnd; ++nPart)
+				{
+					offsets[nPart + 1] = eastl::countIf(first + (difference_type)(nPart * nGrainSize),
+					                                    first + (difference_type)eastl::minAlt((nPart + 1) * nGrainSize, nCount), predicate);
+				}
+			};
+
+			auto copyPart = [&](size_t nPartBegin, size_t nPartEnd)
+			{
+				for(size_t nPart = nPartBegin; nPart != nPartEnd; ++nPart)
+				{
+					eastl::copy_if(first + (difference_type)(nPart * nGrainSize),
+					               first + (difference_type)eastl::minAlt((nPart + 1) * nGrainSize, nCount), result + offsets[nPart], predicate);
+				}
+			};
+
+			Internal::execution_for(pool, 0, nPartCount, 1, countPart);
+
+			for(size_t nPart = 0; nPart != nPartCount; ++nPart)
+				offsets[nPart + 1] += offsets[nPart];
+
+			Internal::execution_for(pool, 0, nPartCount, 1, copyPart);
+			return result + offsets[nPartCount];
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename Predicate>
+		typename iterator_traits<ForwardIterator>::difference_type
+		countIf_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, Predicate& predicate, false_type)
+		{
+			return eastl::countIf(first, last, predicate);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Predicate>
+		typename iterator_traits<RandomAccessIterator>::difference_type
+		countIf_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Predicate& predicate, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			auto leaf = [&](size_t nBegin, size_t nEnd, difference_type n)
+				{ return n + eastl::countIf(first + (difference_type)nBegin, first + (difference_type)nEnd, predicate); };
+			auto element = [&](size_t i)
+				{ return predicate(*(first + (difference_type)i)) ? difference_type(1) : difference_type(0); };
+			eastl::plus<difference_type> binary_op;
+
+			return Internal::execution_reduce(policy, (size_t)(last - first), difference_type(0), leaf, element, binary_op);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename Predicate>
+		ForwardIterator findIf_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, Predicate& predicate, false_type)
+		{
+			return eastl::findIf(first, last, predicate);
+		}
+
+		// Parts which lie after a value that another part already found skip their search.
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Predicate>
+		RandomAccessIterator findIf_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Predicate& predicate, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const size_t        nCount = (size_t)(last - first);
+			eastl::atomic<size_t> nFound(nCount);
+
+			auto part = [&](size_t nBegin, size_t nEnd)
+			{
+				if(nBegin < nFound.load(eastl::memory_order_relaxed))
+				{
+					const size_t i = (size_t)(eastl::findIf(first + (difference_type)nBegin, first + (difference_type)nEnd, predicate) - first);
+
+					if(i != nEnd)
+					{
+						size_t nPrevious = nFound.load(eastl::memory_order_relaxed);
+
+						while((i < nPrevious) && !nFound.compare_exchange_weak(nPrevious, i, eastl::memory_order_relaxed))
+							{ }
+					}
+				}
+			};
+
+			Internal::execution_for(policy, nCount, part);
+			return first + (difference_type)nFound.load(eastl::memory_order_relaxed);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+		void fill_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, const T& value, false_type)
+		{
+			eastl::fill(first, last, value);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename T>
+		void fill_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, const T& value, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			auto part = [&](size_t nBegin, size_t nEnd)
+				{ eastl::fill(first + (difference_type)nBegin, first + (difference_type)nEnd, value); };
+
+			Internal::execution_for(policy, (size_t)(last - first), part);
+		}
+
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+		void sort_execution(const ExecutionPolicy&, RandomAccessIterator first, RandomAccessIterator last, Compare& compare, false_type)
+		{
+			eastl::sort(first, last, compare);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+		void sort_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Compare& compare, true_type)
+		{
+			eastl::parallel_sort(first, last, compare, policy.pool());
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+		T reduce_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, T init, BinaryOperation& binary_op, false_type)
+		{
+			return eastl::reduce(first, last, eastl::move(init), binary_op);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename BinaryOperation>
+		T reduce_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation& binary_op, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			auto leaf = [&](size_t nBegin, size_t nEnd, T value)
+				{ return eastl::reduce(first + (difference_type)nBegin, first + (difference_type)nEnd, eastl::move(value), binary_op); };
+			auto element = [&](size_t i) -> typename iterator_traits<RandomAccessIterator>::reference
+				{ return *(first + (difference_type)i); };
+
+			return Internal::execution_reduce(policy, (size_t)(last - first), eastl::move(init), leaf, element, binary_op);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+		T transform_reduce_execution(const ExecutionPolicy&, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, T init,
+		                             BinaryOperation1& binary_op1, BinaryOperation2& binary_op2, false_type)
+		{
+			return eastl::transform_reduce(first1, last1, first2, eastl::move(init), binary_op1, binary_op2);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+		T transform_reduce_execution(const ExecutionPolicy& policy, RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, T init,
+		                             BinaryOperation1& binary_op1, BinaryOperation2& binary_op2, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+			auto leaf = [&](size_t nBegin, size_t nEnd, T value)
+			{
+				return eastl::transform_reduce(first1 + (difference_type)nBegin, first1 + (difference_type)nEnd, first2 + (difference_type)nBegin,
+				                               eastl::move(value), binary_op1, binary_op2);
+			};
+			auto element = [&](size_t i)
+				{ return binary_op2(*(first1 + (difference_type)i), *(first2 + (difference_type)i)); };
+
+			return Internal::execution_reduce(policy, (size_t)(last1 - first1), eastl::move(init), leaf, element, binary_op1);
+		}
+
+
+		template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+		T transform_reduce_execution(const ExecutionPolicy&, ForwardIterator first, ForwardIterator last, T init,
+		                             BinaryOperation& binary_op, UnaryOperation& unary_op, false_type)
+		{
+			return eastl::transform_reduce(first, last, eastl::move(init), binary_op, unary_op);
+		}
+
+		template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+		T transform_reduce_execution(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, T init,
+		                             BinaryOperation& binary_op, UnaryOperation& unary_op, true_type)
+		{
+			typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			auto leaf = [&](size_t nBegin, size_t nEnd, T value)
+				{ return eastl::transform_reduce(first + (difference_type)nBegin, first + (difference_type)nEnd, eastl::move(value), binary_op, unary_op); };
+			auto element = [&](size_t i)
+				{ return unary_op(*(first + (difference_type)i)); };
+
+			return Internal::execution_reduce(policy, (size_t)(last - first), eastl::move(init), leaf, element, binary_op);
+		}
+
+	} // namespace Internal
+
+
+
+	/// forEach
+	///
+	/// Calls function for each value in the range [first, last), see the top of this file.
+	/// Unlike the version without a policy, it returns nothing.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Function>
+	typename Internal::execution_enable_if<ExecutionPolicy, void>::type
+	forEach(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, Function function)
+	{
+		Internal::forEach_execution(policy, first, last, function, typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// transform
+	///
+	/// See the top of this file. result may be equal to first, but the ranges
+	/// must not overlap otherwise.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename OutputIterator, typename UnaryOperation>
+	typename Internal::execution_enable_if<ExecutionPolicy, OutputIterator>::type
+	transform(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, OutputIterator result, UnaryOperation unaryOperation)
+	{
+		return Internal::transform_execution(policy, first, last, result, unaryOperation,
+		                                     typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator, OutputIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename OutputIterator, typename BinaryOperation>
+	typename Internal::execution_enable_if<ExecutionPolicy, OutputIterator>::type
+	transform(const ExecutionPolicy& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, OutputIterator result, BinaryOperation binaryOperation)
+	{
+		return Internal::transform_execution(policy, first1, last1, first2, result, binaryOperation,
+		                                     typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator1, ForwardIterator2, OutputIterator>::type());
+	}
+
+
+	/// copy_if
+	///
+	/// See the top of this file. Copies the values in the same order as the version
+	/// without a policy, but calls predicate twice for each value, once to count
+	/// and once to copy.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename OutputIterator, typename Predicate>
+	typename Internal::execution_enable_if<ExecutionPolicy, OutputIterator>::type
+	copy_if(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, OutputIterator result, Predicate predicate)
+	{
+		return Internal::copy_if_execution(policy, first, last, result, predicate,
+		                                   typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator, OutputIterator>::type());
+	}
+
+
+	/// countIf
+	///
+	/// See the top of this file.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Predicate>
+	typename Internal::execution_enable_if<ExecutionPolicy, typename iterator_traits<ForwardIterator>::difference_type>::type
+	countIf(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, Predicate predicate)
+	{
+		return Internal::countIf_execution(policy, first, last, predicate, typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// findIf
+	///
+	/// See the top of this file. Returns the first value for which predicate is true,
+	/// like the version without a policy, but may call predicate for values after it.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename Predicate>
+	typename Internal::execution_enable_if<ExecutionPolicy, ForwardIterator>::type
+	findIf(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, Predicate predicate)
+	{
+		return Internal::findIf_execution(policy, first, last, predicate, typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// fill
+	///
+	/// See the top of this file.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	typename Internal::execution_enable_if<ExecutionPolicy, void>::type
+	fill(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, const T& value)
+	{
+		Internal::fill_execution(policy, first, last, value, typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+
+	/// sort
+	///
+	/// See the top of this file. With a parallel policy this is parallel_sort.
+	///
+	template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+	typename Internal::execution_enable_if<ExecutionPolicy, void>::type
+	sort(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		Internal::sort_execution(policy, first, last, compare, typename Internal::execution_is_parallel<ExecutionPolicy, RandomAccessIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename RandomAccessIterator>
+	typename Internal::execution_enable_if<ExecutionPolicy, void>::type
+	sort(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last)
+	{
+		eastl::sort(policy, first, last, eastl::less<typename iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+
+	/// reduce
+	///
+	/// See reduce in numeric.h and the top of this file. The parts are combined in
+	/// order, so binary_op needs to be associative, but not commutative.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	reduce(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op)
+	{
+		return Internal::reduce_execution(policy, first, last, eastl::move(init), binary_op,
+		                                  typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	reduce(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, T init)
+	{
+		return eastl::reduce(policy, first, last, eastl::move(init), eastl::plus<>());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator>
+	typename Internal::execution_enable_if<ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type>::type
+	reduce(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last)
+	{
+		return eastl::reduce(policy, first, last, typename iterator_traits<ForwardIterator>::value_type(), eastl::plus<>());
+	}
+
+
+	/// accumulate
+	///
+	/// With an execution policy, accumulate is reduce: binary_op has to be associative
+	/// and take two values of type T, as the results of the parts are combined with it.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	accumulate(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op)
+	{
+		return eastl::reduce(policy, first, last, eastl::move(init), binary_op);
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	accumulate(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, T init)
+	{
+		return eastl::reduce(policy, first, last, eastl::move(init), eastl::plus<>());
+	}
+
+
+	/// transform_reduce
+	///
+	/// See transform_reduce in numeric.h and reduce above.
+	///
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	transform_reduce(const ExecutionPolicy& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, T init,
+	                 BinaryOperation1 binary_op1, BinaryOperation2 binary_op2)
+	{
+		return Internal::transform_reduce_execution(policy, first1, last1, first2, eastl::move(init), binary_op1, binary_op2,
+		                                            typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator1, ForwardIterator2>::type());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	transform_reduce(const ExecutionPolicy& policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, T init)
+	{
+		return eastl::transform_reduce(policy, first1, last1, first2, eastl::move(init), eastl::plus<>(), eastl::multiplies<>());
+	}
+
+	template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+	typename Internal::execution_enable_if<ExecutionPolicy, T>::type
+	transform_reduce(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op, UnaryOperation unary_op)
+	{
+		return Internal::transform_reduce_execution(policy, first, last, eastl::move(init), binary_op, unary_op,
+		                                            typename Internal::execution_is_parallel<ExecutionPolicy, ForwardIterator>::type());
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -78,6 +78,7 @@ namespace eastl
 		typedef fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>  this_type;
 		typedef typename base_type::size_type                                   size_type;
 		typedef typename base_type::value_type                                  value_type;
+		typedef typename base_type::pointer                                     pointer;
 		typedef typename base_type::reference                                   reference;
 		typedef typename base_type::iterator                                    iterator;
 		typedef typename base_type::const_iterator                              const_iterator;
@@ -135,6 +136,8 @@ namespace eastl
 		bool      can_overflow() const;         // Returns the value of the bEnableOverflow template parameter.
 
 		void*     pushBackUninitialized();
+		pointer   appendUninitialized(size_type n);   // Requires a trivially default constructible value_type.
+		void      resizeUninitialized(size_type n);   // Requires a trivially default constructible value_type.
 		void      pushBack(const value_type& value);   // We implement pushBack here because we have a specialization that's 
 		reference pushBack();                          // smaller for the case of overflow being disabled.
 		void      pushBack(value_type&& value);
@@ -148,6 +151,9 @@ namespace eastl
 		void*     DoPushBackUninitialized(true_type);
 		void*     DoPushBackUninitialized(false_type);
 
+		pointer   DoAppendUninitialized(true_type, size_type n);
+		pointer   DoAppendUninitialized(false_type, size_type n);
+
 		void      DoPushBack(true_type, const value_type& value);
 		void      DoPushBack(false_type, const value_type& value);
 
@@ -481,6 +487,48 @@ namespace eastl
 	}
 
 
+	template <typename T, size_t nodeCount, bool bEnableOverflow, typename OverflowAllocator>
+	inline typename fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::pointer
+	fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::appendUninitialized(size_type n)
+	{
+		static_assert(eastl::is_trivially_default_constructible<value_type>::value, "fixedVector::appendUninitialized requires a trivially default constructible value_type.");
+
+		return DoAppendUninitialized(typename conditional<bEnableOverflow, true_type, false_type>::type(), n);
+	}
+
+
+	template <typename T, size_t nodeCount, bool bEnableOverflow, typename OverflowAllocator>
+	inline void fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::resizeUninitialized(size_type n)
+	{
+		if(n > (size_type)(mpEnd - mpBegin))
+			appendUninitialized(n - (size_type)(mpEnd - mpBegin));
+		else
+			base_type::resizeUninitialized(n);
+	}
+
+
+	template <typename T, size_t nodeCount, bool bEnableOverflow, typename OverflowAllocator>
+	inline typename fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::pointer
+	fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::DoAppendUninitialized(true_type, size_type n)
+	{
+		return base_type::appendUninitialized(n);
+	}
+
+
+	// This template specializes for overflow NOT enabled.
+	// In this configuration, there is no need to test whether the container should grow (it never will)
+	template <typename T, size_t nodeCount, bool bEnableOverflow, typename OverflowAllocator>
+	inline typename fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::pointer
+	fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::DoAppendUninitialized(false_type, size_type n)
+	{
+		EASTL_ASSERT(n <= (size_type)(internalCapacityPtr() - mpEnd));
+
+		pointer const pAppended = mpEnd;
+		mpEnd += n;
+		return pAppended;
+	}
+
+
 	template <typename T, size_t nodeCount, bool bEnableOverflow, typename OverflowAllocator>
 	inline void fixedVector<T, nodeCount, bEnableOverflow, OverflowAllocator>::pushBack(const value_type& value)
 	{
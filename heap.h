@@ -26,6 +26,13 @@
 //    changeHeap   -- Changes the priority of an entry in the heap.
 //    isHeap       -- Returns true if an array appears is in heap format.   Same as C++11 std::isHeap.
 //    isHeap_until -- Returns largest part of the range which is a heap.    Same as C++11 std::isHeap_until.
+//
+// Each of these is also available for d-ary heaps, where every node has D
+// children instead of two, by passing D as the first template argument,
+// e.g. pushHeap<4>(first, last). A 4-ary heap is half as deep as a binary
+// heap and the children of a node are adjacent in memory, so sifting touches
+// fewer cache lines; the price is more comparisons per level on the way down.
+// The same D must be used for all operations on a given heap.
 ///////////////////////////////////////////////////////////////////////////////
 
 
@@ -35,6 +42,7 @@
 
 
 #include <eastl/internal/config.h>
+#include <eastl/internal/functional_base.h>
 #include <eastl/iterator.h>
 #include <stddef.h>
 
@@ -675,6 +683,287 @@ namespace eastl
 	// }
 
 
+
+	///////////////////////////////////////////////////////////////////////
+	// d-ary heaps
+	///////////////////////////////////////////////////////////////////////
+
+	// The children of position p are at D * p + 1 through D * p + D, and the parent of p is at
+	// (p - 1) / D. For D == 2 the public functions below forward to the binary versions above.
+	namespace Internal
+	{
+		// Heap helpers take a functor which is called with each position that receives a new
+		// value, so that containers such as indexed_priority_queue can track where their
+		// elements are. Plain heaps pass this one, which compiles away.
+		struct HeapMovedNone
+		{
+			template <typename Distance>
+			void operator()(Distance) const { }
+		};
+
+		// Moves value up from the vacant position until its parent doesn't compare less.
+		template <size_t D, typename RandomAccessIterator, typename Distance, typename T, typename Compare, typename Moved>
+		inline void promoteDaryHeap(RandomAccessIterator first, Distance topPosition, Distance position, T&& value, Compare& compare, Moved& moved)
+		{
+			for(Distance parentPosition = (position - 1) / (Distance)D;
+				(position > topPosition) && compare(*(first + parentPosition), value);
+				parentPosition = (position - 1) / (Distance)D)
+			{
+				*(first + position) = eastl::move(*(first + parentPosition));
+				moved(position);
+				position = parentPosition;
+			}
+
+			*(first + position) = eastl::forward<T>(value);
+			moved(position);
+		}
+
+		// Fills the vacant position by moving the largest child up, down to the bottom of the
+		// heap, then places value there and promotes it. As in adjustHeap, this costs one
+		// comparison per level less than stopping as soon as value fits.
+		template <size_t D, typename RandomAccessIterator, typename Distance, typename T, typename Compare, typename Moved>
+		void adjustDaryHeap(RandomAccessIterator first, Distance topPosition, Distance heapSize, Distance position, T&& value, Compare& compare, Moved& moved)
+		{
+			static_assert(D >= 2, "d-ary heaps require D >= 2");
+
+			Distance childPosition = ((Distance)D * position) + 1;
+
+			while(childPosition < heapSize)
+			{
+				const Distance childEnd = ((heapSize - childPosition) > (Distance)D) ? (childPosition + (Distance)D) : heapSize;
+				Distance largestPosition = childPosition;
+
+				for(Distance i = childPosition + 1; i < childEnd; ++i)
+				{
+					if(compare(*(first + largestPosition), *(first + i)))
+						largestPosition = i;
+				}
+
+				*(first + position) = eastl::move(*(first + largestPosition));
+				moved(position);
+				position = largestPosition;
+				childPosition = ((Distance)D * position) + 1;
+			}
+
+			Internal::promoteDaryHeap<D>(first, topPosition, position, eastl::forward<T>(value), compare, moved);
+		}
+	}
+
+
+	/// pushHeap<D>
+	///
+	/// Adds the item at last - 1 to the d-ary heap [first, last - 1).
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline void pushHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EA_CONSTEXPR_IF(D == 2)
+			eastl::pushHeap<RandomAccessIterator, Compare>(first, last, compare);
+		else
+		{
+			Internal::HeapMovedNone moved;
+			value_type tempBottom(eastl::move(*(last - 1)));
+			Internal::promoteDaryHeap<D>(first, (difference_type)0, (difference_type)(last - first - 1), eastl::move(tempBottom), compare, moved);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void pushHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		eastl::pushHeap<D>(first, last, eastl::less<value_type>());
+	}
+
+
+	/// popHeap<D>
+	///
+	/// Moves the top of the d-ary heap [first, last) to last - 1 and restores the heap [first, last - 1).
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline void popHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EA_CONSTEXPR_IF(D == 2)
+			eastl::popHeap<RandomAccessIterator, Compare>(first, last, compare);
+		else
+		{
+			Internal::HeapMovedNone moved;
+			value_type tempBottom(eastl::move(*(last - 1)));
+			*(last - 1) = eastl::move(*first);
+			Internal::adjustDaryHeap<D>(first, (difference_type)0, (difference_type)(last - first - 1), (difference_type)0, eastl::move(tempBottom), compare, moved);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void popHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		eastl::popHeap<D>(first, last, eastl::less<value_type>());
+	}
+
+
+	/// makeHeap<D>
+	///
+	/// Converts [first, last) into a d-ary heap in O(n).
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	void makeHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EA_CONSTEXPR_IF(D == 2)
+			eastl::makeHeap<RandomAccessIterator, Compare>(first, last, compare);
+		else
+		{
+			const difference_type heapSize = last - first;
+
+			if(heapSize >= 2)
+			{
+				Internal::HeapMovedNone moved;
+				difference_type parentPosition = ((heapSize - 2) / (difference_type)D) + 1;
+
+				do{
+					--parentPosition;
+					value_type temp(eastl::move(*(first + parentPosition)));
+					Internal::adjustDaryHeap<D>(first, parentPosition, heapSize, parentPosition, eastl::move(temp), compare, moved);
+				} while(parentPosition != 0);
+			}
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void makeHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		eastl::makeHeap<D>(first, last, eastl::less<value_type>());
+	}
+
+
+	/// sortHeap<D>
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline void sortHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		for(; (last - first) > 1; --last)
+			eastl::popHeap<D>(first, last, compare);
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void sortHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		eastl::sortHeap<D>(first, last, eastl::less<value_type>());
+	}
+
+
+	/// removeHeap<D>
+	///
+	/// Moves the item at position to the back of the d-ary heap and restores the heap in front of it.
+	/// As with removeHeap, the caller erases the item from the container.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Distance, typename Compare>
+	inline void removeHeap(RandomAccessIterator first, Distance heapSize, Distance position, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EA_CONSTEXPR_IF(D == 2)
+			eastl::removeHeap<RandomAccessIterator, Distance, Compare>(first, heapSize, position, compare);
+		else
+		{
+			Internal::HeapMovedNone moved;
+			value_type tempBottom(eastl::move(*(first + heapSize - 1)));
+			*(first + heapSize - 1) = eastl::move(*(first + position));
+			Internal::adjustDaryHeap<D>(first, (difference_type)0, (difference_type)(heapSize - 1), (difference_type)position, eastl::move(tempBottom), compare, moved);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator, typename Distance>
+	inline void removeHeap(RandomAccessIterator first, Distance heapSize, Distance position)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		eastl::removeHeap<D>(first, heapSize, position, eastl::less<value_type>());
+	}
+
+
+	/// changeHeap<D>
+	///
+	/// Restores the d-ary heap after the priority of the item at position has changed.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Distance, typename Compare>
+	inline void changeHeap(RandomAccessIterator first, Distance heapSize, Distance position, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EA_CONSTEXPR_IF(D == 2)
+			eastl::changeHeap<RandomAccessIterator, Distance, Compare>(first, heapSize, position, compare);
+		else
+		{
+			// Unlike the binary version, there is no need to remove and reinsert the item: the
+			// adjustment sifts it down to the bottom and then back up as far as it belongs.
+			Internal::HeapMovedNone moved;
+			value_type temp(eastl::move(*(first + position)));
+			Internal::adjustDaryHeap<D>(first, (difference_type)0, (difference_type)heapSize, (difference_type)position, eastl::move(temp), compare, moved);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator, typename Distance>
+	inline void changeHeap(RandomAccessIterator first, Distance heapSize, Distance position)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		eastl::changeHeap<D>(first, heapSize, position, eastl::less<value_type>());
+	}
+
+
+	/// isHeap_until<D>
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline RandomAccessIterator isHeap_until(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+		const difference_type heapSize = last - first;
+
+		for(difference_type childPosition = 1; childPosition < heapSize; ++childPosition)
+		{
+			if(compare(*(first + ((childPosition - 1) / (difference_type)D)), *(first + childPosition)))
+				return first + childPosition;
+		}
+
+		return last;
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline RandomAccessIterator isHeap_until(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		return eastl::isHeap_until<D>(first, last, eastl::less<value_type>());
+	}
+
+
+	/// isHeap<D>
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline bool isHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		return (eastl::isHeap_until<D>(first, last, compare) == last);
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline bool isHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		return (eastl::isHeap_until<D>(first, last) == last);
+	}
+
+
+
 } // namespace eastl
 
 
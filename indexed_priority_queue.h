@@ -0,0 +1,558 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements indexed_priority_queue, an addressable priority queue.
+// push returns a handle to the new element which stays valid until that
+// element is popped or erased, no matter how the heap is reordered. The
+// handle can then be used to change the element's priority or to remove it
+// in O(log n), which is what schedulers that reprioritize pending work and
+// shortest-path searches that relax distances need. With priority_queue the
+// same requires knowing the element's position in the heap, which changes on
+// every push and pop.
+//
+// Example usage (Dijkstra, with the nearest node on top):
+//     typedef eastl::pair<float, NodeIndex> Entry;  // distance, node
+//     eastl::indexed_priority_queue<Entry, eastl::greater<Entry>> open;
+//     eastl::vector<eastl_size_t> handleOf(nodeCount);
+//
+//     handleOf[start] = open.push(Entry(0.f, start));
+//     ...
+//     // A shorter path to node n ranks it higher, as the comparison is greater.
+//     open.increaseKey(handleOf[n], Entry(newDistance, n));
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INDEXED_PRIORITY_QUEUE_H
+#define EASTL_INDEXED_PRIORITY_QUEUE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/vector.h>
+#include <eastl/heap.h>
+#include <eastl/functional.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_NAME
+		#define EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " indexed_priority_queue" // Unless the user overrides something, this is "EASTL indexed_priority_queue".
+	#endif
+
+	/// EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR
+		#define EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR allocator_type(EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_NAME)
+	#endif
+
+
+
+	/// indexed_priority_queue
+	///
+	/// A priority queue whose top is the greatest element under Compare, like
+	/// priority_queue, stored as a D-ary heap (see heap.h). Every element is
+	/// identified by the handle that push returned for it. Handles are small
+	/// integers, so callers can keep them in arrays; the handle of a popped or
+	/// erased element is reused by a later push.
+	///
+	/// increaseKey and decreaseKey refer to the order given by Compare:
+	/// increaseKey moves an element towards the top and decreaseKey away from
+	/// it. For a queue of the smallest elements first (Compare = greater), this
+	/// means that lowering a value is an increaseKey. update handles either
+	/// direction at the cost of one extra comparison.
+	///
+	template <typename T, typename Compare = eastl::less<T>, size_t D = 4, typename Allocator = EASTLAllocatorType>
+	class indexed_priority_queue
+	{
+	public:
+		typedef indexed_priority_queue<T, Compare, D, Allocator>  this_type;
+		typedef T                                                  value_type;
+		typedef const T&                                           const_reference;
+		typedef Compare                                            compare_type;
+		typedef Allocator                                          allocator_type;
+		typedef eastl_size_t                                       size_type;
+		typedef eastl_size_t                                       handle_type;
+
+		static const size_type kInvalidPosition = (size_type)-1;
+
+	public:
+		indexed_priority_queue();
+		explicit indexed_priority_queue(const compare_type& compare, const allocator_type& allocator = EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR);
+		explicit indexed_priority_queue(const allocator_type& allocator);
+
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;
+
+		const_reference top() const;
+		handle_type     topHandle() const;
+
+		handle_type push(const value_type& value);
+		handle_type push(value_type&& value);
+
+		template <class... Args>
+		handle_type emplace(Args&&... args);
+
+		void pop();
+		void pop(value_type& value);    // Allows popping a move-only type.
+
+		bool            contains(handle_type handle) const EASTL_NOEXCEPT; // Returns true if handle refers to an element in the queue.
+		const_reference get(handle_type handle) const;
+
+		void increaseKey(handle_type handle, const value_type& value); // value must not compare less than the current value.
+		void increaseKey(handle_type handle, value_type&& value);
+		void decreaseKey(handle_type handle, const value_type& value); // The current value must not compare less than value.
+		void decreaseKey(handle_type handle, value_type&& value);
+		void update(handle_type handle, const value_type& value);
+		void update(handle_type handle, value_type&& value);
+
+		void erase(handle_type handle);
+
+		void clear() EASTL_NOEXCEPT;
+		void reserve(size_type n);
+
+		void swap(this_type& x);
+
+		bool validate() const;
+
+	protected:
+		struct Node
+		{
+			value_type  mValue;
+			handle_type mHandle;
+		};
+
+		// Compares nodes by value, for the heap functions. Like priority_queue, this passes a copy of the compare.
+		struct NodeCompare
+		{
+			compare_type mCompare;
+			bool operator()(const Node& a, const Node& b) { return mCompare(a.mValue, b.mValue); }
+		};
+
+		// Keeps mPositions up to date as the heap functions move nodes around.
+		struct NodeMoved
+		{
+			this_type* mpQueue;
+			void operator()(ptrdiff_t position) const { mpQueue->mPositions[mpQueue->mHeap[(size_type)position].mHandle] = (size_type)position; }
+		};
+
+		typedef eastl::vector<Node, Allocator>        NodeVector;
+		typedef eastl::vector<size_type, Allocator>   PositionVector;
+		typedef eastl::vector<handle_type, Allocator> HandleVector;
+
+		handle_type DoPush(value_type&& value);
+		void        DoPromote(size_type position);
+		void        DoAdjust(size_type position);
+		void        DoRemove(size_type position);
+		size_type   DoGetPosition(handle_type handle, const char* pMessage) const;
+
+		NodeVector     mHeap;         // The elements, as a D-ary heap.
+		PositionVector mPositions;    // The position in mHeap of each handle, or kInvalidPosition for unused handles.
+		HandleVector   mFreeHandles;  // Unused handles, for reuse by push.
+		compare_type   mCompare;
+
+	}; // class indexed_priority_queue
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// indexed_priority_queue
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	const typename indexed_priority_queue<T, Compare, D, Allocator>::size_type indexed_priority_queue<T, Compare, D, Allocator>::kInvalidPosition;
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline indexed_priority_queue<T, Compare, D, Allocator>::indexed_priority_queue()
+		: mHeap(EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR)
+		, mPositions(EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR)
+		, mFreeHandles(EASTL_INDEXED_PRIORITY_QUEUE_DEFAULT_ALLOCATOR)
+		, mCompare()
+	{
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline indexed_priority_queue<T, Compare, D, Allocator>::indexed_priority_queue(const compare_type& compare, const allocator_type& allocator)
+		: mHeap(allocator)
+		, mPositions(allocator)
+		, mFreeHandles(allocator)
+		, mCompare(compare)
+	{
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline indexed_priority_queue<T, Compare, D, Allocator>::indexed_priority_queue(const allocator_type& allocator)
+		: mHeap(allocator)
+		, mPositions(allocator)
+		, mFreeHandles(allocator)
+		, mCompare()
+	{
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline bool indexed_priority_queue<T, Compare, D, Allocator>::empty() const EASTL_NOEXCEPT
+	{
+		return mHeap.empty();
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::size_type
+	indexed_priority_queue<T, Compare, D, Allocator>::size() const EASTL_NOEXCEPT
+	{
+		return mHeap.size();
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::const_reference
+	indexed_priority_queue<T, Compare, D, Allocator>::top() const
+	{
+#if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mHeap.empty()))
+			EASTL_FAIL_MSG("indexed_priority_queue::top -- empty container");
+#endif
+
+		return mHeap.front().mValue;
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::handle_type
+	indexed_priority_queue<T, Compare, D, Allocator>::topHandle() const
+	{
+#if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mHeap.empty()))
+			EASTL_FAIL_MSG("indexed_priority_queue::topHandle -- empty container");
+#endif
+
+		return mHeap.front().mHandle;
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::handle_type
+	indexed_priority_queue<T, Compare, D, Allocator>::push(const value_type& value)
+	{
+		return DoPush(value_type(value));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::handle_type
+	indexed_priority_queue<T, Compare, D, Allocator>::push(value_type&& value)
+	{
+		return DoPush(eastl::move(value));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	template <class... Args>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::handle_type
+	indexed_priority_queue<T, Compare, D, Allocator>::emplace(Args&&... args)
+	{
+		return DoPush(value_type(eastl::forward<Args>(args)...));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::pop()
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mHeap.empty()))
+			EASTL_FAIL_MSG("indexed_priority_queue::pop -- empty container");
+#endif
+
+		DoRemove(0);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::pop(value_type& value)
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mHeap.empty()))
+			EASTL_FAIL_MSG("indexed_priority_queue::pop -- empty container");
+#endif
+
+		value = eastl::move(mHeap.front().mValue);
+		DoRemove(0);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline bool indexed_priority_queue<T, Compare, D, Allocator>::contains(handle_type handle) const EASTL_NOEXCEPT
+	{
+		return (handle < mPositions.size()) && (mPositions[handle] != kInvalidPosition);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::const_reference
+	indexed_priority_queue<T, Compare, D, Allocator>::get(handle_type handle) const
+	{
+		return mHeap[DoGetPosition(handle, "indexed_priority_queue::get -- invalid handle")].mValue;
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::increaseKey(handle_type handle, const value_type& value)
+	{
+		increaseKey(handle, value_type(value));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	void indexed_priority_queue<T, Compare, D, Allocator>::increaseKey(handle_type handle, value_type&& value)
+	{
+		const size_type position = DoGetPosition(handle, "indexed_priority_queue::increaseKey -- invalid handle");
+
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mCompare(value, mHeap[position].mValue)))
+			EASTL_FAIL_MSG("indexed_priority_queue::increaseKey -- new value compares less than the current value");
+#endif
+
+		mHeap[position].mValue = eastl::move(value);
+		DoPromote(position);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::decreaseKey(handle_type handle, const value_type& value)
+	{
+		decreaseKey(handle, value_type(value));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	void indexed_priority_queue<T, Compare, D, Allocator>::decreaseKey(handle_type handle, value_type&& value)
+	{
+		const size_type position = DoGetPosition(handle, "indexed_priority_queue::decreaseKey -- invalid handle");
+
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(mCompare(mHeap[position].mValue, value)))
+			EASTL_FAIL_MSG("indexed_priority_queue::decreaseKey -- current value compares less than the new value");
+#endif
+
+		mHeap[position].mValue = eastl::move(value);
+		DoAdjust(position);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::update(handle_type handle, const value_type& value)
+	{
+		update(handle, value_type(value));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	void indexed_priority_queue<T, Compare, D, Allocator>::update(handle_type handle, value_type&& value)
+	{
+		const size_type position = DoGetPosition(handle, "indexed_priority_queue::update -- invalid handle");
+		const bool bIncrease = mCompare(mHeap[position].mValue, value);
+
+		mHeap[position].mValue = eastl::move(value);
+
+		if(bIncrease)
+			DoPromote(position);
+		else
+			DoAdjust(position);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::erase(handle_type handle)
+	{
+		DoRemove(DoGetPosition(handle, "indexed_priority_queue::erase -- invalid handle"));
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::clear() EASTL_NOEXCEPT
+	{
+		mHeap.clear();
+		mPositions.clear();
+		mFreeHandles.clear();
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::reserve(size_type n)
+	{
+		mHeap.reserve(n);
+		mPositions.reserve(n);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::swap(this_type& x)
+	{
+		using eastl::swap;
+		mHeap.swap(x.mHeap);
+		mPositions.swap(x.mPositions);
+		mFreeHandles.swap(x.mFreeHandles);
+		swap(mCompare, x.mCompare);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	bool indexed_priority_queue<T, Compare, D, Allocator>::validate() const
+	{
+		if(!mHeap.validate() || !mPositions.validate() || !mFreeHandles.validate())
+			return false;
+
+		if((mHeap.size() + mFreeHandles.size()) != mPositions.size())
+			return false;
+
+		for(size_type i = 0, n = mHeap.size(); i < n; ++i)
+		{
+			if((mHeap[i].mHandle >= mPositions.size()) || (mPositions[mHeap[i].mHandle] != i))
+				return false;
+		}
+
+		for(size_type i = 0, n = mFreeHandles.size(); i < n; ++i)
+		{
+			if((mFreeHandles[i] >= mPositions.size()) || (mPositions[mFreeHandles[i]] != kInvalidPosition))
+				return false;
+		}
+
+		NodeCompare compare = { mCompare };
+		return eastl::isHeap<D>(mHeap.begin(), mHeap.end(), compare);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	typename indexed_priority_queue<T, Compare, D, Allocator>::handle_type
+	indexed_priority_queue<T, Compare, D, Allocator>::DoPush(value_type&& value)
+	{
+		// Grow mHeap first, so that nothing needs to be undone if that throws.
+		mHeap.pushBack(Node{ eastl::move(value), (handle_type)0 });
+
+		handle_type handle;
+
+		if(mFreeHandles.empty())
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					mPositions.pushBack(kInvalidPosition);
+				}
+				catch(...)
+				{
+					mHeap.popBack();
+					throw;
+				}
+			#else
+				mPositions.pushBack(kInvalidPosition);
+			#endif
+
+			handle = (handle_type)(mPositions.size() - 1);
+		}
+		else
+		{
+			handle = mFreeHandles.back();
+			mFreeHandles.popBack();
+		}
+
+		mHeap.back().mHandle = handle;
+
+		DoPromote(mHeap.size() - 1);
+		return handle;
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::DoPromote(size_type position)
+	{
+		NodeCompare compare = { mCompare };
+		NodeMoved   moved   = { this };
+
+		Node temp(eastl::move(mHeap[position]));
+		Internal::promoteDaryHeap<D>(mHeap.begin(), (ptrdiff_t)0, (ptrdiff_t)position, eastl::move(temp), compare, moved);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void indexed_priority_queue<T, Compare, D, Allocator>::DoAdjust(size_type position)
+	{
+		NodeCompare compare = { mCompare };
+		NodeMoved   moved   = { this };
+
+		// The node can only move down, so position is the top of the adjustment.
+		Node temp(eastl::move(mHeap[position]));
+		Internal::adjustDaryHeap<D>(mHeap.begin(), (ptrdiff_t)position, (ptrdiff_t)mHeap.size(), (ptrdiff_t)position, eastl::move(temp), compare, moved);
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	void indexed_priority_queue<T, Compare, D, Allocator>::DoRemove(size_type position)
+	{
+		const handle_type handle = mHeap[position].mHandle;
+		const size_type   nLast  = mHeap.size() - 1;
+
+		mFreeHandles.pushBack(handle);
+		mPositions[handle] = kInvalidPosition;
+
+		if(position != nLast)
+		{
+			// Fill the hole with the last node, which may belong above or below it.
+			NodeCompare compare = { mCompare };
+			NodeMoved   moved   = { this };
+
+			Node temp(eastl::move(mHeap.back()));
+			mHeap.popBack();
+			Internal::adjustDaryHeap<D>(mHeap.begin(), (ptrdiff_t)0, (ptrdiff_t)nLast, (ptrdiff_t)position, eastl::move(temp), compare, moved);
+		}
+		else
+			mHeap.popBack();
+	}
+
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline typename indexed_priority_queue<T, Compare, D, Allocator>::size_type
+	indexed_priority_queue<T, Compare, D, Allocator>::DoGetPosition(handle_type handle, const char* pMessage) const
+	{
+#if EASTL_ASSERT_ENABLED
+		if (EASTL_UNLIKELY(!contains(handle)))
+			EASTL_FAIL_MSG(pMessage);
+#else
+		EA_UNUSED(pMessage);
+#endif
+
+		return mPositions[handle];
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Compare, size_t D, typename Allocator>
+	inline void swap(indexed_priority_queue<T, Compare, D, Allocator>& a, indexed_priority_queue<T, Compare, D, Allocator>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -21,6 +21,7 @@
 #include <eastl/internal/config.h>
 #include <eastl/type_traits.h>
 #include <eastl/algorithm.h>
+#include <eastl/internal/string_search.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <ctype.h>              // toupper, etc.
@@ -378,6 +379,11 @@ namespace eastl
 		if((p2Begin + 1) == p2End)
 			return eastl::find(p1Begin, p1End, *p2Begin);
 
+		// SIMD filter with Two-Way fallback for character types (see internal/string_search.h).
+		const T* pResult;
+		if(eastl::internal::string_search(p1Begin, p1End, p2Begin, p2End, pResult))
+			return pResult;
+
 		// General case.
 		const T* pTemp;
 		const T* pTemp1 = (p2Begin + 1);
@@ -429,6 +435,11 @@ namespace eastl
 		if((p2End - p2Begin) > (p1End - p1Begin))
 			return p1End;
 
+		// SIMD search for character types (see internal/string_search.h).
+		const T* pResult;
+		if(eastl::internal::string_rsearch(p1Begin, p1End, p2Begin, p2End, pResult))
+			return pResult;
+
 		// General case.
 		const T* pSearchEnd = (p1End - (p2End - p2Begin) + 1);
 
@@ -458,6 +469,11 @@ namespace eastl
 	template <typename T>
 	inline const T* CharTypeStringFindFirstOf(const T* p1Begin, const T* p1End, const T* p2Begin, const T* p2End)
 	{
+		// SIMD or character set search for character types (see internal/string_search.h).
+		const T* pResult;
+		if(eastl::internal::string_find_first_of(p1Begin, p1End, p2Begin, p2End, pResult))
+			return pResult;
+
 		for (; p1Begin != p1End; ++p1Begin)
 		{
 			for (const T* pTemp = p2Begin; pTemp != p2End; ++pTemp)
@@ -533,6 +549,10 @@ namespace eastl
 	template <typename T>
 	inline const T* CharTypeStringRFind(const T* pRBegin, const T* pREnd, const T c)
 	{
+		const T* pResult;
+		if(eastl::internal::string_rfind(pRBegin, pREnd, c, pResult)) // Vectorized for character types.
+			return pResult;
+
 		while (pRBegin > pREnd)
 		{
 			if (*(pRBegin - 1) == c)
@@ -944,6 +944,18 @@ namespace eastl
 #endif
 
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_BITSET_SIMD_THRESHOLD
+//
+// The bit count from which bitset uses its SSE2/AVX2 code for bulk operations
+// (&=, |=, ^=, any, count, countAnd, intersects and the find functions).
+// Smaller bitsets use plain word loops, which the compiler fully unrolls.
+//
+#ifndef EASTL_BITSET_SIMD_THRESHOLD
+	#define EASTL_BITSET_SIMD_THRESHOLD 1024
+#endif
+
+
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1785,6 +1797,20 @@ typedef EASTL_SSIZE_T eastl_ssize_t; // Signed version of eastl_size_t. Concept
 	#define EASTL_CONSTEXPR_BIT_CAST_SUPPORTED 0
 #endif
 
+/// EASTL_DESTRUCTIVE_INTERFERENCE_SIZE
+/// The alignment used to keep data which is written by different threads (e.g. the
+/// producer and consumer indices of a lock-free queue) from sharing a cache line.
+/// This is the equivalent of std::hardware_destructive_interference_size. x86-64
+/// processors prefetch cache lines in adjacent pairs, so we use two lines there.
+///
+#ifndef EASTL_DESTRUCTIVE_INTERFERENCE_SIZE
+	#if defined(EA_PROCESSOR_X86_64)
+		#define EASTL_DESTRUCTIVE_INTERFERENCE_SIZE (2 * EA_CACHE_LINE_SIZE)
+	#else
+		#define EASTL_DESTRUCTIVE_INTERFERENCE_SIZE EA_CACHE_LINE_SIZE
+	#endif
+#endif
+
 // EASTL deprecation macros:
 // 
 // EASTL_DEPRECATIONS_FOR_2024_APRIL
@@ -14,6 +14,7 @@
 
 #include <eastl/type_traits.h>
 #include <eastl/iterator.h>
+#include <eastl/internal/segmented_iterator.h>
 #include <string.h> // memcpy, memcmp, memmove
 
 
@@ -23,7 +24,8 @@ namespace eastl
 	/// copy / copy_n / copyBackward
 	///
 	/// We want to optimize move, move_n, move_backward, copy, copyBackward, copy_n to do memmove operations
-	/// when possible.
+	/// when possible. move and copy additionally split segmented ranges (see segmented_iterator_traits)
+	/// into contiguous pieces so that this optimization applies to containers such as deque as well.
 	///
 	/// We could possibly use memcpy, though it has stricter overlap requirements than the move and copy
 	/// algorithms and would require a runtime if/else to choose it over memmove. In particular, memcpy
@@ -160,6 +162,98 @@ namespace eastl
 	}
 
 
+	namespace internal
+	{
+		// Segmented iterator support for move and copy. If the input range is segmented (e.g. deque), we
+		// copy it one contiguous segment at a time. If the output is a random access segmented iterator,
+		// we split the input into chunks which fit the remainder of each output segment. Either way the
+		// innermost copy runs on raw pointers and can take advantage of memmove.
+		template <bool isMove, typename InputIterator, typename OutputIterator>
+		OutputIterator move_and_copy_segmented(InputIterator first, InputIterator last, OutputIterator result);
+
+		template <bool isMove, typename OutputIterator>
+		struct segmented_move_and_copy_op
+		{
+			OutputIterator mResult;
+
+			template <typename LocalIterator>
+			LocalIterator operator()(LocalIterator first, LocalIterator last)
+			{
+				mResult = eastl::internal::move_and_copy_segmented<isMove>(first, last, mResult);
+				return last;
+			}
+		};
+
+		template <bool isMove, typename InputIterator, typename OutputIterator, typename InputIteratorCategory, typename OutputIteratorCategory>
+		inline OutputIterator move_and_copy_to_segmented(InputIterator first, InputIterator last, OutputIterator result, InputIteratorCategory, OutputIteratorCategory)
+		{
+			return eastl::move_and_copy_chooser<isMove>(first, last, result);
+		}
+
+		template <bool isMove, typename InputIterator, typename OutputIterator>
+		OutputIterator move_and_copy_to_segmented(InputIterator first, InputIterator last, OutputIterator result,
+		                                          EASTL_ITC_NS::random_access_iterator_tag, EASTL_ITC_NS::random_access_iterator_tag)
+		{
+			typedef eastl::segmented_iterator_traits<OutputIterator>                 traits;
+			typedef typename eastl::iterator_traits<InputIterator>::difference_type difference_type;
+
+			if(first == last)
+				return result;
+
+			typename traits::segment_iterator segment = traits::segment(result);
+			typename traits::local_iterator   local   = traits::local(result);
+
+			for(;;)
+			{
+				const difference_type nRoom = (difference_type)(traits::segment_end(segment) - local);
+
+				if((last - first) < nRoom) // If the remainder fits within the current output segment...
+					return traits::compose(segment, eastl::move_and_copy_chooser<isMove>(first, last, local));
+
+				eastl::move_and_copy_chooser<isMove>(first, first + nRoom, local);
+				first += nRoom;
+
+				segment = traits::next_segment(segment);
+				local   = traits::segment_begin(segment);
+
+				if(first == last)
+					return traits::compose(segment, local);
+			}
+		}
+
+		template <bool isMove, typename InputIterator, typename OutputIterator>
+		inline OutputIterator move_and_copy_segmented_dispatch(InputIterator first, InputIterator last, OutputIterator result, false_type, false_type)
+		{
+			return eastl::move_and_copy_chooser<isMove>(first, last, result);
+		}
+
+		template <bool isMove, typename InputIterator, typename OutputIterator>
+		inline OutputIterator move_and_copy_segmented_dispatch(InputIterator first, InputIterator last, OutputIterator result, false_type, true_type)
+		{
+			typedef typename eastl::iterator_traits<InputIterator>::iterator_category  IIC;
+			typedef typename eastl::iterator_traits<OutputIterator>::iterator_category OIC;
+
+			return eastl::internal::move_and_copy_to_segmented<isMove>(first, last, result, IIC(), OIC());
+		}
+
+		template <bool isMove, typename InputIterator, typename OutputIterator, typename bOutputSegmented>
+		inline OutputIterator move_and_copy_segmented_dispatch(InputIterator first, InputIterator last, OutputIterator result, true_type, bOutputSegmented)
+		{
+			segmented_move_and_copy_op<isMove, OutputIterator> op = { result };
+			eastl::internal::segmented_walk(first, last, op);
+			return op.mResult;
+		}
+
+		template <bool isMove, typename InputIterator, typename OutputIterator>
+		inline OutputIterator move_and_copy_segmented(InputIterator first, InputIterator last, OutputIterator result)
+		{
+			return eastl::internal::move_and_copy_segmented_dispatch<isMove>(first, last, result,
+			           typename eastl::segmented_iterator_traits<InputIterator>::is_segmented_iterator(),
+			           typename eastl::segmented_iterator_traits<OutputIterator>::is_segmented_iterator());
+		}
+	}
+
+
 	// We have a second layer of unwrap_iterator calls because the original iterator might be something like move_iterator<reverse_iterator<int*> > (i.e. doubly-wrapped).
 	template <bool isMove, typename InputIterator, typename OutputIterator>
 	EASTL_REMOVE_AT_2024_SEPT inline OutputIterator move_and_copy_unwrapper(InputIterator first, InputIterator last, OutputIterator result)
@@ -193,7 +287,7 @@ namespace eastl
 	template <typename InputIterator, typename OutputIterator>
 	inline OutputIterator move(InputIterator first, InputIterator last, OutputIterator result)
 	{
-		return eastl::move_and_copy_chooser<true>(first, last, result);
+		return eastl::internal::move_and_copy_segmented<true>(first, last, result);
 	}
 
 
@@ -214,7 +308,7 @@ namespace eastl
 	template <typename InputIterator, typename OutputIterator>
 	inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result)
 	{
-		return eastl::move_and_copy_chooser<false>(first, last, result);
+		return eastl::internal::move_and_copy_segmented<false>(first, last, result);
 	}
 } // namespace eastl
 
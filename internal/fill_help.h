@@ -12,6 +12,7 @@
 #endif
 
 #include <eastl/internal/config.h>
+#include <eastl/internal/segmented_iterator.h>
 
 #if defined(EA_COMPILER_MICROSOFT) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
 #include <intrin.h>
@@ -55,6 +56,19 @@ namespace eastl
 		}
 	};
 
+	namespace internal
+	{
+		// Defined below the pointer overloads of fill, so that they are visible to it.
+		template <typename ForwardIterator, typename T>
+		void fill_segmented(ForwardIterator first, ForwardIterator last, const T& value, true_type);
+
+		template <typename ForwardIterator, typename T>
+		inline void fill_segmented(ForwardIterator first, ForwardIterator last, const T& value, false_type)
+		{
+			eastl::fill_imp< is_scalar<T>::value >::do_fill(first, last, value);
+		}
+	}
+
 	/// fill
 	///
 	/// fill is like memset in that it assigns a single value repeatedly to a 
@@ -71,10 +85,13 @@ namespace eastl
 	/// coming from within the first-last range. All std STL implementations act
 	/// as if the standard specifies that value must not come from within this range.
 	///
+	/// Segmented ranges (e.g. deque) are filled one contiguous segment at a time,
+	/// which lets the pointer overloads below do the actual work.
+	///
 	template <typename ForwardIterator, typename T>
 	inline void fill(ForwardIterator first, ForwardIterator last, const T& value)
 	{
-		eastl::fill_imp< is_scalar<T>::value >::do_fill(first, last, value);
+		eastl::internal::fill_segmented(first, last, value, typename eastl::segmented_iterator_traits<ForwardIterator>::is_segmented_iterator());
 
 		// Possibly better implementation, as it will deal with small PODs as well as scalars:
 		// bEasyCopy is true if the type has a trivial constructor (e.g. is a POD) and if 
@@ -249,6 +266,30 @@ namespace eastl
 	#endif
 
 
+	namespace internal
+	{
+		template <typename T>
+		struct segmented_fill_op
+		{
+			const T& mValue;
+
+			template <typename LocalIterator>
+			LocalIterator operator()(LocalIterator first, LocalIterator last)
+			{
+				eastl::fill(first, last, mValue);
+				return last;
+			}
+		};
+
+		template <typename ForwardIterator, typename T>
+		inline void fill_segmented(ForwardIterator first, ForwardIterator last, const T& value, true_type)
+		{
+			segmented_fill_op<T> op = { value };
+			eastl::internal::segmented_walk(first, last, op);
+		}
+	}
+
+
 
 
 	// fillN
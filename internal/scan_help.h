@@ -0,0 +1,749 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// This file implements vectorized scans over contiguous ranges of arithmetic
+// values, which algorithm.h uses for find, count, mismatch, equal,
+// minElement, maxElement and minmaxElement when the iterators are pointers.
+// They are not intended to be used directly.
+//
+// Every kernel is exposed as a scan_xxx function that takes the algorithm's
+// arguments plus an out parameter and returns true if it handled the call.
+// The generic overloads return false, so the algorithms keep their loops
+// for all other iterators and value types and the check folds away:
+//
+//    if(eastl::internal::scan_find(first, last, value, first))
+//        return first;
+//    <generic loop>
+//
+// Byte values use memchr and integral equal uses memcmp on all platforms.
+// With SSE2 (or AVX2) the other kernels compare a whole register of values
+// at a time and turn the comparison into a bit mask with movemask, which has
+// sizeof(T) bits per value. floats and doubles are compared with the floating
+// point compare instructions and so have the same semantics as operator==
+// (-0 == +0 and NaN != NaN). The min/max kernels reduce the range to its
+// smallest or largest value and then find its first (or last) position; for
+// floating point ranges they give up if they see a NaN, as NaN makes the
+// result of the generic algorithms depend on the order of the elements.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_SCAN_HELP_H
+#define EASTL_INTERNAL_SCAN_HELP_H
+
+#include <eastl/internal/config.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/type_traits.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+
+#include <stddef.h>
+#include <string.h> // memchr, memcmp
+
+#if defined(EA_COMPILER_MSVC) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+	#include <intrin.h>
+#endif
+
+#if EA_AVX2
+	#include <immintrin.h>
+#elif EASTL_SSE4_2
+	#include <nmmintrin.h>
+#elif EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SCAN_SIMD_ENABLED
+//
+// Defined as 0 or 1. Can be defined as 0 to make the algorithms use only
+// scalar code (and memchr/memcmp).
+//
+#ifndef EASTL_SCAN_SIMD_ENABLED
+	#if EA_AVX2 || EASTL_SSE2
+		#define EASTL_SCAN_SIMD_ENABLED 1
+	#else
+		#define EASTL_SCAN_SIMD_ENABLED 0
+	#endif
+#endif
+
+
+namespace eastl
+{
+	namespace internal
+	{
+		// scan_value_type
+		//
+		// The value type of a contiguous range of arithmetic values given by
+		// pointers of type Iterator, or void.
+		//
+		template <typename Iterator>
+		struct scan_value_type { typedef void type; };
+
+		template <typename T>
+		struct scan_value_type<T*>
+		{
+			typedef typename eastl::remove_cv<T>::type value_type;
+			typedef typename eastl::conditional<eastl::is_arithmetic<value_type>::value && !eastl::is_volatile<T>::value &&
+			                                    (sizeof(value_type) <= 8) && !eastl::is_same<value_type, long double>::value,
+			                                    value_type, void>::type type;
+		};
+
+
+		// scan_value_convertible
+		//
+		// Whether a value of type U that is looked for in a range of T can be
+		// converted to T first: x == value for an element x is x == T(value) if
+		// T(value) == value, and false for all x otherwise. This holds for all
+		// pairs of integral types and of floating point types, as the common type
+		// both are compared in represents every value of T exactly.
+		//
+		template <typename T, typename U>
+		struct scan_value_convertible
+			: public eastl::integral_constant<bool, (eastl::is_integral<U>::value && eastl::is_integral<T>::value && (sizeof(U) <= 8)) ||
+			                                        (eastl::is_floating_point<U>::value && eastl::is_floating_point<T>::value &&
+			                                         !eastl::is_same<U, long double>::value)> { };
+
+
+		EASTL_FORCE_INLINE uint32_t scan_first_bit(uint32_t mask) // mask != 0
+		{
+			#if defined(EA_COMPILER_MSVC) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return (uint32_t)index;
+			#elif (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+				return (uint32_t)__builtin_ctz(mask);
+			#else
+				uint32_t n = 0;
+				for(; !(mask & 1); mask >>= 1)
+					++n;
+				return n;
+			#endif
+		}
+
+		EASTL_FORCE_INLINE uint32_t scan_last_bit(uint32_t mask) // mask != 0
+		{
+			#if defined(EA_COMPILER_MSVC) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				unsigned long index;
+				_BitScanReverse(&index, mask);
+				return (uint32_t)index;
+			#elif (defined(EA_COMPILER_GNUC) || defined(EA_COMPILER_CLANG)) && !defined(EA_COMPILER_EDG)
+				return (uint32_t)(31 - __builtin_clz(mask));
+			#else
+				uint32_t n = 31;
+				for(; !(mask & 0x80000000u); mask <<= 1)
+					--n;
+				return n;
+			#endif
+		}
+
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			// scan_lanes
+			//
+			// Integer operations on the lanes of a register for each lane size N:
+			//    broadcast(x)     All lanes set to x.
+			//    eq(a, b)         All ones in the lanes where a == b.
+			//    gt(a, b)         All ones in the lanes where a > b as signed integers, if kHasGt.
+			//    sub(a, b)        a - b.
+			//
+			// scan_register holds the functions that are independent of the lane size.
+			//
+			template <size_t N>
+			struct scan_lanes;
+
+			#if EA_AVX2
+				struct scan_register
+				{
+					typedef __m256i reg;
+					static const size_t kSize = 32;
+					static const uint32_t kFullMask = 0xffffffffu;
+
+					static reg      load(const void* p)              { return _mm256_loadu_si256((const __m256i*)p); }
+					static void     store(void* p, reg v)            { _mm256_storeu_si256((__m256i*)p, v); }
+					static reg      zero()                           { return _mm256_setzero_si256(); }
+					static reg      bitAnd(reg a, reg b)             { return _mm256_and_si256(a, b); }
+					static reg      bitOr(reg a, reg b)              { return _mm256_or_si256(a, b); }
+					static reg      bitXor(reg a, reg b)             { return _mm256_xor_si256(a, b); }
+					static reg      select(reg mask, reg a, reg b)   { return _mm256_blendv_epi8(b, a, mask); } // mask ? a : b
+					static uint32_t mask(reg v)                      { return (uint32_t)_mm256_movemask_epi8(v); }
+				};
+
+				template <> struct scan_lanes<1>
+				{
+					typedef __m256i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint8_t x)  { return _mm256_set1_epi8((char)x); }
+					static reg eq(reg a, reg b)      { return _mm256_cmpeq_epi8(a, b); }
+					static reg gt(reg a, reg b)      { return _mm256_cmpgt_epi8(a, b); }
+					static reg sub(reg a, reg b)     { return _mm256_sub_epi8(a, b); }
+				};
+
+				template <> struct scan_lanes<2>
+				{
+					typedef __m256i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint16_t x) { return _mm256_set1_epi16((short)x); }
+					static reg eq(reg a, reg b)      { return _mm256_cmpeq_epi16(a, b); }
+					static reg gt(reg a, reg b)      { return _mm256_cmpgt_epi16(a, b); }
+					static reg sub(reg a, reg b)     { return _mm256_sub_epi16(a, b); }
+				};
+
+				template <> struct scan_lanes<4>
+				{
+					typedef __m256i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint32_t x) { return _mm256_set1_epi32((int)x); }
+					static reg eq(reg a, reg b)      { return _mm256_cmpeq_epi32(a, b); }
+					static reg gt(reg a, reg b)      { return _mm256_cmpgt_epi32(a, b); }
+					static reg sub(reg a, reg b)     { return _mm256_sub_epi32(a, b); }
+				};
+
+				template <> struct scan_lanes<8>
+				{
+					typedef __m256i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint64_t x) { return _mm256_set1_epi64x((long long)x); }
+					static reg eq(reg a, reg b)      { return _mm256_cmpeq_epi64(a, b); }
+					static reg gt(reg a, reg b)      { return _mm256_cmpgt_epi64(a, b); }
+					static reg sub(reg a, reg b)     { return _mm256_sub_epi64(a, b); }
+				};
+
+				// Floating point operations, with the same meaning as for the integer lanes.
+				// min/max return the lane-wise minimum or maximum and unordered has all ones
+				// in the NaN lanes.
+				struct scan_lanes_float
+				{
+					typedef __m256i reg;
+					static reg broadcast(float x)    { return _mm256_castps_si256(_mm256_set1_ps(x)); }
+					static reg eq(reg a, reg b)      { return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ)); }
+					static reg min(reg a, reg b)     { return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+					static reg max(reg a, reg b)     { return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+					static reg unordered(reg a)      { return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(a), _CMP_UNORD_Q)); }
+				};
+
+				struct scan_lanes_double
+				{
+					typedef __m256i reg;
+					static reg broadcast(double x)   { return _mm256_castpd_si256(_mm256_set1_pd(x)); }
+					static reg eq(reg a, reg b)      { return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ)); }
+					static reg min(reg a, reg b)     { return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+					static reg max(reg a, reg b)     { return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+					static reg unordered(reg a)      { return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(a), _CMP_UNORD_Q)); }
+				};
+			#else
+				struct scan_register
+				{
+					typedef __m128i reg;
+					static const size_t kSize = 16;
+					static const uint32_t kFullMask = 0xffffu;
+
+					static reg      load(const void* p)              { return _mm_loadu_si128((const __m128i*)p); }
+					static void     store(void* p, reg v)            { _mm_storeu_si128((__m128i*)p, v); }
+					static reg      zero()                           { return _mm_setzero_si128(); }
+					static reg      bitAnd(reg a, reg b)             { return _mm_and_si128(a, b); }
+					static reg      bitOr(reg a, reg b)              { return _mm_or_si128(a, b); }
+					static reg      bitXor(reg a, reg b)             { return _mm_xor_si128(a, b); }
+					static uint32_t mask(reg v)                      { return (uint32_t)_mm_movemask_epi8(v); }
+
+					#if EASTL_SSE4_2
+						static reg  select(reg mask, reg a, reg b)   { return _mm_blendv_epi8(b, a, mask); }
+					#else
+						static reg  select(reg mask, reg a, reg b)   { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+					#endif
+				};
+
+				template <> struct scan_lanes<1>
+				{
+					typedef __m128i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint8_t x)  { return _mm_set1_epi8((char)x); }
+					static reg eq(reg a, reg b)      { return _mm_cmpeq_epi8(a, b); }
+					static reg gt(reg a, reg b)      { return _mm_cmpgt_epi8(a, b); }
+					static reg sub(reg a, reg b)     { return _mm_sub_epi8(a, b); }
+				};
+
+				template <> struct scan_lanes<2>
+				{
+					typedef __m128i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint16_t x) { return _mm_set1_epi16((short)x); }
+					static reg eq(reg a, reg b)      { return _mm_cmpeq_epi16(a, b); }
+					static reg gt(reg a, reg b)      { return _mm_cmpgt_epi16(a, b); }
+					static reg sub(reg a, reg b)     { return _mm_sub_epi16(a, b); }
+				};
+
+				template <> struct scan_lanes<4>
+				{
+					typedef __m128i reg;
+					static const bool kHasGt = true;
+					static reg broadcast(uint32_t x) { return _mm_set1_epi32((int)x); }
+					static reg eq(reg a, reg b)      { return _mm_cmpeq_epi32(a, b); }
+					static reg gt(reg a, reg b)      { return _mm_cmpgt_epi32(a, b); }
+					static reg sub(reg a, reg b)     { return _mm_sub_epi32(a, b); }
+				};
+
+				template <> struct scan_lanes<8>
+				{
+					typedef __m128i reg;
+					static reg broadcast(uint64_t x) { return _mm_set1_epi64x((long long)x); }
+					static reg sub(reg a, reg b)     { return _mm_sub_epi64(a, b); }
+
+					#if EASTL_SSE4_2
+						static const bool kHasGt = true;
+						static reg eq(reg a, reg b)  { return _mm_cmpeq_epi64(a, b); }
+						static reg gt(reg a, reg b)  { return _mm_cmpgt_epi64(a, b); }
+					#else
+						static const bool kHasGt = false; // SSE2 has no 64 bit compares; equality is synthesized from the 32 bit halves.
+						static reg eq(reg a, reg b)  { const reg e = _mm_cmpeq_epi32(a, b); return _mm_and_si128(e, _mm_shuffle_epi32(e, 0xb1)); }
+					#endif
+				};
+
+				struct scan_lanes_float
+				{
+					typedef __m128i reg;
+					static reg broadcast(float x)    { return _mm_castps_si128(_mm_set1_ps(x)); }
+					static reg eq(reg a, reg b)      { return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+					static reg min(reg a, reg b)     { return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+					static reg max(reg a, reg b)     { return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+					static reg unordered(reg a)      { return _mm_castps_si128(_mm_cmpunord_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(a))); }
+				};
+
+				struct scan_lanes_double
+				{
+					typedef __m128i reg;
+					static reg broadcast(double x)   { return _mm_castpd_si128(_mm_set1_pd(x)); }
+					static reg eq(reg a, reg b)      { return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+					static reg min(reg a, reg b)     { return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+					static reg max(reg a, reg b)     { return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+					static reg unordered(reg a)      { return _mm_castpd_si128(_mm_cmpunord_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(a))); }
+				};
+			#endif
+
+
+			template <size_t N> struct scan_bits_type    { typedef uint8_t  type; };
+			template <>         struct scan_bits_type<2> { typedef uint16_t type; };
+			template <>         struct scan_bits_type<4> { typedef uint32_t type; };
+			template <>         struct scan_bits_type<8> { typedef uint64_t type; };
+
+
+			// scan_simd
+			//
+			// The operations the kernels use for a value type T:
+			//    kLanes                       The number of values per register.
+			//    kMinMax                      Whether min and max are supported.
+			//    broadcast, eq                As for scan_lanes.
+			//    min, max                     Lane-wise minimum and maximum.
+			//    unordered                    All ones in the lanes that are NaN.
+			//
+			template <typename T, bool bFloat = eastl::is_floating_point<T>::value>
+			struct scan_simd : public scan_register
+			{
+				typedef scan_lanes<sizeof(T)> lanes;
+				typedef typename scan_bits_type<sizeof(T)>::type bits_type;
+
+				static const size_t kLanes = kSize / sizeof(T);
+				static const bool   kMinMax = (sizeof(T) < 8) || lanes::kHasGt;
+
+				static reg broadcast(T x)   { return lanes::broadcast((bits_type)x); }
+				static reg eq(reg a, reg b) { return lanes::eq(a, b); }
+				static reg sub(reg a, reg b){ return lanes::sub(a, b); }
+				static reg unordered(reg)   { return zero(); }
+
+				// Unsigned values compare as signed after flipping their sign bits.
+				static reg gt(reg a, reg b)
+				{
+					if(eastl::is_signed<T>::value)
+						return lanes::gt(a, b);
+					const reg bias = lanes::broadcast((bits_type)((bits_type)1 << (sizeof(T) * 8 - 1)));
+					return lanes::gt(bitXor(a, bias), bitXor(b, bias));
+				}
+
+				static reg min(reg a, reg b) { return select(gt(a, b), b, a); }
+				static reg max(reg a, reg b) { return select(gt(a, b), a, b); }
+			};
+
+			template <typename T>
+			struct scan_simd<T, true> : public scan_register
+			{
+				typedef typename eastl::conditional<sizeof(T) == 4, scan_lanes_float, scan_lanes_double>::type lanes;
+
+				static const size_t kLanes = kSize / sizeof(T);
+				static const bool   kMinMax = true;
+
+				static reg broadcast(T x)    { return lanes::broadcast(x); }
+				static reg eq(reg a, reg b)  { return lanes::eq(a, b); }
+				static reg sub(reg a, reg b) { return scan_lanes<sizeof(T)>::sub(a, b); }
+				static reg unordered(reg a)  { return lanes::unordered(a); }
+				static reg min(reg a, reg b) { return lanes::min(a, b); }
+				static reg max(reg a, reg b) { return lanes::max(a, b); }
+			};
+
+
+			// Returns the first pointer in [first, last) to a value that is equal to value, or last.
+			template <typename T>
+			const T* scan_find_simd(const T* first, const T* last, T value)
+			{
+				typedef scan_simd<T> simd;
+				typedef typename simd::reg reg;
+
+				const reg v = simd::broadcast(value);
+
+				// Four registers at a time, with a single branch.
+				for(; (size_t)(last - first) >= (4 * simd::kLanes); first += (4 * simd::kLanes))
+				{
+					const reg e0 = simd::eq(simd::load(first),                     v);
+					const reg e1 = simd::eq(simd::load(first +     simd::kLanes), v);
+					const reg e2 = simd::eq(simd::load(first + 2 * simd::kLanes), v);
+					const reg e3 = simd::eq(simd::load(first + 3 * simd::kLanes), v);
+
+					if(simd::mask(simd::bitOr(simd::bitOr(e0, e1), simd::bitOr(e2, e3))))
+					{
+						uint32_t m;
+						if((m = simd::mask(e0)) != 0) return first +                     scan_first_bit(m) / sizeof(T);
+						if((m = simd::mask(e1)) != 0) return first +     simd::kLanes + scan_first_bit(m) / sizeof(T);
+						if((m = simd::mask(e2)) != 0) return first + 2 * simd::kLanes + scan_first_bit(m) / sizeof(T);
+						return first + 3 * simd::kLanes + scan_first_bit(simd::mask(e3)) / sizeof(T);
+					}
+				}
+
+				for(; (size_t)(last - first) >= simd::kLanes; first += simd::kLanes)
+				{
+					const uint32_t m = simd::mask(simd::eq(simd::load(first), v));
+					if(m)
+						return first + scan_first_bit(m) / sizeof(T);
+				}
+
+				while((first != last) && !(*first == value))
+					++first;
+				return first;
+			}
+
+
+			// Returns the last pointer in [first, last) to a value that is equal to value, or last.
+			template <typename T>
+			const T* scan_find_last_simd(const T* first, const T* last, T value)
+			{
+				typedef scan_simd<T> simd;
+				typedef typename simd::reg reg;
+
+				const reg v = simd::broadcast(value);
+				const T*  end = last;
+
+				while((size_t)(end - first) >= simd::kLanes)
+				{
+					end -= simd::kLanes;
+					const uint32_t m = simd::mask(simd::eq(simd::load(end), v));
+					if(m)
+						return end + scan_last_bit(m) / sizeof(T);
+				}
+
+				while(end != first)
+				{
+					if(*--end == value)
+						return end;
+				}
+				return last;
+			}
+
+
+			template <typename T>
+			size_t scan_count_simd(const T* first, const T* last, T value)
+			{
+				typedef scan_simd<T> simd;
+				typedef typename simd::reg reg;
+				typedef typename scan_bits_type<sizeof(T)>::type bits_type;
+
+				const reg v = simd::broadcast(value);
+				size_t result = 0;
+
+				while((size_t)(last - first) >= simd::kLanes)
+				{
+					// A match is all ones (-1) in its lane, so subtracting the comparison
+					// counts up per lane. Flush the counters every 255 registers so that
+					// even 8 bit lanes can't wrap.
+					size_t n = (size_t)(last - first) / simd::kLanes;
+					if(n > 255)
+						n = 255;
+
+					reg counts = simd::zero();
+					for(const T* const blockEnd = first + (n * simd::kLanes); first != blockEnd; first += simd::kLanes)
+						counts = simd::sub(counts, simd::eq(simd::load(first), v));
+
+					bits_type laneCounts[simd::kLanes];
+					simd::store(laneCounts, counts);
+					for(size_t i = 0; i < simd::kLanes; ++i)
+						result += (size_t)laneCounts[i];
+				}
+
+				for(; first != last; ++first)
+				{
+					if(*first == value)
+						++result;
+				}
+				return result;
+			}
+
+
+			// Returns the first pointer in [first1, last1) whose value is not equal to the
+			// corresponding value in first2, or last1.
+			template <typename T>
+			const T* scan_mismatch_simd(const T* first1, const T* last1, const T* first2)
+			{
+				typedef scan_simd<T> simd;
+
+				for(; (size_t)(last1 - first1) >= (2 * simd::kLanes); first1 += (2 * simd::kLanes), first2 += (2 * simd::kLanes))
+				{
+					const uint32_t m0 = simd::mask(simd::eq(simd::load(first1),                simd::load(first2)));
+					const uint32_t m1 = simd::mask(simd::eq(simd::load(first1 + simd::kLanes), simd::load(first2 + simd::kLanes)));
+
+					if((m0 & m1) != simd::kFullMask)
+					{
+						if(m0 != simd::kFullMask)
+							return first1 + scan_first_bit(~m0) / sizeof(T);
+						return first1 + simd::kLanes + scan_first_bit(~m1) / sizeof(T);
+					}
+				}
+
+				if((size_t)(last1 - first1) >= simd::kLanes)
+				{
+					const uint32_t m = simd::mask(simd::eq(simd::load(first1), simd::load(first2)));
+					if(m != simd::kFullMask)
+						return first1 + scan_first_bit(~m) / sizeof(T);
+					first1 += simd::kLanes;
+					first2 += simd::kLanes;
+				}
+
+				for(; (first1 != last1) && (*first1 == *first2); ++first1, ++first2)
+					{ }
+				return first1;
+			}
+
+
+			// Sets result to the smallest (bMax == false) or largest (bMax == true) value of
+			// [first, last), which holds at least kLanes values. Returns false if the range
+			// contains a NaN.
+			template <bool bMax, typename T>
+			bool scan_reduce_simd(const T* first, const T* last, T& result)
+			{
+				typedef scan_simd<T> simd;
+				typedef typename simd::reg reg;
+
+				reg acc = simd::load(first);
+				reg nan = simd::unordered(acc);
+
+				for(first += simd::kLanes; (size_t)(last - first) >= simd::kLanes; first += simd::kLanes)
+				{
+					const reg x = simd::load(first);
+					acc = bMax ? simd::max(acc, x) : simd::min(acc, x);
+					nan = simd::bitOr(nan, simd::unordered(x));
+				}
+
+				if(first != last) // The last register overlaps values we have seen, which min and max don't mind.
+				{
+					const reg x = simd::load(last - simd::kLanes);
+					acc = bMax ? simd::max(acc, x) : simd::min(acc, x);
+					nan = simd::bitOr(nan, simd::unordered(x));
+				}
+
+				if(simd::mask(nan))
+					return false;
+
+				T lanes[simd::kLanes];
+				simd::store(lanes, acc);
+				result = lanes[0];
+				for(size_t i = 1; i < simd::kLanes; ++i)
+				{
+					if(bMax ? (result < lanes[i]) : (lanes[i] < result))
+						result = lanes[i];
+				}
+				return true;
+			}
+		#endif // EASTL_SCAN_SIMD_ENABLED
+
+
+		// scan_find
+		//
+		template <typename Iterator, typename T>
+		inline bool scan_find(Iterator, Iterator, const T&, Iterator&)
+			{ return false; }
+
+		template <typename V, typename T>
+		inline typename eastl::enable_if<scan_value_convertible<typename scan_value_type<V*>::type, T>::value &&
+		                                 ((sizeof(V) == 1) || EASTL_SCAN_SIMD_ENABLED), bool>::type
+		scan_find(V* first, V* last, const T& value, V*& result)
+		{
+			typedef typename scan_value_type<V*>::type value_type;
+
+			const value_type x = (value_type)value;
+			if(!(x == value) || (first == last))
+				result = last;
+			else if(sizeof(value_type) == 1)
+			{
+				const void* const p = memchr(first, (int)(unsigned char)x, (size_t)(last - first));
+				result = p ? (V*)p : last;
+			}
+			else
+			{
+				#if EASTL_SCAN_SIMD_ENABLED
+					result = const_cast<V*>(eastl::internal::scan_find_simd<value_type>(first, last, x));
+				#endif
+			}
+			return true;
+		}
+
+
+		// scan_count
+		//
+		template <typename Iterator, typename T, typename Size>
+		inline bool scan_count(Iterator, Iterator, const T&, Size&)
+			{ return false; }
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			template <typename V, typename T, typename Size>
+			inline typename eastl::enable_if<scan_value_convertible<typename scan_value_type<V*>::type, T>::value, bool>::type
+			scan_count(V* first, V* last, const T& value, Size& result)
+			{
+				typedef typename scan_value_type<V*>::type value_type;
+
+				const value_type x = (value_type)value;
+				result = (x == value) ? (Size)eastl::internal::scan_count_simd<value_type>(first, last, x) : 0;
+				return true;
+			}
+		#endif
+
+
+		// scan_mismatch
+		//
+		template <typename Iterator1, typename Iterator2, typename Pair>
+		inline bool scan_mismatch(Iterator1, Iterator1, Iterator2, Pair&)
+			{ return false; }
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			template <typename V1, typename V2, typename Pair>
+			inline typename eastl::enable_if<!eastl::is_void<typename scan_value_type<V1*>::type>::value &&
+			                                 eastl::is_same<typename scan_value_type<V1*>::type, typename scan_value_type<V2*>::type>::value, bool>::type
+			scan_mismatch(V1* first1, V1* last1, V2* first2, Pair& result)
+			{
+				typedef typename scan_value_type<V1*>::type value_type;
+
+				result.first  = const_cast<V1*>(eastl::internal::scan_mismatch_simd<value_type>(first1, last1, first2));
+				result.second = first2 + (result.first - first1);
+				return true;
+			}
+		#endif
+
+
+		// scan_equal
+		//
+		// Integral values are equal if their bytes are, so memcmp does the work.
+		// Floating point values are not (-0 == +0 and NaN != NaN) and use mismatch.
+		//
+		template <typename Iterator1, typename Iterator2>
+		inline bool scan_equal(Iterator1, Iterator1, Iterator2, bool&)
+			{ return false; }
+
+		template <typename V1, typename V2>
+		inline typename eastl::enable_if<eastl::is_integral<typename scan_value_type<V1*>::type>::value &&
+		                                 eastl::is_same<typename scan_value_type<V1*>::type, typename scan_value_type<V2*>::type>::value, bool>::type
+		scan_equal(V1* first1, V1* last1, V2* first2, bool& result)
+		{
+			result = (first1 == last1) || (memcmp(first1, first2, (size_t)((const char*)last1 - (const char*)first1)) == 0);
+			return true;
+		}
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			template <typename V1, typename V2>
+			inline typename eastl::enable_if<eastl::is_floating_point<typename scan_value_type<V1*>::type>::value &&
+			                                 eastl::is_same<typename scan_value_type<V1*>::type, typename scan_value_type<V2*>::type>::value, bool>::type
+			scan_equal(V1* first1, V1* last1, V2* first2, bool& result)
+			{
+				typedef typename scan_value_type<V1*>::type value_type;
+
+				result = (eastl::internal::scan_mismatch_simd<value_type>(first1, last1, first2) == last1);
+				return true;
+			}
+		#endif
+
+
+		// scan_min_element, scan_max_element, scan_minmax_element
+		//
+		// These only handle ranges of at least one register of values. The
+		// results are the same as those of the generic algorithms: the first
+		// smallest value, the first largest value for maxElement and the last
+		// largest value for minmaxElement.
+		//
+		template <typename Iterator>
+		inline bool scan_min_element(Iterator, Iterator, Iterator&)
+			{ return false; }
+
+		template <typename Iterator>
+		inline bool scan_max_element(Iterator, Iterator, Iterator&)
+			{ return false; }
+
+		template <typename Iterator, typename Pair>
+		inline bool scan_minmax_element(Iterator, Iterator, Pair&)
+			{ return false; }
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			template <typename Iterator, typename T = typename scan_value_type<Iterator>::type, bool bEnabled = !eastl::is_void<T>::value>
+			struct scan_minmax_enabled : public eastl::false_type { };
+
+			template <typename Iterator, typename T>
+			struct scan_minmax_enabled<Iterator, T, true> : public eastl::integral_constant<bool, scan_simd<T>::kMinMax> { };
+
+			template <typename V>
+			inline typename eastl::enable_if<scan_minmax_enabled<V*>::value, bool>::type
+			scan_min_element(V* first, V* last, V*& result)
+			{
+				typedef typename scan_value_type<V*>::type value_type;
+
+				value_type m;
+				if(((size_t)(last - first) < scan_simd<value_type>::kLanes) || !eastl::internal::scan_reduce_simd<false>((const value_type*)first, (const value_type*)last, m))
+					return false;
+				result = const_cast<V*>(eastl::internal::scan_find_simd<value_type>(first, last, m));
+				return true;
+			}
+
+			template <typename V>
+			inline typename eastl::enable_if<scan_minmax_enabled<V*>::value, bool>::type
+			scan_max_element(V* first, V* last, V*& result)
+			{
+				typedef typename scan_value_type<V*>::type value_type;
+
+				value_type m;
+				if(((size_t)(last - first) < scan_simd<value_type>::kLanes) || !eastl::internal::scan_reduce_simd<true>((const value_type*)first, (const value_type*)last, m))
+					return false;
+				result = const_cast<V*>(eastl::internal::scan_find_simd<value_type>(first, last, m));
+				return true;
+			}
+
+			template <typename V, typename Pair>
+			inline typename eastl::enable_if<scan_minmax_enabled<V*>::value, bool>::type
+			scan_minmax_element(V* first, V* last, Pair& result)
+			{
+				typedef typename scan_value_type<V*>::type value_type;
+
+				value_type lo, hi;
+				if(((size_t)(last - first) < scan_simd<value_type>::kLanes) ||
+				   !eastl::internal::scan_reduce_simd<false>((const value_type*)first, (const value_type*)last, lo) ||
+				   !eastl::internal::scan_reduce_simd<true>((const value_type*)first, (const value_type*)last, hi))
+					return false;
+				result.first  = const_cast<V*>(eastl::internal::scan_find_simd<value_type>(first, last, lo));
+				result.second = const_cast<V*>(eastl::internal::scan_find_last_simd<value_type>(first, last, hi));
+				return true;
+			}
+		#endif
+
+	} // namespace internal
+
+} // namespace eastl
+
+#endif // Header include guard
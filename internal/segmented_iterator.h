@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_SEGMENTED_ITERATOR_H
+#define EASTL_INTERNAL_SEGMENTED_ITERATOR_H
+
+#include <eastl/internal/config.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/type_traits.h>
+
+
+namespace eastl
+{
+	/// segmented_iterator_traits
+	///
+	/// Describes iterators of containers which store their elements as a sequence
+	/// of contiguous segments, such as deque and segmented_vector (see Austern,
+	/// "Segmented Iterators and Hierarchical Algorithms"). Algorithms such as
+	/// forEach, find, fill and copy use this to run their inner loop over raw
+	/// pointer ranges, one segment at a time, instead of paying for a segment
+	/// boundary check on every increment. That inner loop is also something the
+	/// compiler can vectorize.
+	///
+	/// The primary template describes a non-segmented iterator. A container
+	/// opts in by specializing it for its iterator type and providing:
+	///
+	///     typedef true_type is_segmented_iterator;
+	///     typedef <...>     segment_iterator;     // Identifies a segment. Must be equality comparable.
+	///     typedef <...>     local_iterator;       // Iterates the elements of a segment; normally T*.
+	///
+	///     static segment_iterator segment(const Iterator& it);                               // The segment it lies in.
+	///     static local_iterator   local(const Iterator& it);                                 // The position of it within its segment.
+	///     static local_iterator   segment_begin(segment_iterator s);                         // The first element of s.
+	///     static local_iterator   segment_end(segment_iterator s);                           // One past the last element of s.
+	///     static local_iterator   segment_end(segment_iterator s, const Iterator& last);     // One past the last element of s which precedes last.
+	///     static bool             is_final_segment(segment_iterator s, const Iterator& last); // True if last lies within s (or is the end of the container and s is its last segment).
+	///     static segment_iterator next_segment(segment_iterator s);
+	///     static Iterator         compose(segment_iterator s, local_iterator l);             // Builds a normalized container iterator from s and l.
+	///
+	template <typename Iterator>
+	struct segmented_iterator_traits
+	{
+		typedef false_type is_segmented_iterator;
+	};
+
+
+	namespace internal
+	{
+		/// segmented_walk
+		///
+		/// Splits the segmented range [first, last) into its contiguous local
+		/// ranges and calls op(localFirst, localLast) on each of them in order.
+		/// op returns the local position at which it stopped; returning anything
+		/// other than localLast ends the walk, and the corresponding container
+		/// iterator is returned. If op never stops early, last is returned.
+		///
+		template <typename SegmentedIterator, typename Operation>
+		inline SegmentedIterator segmented_walk(SegmentedIterator first, SegmentedIterator last, Operation& op)
+		{
+			typedef eastl::segmented_iterator_traits<SegmentedIterator> traits;
+			typedef typename traits::segment_iterator                    segment_iterator;
+			typedef typename traits::local_iterator                      local_iterator;
+
+			if(first == last)
+				return last;
+
+			segment_iterator segment    = traits::segment(first);
+			local_iterator   localFirst = traits::local(first);
+
+			for(;;)
+			{
+				const bool           bFinal    = traits::is_final_segment(segment, last);
+				const local_iterator localLast = bFinal ? traits::segment_end(segment, last) : traits::segment_end(segment);
+				const local_iterator localStop = op(localFirst, localLast);
+
+				if(localStop != localLast)
+					return traits::compose(segment, localStop);
+
+				if(bFinal)
+					return last;
+
+				segment    = traits::next_segment(segment);
+				localFirst = traits::segment_begin(segment);
+			}
+		}
+	}
+
+} // namespace eastl
+
+#endif // EASTL_INTERNAL_SEGMENTED_ITERATOR_H
@@ -0,0 +1,600 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// This file implements SIMD sorting networks for small arrays of up to
+// EASTL_SORT_NETWORK_MAX (64) elements of 32 and 64 bit integers, float and
+// double. They are used by eastl::small_sort and as the leaves of eastl::sort
+// (see sort.h) and are not intended to be used directly.
+//
+// The elements are loaded into R SIMD registers of L lanes each, padded up
+// to the next power of two P = R * L with the largest key, and sorted by a
+// bitonic sorting network in the registers. A bitonic network of P elements
+// has log2(P) * (log2(P) + 1) / 2 steps, each of which compares and swaps
+// P / 2 pairs of elements:
+//    - pairs in different registers are a min and a max of two registers;
+//    - pairs within one register (distance < L) additionally need a lane
+//      permutation and a blend.
+// We use the variant of the network in which the first step of each merge
+// pairs element i with element i ^ (K - 1) (which reverses the second half
+// of the merged runs) so that every pair sorts in the same direction.
+//
+// float and double are sorted as the integers
+//    bits ^ ((bits >> (N - 1)) & 0x7ff..f)
+// which order like the floating point values, except that -0 sorts before
+// +0 and NaNs sort to the ends instead of breaking the network. This
+// also preserves the bits of all values, which min/max instructions do not.
+//
+// With AVX2 all types are supported with 8 (32 bit) or 4 (64 bit) lanes.
+// With SSE4.1 only 32 bit types are supported with 4 lanes, unless SSE4.2
+// is available as well, which adds 64 bit types with 2 lanes.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_SORT_NETWORK_H
+#define EASTL_INTERNAL_SORT_NETWORK_H
+
+#include <eastl/internal/config.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/type_traits.h>
+#include <eastl/functional.h>
+#include <string.h> // memcpy
+
+EA_DISABLE_ALL_VC_WARNINGS();
+
+#if EA_AVX2
+	#include <immintrin.h>
+#elif EASTL_SSE4_2
+	#include <nmmintrin.h>
+#elif EASTL_SSE4_1
+	#include <smmintrin.h>
+#endif
+
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SORT_NETWORK_ENABLED
+//
+// Defined as 0 or 1. Can be defined as 0 to make small_sort and sort use
+// only scalar code.
+//
+#ifndef EASTL_SORT_NETWORK_ENABLED
+	#if EA_AVX2 || EASTL_SSE4_1
+		#define EASTL_SORT_NETWORK_ENABLED 1
+	#else
+		#define EASTL_SORT_NETWORK_ENABLED 0
+	#endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_SORT_NETWORK_MAX
+//
+// The largest number of elements the sorting networks sort.
+//
+#define EASTL_SORT_NETWORK_MAX 64
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		enum sort_network_kind_type
+		{
+			kSortNetworkNone,
+			kSortNetworkInt32,
+			kSortNetworkUInt32,
+			kSortNetworkFloat,
+			kSortNetworkInt64,
+			kSortNetworkUInt64,
+			kSortNetworkDouble
+		};
+
+		template <typename T>
+		struct sort_network_kind
+		{
+			static const bool kInteger = eastl::is_integral<T>::value && !eastl::is_same<T, bool>::value;
+
+			static const sort_network_kind_type value =
+				eastl::is_same<T, float>::value                  ? kSortNetworkFloat  :
+				eastl::is_same<T, double>::value                 ? kSortNetworkDouble :
+				(kInteger && (sizeof(T) == 4))                   ? (eastl::is_signed<T>::value ? kSortNetworkInt32 : kSortNetworkUInt32) :
+				(kInteger && (sizeof(T) == 8))                   ? (eastl::is_signed<T>::value ? kSortNetworkInt64 : kSortNetworkUInt64) :
+				                                                   kSortNetworkNone;
+		};
+
+
+		// The order in which a comparison sorts: 1 for less, -1 for greater and 0 for anything else.
+		template <typename Compare, typename T>
+		struct sort_network_order                                { static const int value = 0; };
+
+		template <typename T>
+		struct sort_network_order<eastl::less<T>, T>             { static const int value = 1; };
+
+		template <typename T>
+		struct sort_network_order<eastl::less<void>, T>          { static const int value = 1; };
+
+		template <typename T>
+		struct sort_network_order<eastl::greater<T>, T>          { static const int value = -1; };
+
+		template <typename T>
+		struct sort_network_order<eastl::greater<void>, T>       { static const int value = -1; };
+
+
+		// The immediate for a 4 lane shuffle with lane i taken from lane i ^ X.
+		template <int X>
+		struct sort_network_shuffle_mask
+		{
+			static const int value = (0 ^ X) | ((1 ^ X) << 2) | ((2 ^ X) << 4) | ((3 ^ X) << 6);
+		};
+
+		// The immediate for a blend of Lanes lanes of Width bits each, in which lane i is taken
+		// from the second operand if (i & Bit) != 0.
+		template <int Bit, int Lanes, int Width>
+		struct sort_network_blend_mask
+		{
+			static const int value = sort_network_blend_mask<Bit, Lanes - 1, Width>::value |
+			                         ((((Lanes - 1) & Bit) ? ((1 << Width) - 1) : 0) << ((Lanes - 1) * Width));
+		};
+
+		template <int Bit, int Width>
+		struct sort_network_blend_mask<Bit, 0, Width>
+		{
+			static const int value = 0;
+		};
+
+
+		// sort_network_traits
+		//
+		// Each supported value type has a simd type which provides:
+		//    reg, key_type, kLanes    The register type, its lane type and the number of lanes.
+		//    load, store              Unaligned loads and stores of a register.
+		//    toKey, fromKey           Conversion between the bits of values and the keys they sort by.
+		//    minmax(a, b)             Sets a to the lane-wise minimum of a and b, and b to the maximum.
+		//    permute<X>               Lane i of the result is lane i ^ X of the argument.
+		//    blend<Bit>(lo, hi)       Lane i of the result is lane i of hi if (i & Bit) != 0, else of lo.
+		//
+		template <typename T, sort_network_kind_type Kind = sort_network_kind<T>::value>
+		struct sort_network_traits : public eastl::false_type { };
+
+		#if EASTL_SORT_NETWORK_ENABLED
+			#if EA_AVX2
+				struct sort_network_simd_int32
+				{
+					typedef __m256i reg;
+					typedef int32_t key_type;
+					static const int kLanes = 8;
+
+					static reg  load(const void* p)           { return _mm256_loadu_si256((const __m256i*)p); }
+					static void store(void* p, reg v)         { _mm256_storeu_si256((__m256i*)p, v); }
+					static reg  toKey(reg v)                  { return v; }
+					static reg  fromKey(reg v)                { return v; }
+					static void minmax(reg& a, reg& b)        { const reg m = _mm256_min_epi32(a, b); b = _mm256_max_epi32(a, b); a = m; }
+
+					template <int X>
+					static reg permute(reg v)                 { return permute(v, eastl::integral_constant<int, X>(), eastl::integral_constant<bool, (X < 4)>()); }
+
+					template <int X>
+					static reg permute(reg v, eastl::integral_constant<int, X>, eastl::true_type) // Within 128 bit halves.
+						{ const int kMask = sort_network_shuffle_mask<X>::value; return _mm256_shuffle_epi32(v, kMask); }
+
+					template <int X>
+					static reg permute(reg v, eastl::integral_constant<int, X>, eastl::false_type)
+						{ return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ X, 1 ^ X, 2 ^ X, 3 ^ X, 4 ^ X, 5 ^ X, 6 ^ X, 7 ^ X)); }
+
+					template <int Bit>
+					static reg blend(reg lo, reg hi)          { const int kMask = sort_network_blend_mask<Bit, 8, 1>::value; return _mm256_blend_epi32(lo, hi, kMask); }
+				};
+
+				struct sort_network_simd_uint32 : public sort_network_simd_int32
+				{
+					static void minmax(reg& a, reg& b)        { const reg m = _mm256_min_epu32(a, b); b = _mm256_max_epu32(a, b); a = m; }
+				};
+
+				struct sort_network_simd_float : public sort_network_simd_int32
+				{
+					static reg toKey(reg v)                   { return _mm256_xor_si256(v, _mm256_srli_epi32(_mm256_srai_epi32(v, 31), 1)); }
+					static reg fromKey(reg v)                 { return toKey(v); }
+				};
+
+				struct sort_network_simd_int64
+				{
+					typedef __m256i reg;
+					typedef int64_t key_type;
+					static const int kLanes = 4;
+
+					static reg  load(const void* p)           { return _mm256_loadu_si256((const __m256i*)p); }
+					static void store(void* p, reg v)         { _mm256_storeu_si256((__m256i*)p, v); }
+					static reg  toKey(reg v)                  { return v; }
+					static reg  fromKey(reg v)                { return v; }
+
+					static void minmax(reg& a, reg& b)
+					{
+						const reg greater = _mm256_cmpgt_epi64(a, b);
+						const reg m = _mm256_blendv_epi8(a, b, greater);
+						b = _mm256_blendv_epi8(b, a, greater);
+						a = m;
+					}
+
+					template <int X>
+					static reg permute(reg v)                 { const int kMask = sort_network_shuffle_mask<X>::value; return _mm256_permute4x64_epi64(v, kMask); }
+
+					template <int Bit>
+					static reg blend(reg lo, reg hi)          { const int kMask = sort_network_blend_mask<Bit, 4, 2>::value; return _mm256_blend_epi32(lo, hi, kMask); }
+				};
+
+				struct sort_network_simd_uint64 : public sort_network_simd_int64
+				{
+					static reg toKey(reg v)                   { return _mm256_xor_si256(v, _mm256_set1_epi64x(INT64_MIN)); }
+					static reg fromKey(reg v)                 { return toKey(v); }
+				};
+
+				struct sort_network_simd_double : public sort_network_simd_int64
+				{
+					static reg toKey(reg v)                   { return _mm256_xor_si256(v, _mm256_srli_epi64(_mm256_cmpgt_epi64(_mm256_setzero_si256(), v), 1)); }
+					static reg fromKey(reg v)                 { return toKey(v); }
+				};
+
+				#define EASTL_SORT_NETWORK_64 1
+			#else
+				struct sort_network_simd_int32
+				{
+					typedef __m128i reg;
+					typedef int32_t key_type;
+					static const int kLanes = 4;
+
+					static reg  load(const void* p)           { return _mm_loadu_si128((const __m128i*)p); }
+					static void store(void* p, reg v)         { _mm_storeu_si128((__m128i*)p, v); }
+					static reg  toKey(reg v)                  { return v; }
+					static reg  fromKey(reg v)                { return v; }
+					static void minmax(reg& a, reg& b)        { const reg m = _mm_min_epi32(a, b); b = _mm_max_epi32(a, b); a = m; }
+
+					template <int X>
+					static reg permute(reg v)                 { const int kMask = sort_network_shuffle_mask<X>::value; return _mm_shuffle_epi32(v, kMask); }
+
+					template <int Bit>
+					static reg blend(reg lo, reg hi)          { const int kMask = sort_network_blend_mask<Bit, 4, 2>::value; return _mm_blend_epi16(lo, hi, kMask); }
+				};
+
+				struct sort_network_simd_uint32 : public sort_network_simd_int32
+				{
+					static void minmax(reg& a, reg& b)        { const reg m = _mm_min_epu32(a, b); b = _mm_max_epu32(a, b); a = m; }
+				};
+
+				struct sort_network_simd_float : public sort_network_simd_int32
+				{
+					static reg toKey(reg v)                   { return _mm_xor_si128(v, _mm_srli_epi32(_mm_srai_epi32(v, 31), 1)); }
+					static reg fromKey(reg v)                 { return toKey(v); }
+				};
+
+				#if EASTL_SSE4_2 // _mm_cmpgt_epi64
+					struct sort_network_simd_int64
+					{
+						typedef __m128i reg;
+						typedef int64_t key_type;
+						static const int kLanes = 2;
+
+						static reg  load(const void* p)       { return _mm_loadu_si128((const __m128i*)p); }
+						static void store(void* p, reg v)     { _mm_storeu_si128((__m128i*)p, v); }
+						static reg  toKey(reg v)              { return v; }
+						static reg  fromKey(reg v)            { return v; }
+
+						static void minmax(reg& a, reg& b)
+						{
+							const reg greater = _mm_cmpgt_epi64(a, b);
+							const reg m = _mm_blendv_epi8(a, b, greater);
+							b = _mm_blendv_epi8(b, a, greater);
+							a = m;
+						}
+
+						template <int X>
+						static reg permute(reg v)             { static_assert(X == 1, "two lanes"); return _mm_shuffle_epi32(v, 0x4e); }
+
+						template <int Bit>
+						static reg blend(reg lo, reg hi)      { static_assert(Bit == 1, "two lanes"); return _mm_blend_epi16(lo, hi, 0xf0); }
+					};
+
+					struct sort_network_simd_uint64 : public sort_network_simd_int64
+					{
+						static reg toKey(reg v)               { return _mm_xor_si128(v, _mm_set1_epi64x(INT64_MIN)); }
+						static reg fromKey(reg v)             { return toKey(v); }
+					};
+
+					struct sort_network_simd_double : public sort_network_simd_int64
+					{
+						static reg toKey(reg v)               { return _mm_xor_si128(v, _mm_srli_epi64(_mm_cmpgt_epi64(_mm_setzero_si128(), v), 1)); }
+						static reg fromKey(reg v)             { return toKey(v); }
+					};
+
+					#define EASTL_SORT_NETWORK_64 1
+				#else
+					#define EASTL_SORT_NETWORK_64 0
+				#endif
+			#endif
+
+			// maxValueBits is the value (as bits of the key type) whose key is the largest key. It is a
+			// positive NaN for the floating point types.
+			template <typename T>
+			struct sort_network_traits<T, kSortNetworkInt32>  : public eastl::true_type { typedef sort_network_simd_int32  simd; static int32_t  maxValueBits() { return INT32_MAX; } };
+
+			template <typename T>
+			struct sort_network_traits<T, kSortNetworkUInt32> : public eastl::true_type { typedef sort_network_simd_uint32 simd; static int32_t  maxValueBits() { return -1; } };
+
+			template <typename T>
+			struct sort_network_traits<T, kSortNetworkFloat>  : public eastl::true_type { typedef sort_network_simd_float  simd; static int32_t  maxValueBits() { return INT32_MAX; } };
+
+			#if EASTL_SORT_NETWORK_64
+				template <typename T>
+				struct sort_network_traits<T, kSortNetworkInt64>  : public eastl::true_type { typedef sort_network_simd_int64  simd; static int64_t  maxValueBits() { return INT64_MAX; } };
+
+				template <typename T>
+				struct sort_network_traits<T, kSortNetworkUInt64> : public eastl::true_type { typedef sort_network_simd_uint64 simd; static int64_t  maxValueBits() { return -1; } };
+
+				template <typename T>
+				struct sort_network_traits<T, kSortNetworkDouble> : public eastl::true_type { typedef sort_network_simd_double simd; static int64_t  maxValueBits() { return INT64_MAX; } };
+			#endif
+
+
+			// Applies op to the registers 0, ..., R - 1. This unrolls the loop at compile time, which both
+			// gives the ops constant register indexes and keeps the registers out of memory.
+			template <int R, int I = 0, bool Done = (I == R)>
+			struct sort_network_for_each_register
+			{
+				template <typename Op>
+				static EASTL_FORCE_INLINE void run(Op& op, typename Op::reg* v)
+				{
+					op.template apply<I>(v);
+					sort_network_for_each_register<R, I + 1>::run(op, v);
+				}
+			};
+
+			template <int R, int I>
+			struct sort_network_for_each_register<R, I, true>
+			{
+				template <typename Op>
+				static EASTL_FORCE_INLINE void run(Op&, typename Op::reg*) { }
+			};
+
+
+			// The first step of the merge of runs of K / 2 into runs of K: element i is paired with element i ^ (K - 1).
+			template <typename Simd, int K, bool InRegister = (K <= Simd::kLanes)>
+			struct sort_network_flip
+			{
+				typedef typename Simd::reg reg;
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v)
+				{
+					reg lo(v[I]), hi(Simd::template permute<K - 1>(v[I]));
+					Simd::minmax(lo, hi);
+					v[I] = Simd::template blend<K / 2>(lo, hi);
+				}
+			};
+
+			template <typename Simd, int K>
+			struct sort_network_flip<Simd, K, false>
+			{
+				typedef typename Simd::reg reg;
+
+				static const int kBlock = K / Simd::kLanes; // In registers.
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v)
+				{
+					apply<I, (I ^ (kBlock - 1))>(v, eastl::integral_constant<bool, ((I & (kBlock / 2)) == 0)>());
+				}
+
+				template <int I, int Q>
+				EASTL_FORCE_INLINE void apply(reg* v, eastl::true_type)
+				{
+					reg lo(v[I]), hi(Simd::template permute<Simd::kLanes - 1>(v[Q]));
+					Simd::minmax(lo, hi);
+					v[I] = lo;
+					v[Q] = Simd::template permute<Simd::kLanes - 1>(hi);
+				}
+
+				template <int I, int Q>
+				EASTL_FORCE_INLINE void apply(reg*, eastl::false_type) { }
+			};
+
+
+			// The remaining steps of a merge: element i is paired with element i ^ J, for J = K / 4, ..., 1.
+			template <typename Simd, int J, bool InRegister = (J < Simd::kLanes)>
+			struct sort_network_half_cleaner
+			{
+				typedef typename Simd::reg reg;
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v)
+				{
+					reg lo(v[I]), hi(Simd::template permute<J>(v[I]));
+					Simd::minmax(lo, hi);
+					v[I] = Simd::template blend<J>(lo, hi);
+				}
+			};
+
+			template <typename Simd, int J>
+			struct sort_network_half_cleaner<Simd, J, false>
+			{
+				typedef typename Simd::reg reg;
+
+				static const int kDistance = J / Simd::kLanes; // In registers.
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v)
+				{
+					apply<I>(v, eastl::integral_constant<bool, ((I & kDistance) == 0)>());
+				}
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v, eastl::true_type) { Simd::minmax(v[I], v[I | kDistance]); }
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg*, eastl::false_type) { }
+			};
+
+			template <typename Simd, int R, int J, bool Done = (J == 0)>
+			struct sort_network_cleaner
+			{
+				static EASTL_FORCE_INLINE void run(typename Simd::reg* v)
+				{
+					sort_network_half_cleaner<Simd, J> op;
+					sort_network_for_each_register<R>::run(op, v);
+					sort_network_cleaner<Simd, R, J / 2>::run(v);
+				}
+			};
+
+			template <typename Simd, int R, int J>
+			struct sort_network_cleaner<Simd, R, J, true>
+			{
+				static EASTL_FORCE_INLINE void run(typename Simd::reg*) { }
+			};
+
+
+			// Sorts R registers by merging runs of 1 into runs of 2, runs of 2 into runs of 4, and so on.
+			template <typename Simd, int R, int K = 2, bool Done = (K > R * Simd::kLanes)>
+			struct sort_network_bitonic
+			{
+				static EASTL_FORCE_INLINE void run(typename Simd::reg* v)
+				{
+					sort_network_flip<Simd, K> op;
+					sort_network_for_each_register<R>::run(op, v);
+					sort_network_cleaner<Simd, R, K / 4>::run(v);
+					sort_network_bitonic<Simd, R, K * 2>::run(v);
+				}
+			};
+
+			template <typename Simd, int R, int K>
+			struct sort_network_bitonic<Simd, R, K, true>
+			{
+				static EASTL_FORCE_INLINE void run(typename Simd::reg*) { }
+			};
+
+
+			// Loads register I from the n elements at p. Only register n / kLanes can be partial; it and the
+			// registers after it are padded with the largest key.
+			template <typename T>
+			struct sort_network_load
+			{
+				typedef sort_network_traits<T>  traits;
+				typedef typename traits::simd   simd;
+				typedef typename simd::reg      reg;
+				typedef typename simd::key_type key_type;
+
+				const T* mp;
+				size_t   mnFull;
+				reg      mPartial;
+				reg      mPadding;
+
+				sort_network_load(const T* p, size_t n)
+					: mp(p), mnFull(n / simd::kLanes)
+				{
+					key_type temp[simd::kLanes];
+
+					for(int i = 0; i < simd::kLanes; ++i)
+						temp[i] = traits::maxValueBits();
+					mPadding = simd::toKey(simd::load(temp));
+
+					memcpy(temp, p + (mnFull * simd::kLanes), (n % simd::kLanes) * sizeof(T));
+					mPartial = simd::toKey(simd::load(temp));
+				}
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v)
+				{
+					if((size_t)I < mnFull)
+						v[I] = simd::toKey(simd::load(mp + I * simd::kLanes));
+					else
+						v[I] = ((size_t)I == mnFull) ? mPartial : mPadding;
+				}
+			};
+
+			// Stores register I to the n elements at p, with the partial register going to mPartial.
+			template <typename T>
+			struct sort_network_store
+			{
+				typedef sort_network_traits<T>  traits;
+				typedef typename traits::simd   simd;
+				typedef typename simd::reg      reg;
+				typedef typename simd::key_type key_type;
+
+				T*       mp;
+				size_t   mnFull;
+				key_type mPartial[simd::kLanes];
+
+				sort_network_store(T* p, size_t n)
+					: mp(p), mnFull(n / simd::kLanes) { }
+
+				template <int I>
+				EASTL_FORCE_INLINE void apply(reg* v)
+				{
+					if((size_t)I < mnFull)
+						simd::store(mp + I * simd::kLanes, simd::fromKey(v[I]));
+					else if((size_t)I == mnFull)
+						simd::store(mPartial, simd::fromKey(v[I]));
+				}
+			};
+
+
+			// Sorts the n elements at p, with n <= R * kLanes.
+			template <typename T, int R>
+			void sort_network_registers(T* p, size_t n)
+			{
+				typedef typename sort_network_traits<T>::simd simd;
+
+				typename simd::reg    v[R];
+				sort_network_load<T>  load(p, n);
+				sort_network_store<T> store(p, n);
+
+				sort_network_for_each_register<R>::run(load, v);
+				sort_network_bitonic<simd, R>::run(v);
+				sort_network_for_each_register<R>::run(store, v);
+
+				memcpy(p + (store.mnFull * simd::kLanes), store.mPartial, (n % simd::kLanes) * sizeof(T));
+			}
+
+
+			// Picks the smallest number of registers R for n elements.
+			template <typename T, int R = 1, bool Last = (R * sort_network_traits<T>::simd::kLanes >= EASTL_SORT_NETWORK_MAX)>
+			struct sort_network_dispatch
+			{
+				static void run(T* p, size_t n)
+				{
+					if(n <= (size_t)(R * sort_network_traits<T>::simd::kLanes))
+						sort_network_registers<T, R>(p, n);
+					else
+						sort_network_dispatch<T, R * 2>::run(p, n);
+				}
+			};
+
+			template <typename T, int R>
+			struct sort_network_dispatch<T, R, true>
+			{
+				static void run(T* p, size_t n)
+				{
+					sort_network_registers<T, R>(p, n);
+				}
+			};
+
+
+			// Sorts the n elements at p into ascending order, for 0 < n <= EASTL_SORT_NETWORK_MAX.
+			template <typename T>
+			inline void sort_network(T* p, size_t n)
+			{
+				EASTL_ASSERT((n > 0) && (n <= EASTL_SORT_NETWORK_MAX));
+				sort_network_dispatch<T>::run(p, n);
+			}
+
+		#endif // EASTL_SORT_NETWORK_ENABLED
+
+	} // namespace Internal
+
+} // namespace eastl
+
+
+#endif // Header include guard
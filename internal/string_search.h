@@ -0,0 +1,478 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// This file implements the substring and character set searches behind
+// CharTypeStringSearch, CharTypeStringRSearch, CharTypeStringRFind and
+// CharTypeStringFindFirstOf (see char_traits.h), and so behind the find,
+// rfind and findFirstOf functions of basicString and basicString_view.
+// They are not intended to be used directly.
+//
+// Substring search (for a needle of m >= 2 characters):
+//    - The SSE2/AVX2 kernels compare a register of candidate positions at a
+//      time against the first and the last character of the needle (loaded
+//      m - 1 characters apart) and only verify the positions where both match,
+//      with memcmp. For most text that rejects nearly all positions with two
+//      compares per register.
+//    - Repetitive text can make most positions candidates and each
+//      verification cost up to m compares. For needles of at least
+//      EASTL_STRING_SEARCH_TWO_WAY_MIN characters the filter counts the
+//      characters it verifies, and once that exceeds a few times the
+//      characters it has scanned, it continues with the Two-Way algorithm
+//      (Crochemore-Perrin), which is linear in the length of the text.
+//    - Without SIMD, needles of at least EASTL_STRING_SEARCH_TWO_WAY_MIN
+//      characters use Two-Way directly and shorter ones the generic loop.
+//    - rfind uses the same filter, scanning backwards, without the fallback.
+//
+// findFirstOf with a set of a few characters compares each register against
+// all of them. Larger sets of characters below 256 are looked up in a 256 bit
+// set, one character at a time.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_STRING_SEARCH_H
+#define EASTL_INTERNAL_STRING_SEARCH_H
+
+#include <eastl/internal/config.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/type_traits.h>
+#include <eastl/internal/scan_help.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <stddef.h>
+#include <string.h> // memcmp
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_STRING_SEARCH_TWO_WAY_MIN
+//
+// The needle length from which substring searches can fall back to the
+// Two-Way algorithm, which bounds their worst case to linear time.
+//
+#ifndef EASTL_STRING_SEARCH_TWO_WAY_MIN
+	#define EASTL_STRING_SEARCH_TWO_WAY_MIN 64
+#endif
+
+
+namespace eastl
+{
+	namespace internal
+	{
+		// Returns whether the m characters at p1 and p2 are equal.
+		template <typename T>
+		EASTL_FORCE_INLINE bool string_search_equal(const T* p1, const T* p2, size_t m)
+		{
+			return (m == 0) || (memcmp(p1, p2, m * sizeof(T)) == 0);
+		}
+
+
+		// string_search_critical_factorization
+		//
+		// Returns the position of a critical factorization of the needle
+		// [p2Begin, p2Begin + m), the larger of its maximal suffixes for < and >,
+		// and sets period to the period of that suffix.
+		//
+		template <typename T>
+		size_t string_search_critical_factorization(const T* p2Begin, size_t m, size_t& period)
+		{
+			size_t maxSuffix = (size_t)-1, j = 0, k = 1, p = 1;
+
+			while((j + k) < m)
+			{
+				const T a = p2Begin[j + k];
+				const T b = p2Begin[maxSuffix + k]; // maxSuffix + k wraps around to k - 1 for the initial -1.
+
+				if(a < b)       { j += k; k = 1; p = j - maxSuffix; }
+				else if(a == b) { if(k != p) ++k; else { j += p; k = 1; } }
+				else            { maxSuffix = j++; k = p = 1; }
+			}
+			period = p;
+
+			size_t maxSuffixRev = (size_t)-1;
+			j = 0; k = p = 1;
+
+			while((j + k) < m)
+			{
+				const T a = p2Begin[j + k];
+				const T b = p2Begin[maxSuffixRev + k];
+
+				if(b < a)       { j += k; k = 1; p = j - maxSuffixRev; }
+				else if(a == b) { if(k != p) ++k; else { j += p; k = 1; } }
+				else            { maxSuffixRev = j++; k = p = 1; }
+			}
+
+			if((maxSuffixRev + 1) < (maxSuffix + 1))
+				return maxSuffix + 1;
+			period = p;
+			return maxSuffixRev + 1;
+		}
+
+
+		// string_search_two_way
+		//
+		// Finds the first occurrence of [p2Begin, p2Begin + m) in [p1Begin, p1End),
+		// or returns p1End. Requires 2 <= m. This is the Two-Way algorithm of
+		// Crochemore and Perrin, which needs O(n + m) time and O(1) space.
+		//
+		template <typename T>
+		const T* string_search_two_way(const T* p1Begin, const T* p1End, const T* p2Begin, size_t m)
+		{
+			const size_t n = (size_t)(p1End - p1Begin);
+			size_t period;
+			const size_t suffix = eastl::internal::string_search_critical_factorization(p2Begin, m, period);
+
+			if(string_search_equal(p2Begin, p2Begin + period, suffix))
+			{
+				// The needle is periodic: after a match of the right half, the part
+				// of the left half that overlaps the previous window is known to match.
+				size_t memory = 0;
+
+				for(size_t j = 0; (j + m) <= n; )
+				{
+					size_t i = (suffix > memory) ? suffix : memory;
+					while((i < m) && (p2Begin[i] == p1Begin[i + j]))
+						++i;
+
+					if(i >= m)
+					{
+						i = suffix - 1;
+						while((memory < (i + 1)) && (p2Begin[i] == p1Begin[i + j]))
+							--i;
+						if((i + 1) < (memory + 1))
+							return p1Begin + j;
+						j += period;
+						memory = m - period;
+					}
+					else
+					{
+						j += (i - suffix) + 1;
+						memory = 0;
+					}
+				}
+			}
+			else
+			{
+				period = ((suffix > (m - suffix)) ? suffix : (m - suffix)) + 1;
+
+				for(size_t j = 0; (j + m) <= n; )
+				{
+					size_t i = suffix;
+					while((i < m) && (p2Begin[i] == p1Begin[i + j]))
+						++i;
+
+					if(i >= m)
+					{
+						i = suffix - 1;
+						while((i != (size_t)-1) && (p2Begin[i] == p1Begin[i + j]))
+							--i;
+						if(i == (size_t)-1)
+							return p1Begin + j;
+						j += period;
+					}
+					else
+						j += (i - suffix) + 1;
+				}
+			}
+			return p1End;
+		}
+
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			template <typename T>
+			struct string_search_simd : public scan_register
+			{
+				typedef scan_lanes<sizeof(T)>                        lanes;
+				typedef typename scan_bits_type<sizeof(T)>::type     bits_type;
+
+				static const size_t   kLanes    = kSize / sizeof(T);
+				static const uint32_t kLaneMask = (1u << sizeof(T)) - 1; // The mask bits of one character.
+
+				static reg broadcast(T c)   { return lanes::broadcast((bits_type)c); }
+				static reg eq(reg a, reg b) { return lanes::eq(a, b); }
+			};
+
+
+			// string_search_filter
+			//
+			// Finds the first occurrence of [p2Begin, p2Begin + m) in [p1Begin, p1End),
+			// or returns p1End. Requires 2 <= m <= (p1End - p1Begin).
+			//
+			template <typename T>
+			const T* string_search_filter(const T* p1Begin, const T* p1End, const T* p2Begin, size_t m)
+			{
+				typedef string_search_simd<T> simd;
+				typedef typename simd::reg reg;
+
+				const reg vFirst = simd::broadcast(p2Begin[0]);
+				const reg vLast  = simd::broadcast(p2Begin[m - 1]);
+
+				const T* p = p1Begin;
+				const T* const pStartEnd = p1End - m + 1; // One past the last position a match can start at.
+				size_t nVerified = 0;                     // The characters compared by the verifications of long needles.
+
+				for(; (size_t)(pStartEnd - p) >= simd::kLanes; p += simd::kLanes)
+				{
+					uint32_t mask = simd::mask(simd::bitAnd(simd::eq(simd::load(p),         vFirst),
+					                                        simd::eq(simd::load(p + m - 1), vLast)));
+					while(mask)
+					{
+						const uint32_t bit = scan_first_bit(mask);
+						const T* const pCandidate = p + (bit / sizeof(T));
+
+						if(m < EASTL_STRING_SEARCH_TWO_WAY_MIN)
+						{
+							if(string_search_equal(pCandidate + 1, p2Begin + 1, m - 2))
+								return pCandidate;
+						}
+						else
+						{
+							const T* const pMismatch = eastl::internal::scan_mismatch_simd<T>(pCandidate + 1, pCandidate + m - 1, p2Begin + 1);
+							if(pMismatch == (pCandidate + m - 1))
+								return pCandidate;
+
+							nVerified += (size_t)(pMismatch - pCandidate);
+							if(nVerified > ((size_t)(p - p1Begin) * 2 + m * 8))
+								return eastl::internal::string_search_two_way(pCandidate + 1, p1End, p2Begin, m);
+						}
+						mask &= ~(simd::kLaneMask << bit);
+					}
+				}
+
+				for(; p != pStartEnd; ++p)
+				{
+					if((*p == p2Begin[0]) && (p[m - 1] == p2Begin[m - 1]) && string_search_equal(p + 1, p2Begin + 1, m - 2))
+						return p;
+				}
+				return p1End;
+			}
+
+
+			// string_search_filter_reverse
+			//
+			// Finds the last occurrence of [p2Begin, p2Begin + m) in [p1Begin, p1End),
+			// or returns p1End. Requires 2 <= m <= (p1End - p1Begin).
+			//
+			template <typename T>
+			const T* string_search_filter_reverse(const T* p1Begin, const T* p1End, const T* p2Begin, size_t m)
+			{
+				typedef string_search_simd<T> simd;
+				typedef typename simd::reg reg;
+
+				const reg vFirst = simd::broadcast(p2Begin[0]);
+				const reg vLast  = simd::broadcast(p2Begin[m - 1]);
+
+				const T* p = p1End - m + 1; // One past the last position a match can start at.
+
+				while((size_t)(p - p1Begin) >= simd::kLanes)
+				{
+					p -= simd::kLanes;
+
+					uint32_t mask = simd::mask(simd::bitAnd(simd::eq(simd::load(p),         vFirst),
+					                                        simd::eq(simd::load(p + m - 1), vLast)));
+					while(mask)
+					{
+						const uint32_t bit = scan_last_bit(mask) & ~(uint32_t)(sizeof(T) - 1); // The first mask bit of the character.
+						const T* const pCandidate = p + (bit / sizeof(T));
+
+						if(string_search_equal(pCandidate + 1, p2Begin + 1, m - 2))
+							return pCandidate;
+						mask &= ~(simd::kLaneMask << bit);
+					}
+				}
+
+				while(p != p1Begin)
+				{
+					--p;
+					if((*p == p2Begin[0]) && (p[m - 1] == p2Begin[m - 1]) && string_search_equal(p + 1, p2Begin + 1, m - 2))
+						return p;
+				}
+				return p1End;
+			}
+
+
+			// string_find_first_of_simd
+			//
+			// Finds the first character in [p1Begin, p1End) that is one of the n
+			// characters at p2Begin, or returns p1End. Requires 1 <= n <= 4.
+			//
+			template <typename T>
+			const T* string_find_first_of_simd(const T* p1Begin, const T* p1End, const T* p2Begin, size_t n)
+			{
+				typedef string_search_simd<T> simd;
+				typedef typename simd::reg reg;
+
+				// Sets of fewer than four characters repeat their first one.
+				const reg v0 = simd::broadcast(p2Begin[0]);
+				const reg v1 = simd::broadcast(p2Begin[(n > 1) ? 1 : 0]);
+				const reg v2 = simd::broadcast(p2Begin[(n > 2) ? 2 : 0]);
+				const reg v3 = simd::broadcast(p2Begin[(n > 3) ? 3 : 0]);
+
+				const T* p = p1Begin;
+				for(; (size_t)(p1End - p) >= simd::kLanes; p += simd::kLanes)
+				{
+					const reg x = simd::load(p);
+					const uint32_t mask = simd::mask(simd::bitOr(simd::bitOr(simd::eq(x, v0), simd::eq(x, v1)),
+					                                             simd::bitOr(simd::eq(x, v2), simd::eq(x, v3))));
+					if(mask)
+						return p + (scan_first_bit(mask) / sizeof(T));
+				}
+
+				for(; p != p1End; ++p)
+				{
+					for(size_t i = 0; i < n; ++i)
+					{
+						if(*p == p2Begin[i])
+							return p;
+					}
+				}
+				return p1End;
+			}
+		#endif // EASTL_SCAN_SIMD_ENABLED
+
+
+		// string_find_first_of_set
+		//
+		// Finds the first character in [p1Begin, p1End) that is one of the
+		// characters in [p2Begin, p2End) by looking it up in a 256 bit set.
+		// Returns false if the set has characters outside of [0, 256).
+		//
+		template <typename T>
+		bool string_find_first_of_set(const T* p1Begin, const T* p1End, const T* p2Begin, const T* p2End, const T*& pResult)
+		{
+			typedef typename eastl::make_unsigned<T>::type uchar_type;
+
+			uint32_t set[8] = {};
+			for(; p2Begin != p2End; ++p2Begin)
+			{
+				const uchar_type c = (uchar_type)*p2Begin;
+				if(c >> 8)
+					return false;
+				set[c >> 5] |= (1u << (c & 31));
+			}
+
+			for(; p1Begin != p1End; ++p1Begin)
+			{
+				const uchar_type c = (uchar_type)*p1Begin;
+				if(!(c >> 8) && (set[c >> 5] & (1u << (c & 31))))
+					break;
+			}
+			pResult = p1Begin;
+			return true;
+		}
+
+
+		// string_search, string_rsearch, string_rfind, string_find_first_of
+		//
+		// Like the scan_xxx functions in scan_help.h, these take the arguments of
+		// the char_traits.h function of the same purpose plus an out parameter and
+		// return true if they handled the call, so the generic overloads leave the
+		// character types and cases they don't handle to the generic loops.
+		//
+		template <typename T>
+		struct string_search_enabled
+			: public eastl::integral_constant<bool, eastl::is_integral<T>::value && ((sizeof(T) == 1) || (sizeof(T) == 2) || (sizeof(T) == 4))> { };
+
+		template <typename T>
+		struct string_search_simd_enabled
+			: public eastl::integral_constant<bool, string_search_enabled<T>::value && EASTL_SCAN_SIMD_ENABLED> { };
+
+		template <typename T>
+		inline typename eastl::enable_if<!string_search_enabled<T>::value, bool>::type
+		string_search(const T*, const T*, const T*, const T*, const T*&)
+			{ return false; }
+
+		template <typename T>
+		inline typename eastl::enable_if<!string_search_enabled<T>::value, bool>::type
+		string_find_first_of(const T*, const T*, const T*, const T*, const T*&)
+			{ return false; }
+
+		template <typename T>
+		inline typename eastl::enable_if<!string_search_simd_enabled<T>::value, bool>::type
+		string_rsearch(const T*, const T*, const T*, const T*, const T*&)
+			{ return false; }
+
+		template <typename T>
+		inline typename eastl::enable_if<!string_search_simd_enabled<T>::value, bool>::type
+		string_rfind(const T*, const T*, T, const T*&)
+			{ return false; }
+
+
+		// Finds the first occurrence of [p2Begin, p2End) in [p1Begin, p1End) if it has at least two characters.
+		template <typename T>
+		inline typename eastl::enable_if<string_search_enabled<T>::value, bool>::type
+		string_search(const T* p1Begin, const T* p1End, const T* p2Begin, const T* p2End, const T*& pResult)
+		{
+			const size_t m = (size_t)(p2End - p2Begin);
+
+			if(m < 2)
+				return false;
+			if(m > (size_t)(p1End - p1Begin))
+				pResult = p1End;
+			else
+			{
+				#if EASTL_SCAN_SIMD_ENABLED
+					pResult = eastl::internal::string_search_filter(p1Begin, p1End, p2Begin, m);
+				#else
+					if(m < EASTL_STRING_SEARCH_TWO_WAY_MIN)
+						return false;
+					pResult = eastl::internal::string_search_two_way(p1Begin, p1End, p2Begin, m);
+				#endif
+			}
+			return true;
+		}
+
+		// Finds the first character in [p1Begin, p1End) that is in [p2Begin, p2End), for sets of at least two characters.
+		template <typename T>
+		inline typename eastl::enable_if<string_search_enabled<T>::value, bool>::type
+		string_find_first_of(const T* p1Begin, const T* p1End, const T* p2Begin, const T* p2End, const T*& pResult)
+		{
+			const size_t n = (size_t)(p2End - p2Begin);
+
+			if(n < 2)
+				return false;
+			#if EASTL_SCAN_SIMD_ENABLED
+				if(n <= 4)
+				{
+					pResult = eastl::internal::string_find_first_of_simd(p1Begin, p1End, p2Begin, n);
+					return true;
+				}
+			#endif
+			return eastl::internal::string_find_first_of_set(p1Begin, p1End, p2Begin, p2End, pResult);
+		}
+
+		#if EASTL_SCAN_SIMD_ENABLED
+			// Finds the last occurrence of [p2Begin, p2End) in [p1Begin, p1End) if it has at least two characters.
+			template <typename T>
+			inline typename eastl::enable_if<string_search_simd_enabled<T>::value, bool>::type
+			string_rsearch(const T* p1Begin, const T* p1End, const T* p2Begin, const T* p2End, const T*& pResult)
+			{
+				const size_t m = (size_t)(p2End - p2Begin);
+
+				if(m < 2)
+					return false;
+				pResult = (m > (size_t)(p1End - p1Begin)) ? p1End : eastl::internal::string_search_filter_reverse(p1Begin, p1End, p2Begin, m);
+				return true;
+			}
+
+			// Finds the last c in [pREnd, pRBegin) and returns one past it, or pREnd (see CharTypeStringRFind).
+			template <typename T>
+			inline typename eastl::enable_if<string_search_simd_enabled<T>::value, bool>::type
+			string_rfind(const T* pRBegin, const T* pREnd, T c, const T*& pResult)
+			{
+				const T* const p = eastl::internal::scan_find_last_simd<T>(pREnd, pRBegin, c);
+				pResult = (p == pRBegin) ? pREnd : (p + 1);
+				return true;
+			}
+		#endif
+
+	} // namespace internal
+
+} // namespace eastl
+
+#endif // Header include guard
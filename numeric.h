@@ -116,6 +116,71 @@ namespace eastl
 
 
 
+	/// reduce
+	///
+	/// Like accumulate, but the values may be combined in any grouping, so
+	/// binary_op is required to be associative. The overloads which take an
+	/// execution policy (see execution.h) make use of this to combine the
+	/// values of several parts of the range in parallel. Without a policy,
+	/// the values are processed in order.
+	///
+	template <typename InputIterator, typename T, typename BinaryOperation>
+	T reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op)
+	{
+		for(; first != last; ++first)
+			init = binary_op(eastl::move(init), *first);
+		return init;
+	}
+
+	template <typename InputIterator, typename T>
+	T reduce(InputIterator first, InputIterator last, T init)
+	{
+		for(; first != last; ++first)
+			init += *first; // See accumulate about why we use operator +=.
+		return init;
+	}
+
+	template <typename InputIterator>
+	typename iterator_traits<InputIterator>::value_type
+	reduce(InputIterator first, InputIterator last)
+	{
+		return eastl::reduce(first, last, typename iterator_traits<InputIterator>::value_type());
+	}
+
+
+	/// transform_reduce
+	///
+	/// Like inner_product, but the results of binary_op2 may be combined by
+	/// binary_op1 in any grouping, as with reduce. The last overload applies
+	/// unary_op to each value of a single range instead.
+	///
+	template <typename InputIterator1, typename InputIterator2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+	T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+	                   BinaryOperation1 binary_op1, BinaryOperation2 binary_op2)
+	{
+		for(; first1 != last1; ++first1, ++first2)
+			init = binary_op1(eastl::move(init), binary_op2(*first1, *first2));
+		return init;
+	}
+
+	template <typename InputIterator1, typename InputIterator2, typename T>
+	T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init)
+	{
+		for(; first1 != last1; ++first1, ++first2)
+			init += (*first1 * *first2);
+		return init;
+	}
+
+	template <typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+	T transform_reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op, UnaryOperation unary_op)
+	{
+		for(; first != last; ++first)
+			init = binary_op(eastl::move(init), unary_op(*first));
+		return init;
+	}
+
+
+
 
 
 	/// partial_sum
@@ -90,13 +90,17 @@ namespace eastl
 	/// these operations. We have extended the heap algorithms and the 
 	/// priority_queue implementation to support these operations.
 	///
+	/// D is the arity of the underlying heap (see heap.h). The default
+	/// is a binary heap, like std::priority_queue; a 4-ary heap is
+	/// usually faster for large queues of small elements.
+	///
 	///////////////////////////////////////////////////////////////////
 
-	template <typename T, typename Container = eastl::vector<T>, typename Compare = eastl::less<typename Container::value_type> >
+	template <typename T, typename Container = eastl::vector<T>, typename Compare = eastl::less<typename Container::value_type>, size_t D = 2>
 	class priority_queue
 	{
 	public:
-		typedef priority_queue<T, Container, Compare>        this_type;
+		typedef priority_queue<T, Container, Compare, D>        this_type;
 		typedef Container                                    container_type;
 		typedef Compare                                      compare_type;
 	  //typedef typename Container::allocator_type           allocator_type;  // We can't currently declare this because the container may be a type that doesn't have an allocator. 
@@ -126,14 +130,14 @@ namespace eastl
 		priority_queue(const this_type& x, const Allocator& allocator, typename eastl::enable_if<eastl::uses_allocator<container_type, Allocator>::value>::type* = NULL)
 			: c(x.c, allocator), comp(x.comp)
 		{
-			eastl::makeHeap(c.begin(), c.end(), comp);
+			eastl::makeHeap<D>(c.begin(), c.end(), comp);
 		}
 
 		template <class Allocator>
 		priority_queue(this_type&& x, const Allocator& allocator, typename eastl::enable_if<eastl::uses_allocator<container_type, Allocator>::value>::type* = NULL)
 			: c(eastl::move(x.c), allocator), comp(x.comp)
 		{
-			eastl::makeHeap(c.begin(), c.end(), comp);
+			eastl::makeHeap<D>(c.begin(), c.end(), comp);
 		}
 
 		explicit priority_queue(const compare_type& compare);
@@ -213,104 +217,104 @@ namespace eastl
 	///////////////////////////////////////////////////////////////////////
 
 
-	template <typename T, typename Container, typename Compare>
-	inline priority_queue<T, Container, Compare>::priority_queue()
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline priority_queue<T, Container, Compare, D>::priority_queue()
 		: c(),  // To consider: use c(EASTL_PRIORITY_QUEUE_DEFAULT_ALLOCATOR) here, though that would add the requirement that the user supplied container support this.
 		  comp()
 	{
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline priority_queue<T, Container, Compare>::priority_queue(const compare_type& compare)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline priority_queue<T, Container, Compare, D>::priority_queue(const compare_type& compare)
 		: c(),  // To consider: use c(EASTL_PRIORITY_QUEUE_DEFAULT_ALLOCATOR) here, though that would add the requirement that the user supplied container support this.
 		  comp(compare)
 	{
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline priority_queue<T, Container, Compare>::priority_queue(const compare_type& compare, const container_type& x)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline priority_queue<T, Container, Compare, D>::priority_queue(const compare_type& compare, const container_type& x)
 		: c(x), comp(compare)
 	{
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline priority_queue<T, Container, Compare>::priority_queue(const compare_type& compare, container_type&& x)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline priority_queue<T, Container, Compare, D>::priority_queue(const compare_type& compare, container_type&& x)
 	  : c(eastl::move(x)), comp(compare)
 	{
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline priority_queue<T, Container, Compare>::priority_queue(std::initializer_list<value_type> ilist, const compare_type& compare)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline priority_queue<T, Container, Compare, D>::priority_queue(std::initializer_list<value_type> ilist, const compare_type& compare)
 		: c(), comp(compare)
 	{
 		c.insert(c.end(), ilist.begin(), ilist.end());
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
 
-	template <typename T, typename Container, typename Compare>
+	template <typename T, typename Container, typename Compare, size_t D>
 	template <typename InputIterator>
-	inline priority_queue<T, Container, Compare>::priority_queue(InputIterator first, InputIterator last)
+	inline priority_queue<T, Container, Compare, D>::priority_queue(InputIterator first, InputIterator last)
 		: c(first, last), comp()
 	{
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
+	template <typename T, typename Container, typename Compare, size_t D>
 	template <typename InputIterator>
-	inline priority_queue<T, Container, Compare>::priority_queue(InputIterator first, InputIterator last, const compare_type& compare)
+	inline priority_queue<T, Container, Compare, D>::priority_queue(InputIterator first, InputIterator last, const compare_type& compare)
 		: c(first, last), comp(compare)
 	{
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
+	template <typename T, typename Container, typename Compare, size_t D>
 	template <typename InputIterator>
-	inline priority_queue<T, Container, Compare>::priority_queue(InputIterator first, InputIterator last, const compare_type& compare, const container_type& x)
+	inline priority_queue<T, Container, Compare, D>::priority_queue(InputIterator first, InputIterator last, const compare_type& compare, const container_type& x)
 		: c(x), comp(compare)
 	{
 		c.insert(c.end(), first, last);
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
+	template <typename T, typename Container, typename Compare, size_t D>
 	template <typename InputIterator>
-	inline priority_queue<T, Container, Compare>::priority_queue(InputIterator first, InputIterator last, const compare_type& compare, container_type&& x)
+	inline priority_queue<T, Container, Compare, D>::priority_queue(InputIterator first, InputIterator last, const compare_type& compare, container_type&& x)
 		: c(eastl::move(x)), comp(compare)
 	{
 		c.insert(c.end(), first, last);
-		eastl::makeHeap(c.begin(), c.end(), comp);
+		eastl::makeHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline bool priority_queue<T, Container, Compare>::empty() const
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline bool priority_queue<T, Container, Compare, D>::empty() const
 	{
 		return c.empty();
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline typename priority_queue<T, Container, Compare>::size_type
-	priority_queue<T, Container, Compare>::size() const
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline typename priority_queue<T, Container, Compare, D>::size_type
+	priority_queue<T, Container, Compare, D>::size() const
 	{
 		return c.size();
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline typename priority_queue<T, Container, Compare>::const_reference
-	priority_queue<T, Container, Compare>::top() const
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline typename priority_queue<T, Container, Compare, D>::const_reference
+	priority_queue<T, Container, Compare, D>::top() const
 	{
 #if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
 		if (EASTL_UNLIKELY(c.empty()))
@@ -321,14 +325,14 @@ namespace eastl
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::push(const value_type& value)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::push(const value_type& value)
 	{
 		#if EASTL_EXCEPTIONS_ENABLED
 			try
 			{
 				c.pushBack(value);
-				eastl::pushHeap(c.begin(), c.end(), comp);
+				eastl::pushHeap<D>(c.begin(), c.end(), comp);
 			}
 			catch(...)
 			{
@@ -337,19 +341,19 @@ namespace eastl
 			}
 		#else
 			c.pushBack(value);
-			eastl::pushHeap(c.begin(), c.end(), comp);
+			eastl::pushHeap<D>(c.begin(), c.end(), comp);
 		#endif
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::push(value_type&& value)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::push(value_type&& value)
 	{
 		#if EASTL_EXCEPTIONS_ENABLED
 			try
 			{
 				c.pushBack(eastl::move(value));
-				eastl::pushHeap(c.begin(), c.end(), comp);
+				eastl::pushHeap<D>(c.begin(), c.end(), comp);
 			}
 			catch(...)
 			{
@@ -358,21 +362,21 @@ namespace eastl
 			}
 		#else
 			c.pushBack(eastl::move(value));
-			eastl::pushHeap(c.begin(), c.end(), comp);
+			eastl::pushHeap<D>(c.begin(), c.end(), comp);
 		#endif
 	}
 
 
-	template <typename T, typename Container, typename Compare>
+	template <typename T, typename Container, typename Compare, size_t D>
 	template <class... Args>
-	inline void priority_queue<T, Container, Compare>::emplace(Args&&... args)
+	inline void priority_queue<T, Container, Compare, D>::emplace(Args&&... args)
 	{
 		push(value_type(eastl::forward<Args>(args)...)); // The C++11 Standard 23.6.4/1 states that c.emplace is used, but also declares that c doesn't need to have an emplace function.
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::pop()
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::pop()
 	{
 #if EASTL_ASSERT_ENABLED
 		if (EASTL_UNLIKELY(c.empty()))
@@ -382,7 +386,7 @@ namespace eastl
 		#if EASTL_EXCEPTIONS_ENABLED
 			try
 			{
-				eastl::popHeap(c.begin(), c.end(), comp);
+				eastl::popHeap<D>(c.begin(), c.end(), comp);
 				c.popBack();
 			}
 			catch(...)
@@ -391,14 +395,14 @@ namespace eastl
 				throw;
 			}
 		#else
-			eastl::popHeap(c.begin(), c.end(), comp);
+			eastl::popHeap<D>(c.begin(), c.end(), comp);
 			c.popBack();
 		#endif
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::pop(value_type& value)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::pop(value_type& value)
 	{
 #if EASTL_ASSERT_ENABLED
 		if (EASTL_UNLIKELY(c.empty()))
@@ -410,49 +414,49 @@ namespace eastl
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::change(size_type n) // This function is not in the STL std::priority_queue.
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::change(size_type n) // This function is not in the STL std::priority_queue.
 	{
 #if EASTL_ASSERT_ENABLED
 		if (EASTL_UNLIKELY(n >= c.size()))
 			EASTL_FAIL_MSG("priority_queue::change -- out of range");
 #endif
 
-		eastl::changeHeap(c.begin(), c.size(), n, comp);
+		eastl::changeHeap<D>(c.begin(), c.size(), n, comp);
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::remove(size_type n) // This function is not in the STL std::priority_queue.
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::remove(size_type n) // This function is not in the STL std::priority_queue.
 	{
 #if EASTL_ASSERT_ENABLED
 		if (EASTL_UNLIKELY(n >= c.size()))
 			EASTL_FAIL_MSG("priority_queue::remove -- out of range");
 #endif
 
-		eastl::removeHeap(c.begin(), c.size(), n, comp);
+		eastl::removeHeap<D>(c.begin(), c.size(), n, comp);
 		c.popBack();
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline typename priority_queue<T, Container, Compare>::container_type&
-	priority_queue<T, Container, Compare>::get_container()
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline typename priority_queue<T, Container, Compare, D>::container_type&
+	priority_queue<T, Container, Compare, D>::get_container()
 	{
 		return c;
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline const typename priority_queue<T, Container, Compare>::container_type&
-	priority_queue<T, Container, Compare>::get_container() const
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline const typename priority_queue<T, Container, Compare, D>::container_type&
+	priority_queue<T, Container, Compare, D>::get_container() const
 	{
 		return c;
 	}
 
 
-	template <typename T, typename Container, typename Compare>
-	inline void priority_queue<T, Container, Compare>::swap(this_type& x) EASTL_NOEXCEPT_IF((eastl::is_nothrow_swappable<this_type::container_type>::value && 
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline void priority_queue<T, Container, Compare, D>::swap(this_type& x) EASTL_NOEXCEPT_IF((eastl::is_nothrow_swappable<this_type::container_type>::value && 
 																						  eastl::is_nothrow_swappable<this_type::compare_type>::value))
 	{
 		using eastl::swap;
@@ -461,11 +465,11 @@ namespace eastl
 	}
 
 
-	template <typename T, typename Container, typename Compare>
+	template <typename T, typename Container, typename Compare, size_t D>
 	inline bool
-	priority_queue<T, Container, Compare>::validate() const
+	priority_queue<T, Container, Compare, D>::validate() const
 	{
-		return c.validate() && eastl::isHeap(c.begin(), c.end(), comp);
+		return c.validate() && eastl::isHeap<D>(c.begin(), c.end(), comp);
 	}
 
 
@@ -474,46 +478,46 @@ namespace eastl
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename T, typename Container, typename Compare>
-	bool operator==(const priority_queue<T, Container, Compare>& a, const priority_queue<T, Container, Compare>& b)
+	template <typename T, typename Container, typename Compare, size_t D>
+	bool operator==(const priority_queue<T, Container, Compare, D>& a, const priority_queue<T, Container, Compare, D>& b)
 	{
 		return (a.c == b.c);
 	}
 
-	template <typename T, typename Container, typename Compare>
-	bool operator<(const priority_queue<T, Container, Compare>& a, const priority_queue<T, Container, Compare>& b)
+	template <typename T, typename Container, typename Compare, size_t D>
+	bool operator<(const priority_queue<T, Container, Compare, D>& a, const priority_queue<T, Container, Compare, D>& b)
 	{
 		return (a.c < b.c);
 	}
 
-	template <typename T, typename Container, typename Compare>
-	inline bool operator!=(const priority_queue<T, Container, Compare>& a, const priority_queue<T, Container, Compare>& b)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline bool operator!=(const priority_queue<T, Container, Compare, D>& a, const priority_queue<T, Container, Compare, D>& b)
 	{
 		return !(a.c == b.c);
 	}
 
-	template <typename T, typename Container, typename Compare>
-	inline bool operator>(const priority_queue<T, Container, Compare>& a, const priority_queue<T, Container, Compare>& b)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline bool operator>(const priority_queue<T, Container, Compare, D>& a, const priority_queue<T, Container, Compare, D>& b)
 	{
 		return (b.c < a.c);
 	}
 
-	template <typename T, typename Container, typename Compare>
-	inline bool operator<=(const priority_queue<T, Container, Compare>& a, const priority_queue<T, Container, Compare>& b)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline bool operator<=(const priority_queue<T, Container, Compare, D>& a, const priority_queue<T, Container, Compare, D>& b)
 	{
 		return !(b.c < a.c);
 	}
 
-	template <typename T, typename Container, typename Compare>
-	inline bool operator>=(const priority_queue<T, Container, Compare>& a, const priority_queue<T, Container, Compare>& b)
+	template <typename T, typename Container, typename Compare, size_t D>
+	inline bool operator>=(const priority_queue<T, Container, Compare, D>& a, const priority_queue<T, Container, Compare, D>& b)
 	{
 		return !(a.c < b.c);
 	}
 
 
-	template <class T, class Container, class Compare>
-	inline void swap(priority_queue<T, Container, Compare>& a,  priority_queue<T, Container, Compare>& b) EASTL_NOEXCEPT_IF((eastl::is_nothrow_swappable<typename priority_queue<T, Container, Compare>::container_type>::value && 
-																														  eastl::is_nothrow_swappable<typename priority_queue<T, Container, Compare>::compare_type>::value)) // EDG has a bug and won't let us use Container in this noexcept statement
+	template <class T, class Container, class Compare, size_t D>
+	inline void swap(priority_queue<T, Container, Compare, D>& a,  priority_queue<T, Container, Compare, D>& b) EASTL_NOEXCEPT_IF((eastl::is_nothrow_swappable<typename priority_queue<T, Container, Compare, D>::container_type>::value && 
+																														  eastl::is_nothrow_swappable<typename priority_queue<T, Container, Compare, D>::compare_type>::value)) // EDG has a bug and won't let us use Container in this noexcept statement
 	{
 		a.swap(b);
 	}
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <eastl/internal/config.h>
+#include <eastl/reserved_vector.h>
+
+#if defined(EA_PLATFORM_MICROSOFT)
+	EA_DISABLE_ALL_VC_WARNINGS();
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+	EA_RESTORE_ALL_VC_WARNINGS();
+#elif defined(EA_PLATFORM_POSIX)
+	#include <sys/mman.h>
+	#include <unistd.h>
+#else
+	#include <stdlib.h>
+#endif
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		EASTL_API size_t VirtualMemoryPageSize()
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				SYSTEM_INFO systemInfo;
+				GetSystemInfo(&systemInfo);
+				return (size_t)systemInfo.dwPageSize;
+			#elif defined(EA_PLATFORM_POSIX)
+				static const size_t nPageSize = (size_t)sysconf(_SC_PAGESIZE);
+				return nPageSize;
+			#else
+				return 4096;
+			#endif
+		}
+
+
+		EASTL_API void* VirtualMemoryReserve(size_t nBytes, size_t nAlignment)
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				// Reservations are aligned to the allocation granularity (usually 64 KiB).
+				// Large pages on Windows require a privilege and must be committed at
+				// reservation time, so we don't attempt to honor larger alignments.
+				EA_UNUSED(nAlignment);
+				return VirtualAlloc(NULL, nBytes, MEM_RESERVE, PAGE_NOACCESS);
+
+			#elif defined(EA_PLATFORM_POSIX)
+				// Over-reserve by nAlignment so that we can trim the range down to an
+				// aligned block. This is needed for huge pages to be usable at all.
+				const size_t nPageSize = VirtualMemoryPageSize();
+				const size_t nSlack    = (nAlignment > nPageSize) ? nAlignment : 0;
+
+				#if defined(MAP_NORESERVE)
+					const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+				#else
+					const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+				#endif
+
+				void* const p = mmap(NULL, nBytes + nSlack, PROT_NONE, flags, -1, 0);
+
+				if(p == MAP_FAILED)
+					return NULL;
+
+				if(nSlack)
+				{
+					char* const pBegin   = (char*)p;
+					char* const pAligned = (char*)(((uintptr_t)pBegin + (nAlignment - 1)) & ~(uintptr_t)(nAlignment - 1));
+					char* const pEnd     = pBegin + nBytes + nSlack;
+
+					if(pAligned != pBegin)
+						munmap(pBegin, (size_t)(pAligned - pBegin));
+					if((pAligned + nBytes) != pEnd)
+						munmap(pAligned + nBytes, (size_t)(pEnd - (pAligned + nBytes)));
+
+					return pAligned;
+				}
+
+				return p;
+
+			#else
+				// No virtual memory support; fall back to allocating the whole range.
+				EA_UNUSED(nAlignment);
+				return malloc(nBytes);
+			#endif
+		}
+
+
+		EASTL_API bool VirtualMemoryCommit(void* p, size_t nBytes, bool bHugePages)
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				EA_UNUSED(bHugePages);
+				return VirtualAlloc(p, nBytes, MEM_COMMIT, PAGE_READWRITE) != NULL;
+
+			#elif defined(EA_PLATFORM_POSIX)
+				if(mprotect(p, nBytes, PROT_READ | PROT_WRITE) != 0)
+					return false;
+
+				#if defined(MADV_HUGEPAGE)
+					if(bHugePages)
+						madvise(p, nBytes, MADV_HUGEPAGE); // This is merely a hint; failure is not an error.
+				#else
+					EA_UNUSED(bHugePages);
+				#endif
+
+				return true;
+
+			#else
+				EA_UNUSED(p); EA_UNUSED(nBytes); EA_UNUSED(bHugePages);
+				return true;
+			#endif
+		}
+
+
+		EASTL_API void VirtualMemoryDecommit(void* p, size_t nBytes)
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				VirtualFree(p, nBytes, MEM_DECOMMIT);
+
+			#elif defined(EA_PLATFORM_POSIX)
+				// Return the physical pages to the system, then make the range inaccessible again.
+				madvise(p, nBytes, MADV_DONTNEED);
+				mprotect(p, nBytes, PROT_NONE);
+
+			#else
+				EA_UNUSED(p); EA_UNUSED(nBytes);
+			#endif
+		}
+
+
+		EASTL_API void VirtualMemoryRelease(void* p, size_t nBytes)
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				EA_UNUSED(nBytes);
+				VirtualFree(p, 0, MEM_RELEASE);
+
+			#elif defined(EA_PLATFORM_POSIX)
+				munmap(p, nBytes);
+
+			#else
+				EA_UNUSED(nBytes);
+				free(p);
+			#endif
+		}
+
+	} // namespace Internal
+
+} // namespace eastl
@@ -0,0 +1,857 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements reserved_vector, a vector-like container which reserves
+// a large range of virtual address space up front and commits physical pages
+// on demand as it grows. The primary distinctions between reserved_vector and
+// vector are:
+//    - reserved_vector never relocates its elements. Growth only commits more
+//      pages at the end of the existing block, so pointers, references and
+//      iterators to elements stay valid for the lifetime of the element.
+//    - Growth never copies or moves elements, so there is no 2x peak memory
+//      while growing very large arrays.
+//    - reserved_vector has a fixed maximum size, chosen at construction time,
+//      which is the size of the reserved address range. The address range
+//      costs no physical memory until it is committed.
+//    - reserved_vector doesn't use an EASTL allocator; memory comes directly
+//      from the operating system's virtual memory functions.
+//    - reserved_vector can request transparent huge pages for its block
+//      (kFlagHugePages), on platforms which support it.
+//
+// Example usage:
+//     eastl::reserved_vector<Particle> particles(100000000); // Reserves address space for 100M particles.
+//     particles.pushBack(Particle());                        // Commits only the first page(s).
+//     Particle* pFirst = &particles[0];                      // Stays valid no matter how large particles grows.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_RESERVED_VECTOR_H
+#define EASTL_RESERVED_VECTOR_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/type_traits.h>
+#include <eastl/iterator.h>
+#include <eastl/algorithm.h>
+#include <eastl/initializer_list.h>
+#include <eastl/memory.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <new>
+#include <stddef.h>
+#if EASTL_EXCEPTIONS_ENABLED
+	#include <stdexcept> // std::out_of_range, std::length_error.
+#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_RESERVED_VECTOR_DEFAULT_RESERVE_SIZE
+	///
+	/// Defines the number of bytes of address space which a default-constructed
+	/// reserved_vector reserves. Every instance reserves this much, so the default
+	/// is kept moderate; pass an explicit maximum size for larger arrays.
+	///
+	#ifndef EASTL_RESERVED_VECTOR_DEFAULT_RESERVE_SIZE
+		#if (EA_PLATFORM_PTR_SIZE >= 8)
+			#define EASTL_RESERVED_VECTOR_DEFAULT_RESERVE_SIZE (size_t(1) << 30) // 1 GiB
+		#else
+			#define EASTL_RESERVED_VECTOR_DEFAULT_RESERVE_SIZE (size_t(64) << 20) // 64 MiB
+		#endif
+	#endif
+
+
+	/// EASTL_RESERVED_VECTOR_COMMIT_SIZE
+	///
+	/// Defines the minimum number of bytes which reserved_vector commits at a
+	/// time. Larger values mean fewer system calls while growing. The value is
+	/// rounded up to the page size at runtime.
+	///
+	#ifndef EASTL_RESERVED_VECTOR_COMMIT_SIZE
+		#define EASTL_RESERVED_VECTOR_COMMIT_SIZE (size_t(64) << 10) // 64 KiB
+	#endif
+
+
+	/// EASTL_RESERVED_VECTOR_HUGE_PAGE_SIZE
+	///
+	/// Defines the commit granularity and block alignment used when a
+	/// reserved_vector is created with kFlagHugePages.
+	///
+	#ifndef EASTL_RESERVED_VECTOR_HUGE_PAGE_SIZE
+		#define EASTL_RESERVED_VECTOR_HUGE_PAGE_SIZE (size_t(2) << 20) // 2 MiB
+	#endif
+
+
+	namespace Internal
+	{
+		// Thin wrappers around the platform virtual memory functions. They are implemented
+		// in reserved_vector.cpp so that platform headers don't leak into user code.
+		EASTL_API size_t VirtualMemoryPageSize();
+		EASTL_API void*  VirtualMemoryReserve(size_t nBytes, size_t nAlignment); // Returns NULL upon failure. nAlignment must be a power of two multiple of the page size.
+		EASTL_API bool   VirtualMemoryCommit(void* p, size_t nBytes, bool bHugePages);
+		EASTL_API void   VirtualMemoryDecommit(void* p, size_t nBytes);
+		EASTL_API void   VirtualMemoryRelease(void* p, size_t nBytes);
+	}
+
+
+	/// reserved_vector
+	///
+	/// Implements a contiguous array which grows in place within a reserved
+	/// virtual address range. See the top of this file for a description.
+	///
+	template <typename T>
+	class reserved_vector
+	{
+	public:
+		typedef reserved_vector<T>                            this_type;
+		typedef T                                             value_type;
+		typedef T*                                            pointer;
+		typedef const T*                                      const_pointer;
+		typedef T&                                            reference;
+		typedef const T&                                      const_reference;
+		typedef T*                                            iterator;
+		typedef const T*                                      const_iterator;
+		typedef eastl::reverse_iterator<iterator>             reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>       const_reverse_iterator;
+		typedef eastl_size_t                                  size_type;
+		typedef ptrdiff_t                                     difference_type;
+
+		static const size_type npos = (size_type)-1;
+
+		enum Flags
+		{
+			kFlagNone      = 0x00,
+			kFlagHugePages = 0x01   // Request transparent huge pages for the block. Silently ignored where unsupported.
+		};
+
+		static const size_type kDefaultMaxSize = (size_type)(EASTL_RESERVED_VECTOR_DEFAULT_RESERVE_SIZE / sizeof(T));
+
+	public:
+		explicit reserved_vector(size_type nMaxSize = kDefaultMaxSize, int flags = kFlagNone);
+		reserved_vector(std::initializer_list<value_type> ilist, size_type nMaxSize = kDefaultMaxSize, int flags = kFlagNone);
+		reserved_vector(const this_type& x);
+		reserved_vector(this_type&& x) EASTL_NOEXCEPT;
+	   ~reserved_vector();
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(this_type&& x) EASTL_NOEXCEPT;
+
+		void swap(this_type& x) EASTL_NOEXCEPT;
+
+		iterator       begin() EASTL_NOEXCEPT;
+		const_iterator begin() const EASTL_NOEXCEPT;
+		const_iterator cbegin() const EASTL_NOEXCEPT;
+
+		iterator       end() EASTL_NOEXCEPT;
+		const_iterator end() const EASTL_NOEXCEPT;
+		const_iterator cend() const EASTL_NOEXCEPT;
+
+		reverse_iterator       rbegin() EASTL_NOEXCEPT;
+		const_reverse_iterator rbegin() const EASTL_NOEXCEPT;
+		reverse_iterator       rend() EASTL_NOEXCEPT;
+		const_reverse_iterator rend() const EASTL_NOEXCEPT;
+
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;
+		size_type capacity() const EASTL_NOEXCEPT;     // Returns the number of elements which fit in the currently committed pages.
+		size_type maxSize() const EASTL_NOEXCEPT;      // Returns the number of elements which fit in the reserved address range. The container can never grow beyond this.
+		int       getFlags() const EASTL_NOEXCEPT;
+
+		void resize(size_type n, const value_type& value);
+		void resize(size_type n);
+		void reserve(size_type n);                      // Commits pages for at least n elements. Never relocates.
+		void shrink_to_fit();                           // Decommits the pages beyond those needed for size(). The address range itself stays reserved.
+
+		pointer       data() EASTL_NOEXCEPT;
+		const_pointer data() const EASTL_NOEXCEPT;
+
+		reference       operator[](size_type n);
+		const_reference operator[](size_type n) const;
+
+		reference       at(size_type n);
+		const_reference at(size_type n) const;
+
+		reference       front();
+		const_reference front() const;
+
+		reference       back();
+		const_reference back() const;
+
+		void      pushBack(const value_type& value);
+		void      pushBack(value_type&& value);
+		reference pushBack();
+		void      popBack();
+
+		template<class... Args>
+		reference emplace_back(Args&&... args);
+
+		iterator erase(const_iterator position);
+		iterator erase(const_iterator first, const_iterator last);
+
+		void clear() EASTL_NOEXCEPT;
+
+		bool validate() const EASTL_NOEXCEPT;
+
+	protected:
+		T*          mpBegin;
+		T*          mpEnd;
+		T*          mpCommitEnd;     // End of the committed pages, in units of T. Equivalent to vector's capacity pointer.
+		size_t      mnReservedBytes;
+		size_t      mnCommittedBytes;
+		int         mFlags;
+
+		void   DoReserveAddressSpace(size_type nMaxSize);
+		void   DoReleaseAddressSpace();
+		bool   DoCommit(size_type n);
+		size_t DoGetCommitGranularity() const;
+	}; // class reserved_vector
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// reserved_vector
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	inline reserved_vector<T>::reserved_vector(size_type nMaxSize, int flags)
+		: mpBegin(NULL), mpEnd(NULL), mpCommitEnd(NULL), mnReservedBytes(0), mnCommittedBytes(0), mFlags(flags)
+	{
+		DoReserveAddressSpace(nMaxSize);
+	}
+
+
+	template <typename T>
+	inline reserved_vector<T>::reserved_vector(std::initializer_list<value_type> ilist, size_type nMaxSize, int flags)
+		: mpBegin(NULL), mpEnd(NULL), mpCommitEnd(NULL), mnReservedBytes(0), mnCommittedBytes(0), mFlags(flags)
+	{
+		DoReserveAddressSpace(eastl::maxAlt(nMaxSize, (size_type)ilist.size()));
+		if(DoCommit((size_type)ilist.size()))
+			mpEnd = eastl::uninitializedCopy(ilist.begin(), ilist.end(), mpBegin);
+	}
+
+
+	template <typename T>
+	inline reserved_vector<T>::reserved_vector(const this_type& x)
+		: mpBegin(NULL), mpEnd(NULL), mpCommitEnd(NULL), mnReservedBytes(0), mnCommittedBytes(0), mFlags(x.mFlags)
+	{
+		DoReserveAddressSpace(x.maxSize());
+		if(DoCommit(x.size()))
+			mpEnd = eastl::uninitializedCopy(x.mpBegin, x.mpEnd, mpBegin);
+	}
+
+
+	template <typename T>
+	inline reserved_vector<T>::reserved_vector(this_type&& x) EASTL_NOEXCEPT
+		: mpBegin(x.mpBegin), mpEnd(x.mpEnd), mpCommitEnd(x.mpCommitEnd), mnReservedBytes(x.mnReservedBytes), mnCommittedBytes(x.mnCommittedBytes), mFlags(x.mFlags)
+	{
+		x.mpBegin = x.mpEnd = x.mpCommitEnd = NULL;
+		x.mnReservedBytes = x.mnCommittedBytes = 0;
+	}
+
+
+	template <typename T>
+	inline reserved_vector<T>::~reserved_vector()
+	{
+		eastl::destruct(mpBegin, mpEnd);
+		DoReleaseAddressSpace();
+	}
+
+
+	template <typename T>
+	typename reserved_vector<T>::this_type&
+	reserved_vector<T>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			this_type temp(x);
+			swap(temp);
+		}
+
+		return *this;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::this_type&
+	reserved_vector<T>::operator=(this_type&& x) EASTL_NOEXCEPT
+	{
+		if(this != &x)
+			swap(x); // x's destructor will free our previous contents.
+
+		return *this;
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::swap(this_type& x) EASTL_NOEXCEPT
+	{
+		eastl::swap(mpBegin,          x.mpBegin);
+		eastl::swap(mpEnd,            x.mpEnd);
+		eastl::swap(mpCommitEnd,      x.mpCommitEnd);
+		eastl::swap(mnReservedBytes,  x.mnReservedBytes);
+		eastl::swap(mnCommittedBytes, x.mnCommittedBytes);
+		eastl::swap(mFlags,           x.mFlags);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::iterator
+	reserved_vector<T>::begin() EASTL_NOEXCEPT
+	{
+		return mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_iterator
+	reserved_vector<T>::begin() const EASTL_NOEXCEPT
+	{
+		return mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_iterator
+	reserved_vector<T>::cbegin() const EASTL_NOEXCEPT
+	{
+		return mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::iterator
+	reserved_vector<T>::end() EASTL_NOEXCEPT
+	{
+		return mpEnd;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_iterator
+	reserved_vector<T>::end() const EASTL_NOEXCEPT
+	{
+		return mpEnd;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_iterator
+	reserved_vector<T>::cend() const EASTL_NOEXCEPT
+	{
+		return mpEnd;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reverse_iterator
+	reserved_vector<T>::rbegin() EASTL_NOEXCEPT
+	{
+		return reverse_iterator(mpEnd);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_reverse_iterator
+	reserved_vector<T>::rbegin() const EASTL_NOEXCEPT
+	{
+		return const_reverse_iterator(mpEnd);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reverse_iterator
+	reserved_vector<T>::rend() EASTL_NOEXCEPT
+	{
+		return reverse_iterator(mpBegin);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_reverse_iterator
+	reserved_vector<T>::rend() const EASTL_NOEXCEPT
+	{
+		return const_reverse_iterator(mpBegin);
+	}
+
+
+	template <typename T>
+	inline bool reserved_vector<T>::empty() const EASTL_NOEXCEPT
+	{
+		return (mpBegin == mpEnd);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::size_type
+	reserved_vector<T>::size() const EASTL_NOEXCEPT
+	{
+		return (size_type)(mpEnd - mpBegin);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::size_type
+	reserved_vector<T>::capacity() const EASTL_NOEXCEPT
+	{
+		return (size_type)(mpCommitEnd - mpBegin);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::size_type
+	reserved_vector<T>::maxSize() const EASTL_NOEXCEPT
+	{
+		return (size_type)(mnReservedBytes / sizeof(T));
+	}
+
+
+	template <typename T>
+	inline int reserved_vector<T>::getFlags() const EASTL_NOEXCEPT
+	{
+		return mFlags;
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::resize(size_type n, const value_type& value)
+	{
+		const size_type nPrevSize = (size_type)(mpEnd - mpBegin);
+
+		if(n > nPrevSize)
+		{
+			if(EASTL_UNLIKELY(!DoCommit(n)))
+				return;
+			eastl::uninitializedFillN(mpEnd, n - nPrevSize, value);
+		}
+		else
+			eastl::destruct(mpBegin + n, mpEnd);
+
+		mpEnd = mpBegin + n;
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::resize(size_type n)
+	{
+		const size_type nPrevSize = (size_type)(mpEnd - mpBegin);
+
+		if(n > nPrevSize)
+		{
+			if(EASTL_UNLIKELY(!DoCommit(n)))
+				return;
+			eastl::uninitialized_value_construct_n(mpEnd, n - nPrevSize);
+		}
+		else
+			eastl::destruct(mpBegin + n, mpEnd);
+
+		mpEnd = mpBegin + n;
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::reserve(size_type n)
+	{
+		if(n > (size_type)(mpCommitEnd - mpBegin))
+			DoCommit(n);
+	}
+
+
+	template <typename T>
+	void reserved_vector<T>::shrink_to_fit()
+	{
+		const size_t nGranularity = DoGetCommitGranularity();
+		const size_t nNeededBytes = (((size_t)(mpEnd - mpBegin) * sizeof(T)) + (nGranularity - 1)) & ~(nGranularity - 1);
+
+		if(nNeededBytes < mnCommittedBytes)
+		{
+			Internal::VirtualMemoryDecommit((char*)mpBegin + nNeededBytes, mnCommittedBytes - nNeededBytes);
+			mnCommittedBytes = nNeededBytes;
+			mpCommitEnd      = mpBegin + (nNeededBytes / sizeof(T));
+		}
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::pointer
+	reserved_vector<T>::data() EASTL_NOEXCEPT
+	{
+		return mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_pointer
+	reserved_vector<T>::data() const EASTL_NOEXCEPT
+	{
+		return mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reference
+	reserved_vector<T>::operator[](size_type n)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= (size_type)(mpEnd - mpBegin)))
+				EASTL_FAIL_MSG("reserved_vector::operator[] -- out of range");
+		#endif
+
+		return *(mpBegin + n);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_reference
+	reserved_vector<T>::operator[](size_type n) const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= (size_type)(mpEnd - mpBegin)))
+				EASTL_FAIL_MSG("reserved_vector::operator[] -- out of range");
+		#endif
+
+		return *(mpBegin + n);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reference
+	reserved_vector<T>::at(size_type n)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			if(EASTL_UNLIKELY(n >= (size_type)(mpEnd - mpBegin)))
+				throw std::out_of_range("reserved_vector::at -- out of range");
+		#elif EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= (size_type)(mpEnd - mpBegin)))
+				EASTL_FAIL_MSG("reserved_vector::at -- out of range");
+		#endif
+
+		return *(mpBegin + n);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_reference
+	reserved_vector<T>::at(size_type n) const
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			if(EASTL_UNLIKELY(n >= (size_type)(mpEnd - mpBegin)))
+				throw std::out_of_range("reserved_vector::at -- out of range");
+		#elif EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= (size_type)(mpEnd - mpBegin)))
+				EASTL_FAIL_MSG("reserved_vector::at -- out of range");
+		#endif
+
+		return *(mpBegin + n);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reference
+	reserved_vector<T>::front()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mpEnd <= mpBegin))
+				EASTL_FAIL_MSG("reserved_vector::front -- empty vector");
+		#endif
+
+		return *mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_reference
+	reserved_vector<T>::front() const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mpEnd <= mpBegin))
+				EASTL_FAIL_MSG("reserved_vector::front -- empty vector");
+		#endif
+
+		return *mpBegin;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reference
+	reserved_vector<T>::back()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mpEnd <= mpBegin))
+				EASTL_FAIL_MSG("reserved_vector::back -- empty vector");
+		#endif
+
+		return *(mpEnd - 1);
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::const_reference
+	reserved_vector<T>::back() const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mpEnd <= mpBegin))
+				EASTL_FAIL_MSG("reserved_vector::back -- empty vector");
+		#endif
+
+		return *(mpEnd - 1);
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::pushBack(const value_type& value)
+	{
+		if(EASTL_UNLIKELY(mpEnd == mpCommitEnd) && !DoCommit((size_type)(mpEnd - mpBegin) + 1)) // Since we never relocate, value can safely refer to an element of this container.
+			return;
+
+		::new((void*)mpEnd) value_type(value);
+		++mpEnd;
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::pushBack(value_type&& value)
+	{
+		if(EASTL_UNLIKELY(mpEnd == mpCommitEnd) && !DoCommit((size_type)(mpEnd - mpBegin) + 1))
+			return;
+
+		::new((void*)mpEnd) value_type(eastl::move(value));
+		++mpEnd;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::reference
+	reserved_vector<T>::pushBack()
+	{
+		if(EASTL_UNLIKELY(mpEnd == mpCommitEnd) && !DoCommit((size_type)(mpEnd - mpBegin) + 1))
+		{
+			// Only reachable with exceptions disabled, after DoCommit reported the failure. Nothing is
+			// constructed; the returned reference is to uncommitted memory and must not be used.
+			return *mpEnd;
+		}
+
+		EASTL_ASSERT(mpEnd < mpCommitEnd);
+		::new((void*)mpEnd) value_type();
+		return *mpEnd++;
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::popBack()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mpEnd <= mpBegin))
+				EASTL_FAIL_MSG("reserved_vector::popBack -- empty vector");
+		#endif
+
+		--mpEnd;
+		mpEnd->~value_type();
+	}
+
+
+	template <typename T>
+	template<class... Args>
+	inline typename reserved_vector<T>::reference
+	reserved_vector<T>::emplace_back(Args&&... args)
+	{
+		if(EASTL_UNLIKELY(mpEnd == mpCommitEnd) && !DoCommit((size_type)(mpEnd - mpBegin) + 1))
+		{
+			// Only reachable with exceptions disabled, after DoCommit reported the failure. Nothing is
+			// constructed; the returned reference is to uncommitted memory and must not be used.
+			return *mpEnd;
+		}
+
+		EASTL_ASSERT(mpEnd < mpCommitEnd);
+		::new((void*)mpEnd) value_type(eastl::forward<Args>(args)...);
+		return *mpEnd++;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::iterator
+	reserved_vector<T>::erase(const_iterator position)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY((position < mpBegin) || (position >= mpEnd)))
+				EASTL_FAIL_MSG("reserved_vector::erase -- invalid position");
+		#endif
+
+		iterator destPosition = const_cast<value_type*>(position);
+
+		if((destPosition + 1) < mpEnd)
+			eastl::move(destPosition + 1, mpEnd, destPosition);
+		--mpEnd;
+		mpEnd->~value_type();
+		return destPosition;
+	}
+
+
+	template <typename T>
+	inline typename reserved_vector<T>::iterator
+	reserved_vector<T>::erase(const_iterator first, const_iterator last)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY((first < mpBegin) || (first > mpEnd) || (last < mpBegin) || (last > mpEnd) || (last < first)))
+				EASTL_FAIL_MSG("reserved_vector::erase -- invalid position");
+		#endif
+
+		if(first != last)
+		{
+			iterator const position = const_cast<value_type*>(eastl::move(const_cast<value_type*>(last), mpEnd, const_cast<value_type*>(first)));
+			eastl::destruct(position, mpEnd);
+			mpEnd -= (last - first);
+		}
+
+		return const_cast<value_type*>(first);
+	}
+
+
+	template <typename T>
+	inline void reserved_vector<T>::clear() EASTL_NOEXCEPT
+	{
+		eastl::destruct(mpBegin, mpEnd);
+		mpEnd = mpBegin;
+	}
+
+
+	template <typename T>
+	inline bool reserved_vector<T>::validate() const EASTL_NOEXCEPT
+	{
+		if(mpEnd < mpBegin)
+			return false;
+		if(mpCommitEnd < mpEnd)
+			return false;
+		if(mnCommittedBytes > mnReservedBytes)
+			return false;
+		return true;
+	}
+
+
+	template <typename T>
+	inline size_t reserved_vector<T>::DoGetCommitGranularity() const
+	{
+		const size_t nPageSize   = Internal::VirtualMemoryPageSize();
+		const size_t nCommitSize = (mFlags & kFlagHugePages) ? EASTL_RESERVED_VECTOR_HUGE_PAGE_SIZE : EASTL_RESERVED_VECTOR_COMMIT_SIZE;
+
+		return (nCommitSize > nPageSize) ? nCommitSize : nPageSize;
+	}
+
+
+	template <typename T>
+	void reserved_vector<T>::DoReserveAddressSpace(size_type nMaxSize)
+	{
+		if(nMaxSize)
+		{
+			const size_t nGranularity = DoGetCommitGranularity();
+			const size_t nAlignment   = (mFlags & kFlagHugePages) ? EASTL_RESERVED_VECTOR_HUGE_PAGE_SIZE : Internal::VirtualMemoryPageSize();
+			const size_t nBytes       = (((size_t)nMaxSize * sizeof(T)) + (nGranularity - 1)) & ~(nGranularity - 1);
+
+			mpBegin = (T*)Internal::VirtualMemoryReserve(nBytes, nAlignment);
+
+			if(EASTL_UNLIKELY(!mpBegin))
+			{
+				#if EASTL_EXCEPTIONS_ENABLED
+					throw std::bad_alloc();
+				#else
+					EASTL_FAIL_MSG("reserved_vector -- failed to reserve address space");
+					return;
+				#endif
+			}
+
+			mpEnd = mpCommitEnd = mpBegin;
+			mnReservedBytes = nBytes;
+		}
+	}
+
+
+	template <typename T>
+	void reserved_vector<T>::DoReleaseAddressSpace()
+	{
+		if(mpBegin)
+			Internal::VirtualMemoryRelease(mpBegin, mnReservedBytes);
+	}
+
+
+	template <typename T>
+	bool reserved_vector<T>::DoCommit(size_type n)
+	{
+		// Returns false if the first n elements could not be committed, which can only happen
+		// with exceptions disabled. The void growth functions then leave the container unchanged.
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n > maxSize()))
+				EASTL_FAIL_MSG("reserved_vector -- capacity overflow, exceeded the reserved address range");
+		#endif
+
+		if(EASTL_UNLIKELY(n > maxSize()))
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				throw std::length_error("reserved_vector -- exceeded the reserved address range");
+			#else
+				return false;
+			#endif
+		}
+
+		const size_t nGranularity = DoGetCommitGranularity();
+		const size_t nNeededBytes = (((size_t)n * sizeof(T)) + (nGranularity - 1)) & ~(nGranularity - 1);
+
+		if(nNeededBytes > mnCommittedBytes)
+		{
+
+			if(EASTL_UNLIKELY(!Internal::VirtualMemoryCommit((char*)mpBegin + mnCommittedBytes, nNeededBytes - mnCommittedBytes, (mFlags & kFlagHugePages) != 0)))
+			{
+				#if EASTL_EXCEPTIONS_ENABLED
+					throw std::bad_alloc();
+				#else
+					EASTL_FAIL_MSG("reserved_vector -- failed to commit memory");
+					return false;
+				#endif
+			}
+
+			mnCommittedBytes = nNeededBytes;
+			mpCommitEnd      = mpBegin + (nNeededBytes / sizeof(T));
+		}
+
+		return true;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	inline bool operator==(const reserved_vector<T>& a, const reserved_vector<T>& b)
+	{
+		return ((a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin()));
+	}
+
+
+	template <typename T>
+	inline bool operator!=(const reserved_vector<T>& a, const reserved_vector<T>& b)
+	{
+		return ((a.size() != b.size()) || !eastl::equal(a.begin(), a.end(), b.begin()));
+	}
+
+
+	template <typename T>
+	inline void swap(reserved_vector<T>& a, reserved_vector<T>& b) EASTL_NOEXCEPT
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
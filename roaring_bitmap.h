@@ -0,0 +1,1935 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Implements roaring_bitmap, a compressed set of 32 bit unsigned integers.
+//
+// bitset and bitvector take one bit per possible value, which is 512 MiB for
+// the full 32 bit range however few values are set. A roaring bitmap splits
+// the range into 2^16 chunks of 2^16 values and keeps only the chunks that
+// hold values, each in whichever of three encodings is smallest for it:
+//     array:  the sorted low 16 bits of the values (2 bytes per value);
+//     bitmap: one bit per possible value (8 KiB, for chunks of over 4096 values);
+//     run:    sorted (start, length - 1) pairs of consecutive values.
+// Sparse sets thus take about 2 bytes per value, dense ones about one bit per
+// value, and ranges a few bytes. Set operations work chunk by chunk, and
+// bitmap chunks use the same SIMD word primitives as bitset.
+//
+// Array and bitmap chunks are maintained by add and remove. Run chunks come
+// from addRange and runOptimize, and from deserialize; set operations
+// produce array or bitmap chunks, so call runOptimize after them if the
+// result is dominated by runs.
+//
+// serialize writes the portable format of the Roaring bitmap specification
+// (https://github.com/RoaringBitmap/RoaringFormatSpec), so the data can be
+// exchanged with the Roaring libraries of other languages and platforms.
+//
+// Example usage:
+//     eastl::roaring_bitmap<> ids;
+//     ids.add(7);
+//     ids.addRange(1000000, 1999999);
+//     ids.runOptimize();
+//
+//     eastl::roaring_bitmap<> active = ids & otherIds;
+//     active.forEach([](uint32_t id) { Process(id); });
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ROARING_BITMAP_H
+#define EASTL_ROARING_BITMAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/vector.h>
+#include <eastl/algorithm.h>
+#include <eastl/bitset.h>
+#include <eastl/initializer_list.h>
+#include <string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ROARING_BITMAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ROARING_BITMAP_DEFAULT_NAME
+		#define EASTL_ROARING_BITMAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " roaring_bitmap" // Unless the user overrides something, this is "EASTL roaring_bitmap".
+	#endif
+
+	/// EASTL_ROARING_BITMAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_ROARING_BITMAP_DEFAULT_ALLOCATOR
+		#define EASTL_ROARING_BITMAP_DEFAULT_ALLOCATOR allocator_type(EASTL_ROARING_BITMAP_DEFAULT_NAME)
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// RoaringContainer
+		///
+		/// Holds the values of a roaring_bitmap which share their high 16 bits (the key),
+		/// in one of the encodings described at the top of this file.
+		///
+		template <typename Allocator>
+		struct RoaringContainer
+		{
+			typedef RoaringContainer<Allocator>         this_type;
+			typedef eastl::vector<uint16_t, Allocator>  value_array_type;
+			typedef eastl::vector<uint64_t, Allocator>  word_array_type;
+
+			enum Type
+			{
+				kTypeArray,
+				kTypeBitmap,
+				kTypeRun
+			};
+
+			enum
+			{
+				kArrayMaxSize    = 4096,        // An array of more values would be larger than a bitmap.
+				kBitmapWordCount = 65536 / 64,
+				kBitmapBytes     = 65536 / 8
+			};
+
+			value_array_type mValues;        // The values of an array container, or the (start, length - 1) pairs of a run container.
+			word_array_type  mWords;         // The words of a bitmap container; empty otherwise.
+			uint32_t         mnCardinality;  // roaring_bitmap holds no empty containers, so this is in the range of [1, 65536].
+			uint16_t         mKey;
+			uint8_t          mType;
+
+			RoaringContainer(uint16_t key, const Allocator& allocator)
+				: mValues(allocator), mWords(allocator), mnCardinality(0), mKey(key), mType(kTypeArray) { }
+
+			// Membership
+			bool     contains(uint16_t v) const;
+			bool     add(uint16_t v);
+			bool     remove(uint16_t v);
+			void     addRange(uint32_t first, uint32_t last); // Inclusive.
+			uint32_t minimum() const;
+			uint32_t maximum() const;
+
+			// Encodings
+			void   toArray();
+			void   toBitmap();
+			void   toRun();
+			void   toNatural();                               // To array or bitmap, depending on the cardinality.
+			void   optimize();                                // To whichever encoding is smallest.
+			size_t runCount() const;
+			size_t serializedSize() const;
+
+			// Bitmap and run primitives
+			bool     testBit(uint32_t v) const         { return ((mWords[v >> 6] >> (v & 63)) & 1) != 0; }
+			void     setBit(uint32_t v)                { mWords[v >> 6] |= (uint64_t(1) << (v & 63)); }
+			void     resetBit(uint32_t v)              { mWords[v >> 6] &= ~(uint64_t(1) << (v & 63)); }
+			uint32_t findNextBit(uint32_t v) const;   // Returns 65536 if there are no bits set at or after v.
+			void     countBits()                       { mnCardinality = (uint32_t)eastl::detail::BitsetCountWords(mWords.data(), (size_t)kBitmapWordCount); }
+			size_t   runSize() const                   { return mValues.size() / 2; }
+			uint32_t runStart(size_t i) const          { return mValues[2 * i]; }
+			uint32_t runLast(size_t i) const           { return (uint32_t)mValues[2 * i] + mValues[2 * i + 1]; }
+			size_t   runUpperBound(uint32_t v) const;  // Returns the index of the first run which starts after v.
+
+			static void SetWordRange(uint64_t* pWords, uint32_t first, uint32_t last);
+
+			// Set operations. These require a and b to be in array or bitmap encoding, and leave a
+			// in array or bitmap encoding. a may end up empty, which the caller must deal with.
+			static void   And(this_type& a, const this_type& b);
+			static void   Or(this_type& a, const this_type& b);
+			static void   Xor(this_type& a, const this_type& b);
+			static void   AndNot(this_type& a, const this_type& b);
+			static size_t AndCardinality(const this_type& a, const this_type& b);
+			static bool   Intersects(const this_type& a, const this_type& b);
+
+			bool validate() const;
+		};
+
+	} // namespace Internal
+
+
+
+	/// roaring_bitmap_const_iterator
+	///
+	/// Iterates the values of a roaring_bitmap in increasing order.
+	///
+	template <typename Allocator>
+	class roaring_bitmap_const_iterator
+	{
+	public:
+		typedef roaring_bitmap_const_iterator<Allocator>         this_type;
+		typedef Internal::RoaringContainer<Allocator>            container_type;
+		typedef eastl::vector<container_type, Allocator>         container_array_type;
+		typedef uint32_t                                         value_type;
+		typedef uint32_t                                         reference;
+		typedef const uint32_t*                                  pointer;
+		typedef ptrdiff_t                                        difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag               iterator_category;
+
+	public:
+		roaring_bitmap_const_iterator();
+		roaring_bitmap_const_iterator(const container_array_type* pContainers, size_t nContainer);
+
+		reference operator*() const { return ((uint32_t)(*mpContainers)[mnContainer].mKey << 16) | mnLow; }
+
+		this_type& operator++();
+		this_type  operator++(int);
+
+		bool operator==(const this_type& x) const { return (mnContainer == x.mnContainer) && (mnIndex == x.mnIndex) && (mnLow == x.mnLow); }
+		bool operator!=(const this_type& x) const { return !operator==(x); }
+
+	protected:
+		void DoSeekContainer(size_t nContainer);
+
+	protected:
+		const container_array_type* mpContainers;
+		size_t                      mnContainer;  // The container index, or the container count for the end iterator.
+		uint32_t                    mnIndex;      // The array index or run index within the container.
+		uint32_t                    mnLow;        // The low 16 bits of the current value.
+	};
+
+
+
+	/// roaring_bitmap
+	///
+	/// A compressed set of uint32_t values. See the top of this file.
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class roaring_bitmap
+	{
+	public:
+		typedef roaring_bitmap<Allocator>                        this_type;
+		typedef uint32_t                                         value_type;
+		typedef eastl_size_t                                     size_type;
+		typedef Allocator                                        allocator_type;
+		typedef roaring_bitmap_const_iterator<Allocator>         const_iterator;
+		typedef const_iterator                                   iterator;
+		typedef Internal::RoaringContainer<Allocator>            container_type;
+		typedef eastl::vector<container_type, Allocator>         container_array_type;
+
+	public:
+		roaring_bitmap();
+		explicit roaring_bitmap(const allocator_type& allocator);
+		roaring_bitmap(std::initializer_list<value_type> ilist, const allocator_type& allocator = EASTL_ROARING_BITMAP_DEFAULT_ALLOCATOR);
+
+		const_iterator begin() const EASTL_NOEXCEPT;
+		const_iterator end() const EASTL_NOEXCEPT;
+
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;      // The number of values. O(number of 2^16 chunks in use).
+		void      clear() EASTL_NOEXCEPT;
+
+		bool contains(value_type value) const;
+		bool add(value_type value);                  // Returns true if value wasn't already in the set.
+		bool remove(value_type value);               // Returns true if value was in the set.
+		void addRange(value_type first, value_type last);   // Adds [first, last]. The range is inclusive, so that it can reach 0xffffffff.
+
+		value_type minimum() const;                  // The bitmap must not be empty.
+		value_type maximum() const;                  // The bitmap must not be empty.
+
+		template <typename Function>
+		void forEach(Function f) const;              // Calls f(value) for each value in increasing order. Faster than iterating.
+
+		this_type& operator&=(const this_type& x);
+		this_type& operator|=(const this_type& x);
+		this_type& operator^=(const this_type& x);
+		this_type& operator-=(const this_type& x);   // Removes the values of x (and-not).
+
+		size_type andCardinality(const this_type& x) const;  // Returns (*this & x).size() without building the intersection.
+		bool      intersects(const this_type& x) const;       // Returns !(*this & x).empty() without building the intersection.
+
+		bool operator==(const this_type& x) const;
+		bool operator!=(const this_type& x) const;
+
+		// Converts chunks to run encoding where that is smaller. Returns true if any chunk is now in run encoding.
+		bool runOptimize();
+
+		// Portable (Roaring format specification) serialization. serialize writes serializedSize() bytes
+		// and returns that size. deserialize replaces the contents with those of a serialized bitmap,
+		// or returns false and leaves the bitmap empty if the data is malformed or truncated.
+		size_t serializedSize() const;
+		size_t serialize(void* pBuffer) const;
+		bool   deserialize(const void* pBuffer, size_t nBufferSize);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+		allocator_type&       getAllocator() EASTL_NOEXCEPT;
+		void                  setAllocator(const allocator_type& allocator);
+
+		bool validate() const;
+
+	protected:
+		size_t DoLowerBound(uint16_t key) const;
+		size_t DoFindContainer(uint16_t key) const;  // Returns the container count if there is no container for key.
+
+		template <typename Operation>
+		void DoMerge(const this_type& x, Operation operation, bool bKeepOwn, bool bKeepOther);
+
+	protected:
+		container_array_type mContainers;  // Sorted by key.
+	};
+
+
+
+
+	namespace Internal
+	{
+		///////////////////////////////////////////////////////////////////////
+		// RoaringContainer
+		///////////////////////////////////////////////////////////////////////
+
+		template <typename Allocator>
+		inline bool RoaringContainer<Allocator>::contains(uint16_t v) const
+		{
+			if(mType == kTypeArray)
+			{
+				const uint16_t* const pEnd = mValues.end();
+				const uint16_t* const pIt  = eastl::lowerBound(mValues.begin(), pEnd, v);
+
+				return (pIt != pEnd) && (*pIt == v);
+			}
+			else if(mType == kTypeBitmap)
+				return testBit(v);
+
+			const size_t i = runUpperBound(v);
+			return (i > 0) && (v <= runLast(i - 1));
+		}
+
+
+		template <typename Allocator>
+		bool RoaringContainer<Allocator>::add(uint16_t v)
+		{
+			if(mType == kTypeArray)
+			{
+				uint16_t* const pIt = eastl::lowerBound(mValues.begin(), mValues.end(), v);
+
+				if((pIt != mValues.end()) && (*pIt == v))
+					return false;
+
+				if(mnCardinality < (uint32_t)kArrayMaxSize)
+				{
+					mValues.insert(pIt, v);
+					++mnCardinality;
+					return true;
+				}
+
+				toBitmap(); // And fall through.
+			}
+
+			if(mType == kTypeBitmap)
+			{
+				if(testBit(v))
+					return false;
+
+				setBit(v);
+				++mnCardinality;
+				return true;
+			}
+
+			// Run: extend the run before or after v, merging the two if v closes the gap between them.
+			const size_t nRuns = runSize();
+			const size_t i     = runUpperBound(v);
+
+			if(i > 0)
+			{
+				const uint32_t nPrevLast = runLast(i - 1);
+
+				if(v <= nPrevLast)
+					return false;
+
+				if(v == (nPrevLast + 1))
+				{
+					++mValues[2 * (i - 1) + 1];
+
+					if((i < nRuns) && (runStart(i) == (uint32_t)(v + 1)))
+					{
+						mValues[2 * (i - 1) + 1] = (uint16_t)(runLast(i) - runStart(i - 1));
+						mValues.erase(mValues.begin() + 2 * i, mValues.begin() + 2 * i + 2);
+					}
+
+					++mnCardinality;
+					return true;
+				}
+			}
+
+			if((i < nRuns) && (runStart(i) == (uint32_t)(v + 1)))
+			{
+				mValues[2 * i] = v;
+				++mValues[2 * i + 1];
+			}
+			else
+			{
+				const uint16_t run[2] = { v, 0 };
+				mValues.insert(mValues.begin() + 2 * i, run, run + 2);
+			}
+
+			++mnCardinality;
+			return true;
+		}
+
+
+		template <typename Allocator>
+		bool RoaringContainer<Allocator>::remove(uint16_t v)
+		{
+			if(mType == kTypeArray)
+			{
+				uint16_t* const pIt = eastl::lowerBound(mValues.begin(), mValues.end(), v);
+
+				if((pIt == mValues.end()) || (*pIt != v))
+					return false;
+
+				mValues.erase(pIt);
+				--mnCardinality;
+				return true;
+			}
+			else if(mType == kTypeBitmap)
+			{
+				if(!testBit(v))
+					return false;
+
+				resetBit(v);
+
+				if(--mnCardinality <= (uint32_t)kArrayMaxSize)
+					toArray();
+
+				return true;
+			}
+
+			// Run: shrink or split the run which holds v.
+			const size_t i = runUpperBound(v);
+
+			if((i == 0) || (v > runLast(i - 1)))
+				return false;
+
+			const uint32_t nStart = runStart(i - 1);
+			const uint32_t nLast  = runLast(i - 1);
+
+			if(nStart == nLast)
+				mValues.erase(mValues.begin() + 2 * (i - 1), mValues.begin() + 2 * i);
+			else if(v == nStart)
+			{
+				++mValues[2 * (i - 1)];
+				--mValues[2 * (i - 1) + 1];
+			}
+			else if(v == nLast)
+				--mValues[2 * (i - 1) + 1];
+			else
+			{
+				const uint16_t run[2] = { (uint16_t)(v + 1), (uint16_t)(nLast - v - 1) };
+
+				mValues[2 * (i - 1) + 1] = (uint16_t)(v - nStart - 1);
+				mValues.insert(mValues.begin() + 2 * i, run, run + 2);
+			}
+
+			--mnCardinality;
+			return true;
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::addRange(uint32_t first, uint32_t last)
+		{
+			toRun();
+
+			// Replace the runs which overlap or touch [first, last] with a single run.
+			const size_t nRuns = runSize();
+			size_t i = 0;
+
+			while((i < nRuns) && ((runLast(i) + 1) < first))
+				++i;
+
+			size_t j = i;
+
+			while((j < nRuns) && (runStart(j) <= (last + 1)))
+				++j;
+
+			if(i < j)
+			{
+				first = eastl::min(first, runStart(i));
+				last  = eastl::max(last, runLast(j - 1));
+				mValues.erase(mValues.begin() + 2 * i, mValues.begin() + 2 * j);
+			}
+
+			const uint16_t run[2] = { (uint16_t)first, (uint16_t)(last - first) };
+			mValues.insert(mValues.begin() + 2 * i, run, run + 2);
+
+			mnCardinality = 0;
+			for(i = 0; i < runSize(); ++i)
+				mnCardinality += (uint32_t)mValues[2 * i + 1] + 1;
+
+			optimize();
+		}
+
+
+		template <typename Allocator>
+		inline uint32_t RoaringContainer<Allocator>::minimum() const
+		{
+			if(mType == kTypeBitmap)
+				return findNextBit(0);
+
+			return mValues.front(); // The first array value or the first run's start.
+		}
+
+
+		template <typename Allocator>
+		inline uint32_t RoaringContainer<Allocator>::maximum() const
+		{
+			if(mType == kTypeArray)
+				return mValues.back();
+			else if(mType == kTypeRun)
+				return runLast(runSize() - 1);
+
+			const size_t i = eastl::detail::BitsetFindNonZeroWordReverse(mWords.data(), 0, (size_t)kBitmapWordCount);
+			return (uint32_t)(i * 64) + GetLastBit(mWords[i]);
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::toArray()
+		{
+			if(mType == kTypeArray)
+				return;
+
+			value_array_type values(mValues.getAllocator());
+			values.reserve(mnCardinality);
+
+			if(mType == kTypeBitmap)
+			{
+				for(uint32_t i = 0; i < (uint32_t)kBitmapWordCount; ++i)
+				{
+					for(uint64_t w = mWords[i]; w; w &= (w - 1))
+						values.pushBack((uint16_t)((i * 64) + GetFirstBit(w)));
+				}
+
+				word_array_type(mWords.getAllocator()).swap(mWords);
+			}
+			else
+			{
+				for(size_t i = 0; i < runSize(); ++i)
+				{
+					for(uint32_t v = runStart(i), nLast = runLast(i); v <= nLast; ++v)
+						values.pushBack((uint16_t)v);
+				}
+			}
+
+			mValues.swap(values);
+			mType = kTypeArray;
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::toBitmap()
+		{
+			if(mType == kTypeBitmap)
+				return;
+
+			mWords.assign((size_t)kBitmapWordCount, 0);
+
+			if(mType == kTypeArray)
+			{
+				for(const uint16_t* p = mValues.begin(); p != mValues.end(); ++p)
+					setBit(*p);
+			}
+			else
+			{
+				for(size_t i = 0; i < runSize(); ++i)
+					SetWordRange(mWords.data(), runStart(i), runLast(i));
+			}
+
+			value_array_type(mValues.getAllocator()).swap(mValues);
+			mType = kTypeBitmap;
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::toRun()
+		{
+			if(mType == kTypeRun)
+				return;
+
+			value_array_type runs(mValues.getAllocator());
+			runs.reserve(2 * runCount());
+
+			if(mType == kTypeArray)
+			{
+				for(size_t i = 0, n = mValues.size(); i < n; )
+				{
+					size_t j = i + 1;
+
+					while((j < n) && (mValues[j] == (uint16_t)(mValues[j - 1] + 1)))
+						++j;
+
+					runs.pushBack(mValues[i]);
+					runs.pushBack((uint16_t)(j - i - 1));
+					i = j;
+				}
+			}
+			else
+			{
+				// Find each run's first set bit, then its first clear bit, word by word.
+				uint32_t i = 0;
+				uint64_t w = mWords[0];
+
+				for(;;)
+				{
+					while(!w)
+					{
+						if(++i == (uint32_t)kBitmapWordCount)
+							goto Done;
+						w = mWords[i];
+					}
+
+					const uint32_t nStart = (i * 64) + GetFirstBit(w);
+					w |= (w - 1); // Set the bits below the run's start, so that the first clear bit is its end.
+
+					while(w == ~uint64_t(0))
+					{
+						if(++i == (uint32_t)kBitmapWordCount)
+						{
+							runs.pushBack((uint16_t)nStart);
+							runs.pushBack((uint16_t)(65535 - nStart));
+							goto Done;
+						}
+						w = mWords[i];
+					}
+
+					const uint32_t nEnd = (i * 64) + GetFirstBit((uint64_t)~w); // One past the run's last value.
+					runs.pushBack((uint16_t)nStart);
+					runs.pushBack((uint16_t)(nEnd - nStart - 1));
+					w &= (w + 1); // Clear the run's bits.
+				}
+
+				Done:
+				word_array_type(mWords.getAllocator()).swap(mWords);
+			}
+
+			mValues.swap(runs);
+			mType = kTypeRun;
+		}
+
+
+		template <typename Allocator>
+		inline void RoaringContainer<Allocator>::toNatural()
+		{
+			if(mnCardinality <= (uint32_t)kArrayMaxSize)
+				toArray();
+			else
+				toBitmap();
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::optimize()
+		{
+			const size_t nNaturalBytes = (mnCardinality <= (uint32_t)kArrayMaxSize) ? (2 * mnCardinality) : (size_t)kBitmapBytes;
+			const size_t nRunBytes     = 2 + (4 * runCount());
+
+			if(nRunBytes < nNaturalBytes)
+				toRun();
+			else
+				toNatural();
+		}
+
+
+		template <typename Allocator>
+		size_t RoaringContainer<Allocator>::runCount() const
+		{
+			if(mType == kTypeRun)
+				return runSize();
+
+			size_t n = 0;
+
+			if(mType == kTypeArray)
+			{
+				for(size_t i = 0; i < mValues.size(); ++i)
+				{
+					if((i == 0) || (mValues[i] != (uint16_t)(mValues[i - 1] + 1)))
+						++n;
+				}
+			}
+			else
+			{
+				// Count the set bits which are followed by a clear bit, i.e. the run ends.
+				for(size_t i = 0; i < (size_t)kBitmapWordCount; ++i)
+				{
+					const uint64_t w     = mWords[i];
+					const uint64_t wNext = ((i + 1) < (size_t)kBitmapWordCount) ? mWords[i + 1] : 0;
+
+					n += BitsetPopCount((uint64_t)((w << 1) & ~w));
+					n += (size_t)((w >> 63) & ~wNext & 1);
+				}
+			}
+
+			return n;
+		}
+
+
+		template <typename Allocator>
+		inline size_t RoaringContainer<Allocator>::serializedSize() const
+		{
+			if(mType == kTypeArray)
+				return 2 * mValues.size();
+			else if(mType == kTypeBitmap)
+				return (size_t)kBitmapBytes;
+			return 2 + (2 * mValues.size());
+		}
+
+
+		template <typename Allocator>
+		inline uint32_t RoaringContainer<Allocator>::findNextBit(uint32_t v) const
+		{
+			if(v >= 65536)
+				return 65536;
+
+			size_t   i = v >> 6;
+			uint64_t w = mWords[i] & (~uint64_t(0) << (v & 63));
+
+			if(!w)
+			{
+				i = eastl::detail::BitsetFindNonZeroWord(mWords.data(), i + 1, (size_t)kBitmapWordCount);
+
+				if(i == (size_t)kBitmapWordCount)
+					return 65536;
+
+				w = mWords[i];
+			}
+
+			return (uint32_t)(i * 64) + GetFirstBit(w);
+		}
+
+
+		template <typename Allocator>
+		inline size_t RoaringContainer<Allocator>::runUpperBound(uint32_t v) const
+		{
+			size_t nLow  = 0;
+			size_t nHigh = runSize();
+
+			while(nLow < nHigh)
+			{
+				const size_t nMid = (nLow + nHigh) / 2;
+
+				if(runStart(nMid) <= v)
+					nLow = nMid + 1;
+				else
+					nHigh = nMid;
+			}
+
+			return nLow;
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::SetWordRange(uint64_t* pWords, uint32_t first, uint32_t last)
+		{
+			const uint32_t nFirstWord = first >> 6;
+			const uint32_t nLastWord  = last >> 6;
+			const uint64_t firstMask  = ~uint64_t(0) << (first & 63);
+			const uint64_t lastMask   = ~uint64_t(0) >> (63 - (last & 63));
+
+			if(nFirstWord == nLastWord)
+				pWords[nFirstWord] |= (firstMask & lastMask);
+			else
+			{
+				pWords[nFirstWord] |= firstMask;
+
+				for(uint32_t i = nFirstWord + 1; i < nLastWord; ++i)
+					pWords[i] = ~uint64_t(0);
+
+				pWords[nLastWord] |= lastMask;
+			}
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::And(this_type& a, const this_type& b)
+		{
+			if(a.mType == kTypeArray)
+			{
+				// Compact the common values to the front of a; b's bitmap is tested directly.
+				size_t n = 0;
+
+				if(b.mType == kTypeArray)
+				{
+					for(size_t i = 0, j = 0; (i < a.mValues.size()) && (j < b.mValues.size()); )
+					{
+						if(a.mValues[i] < b.mValues[j])
+							++i;
+						else if(b.mValues[j] < a.mValues[i])
+							++j;
+						else
+						{
+							a.mValues[n++] = a.mValues[i];
+							++i;
+							++j;
+						}
+					}
+				}
+				else
+				{
+					for(size_t i = 0; i < a.mValues.size(); ++i)
+					{
+						if(b.testBit(a.mValues[i]))
+							a.mValues[n++] = a.mValues[i];
+					}
+				}
+
+				a.mValues.resize(n);
+				a.mnCardinality = (uint32_t)n;
+			}
+			else if(b.mType == kTypeArray)
+			{
+				value_array_type values(a.mValues.getAllocator());
+				values.reserve(b.mValues.size());
+
+				for(size_t j = 0; j < b.mValues.size(); ++j)
+				{
+					if(a.testBit(b.mValues[j]))
+						values.pushBack(b.mValues[j]);
+				}
+
+				word_array_type(a.mWords.getAllocator()).swap(a.mWords);
+				a.mValues.swap(values);
+				a.mnCardinality = (uint32_t)a.mValues.size();
+				a.mType = kTypeArray;
+			}
+			else
+			{
+				eastl::detail::BitsetApplyWords(a.mWords.data(), b.mWords.data(), (size_t)kBitmapWordCount, eastl::detail::BitsetAndOp());
+				a.countBits();
+				a.toNatural();
+			}
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::Or(this_type& a, const this_type& b)
+		{
+			if((a.mType == kTypeArray) && (b.mType == kTypeArray) && ((a.mnCardinality + b.mnCardinality) <= (uint32_t)kArrayMaxSize))
+			{
+				value_array_type values(a.mValues.getAllocator());
+				values.resize(a.mValues.size() + b.mValues.size());
+
+				uint16_t* const pEnd = eastl::set_union(a.mValues.begin(), a.mValues.end(), b.mValues.begin(), b.mValues.end(), values.begin());
+				values.resize((size_t)(pEnd - values.begin()));
+
+				a.mValues.swap(values);
+				a.mnCardinality = (uint32_t)a.mValues.size();
+				return;
+			}
+
+			a.toBitmap();
+
+			if(b.mType == kTypeArray)
+			{
+				for(size_t j = 0; j < b.mValues.size(); ++j)
+				{
+					if(!a.testBit(b.mValues[j]))
+					{
+						a.setBit(b.mValues[j]);
+						++a.mnCardinality;
+					}
+				}
+			}
+			else
+			{
+				eastl::detail::BitsetApplyWords(a.mWords.data(), b.mWords.data(), (size_t)kBitmapWordCount, eastl::detail::BitsetOrOp());
+				a.countBits();
+			}
+
+			a.toNatural(); // Two overlapping arrays can have a small union.
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::Xor(this_type& a, const this_type& b)
+		{
+			if((a.mType == kTypeArray) && (b.mType == kTypeArray))
+			{
+				value_array_type values(a.mValues.getAllocator());
+				values.resize(a.mValues.size() + b.mValues.size());
+
+				uint16_t* const pEnd = eastl::set_symmetric_difference(a.mValues.begin(), a.mValues.end(), b.mValues.begin(), b.mValues.end(), values.begin());
+				values.resize((size_t)(pEnd - values.begin()));
+
+				a.mValues.swap(values);
+				a.mnCardinality = (uint32_t)a.mValues.size();
+
+				if(a.mnCardinality > (uint32_t)kArrayMaxSize)
+					a.toBitmap();
+				return;
+			}
+
+			a.toBitmap();
+
+			if(b.mType == kTypeArray)
+			{
+				for(size_t j = 0; j < b.mValues.size(); ++j)
+				{
+					const uint32_t v = b.mValues[j];
+
+					a.mWords[v >> 6] ^= (uint64_t(1) << (v & 63));
+					a.mnCardinality = a.testBit(v) ? (a.mnCardinality + 1) : (a.mnCardinality - 1);
+				}
+			}
+			else
+			{
+				eastl::detail::BitsetApplyWords(a.mWords.data(), b.mWords.data(), (size_t)kBitmapWordCount, eastl::detail::BitsetXorOp());
+				a.countBits();
+			}
+
+			a.toNatural();
+		}
+
+
+		template <typename Allocator>
+		void RoaringContainer<Allocator>::AndNot(this_type& a, const this_type& b)
+		{
+			if(a.mType == kTypeArray)
+			{
+				size_t n = 0;
+
+				if(b.mType == kTypeArray)
+				{
+					size_t j = 0;
+
+					for(size_t i = 0; i < a.mValues.size(); ++i)
+					{
+						while((j < b.mValues.size()) && (b.mValues[j] < a.mValues[i]))
+							++j;
+
+						if((j == b.mValues.size()) || (b.mValues[j] != a.mValues[i]))
+							a.mValues[n++] = a.mValues[i];
+					}
+				}
+				else
+				{
+					for(size_t i = 0; i < a.mValues.size(); ++i)
+					{
+						if(!b.testBit(a.mValues[i]))
+							a.mValues[n++] = a.mValues[i];
+					}
+				}
+
+				a.mValues.resize(n);
+				a.mnCardinality = (uint32_t)n;
+				return;
+			}
+
+			if(b.mType == kTypeArray)
+			{
+				for(size_t j = 0; j < b.mValues.size(); ++j)
+				{
+					if(a.testBit(b.mValues[j]))
+					{
+						a.resetBit(b.mValues[j]);
+						--a.mnCardinality;
+					}
+				}
+			}
+			else
+			{
+				eastl::detail::BitsetApplyWords(a.mWords.data(), b.mWords.data(), (size_t)kBitmapWordCount, eastl::detail::BitsetAndNotOp());
+				a.countBits();
+			}
+
+			a.toNatural();
+		}
+
+
+		template <typename Allocator>
+		size_t RoaringContainer<Allocator>::AndCardinality(const this_type& a, const this_type& b)
+		{
+			if((a.mType == kTypeBitmap) && (b.mType == kTypeBitmap))
+				return eastl::detail::BitsetCountAndWords(a.mWords.data(), b.mWords.data(), (size_t)kBitmapWordCount);
+
+			size_t n = 0;
+
+			if((a.mType == kTypeArray) && (b.mType == kTypeArray))
+			{
+				for(size_t i = 0, j = 0; (i < a.mValues.size()) && (j < b.mValues.size()); )
+				{
+					if(a.mValues[i] < b.mValues[j])
+						++i;
+					else if(b.mValues[j] < a.mValues[i])
+						++j;
+					else
+					{
+						++n;
+						++i;
+						++j;
+					}
+				}
+			}
+			else
+			{
+				const this_type& arrayContainer  = (a.mType == kTypeArray) ? a : b;
+				const this_type& bitmapContainer = (a.mType == kTypeArray) ? b : a;
+
+				for(size_t i = 0; i < arrayContainer.mValues.size(); ++i)
+					n += bitmapContainer.testBit(arrayContainer.mValues[i]);
+			}
+
+			return n;
+		}
+
+
+		template <typename Allocator>
+		bool RoaringContainer<Allocator>::Intersects(const this_type& a, const this_type& b)
+		{
+			if((a.mType == kTypeBitmap) && (b.mType == kTypeBitmap))
+				return eastl::detail::BitsetIntersectsWords(a.mWords.data(), b.mWords.data(), (size_t)kBitmapWordCount);
+
+			if((a.mType == kTypeArray) && (b.mType == kTypeArray))
+			{
+				for(size_t i = 0, j = 0; (i < a.mValues.size()) && (j < b.mValues.size()); )
+				{
+					if(a.mValues[i] < b.mValues[j])
+						++i;
+					else if(b.mValues[j] < a.mValues[i])
+						++j;
+					else
+						return true;
+				}
+
+				return false;
+			}
+
+			const this_type& arrayContainer  = (a.mType == kTypeArray) ? a : b;
+			const this_type& bitmapContainer = (a.mType == kTypeArray) ? b : a;
+
+			for(size_t i = 0; i < arrayContainer.mValues.size(); ++i)
+			{
+				if(bitmapContainer.testBit(arrayContainer.mValues[i]))
+					return true;
+			}
+
+			return false;
+		}
+
+
+		template <typename Allocator>
+		bool RoaringContainer<Allocator>::validate() const
+		{
+			if((mnCardinality == 0) || (mnCardinality > 65536))
+				return false;
+
+			if(mType == kTypeArray)
+			{
+				if(!mWords.empty() || (mValues.size() != mnCardinality) || (mnCardinality > (uint32_t)kArrayMaxSize))
+					return false;
+
+				for(size_t i = 1; i < mValues.size(); ++i)
+				{
+					if(mValues[i - 1] >= mValues[i])
+						return false;
+				}
+			}
+			else if(mType == kTypeBitmap)
+			{
+				if(!mValues.empty() || (mWords.size() != (size_t)kBitmapWordCount) || (mnCardinality <= (uint32_t)kArrayMaxSize))
+					return false;
+
+				if(eastl::detail::BitsetCountWords(mWords.data(), (size_t)kBitmapWordCount) != mnCardinality)
+					return false;
+			}
+			else if(mType == kTypeRun)
+			{
+				if(!mWords.empty() || mValues.empty() || (mValues.size() & 1))
+					return false;
+
+				uint32_t n = 0;
+
+				for(size_t i = 0; i < runSize(); ++i)
+				{
+					if((runLast(i) > 65535) || ((i > 0) && (runStart(i) <= (runLast(i - 1) + 1)))) // Runs must neither overlap nor touch.
+						return false;
+
+					n += (runLast(i) - runStart(i)) + 1;
+				}
+
+				if(n != mnCardinality)
+					return false;
+			}
+			else
+				return false;
+
+			return true;
+		}
+
+
+		// Little-endian reads and writes for the portable serialization format.
+		inline void RoaringWrite16(uint8_t*& p, uint32_t v)
+		{
+			p[0] = (uint8_t)v;
+			p[1] = (uint8_t)(v >> 8);
+			p += 2;
+		}
+
+		inline void RoaringWrite32(uint8_t*& p, uint32_t v)
+		{
+			RoaringWrite16(p, v & 0xffff);
+			RoaringWrite16(p, v >> 16);
+		}
+
+		inline uint32_t RoaringRead16(const uint8_t*& p)
+		{
+			const uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+			p += 2;
+			return v;
+		}
+
+		inline uint32_t RoaringRead32(const uint8_t*& p)
+		{
+			const uint32_t v = RoaringRead16(p);
+			return v | (RoaringRead16(p) << 16);
+		}
+
+	} // namespace Internal
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// roaring_bitmap_const_iterator
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Allocator>
+	inline roaring_bitmap_const_iterator<Allocator>::roaring_bitmap_const_iterator()
+		: mpContainers(NULL), mnContainer(0), mnIndex(0), mnLow(0)
+	{
+	}
+
+
+	template <typename Allocator>
+	inline roaring_bitmap_const_iterator<Allocator>::roaring_bitmap_const_iterator(const container_array_type* pContainers, size_t nContainer)
+		: mpContainers(pContainers), mnContainer(0), mnIndex(0), mnLow(0)
+	{
+		DoSeekContainer(nContainer);
+	}
+
+
+	template <typename Allocator>
+	inline void roaring_bitmap_const_iterator<Allocator>::DoSeekContainer(size_t nContainer)
+	{
+		mnContainer = nContainer;
+		mnIndex     = 0;
+		mnLow       = (nContainer < mpContainers->size()) ? (*mpContainers)[nContainer].minimum() : 0;
+	}
+
+
+	template <typename Allocator>
+	typename roaring_bitmap_const_iterator<Allocator>::this_type&
+	roaring_bitmap_const_iterator<Allocator>::operator++()
+	{
+		const container_type& c = (*mpContainers)[mnContainer];
+
+		if(c.mType == container_type::kTypeArray)
+		{
+			if(++mnIndex < (uint32_t)c.mValues.size())
+			{
+				mnLow = c.mValues[mnIndex];
+				return *this;
+			}
+		}
+		else if(c.mType == container_type::kTypeBitmap)
+		{
+			const uint32_t nNext = c.findNextBit(mnLow + 1);
+
+			if(nNext < 65536)
+			{
+				mnLow = nNext;
+				return *this;
+			}
+		}
+		else
+		{
+			if(mnLow < c.runLast(mnIndex))
+			{
+				++mnLow;
+				return *this;
+			}
+
+			if(++mnIndex < (uint32_t)c.runSize())
+			{
+				mnLow = c.runStart(mnIndex);
+				return *this;
+			}
+		}
+
+		DoSeekContainer(mnContainer + 1);
+		return *this;
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap_const_iterator<Allocator>::this_type
+	roaring_bitmap_const_iterator<Allocator>::operator++(int)
+	{
+		this_type temp(*this);
+		operator++();
+		return temp;
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// roaring_bitmap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator>::roaring_bitmap()
+		: mContainers(EASTL_ROARING_BITMAP_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator>::roaring_bitmap(const allocator_type& allocator)
+		: mContainers(allocator)
+	{
+	}
+
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator>::roaring_bitmap(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: mContainers(allocator)
+	{
+		for(const value_type* p = ilist.begin(); p != ilist.end(); ++p)
+			add(*p);
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap<Allocator>::const_iterator
+	roaring_bitmap<Allocator>::begin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(&mContainers, 0);
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap<Allocator>::const_iterator
+	roaring_bitmap<Allocator>::end() const EASTL_NOEXCEPT
+	{
+		return const_iterator(&mContainers, mContainers.size());
+	}
+
+
+	template <typename Allocator>
+	inline bool roaring_bitmap<Allocator>::empty() const EASTL_NOEXCEPT
+	{
+		return mContainers.empty();
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap<Allocator>::size_type
+	roaring_bitmap<Allocator>::size() const EASTL_NOEXCEPT
+	{
+		size_type n = 0;
+
+		for(size_t i = 0; i < mContainers.size(); ++i)
+			n += mContainers[i].mnCardinality;
+
+		return n;
+	}
+
+
+	template <typename Allocator>
+	inline void roaring_bitmap<Allocator>::clear() EASTL_NOEXCEPT
+	{
+		mContainers.clear();
+	}
+
+
+	template <typename Allocator>
+	inline size_t roaring_bitmap<Allocator>::DoLowerBound(uint16_t key) const
+	{
+		// Values are usually added in increasing order, so check the last container first.
+		const size_t nCount = mContainers.size();
+
+		if((nCount == 0) || (mContainers[nCount - 1].mKey < key))
+			return nCount;
+
+		size_t nLow  = 0;
+		size_t nHigh = nCount - 1;
+
+		while(nLow < nHigh)
+		{
+			const size_t nMid = (nLow + nHigh) / 2;
+
+			if(mContainers[nMid].mKey < key)
+				nLow = nMid + 1;
+			else
+				nHigh = nMid;
+		}
+
+		return nLow;
+	}
+
+
+	template <typename Allocator>
+	inline size_t roaring_bitmap<Allocator>::DoFindContainer(uint16_t key) const
+	{
+		const size_t i = DoLowerBound(key);
+
+		if((i < mContainers.size()) && (mContainers[i].mKey == key))
+			return i;
+
+		return mContainers.size();
+	}
+
+
+	template <typename Allocator>
+	inline bool roaring_bitmap<Allocator>::contains(value_type value) const
+	{
+		const size_t i = DoFindContainer((uint16_t)(value >> 16));
+
+		return (i < mContainers.size()) && mContainers[i].contains((uint16_t)value);
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::add(value_type value)
+	{
+		const uint16_t key = (uint16_t)(value >> 16);
+		const size_t   i   = DoLowerBound(key);
+
+		if((i == mContainers.size()) || (mContainers[i].mKey != key))
+			mContainers.insert(mContainers.begin() + i, container_type(key, mContainers.getAllocator()));
+
+		return mContainers[i].add((uint16_t)value);
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::remove(value_type value)
+	{
+		const size_t i = DoFindContainer((uint16_t)(value >> 16));
+
+		if((i == mContainers.size()) || !mContainers[i].remove((uint16_t)value))
+			return false;
+
+		if(mContainers[i].mnCardinality == 0)
+			mContainers.erase(mContainers.begin() + i);
+
+		return true;
+	}
+
+
+	template <typename Allocator>
+	void roaring_bitmap<Allocator>::addRange(value_type first, value_type last)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(first > last))
+				EASTL_FAIL_MSG("roaring_bitmap::addRange -- first > last");
+		#endif
+
+		for(uint32_t key = (first >> 16); key <= (last >> 16); ++key)
+		{
+			const uint32_t nFirst = (key == (first >> 16)) ? (first & 0xffff) : 0;
+			const uint32_t nLast  = (key == (last >> 16))  ? (last & 0xffff)  : 0xffff;
+			size_t         i      = DoLowerBound((uint16_t)key);
+
+			if((i == mContainers.size()) || (mContainers[i].mKey != key))
+				mContainers.insert(mContainers.begin() + i, container_type((uint16_t)key, mContainers.getAllocator()));
+
+			mContainers[i].addRange(nFirst, nLast);
+		}
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap<Allocator>::value_type
+	roaring_bitmap<Allocator>::minimum() const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mContainers.empty()))
+				EASTL_FAIL_MSG("roaring_bitmap::minimum -- empty bitmap");
+		#endif
+
+		const container_type& c = mContainers.front();
+		return ((uint32_t)c.mKey << 16) | c.minimum();
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap<Allocator>::value_type
+	roaring_bitmap<Allocator>::maximum() const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mContainers.empty()))
+				EASTL_FAIL_MSG("roaring_bitmap::maximum -- empty bitmap");
+		#endif
+
+		const container_type& c = mContainers.back();
+		return ((uint32_t)c.mKey << 16) | c.maximum();
+	}
+
+
+	template <typename Allocator>
+	template <typename Function>
+	void roaring_bitmap<Allocator>::forEach(Function f) const
+	{
+		for(size_t i = 0; i < mContainers.size(); ++i)
+		{
+			const container_type& c    = mContainers[i];
+			const uint32_t        high = (uint32_t)c.mKey << 16;
+
+			if(c.mType == container_type::kTypeArray)
+			{
+				for(size_t j = 0; j < c.mValues.size(); ++j)
+					f(high | c.mValues[j]);
+			}
+			else if(c.mType == container_type::kTypeBitmap)
+			{
+				for(uint32_t j = 0; j < (uint32_t)container_type::kBitmapWordCount; ++j)
+				{
+					for(uint64_t w = c.mWords[j]; w; w &= (w - 1))
+						f(high | ((j * 64) + GetFirstBit(w)));
+				}
+			}
+			else
+			{
+				for(size_t j = 0; j < c.runSize(); ++j)
+				{
+					for(uint32_t v = c.runStart(j), nLast = c.runLast(j); v <= nLast; ++v)
+						f(high | v);
+				}
+			}
+		}
+	}
+
+
+	template <typename Allocator>
+	template <typename Operation>
+	void roaring_bitmap<Allocator>::DoMerge(const this_type& x, Operation operation, bool bKeepOwn, bool bKeepOther)
+	{
+		// Walks both container arrays in key order. Containers with a key in both are combined with
+		// operation; the others are kept or dropped as requested. Run containers are expanded first,
+		// as the set operations work on arrays and bitmaps.
+		container_array_type result(mContainers.getAllocator());
+		result.reserve(mContainers.size() + (bKeepOther ? x.mContainers.size() : 0));
+
+		size_t i = 0, j = 0;
+
+		while((i < mContainers.size()) || (j < x.mContainers.size()))
+		{
+			if((j == x.mContainers.size()) || ((i < mContainers.size()) && (mContainers[i].mKey < x.mContainers[j].mKey)))
+			{
+				if(bKeepOwn)
+					result.pushBack(eastl::move(mContainers[i]));
+				++i;
+			}
+			else if((i == mContainers.size()) || (x.mContainers[j].mKey < mContainers[i].mKey))
+			{
+				if(bKeepOther)
+				{
+					result.pushBack(container_type(x.mContainers[j].mKey, mContainers.getAllocator()));
+					result.back() = x.mContainers[j]; // Copies the values but keeps our allocator.
+				}
+				++j;
+			}
+			else
+			{
+				container_type& a = mContainers[i];
+				a.toNatural();
+
+				if(x.mContainers[j].mType == container_type::kTypeRun)
+				{
+					container_type b(x.mContainers[j]);
+					b.toNatural();
+					operation(a, b);
+				}
+				else
+					operation(a, x.mContainers[j]);
+
+				if(a.mnCardinality)
+					result.pushBack(eastl::move(a));
+				++i;
+				++j;
+			}
+		}
+
+		mContainers.swap(result);
+	}
+
+
+	template <typename Allocator>
+	typename roaring_bitmap<Allocator>::this_type&
+	roaring_bitmap<Allocator>::operator&=(const this_type& x)
+	{
+		if(&x != this)
+			DoMerge(x, &container_type::And, false, false);
+		return *this;
+	}
+
+
+	template <typename Allocator>
+	typename roaring_bitmap<Allocator>::this_type&
+	roaring_bitmap<Allocator>::operator|=(const this_type& x)
+	{
+		if(&x != this)
+			DoMerge(x, &container_type::Or, true, true);
+		return *this;
+	}
+
+
+	template <typename Allocator>
+	typename roaring_bitmap<Allocator>::this_type&
+	roaring_bitmap<Allocator>::operator^=(const this_type& x)
+	{
+		if(&x != this)
+			DoMerge(x, &container_type::Xor, true, true);
+		else
+			clear();
+		return *this;
+	}
+
+
+	template <typename Allocator>
+	typename roaring_bitmap<Allocator>::this_type&
+	roaring_bitmap<Allocator>::operator-=(const this_type& x)
+	{
+		if(&x != this)
+			DoMerge(x, &container_type::AndNot, true, false);
+		else
+			clear();
+		return *this;
+	}
+
+
+	template <typename Allocator>
+	typename roaring_bitmap<Allocator>::size_type
+	roaring_bitmap<Allocator>::andCardinality(const this_type& x) const
+	{
+		size_type n = 0;
+
+		for(size_t i = 0, j = 0; (i < mContainers.size()) && (j < x.mContainers.size()); )
+		{
+			const container_type& a = mContainers[i];
+			const container_type& b = x.mContainers[j];
+
+			if(a.mKey < b.mKey)
+				++i;
+			else if(b.mKey < a.mKey)
+				++j;
+			else
+			{
+				if((a.mType == container_type::kTypeRun) || (b.mType == container_type::kTypeRun))
+				{
+					container_type aNatural(a), bNatural(b);
+					aNatural.toNatural();
+					bNatural.toNatural();
+					n += (size_type)container_type::AndCardinality(aNatural, bNatural);
+				}
+				else
+					n += (size_type)container_type::AndCardinality(a, b);
+				++i;
+				++j;
+			}
+		}
+
+		return n;
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::intersects(const this_type& x) const
+	{
+		for(size_t i = 0, j = 0; (i < mContainers.size()) && (j < x.mContainers.size()); )
+		{
+			const container_type& a = mContainers[i];
+			const container_type& b = x.mContainers[j];
+
+			if(a.mKey < b.mKey)
+				++i;
+			else if(b.mKey < a.mKey)
+				++j;
+			else
+			{
+				if((a.mType == container_type::kTypeRun) || (b.mType == container_type::kTypeRun))
+				{
+					container_type aNatural(a), bNatural(b);
+					aNatural.toNatural();
+					bNatural.toNatural();
+
+					if(container_type::Intersects(aNatural, bNatural))
+						return true;
+				}
+				else if(container_type::Intersects(a, b))
+					return true;
+				++i;
+				++j;
+			}
+		}
+
+		return false;
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::operator==(const this_type& x) const
+	{
+		if(mContainers.size() != x.mContainers.size())
+			return false;
+
+		for(size_t i = 0; i < mContainers.size(); ++i)
+		{
+			if((mContainers[i].mKey != x.mContainers[i].mKey) || (mContainers[i].mnCardinality != x.mContainers[i].mnCardinality))
+				return false;
+		}
+
+		// Equal keys and sizes; the sets are equal if the intersection is as large.
+		return andCardinality(x) == size();
+	}
+
+
+	template <typename Allocator>
+	inline bool roaring_bitmap<Allocator>::operator!=(const this_type& x) const
+	{
+		return !operator==(x);
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::runOptimize()
+	{
+		bool bHasRun = false;
+
+		for(size_t i = 0; i < mContainers.size(); ++i)
+		{
+			mContainers[i].optimize();
+			bHasRun |= (mContainers[i].mType == container_type::kTypeRun);
+		}
+
+		return bHasRun;
+	}
+
+
+	// The serialized layout is, with all integers little-endian:
+	//     uint32_t cookie            12346, or 12347 | ((container count - 1) << 16) if there are run containers.
+	//     uint32_t container count   Only if the cookie is 12346.
+	//     uint8_t  run flags[]       Only with run containers; one bit per container, set for the run containers.
+	//     uint16_t key, cardinality - 1, for each container.
+	//     uint32_t offset[]          Byte offset of each container from the start; omitted with run containers if there are fewer than 4 of them.
+	//     containers                 Array: the values. Bitmap (over 4096 values): 1024 uint64_t. Run: uint16_t run count, then (start, length - 1) pairs.
+	//
+	template <typename Allocator>
+	size_t roaring_bitmap<Allocator>::serializedSize() const
+	{
+		const size_t nCount  = mContainers.size();
+		bool         bHasRun = false;
+		size_t       nSize   = 0;
+
+		for(size_t i = 0; i < nCount; ++i)
+		{
+			bHasRun |= (mContainers[i].mType == container_type::kTypeRun);
+			nSize   += mContainers[i].serializedSize();
+		}
+
+		nSize += bHasRun ? (4 + ((nCount + 7) / 8)) : 8;
+		nSize += 4 * nCount;
+
+		if(!bHasRun || (nCount >= 4))
+			nSize += 4 * nCount;
+
+		return nSize;
+	}
+
+
+	template <typename Allocator>
+	size_t roaring_bitmap<Allocator>::serialize(void* pBuffer) const
+	{
+		const size_t   nCount  = mContainers.size();
+		uint8_t* const pBegin  = static_cast<uint8_t*>(pBuffer);
+		uint8_t*       p       = pBegin;
+		bool           bHasRun = false;
+
+		for(size_t i = 0; i < nCount; ++i)
+			bHasRun |= (mContainers[i].mType == container_type::kTypeRun);
+
+		if(bHasRun)
+		{
+			Internal::RoaringWrite32(p, 12347u | ((uint32_t)(nCount - 1) << 16));
+
+			memset(p, 0, (nCount + 7) / 8);
+			for(size_t i = 0; i < nCount; ++i)
+			{
+				if(mContainers[i].mType == container_type::kTypeRun)
+					p[i / 8] |= (uint8_t)(1u << (i % 8));
+			}
+			p += (nCount + 7) / 8;
+		}
+		else
+		{
+			Internal::RoaringWrite32(p, 12346u);
+			Internal::RoaringWrite32(p, (uint32_t)nCount);
+		}
+
+		for(size_t i = 0; i < nCount; ++i)
+		{
+			Internal::RoaringWrite16(p, mContainers[i].mKey);
+			Internal::RoaringWrite16(p, mContainers[i].mnCardinality - 1);
+		}
+
+		if(!bHasRun || (nCount >= 4))
+		{
+			uint32_t nOffset = (uint32_t)((p - pBegin) + (4 * nCount));
+
+			for(size_t i = 0; i < nCount; ++i)
+			{
+				Internal::RoaringWrite32(p, nOffset);
+				nOffset += (uint32_t)mContainers[i].serializedSize();
+			}
+		}
+
+		for(size_t i = 0; i < nCount; ++i)
+		{
+			const container_type& c = mContainers[i];
+
+			if(c.mType == container_type::kTypeRun)
+				Internal::RoaringWrite16(p, (uint32_t)c.runSize());
+
+			if(c.mType == container_type::kTypeBitmap)
+			{
+				#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+					memcpy(p, c.mWords.data(), (size_t)container_type::kBitmapBytes);
+					p += container_type::kBitmapBytes;
+				#else
+					for(size_t j = 0; j < (size_t)container_type::kBitmapWordCount; ++j)
+					{
+						Internal::RoaringWrite32(p, (uint32_t)c.mWords[j]);
+						Internal::RoaringWrite32(p, (uint32_t)(c.mWords[j] >> 32));
+					}
+				#endif
+			}
+			else
+			{
+				for(size_t j = 0; j < c.mValues.size(); ++j)
+					Internal::RoaringWrite16(p, c.mValues[j]);
+			}
+		}
+
+		return (size_t)(p - pBegin);
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::deserialize(const void* pBuffer, size_t nBufferSize)
+	{
+		clear();
+
+		const uint8_t*       p    = static_cast<const uint8_t*>(pBuffer);
+		const uint8_t* const pEnd = p + nBufferSize;
+		const uint8_t*       pRunFlags = NULL;
+		size_t               nCount;
+
+		if(nBufferSize < 4)
+			return false;
+
+		const uint32_t nCookie = Internal::RoaringRead32(p);
+
+		if((nCookie & 0xffff) == 12347)
+		{
+			nCount    = (size_t)(nCookie >> 16) + 1;
+			pRunFlags = p;
+
+			if((size_t)(pEnd - p) < ((nCount + 7) / 8))
+				return false;
+			p += (nCount + 7) / 8;
+		}
+		else if(nCookie == 12346)
+		{
+			if((size_t)(pEnd - p) < 4)
+				return false;
+
+			nCount = Internal::RoaringRead32(p);
+
+			if(nCount > 65536)
+				return false;
+		}
+		else
+			return false;
+
+		const bool bHasOffsets = !pRunFlags || (nCount >= 4);
+
+		if((size_t)(pEnd - p) < ((bHasOffsets ? 8 : 4) * nCount))
+			return false;
+
+		const uint8_t* pHeader = p;
+		p += (bHasOffsets ? 8 : 4) * nCount; // We read the containers in order, so the offsets aren't needed.
+
+		mContainers.reserve(nCount);
+
+		size_t i = 0;
+
+		for(; i < nCount; ++i) // Any malformed container breaks out of the loop early.
+		{
+			const uint32_t key          = Internal::RoaringRead16(pHeader);
+			const uint32_t nCardinality = Internal::RoaringRead16(pHeader) + 1;
+
+			if(!mContainers.empty() && (mContainers.back().mKey >= key))
+				break;
+
+			mContainers.pushBack(container_type((uint16_t)key, mContainers.getAllocator()));
+			container_type& c = mContainers.back();
+
+			if(pRunFlags && ((pRunFlags[i / 8] >> (i % 8)) & 1))
+			{
+				if((pEnd - p) < 2)
+					break;
+
+				const size_t nRuns = Internal::RoaringRead16(p);
+
+				if((size_t)(pEnd - p) < (4 * nRuns))
+					break;
+
+				c.mType = container_type::kTypeRun;
+				c.mValues.resize(2 * nRuns);
+
+				for(size_t j = 0; j < (2 * nRuns); ++j)
+					c.mValues[j] = (uint16_t)Internal::RoaringRead16(p);
+
+				c.mnCardinality = 0;
+				for(size_t j = 0; j < nRuns; ++j)
+					c.mnCardinality += (uint32_t)c.mValues[2 * j + 1] + 1;
+			}
+			else if(nCardinality <= (uint32_t)container_type::kArrayMaxSize)
+			{
+				if((size_t)(pEnd - p) < (2 * nCardinality))
+					break;
+
+				c.mType = container_type::kTypeArray;
+				c.mValues.resize(nCardinality);
+
+				for(size_t j = 0; j < nCardinality; ++j)
+					c.mValues[j] = (uint16_t)Internal::RoaringRead16(p);
+
+				c.mnCardinality = nCardinality;
+			}
+			else
+			{
+				if((size_t)(pEnd - p) < (size_t)container_type::kBitmapBytes)
+					break;
+
+				c.mType = container_type::kTypeBitmap;
+				c.mWords.resize((size_t)container_type::kBitmapWordCount);
+
+				#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+					memcpy(c.mWords.data(), p, (size_t)container_type::kBitmapBytes);
+					p += container_type::kBitmapBytes;
+				#else
+					for(size_t j = 0; j < (size_t)container_type::kBitmapWordCount; ++j)
+					{
+						const uint64_t nLow = Internal::RoaringRead32(p);
+						c.mWords[j] = nLow | ((uint64_t)Internal::RoaringRead32(p) << 32);
+					}
+				#endif
+
+				c.countBits();
+			}
+
+			if((c.mnCardinality != nCardinality) || !c.validate())
+				break;
+		}
+
+		if(i != nCount)
+		{
+			clear();
+			return false;
+		}
+
+		return true;
+	}
+
+
+	template <typename Allocator>
+	inline const typename roaring_bitmap<Allocator>::allocator_type&
+	roaring_bitmap<Allocator>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mContainers.getAllocator();
+	}
+
+
+	template <typename Allocator>
+	inline typename roaring_bitmap<Allocator>::allocator_type&
+	roaring_bitmap<Allocator>::getAllocator() EASTL_NOEXCEPT
+	{
+		return mContainers.getAllocator();
+	}
+
+
+	template <typename Allocator>
+	inline void roaring_bitmap<Allocator>::setAllocator(const allocator_type& allocator)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(!mContainers.empty()))
+				EASTL_FAIL_MSG("roaring_bitmap::setAllocator -- the bitmap must be empty");
+		#endif
+
+		mContainers.setAllocator(allocator);
+	}
+
+
+	template <typename Allocator>
+	bool roaring_bitmap<Allocator>::validate() const
+	{
+		for(size_t i = 0; i < mContainers.size(); ++i)
+		{
+			if(((i > 0) && (mContainers[i - 1].mKey >= mContainers[i].mKey)) || !mContainers[i].validate())
+				return false;
+		}
+
+		return true;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator> operator&(const roaring_bitmap<Allocator>& a, const roaring_bitmap<Allocator>& b)
+	{
+		roaring_bitmap<Allocator> result(a);
+		result &= b;
+		return result;
+	}
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator> operator|(const roaring_bitmap<Allocator>& a, const roaring_bitmap<Allocator>& b)
+	{
+		roaring_bitmap<Allocator> result(a);
+		result |= b;
+		return result;
+	}
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator> operator^(const roaring_bitmap<Allocator>& a, const roaring_bitmap<Allocator>& b)
+	{
+		roaring_bitmap<Allocator> result(a);
+		result ^= b;
+		return result;
+	}
+
+	template <typename Allocator>
+	inline roaring_bitmap<Allocator> operator-(const roaring_bitmap<Allocator>& a, const roaring_bitmap<Allocator>& b)
+	{
+		roaring_bitmap<Allocator> result(a);
+		result -= b;
+		return result;
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
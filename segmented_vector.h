@@ -88,6 +88,11 @@ namespace eastl
 	public:
         typedef segmented_vector_iterator<T, Count, Allocator>	this_type;
 		typedef segment<T, Count, Allocator>					segment_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag				iterator_category;
+		typedef typename eastl::remove_const<T>::type			value_type;
+		typedef ptrdiff_t										difference_type;
+		typedef T*												pointer;
+		typedef T&												reference;
 
 		// does not conform to any Iterator concept. could be a bidirectional iterator, but not random access iterator because segment is a double-linked list.
 
@@ -104,6 +109,50 @@ namespace eastl
 	};
 
 
+	/// segmented_iterator_traits<segmented_vector_iterator>
+	///
+	/// Exposes each segment as a contiguous range. The end iterator of a
+	/// segmented_vector doesn't refer to a segment (mCurrent is null), in which
+	/// case the last segment of the container is the final one.
+	///
+	template <typename T, size_t Count, typename Allocator>
+	struct segmented_iterator_traits< segmented_vector_iterator<T, Count, Allocator> >
+	{
+		typedef segmented_vector_iterator<T, Count, Allocator>	iterator_type;
+		typedef true_type										is_segmented_iterator;
+		typedef typename iterator_type::segment_type*			segment_iterator;
+		typedef T*												local_iterator;
+
+		static segment_iterator segment(const iterator_type& it)								{ return it.mSegment; }
+		static local_iterator	local(const iterator_type& it)									{ return it.mCurrent; }
+		static local_iterator	segment_begin(segment_iterator s)								{ return s->begin(); }
+		static local_iterator	segment_end(segment_iterator s)									{ return s->end(); }
+		static local_iterator	segment_end(segment_iterator s, const iterator_type& last)		{ return (last.mCurrent && (s == last.mSegment)) ? last.mCurrent : s->end(); }
+		static bool				is_final_segment(segment_iterator s, const iterator_type& last)	{ return last.mCurrent ? (s == last.mSegment) : (s->next_segment() == nullptr); }
+		static segment_iterator	next_segment(segment_iterator s)								{ return s->next_segment(); }
+
+		static iterator_type compose(segment_iterator s, local_iterator l)
+		{
+			iterator_type it;
+			it.mSegment = s;
+			it.mCurrent = l;
+			it.mEnd = s->end();
+
+			if (l == it.mEnd)
+			{
+				if ((it.mSegment = s->next_segment()) != nullptr)
+				{
+					it.mCurrent = it.mSegment->begin();
+					it.mEnd = it.mSegment->end();
+				}
+				else
+					it.mCurrent = nullptr;
+			}
+			return it;
+		}
+	};
+
+
 	template <typename T, size_t Count, typename Allocator = EASTLAllocatorType>
 	class segmented_vector
 	{
@@ -7,7 +7,9 @@
 // std C++ sorting algorithms, while others don't have equivalents in the 
 // C++ standard. We implement the following sorting algorithms:
 //    isSorted             -- 
-//    sort                  -- Unstable.    The implementation of this is mapped to quickSort by default.
+//    sort                  -- Unstable.    The implementation of this is mapped to pdqSort by default.
+//    pdqSort              -- Unstable.    Pattern-defeating quicksort, O(n) for sorted input and O(n log n) worst case.
+//    small_sort           -- Unstable.    For small ranges; uses SIMD sorting networks for up to 64 integers or floats.
 //    quickSort            -- Unstable.    This is actually an intro-sort (quick sort with switch to insertion sort).
 //    tim_sort              -- Stable.
 //    tim_sort_buffer       -- Stable.
@@ -21,13 +23,17 @@
 //    mergeSortBuffer     -- Stable. 
 //    nthElement           -- Unstable.
 //    radixSort            -- Stable.      Important and useful sort for integral data, and faster than all others for this.
+//    msdRadixSort         -- Unstable.    In-place radix sort for strings and other byte keys.
 //    combSort             -- Unstable.    Possibly the best combination of small code size but fast sort.
 //    bubbleSort           -- Stable.      Useful in practice for sorting tiny sets of data (<= 10 elements).
 //    selectionSort*       -- Unstable.
 //    shakerSort*          -- Stable.
 //    bucketSort*          -- Stable. 
+//    parallel_sort**       -- Unstable.    Multithreaded sample sort.
+//    parallel_stable_sort** -- Stable.     Multithreaded merge sort.
 //
 // * Found in sort_extra.h.
+// ** Found in parallel_sort.h.
 //
 // Additional sorting and related algorithms we may want to implement:
 //    partialSort_copy     This would be like the std STL version.
@@ -44,11 +50,13 @@
 
 #include <eastl/internal/config.h>
 #include <eastl/internal/move_help.h>
+#include <eastl/bit.h>
 #include <eastl/iterator.h>
 #include <eastl/memory.h>
 #include <eastl/algorithm.h>
 #include <eastl/functional.h>
 #include <eastl/heap.h>
+#include <eastl/internal/sort_network.h>
 #include <eastl/allocator.h>
 #include <eastl/memory.h>
 
@@ -870,91 +878,735 @@ namespace eastl
 	} // namespace Internal
 
 
-	template <typename RandomAccessIterator>
-	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+	namespace Internal
 	{
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+		// Selects the (middle - first) smallest elements into a heap and sorts it. This is O(n log k) for
+		// k = (middle - first) in the worst case, and the fastest way to partially sort for small k.
+		template <typename RandomAccessIterator, typename Compare>
+		inline void partialSort_heap(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare compare)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
 
-		eastl::makeHeap<RandomAccessIterator>(first, middle);
+			eastl::makeHeap<RandomAccessIterator, Compare>(first, middle, compare);
 
-		for(RandomAccessIterator i = middle; i < last; ++i)
-		{
-			if(*i < *first)
+			for(RandomAccessIterator i = middle; i < last; ++i)
 			{
-				EASTL_VALIDATE_COMPARE(!(*first < *i)); // Validate that the compare function is sane.
-				value_type temp(eastl::forward<value_type>(*i));
-				*i = eastl::forward<value_type>(*first);
-				eastl::adjustHeap<RandomAccessIterator, difference_type, value_type>
-								  (first, difference_type(0), difference_type(middle - first), difference_type(0), eastl::forward<value_type>(temp));
+				if(compare(*i, *first))
+				{
+					EASTL_VALIDATE_COMPARE(!compare(*first, *i)); // Validate that the compare function is sane.
+					value_type temp(eastl::forward<value_type>(*i));
+					*i = eastl::forward<value_type>(*first);
+					eastl::adjustHeap<RandomAccessIterator, difference_type, value_type, Compare>
+									  (first, difference_type(0), difference_type(middle - first), difference_type(0), eastl::forward<value_type>(temp), compare);
+				}
 			}
+
+			eastl::sortHeap<RandomAccessIterator, Compare>(first, middle, compare);
 		}
+	} // namespace Internal
 
-		eastl::sortHeap<RandomAccessIterator>(first, middle);
-	}
 
+	/////////////////////////////////////////////////////////////////////
+	// pdqSort
+	//
+	// Pattern-defeating quicksort, by Orson Peters (https://github.com/orlp/pdqsort).
+	// It is an introsort which also:
+	//    - picks the pivot as the median of 3, or the pseudomedian of 9 for
+	//      larger partitions;
+	//    - recognizes partitions which already were partitioned and finishes
+	//      them with an insertion sort that gives up after a few moves, which
+	//      makes sorted, reverse-sorted and nearly sorted input O(n);
+	//    - puts elements equal to the previous pivot into a partition which
+	//      needs no more sorting, which makes input with few distinct values
+	//      O(n k) for k distinct values;
+	//    - shuffles a few elements after an unbalanced partition to break up
+	//      patterns, and switches to heapSort after log2(n) of them, so the
+	//      worst case is O(n log n);
+	//    - uses the branchless block partitioning of BlockQuicksort (Edelkamp
+	//      and Weiss) if comparisons are cheap, which avoids the branch
+	//      mispredictions of a classic partition on random data. This is the
+	//      case for arithmetic types with less or greater.
+	/////////////////////////////////////////////////////////////////////
 
-	template <typename RandomAccessIterator, typename Compare>
-	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare compare)
+	namespace Internal
 	{
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+		// Portions of the pdqSort code were originally written by Orson Peters.
+		// https://github.com/orlp/pdqsort (zlib license, see 3RDPARTYLICENSES.TXT)
+
+		static const int kPdqSortInsertionSortLimit   = 24;  // Partitions below this size are sorted using insertion sort.
+		static const int kPdqSortNintherLimit         = 128; // Partitions above this size use Tukey's ninther to select the pivot.
+		static const int kPdqSortPartialInsertionMoves = 8;  // Moves after which an insertion sort of an already partitioned partition gives up.
+		static const int kPdqSortBlockSize            = 64;  // Must be a multiple of 8 and < 256 to fit in unsigned char.
+		static const int kPdqSortCachelineSize        = 64;
+		static const int kPdqSortNetworkLimit         = 64;  // Partitions up to this size are sorted by a sorting network, where sort_network_applicable.
+
+		// Whether the comparison is cheap and free of side effects, so that pdqSort may partition without branches.
+		template <typename T, typename Compare>
+		struct pdqSort_is_branchless : public eastl::false_type { };
 
-		eastl::makeHeap<RandomAccessIterator, Compare>(first, middle, compare);
+		template <typename T>
+		struct pdqSort_is_branchless<T, eastl::less<T> > : public eastl::is_arithmetic<T> { };
 
-		for(RandomAccessIterator i = middle; i < last; ++i)
+		template <typename T>
+		struct pdqSort_is_branchless<T, eastl::greater<T> > : public eastl::is_arithmetic<T> { };
+
+		template <typename T>
+		struct pdqSort_is_branchless<T, eastl::less<void> > : public eastl::is_arithmetic<T> { };
+
+		template <typename T>
+		struct pdqSort_is_branchless<T, eastl::greater<void> > : public eastl::is_arithmetic<T> { };
+
+
+		// Sorts [first, last) using insertion sort. If Guarded is false, it assumes that *(first - 1) is not greater
+		// than any element in [first, last).
+		template <bool Guarded, typename RandomAccessIterator, typename Compare>
+		inline void pdqSort_insertionSort(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
 		{
-			if(compare(*i, *first))
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			if(first == last)
+				return;
+
+			for(RandomAccessIterator current = first + 1; current != last; ++current)
 			{
-				EASTL_VALIDATE_COMPARE(!compare(*first, *i)); // Validate that the compare function is sane.
-				value_type temp(eastl::forward<value_type>(*i));
-				*i = eastl::forward<value_type>(*first);
-				eastl::adjustHeap<RandomAccessIterator, difference_type, value_type, Compare>
-								  (first, difference_type(0), difference_type(middle - first), difference_type(0), eastl::forward<value_type>(temp), compare);
+				RandomAccessIterator sift(current), siftPrev(current - 1);
+
+				// Compare first so we can avoid 2 moves for an element already positioned correctly.
+				if(compare(*sift, *siftPrev))
+				{
+					value_type temp(eastl::move(*sift));
+
+					do { *sift-- = eastl::move(*siftPrev); }
+					while((!Guarded || (sift != first)) && compare(temp, *--siftPrev));
+
+					*sift = eastl::move(temp);
+				}
 			}
 		}
 
-		eastl::sortHeap<RandomAccessIterator, Compare>(first, middle, compare);
-	}
 
+		// Attempts to use insertion sort on [first, last). Returns false and leaves the range unsorted if more than
+		// kPdqSortPartialInsertionMoves elements were moved.
+		template <typename RandomAccessIterator, typename Compare>
+		inline bool pdqSort_partialInsertionSort(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
 
-	template<typename RandomAccessIterator>
-	inline void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
-	{
-		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+			if(first == last)
+				return true;
+
+			size_t nMoves = 0;
+
+			for(RandomAccessIterator current = first + 1; current != last; ++current)
+			{
+				RandomAccessIterator sift(current), siftPrev(current - 1);
+
+				if(compare(*sift, *siftPrev))
+				{
+					value_type temp(eastl::move(*sift));
+
+					do { *sift-- = eastl::move(*siftPrev); }
+					while((sift != first) && compare(temp, *--siftPrev));
+
+					*sift = eastl::move(temp);
+					nMoves += (size_t)(current - sift);
+				}
+
+				if(nMoves > (size_t)kPdqSortPartialInsertionMoves)
+					return false;
+			}
+
+			return true;
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare>
+		inline void pdqSort_sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare& compare)
+		{
+			if(compare(*b, *a)) eastl::iterSwap(a, b);
+			if(compare(*c, *b)) eastl::iterSwap(b, c);
+			if(compare(*b, *a)) eastl::iterSwap(a, b);
+		}
+
+
+		// Moves the median of 3, or for large ranges the pseudomedian of 9, to *first.
+		template <typename RandomAccessIterator, typename Compare>
+		inline void pdqSort_choosePivot(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const difference_type nSize = last - first;
+			const difference_type nHalf = nSize / 2;
+
+			if(nSize > kPdqSortNintherLimit)
+			{
+				Internal::pdqSort_sort3(first, first + nHalf, last - 1, compare);
+				Internal::pdqSort_sort3(first + 1, first + (nHalf - 1), last - 2, compare);
+				Internal::pdqSort_sort3(first + 2, first + (nHalf + 1), last - 3, compare);
+				Internal::pdqSort_sort3(first + (nHalf - 1), first + nHalf, first + (nHalf + 1), compare);
+				eastl::iterSwap(first, first + nHalf);
+			}
+			else
+				Internal::pdqSort_sort3(first + nHalf, first, last - 1, compare);
+		}
+
+
+		template <typename RandomAccessIterator>
+		inline void pdqSort_swapOffsets(RandomAccessIterator first, RandomAccessIterator last, const unsigned char* pOffsetsLeft,
+		                                const unsigned char* pOffsetsRight, size_t nCount, bool bUseSwaps)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			if(bUseSwaps)
+			{
+				// This case is needed for the descending distribution, where we need
+				// to have proper swapping for pdqSort to remain O(n).
+				for(size_t i = 0; i < nCount; ++i)
+					eastl::iterSwap(first + pOffsetsLeft[i], last - pOffsetsRight[i]);
+			}
+			else if(nCount > 0)
+			{
+				RandomAccessIterator left(first + pOffsetsLeft[0]), right(last - pOffsetsRight[0]);
+				value_type temp(eastl::move(*left));
+
+				*left = eastl::move(*right);
+
+				for(size_t i = 1; i < nCount; ++i)
+				{
+					left   = first + pOffsetsLeft[i];
+					*right = eastl::move(*left);
+					right  = last - pOffsetsRight[i];
+					*left  = eastl::move(*right);
+				}
+
+				*right = eastl::move(temp);
+			}
+		}
+
+
+		// Partitions [begin, end) around the pivot *begin. Elements equal to the pivot go to the right partition.
+		// Returns the position of the pivot and whether the range already was partitioned. Assumes the pivot is a
+		// median of at least 3 elements and the range is at least kPdqSortInsertionSortLimit long.
+		template <typename RandomAccessIterator, typename Compare>
+		inline eastl::pair<RandomAccessIterator, bool> pdqSort_partitionRight(RandomAccessIterator begin, RandomAccessIterator end, Compare& compare, eastl::false_type)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type pivot(eastl::move(*begin));
+			RandomAccessIterator first(begin), last(end);
+
+			// Find the first element greater than or equal to the pivot (the median of 3 guarantees this exists).
+			while(compare(*++first, pivot))
+				{ }
+
+			// Find the first element strictly smaller than the pivot. We have to guard this search if there was
+			// no element before *first.
+			if((first - 1) == begin)
+				while((first < last) && !compare(*--last, pivot)) { }
+			else
+				while(!compare(*--last, pivot)) { }
+
+			// If the first pair of elements that should be swapped to partition are the same element,
+			// the range already was partitioned.
+			const bool bAlreadyPartitioned = (first >= last);
+
+			// Keep swapping pairs of elements that are on the wrong side of the pivot. Previously swapped
+			// pairs guard the searches, which is why the first iteration is special-cased above.
+			while(first < last)
+			{
+				eastl::iterSwap(first, last);
+				while(compare(*++first, pivot)) { }
+				while(!compare(*--last, pivot)) { }
+			}
+
+			const RandomAccessIterator pivotPosition(first - 1);
+			*begin = eastl::move(*pivotPosition);
+			*pivotPosition = eastl::move(pivot);
+
+			return eastl::pair<RandomAccessIterator, bool>(pivotPosition, bAlreadyPartitioned);
+		}
+
+
+		// As above, but without branches on the outcome of comparisons: blocks of elements are compared against the
+		// pivot and the offsets of those on the wrong side are recorded, after which they are swapped in bulk.
+		template <typename RandomAccessIterator, typename Compare>
+		inline eastl::pair<RandomAccessIterator, bool> pdqSort_partitionRight(RandomAccessIterator begin, RandomAccessIterator end, Compare& compare, eastl::true_type)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type pivot(eastl::move(*begin));
+			RandomAccessIterator first(begin), last(end);
+
+			while(compare(*++first, pivot))
+				{ }
+
+			if((first - 1) == begin)
+				while((first < last) && !compare(*--last, pivot)) { }
+			else
+				while(!compare(*--last, pivot)) { }
+
+			const bool bAlreadyPartitioned = (first >= last);
+
+			if(!bAlreadyPartitioned)
+			{
+				eastl::iterSwap(first, last);
+				++first;
+
+				alignas(kPdqSortCachelineSize) unsigned char offsetsLeft[kPdqSortBlockSize];
+				alignas(kPdqSortCachelineSize) unsigned char offsetsRight[kPdqSortBlockSize];
+
+				RandomAccessIterator offsetsLeftBase(first), offsetsRightBase(last);
+				size_t nLeft = 0, nRight = 0, nStartLeft = 0, nStartRight = 0;
+
+				while(first < last)
+				{
+					// Fill up offset blocks with elements that are on the wrong side. First we determine how
+					// many elements are considered for each offset block.
+					const size_t nUnknown    = (size_t)(last - first);
+					const size_t nLeftSplit  = (nLeft == 0) ? ((nRight == 0) ? (nUnknown / 2) : nUnknown) : 0;
+					const size_t nRightSplit = (nRight == 0) ? (nUnknown - nLeftSplit) : 0;
+
+					if(nLeftSplit >= (size_t)kPdqSortBlockSize)
+					{
+						for(size_t i = 0; i < (size_t)kPdqSortBlockSize; )
+						{
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+						}
+					}
+					else
+					{
+						for(size_t i = 0; i < nLeftSplit; )
+						{
+							offsetsLeft[nLeft] = (unsigned char)i++; nLeft += !compare(*first, pivot); ++first;
+						}
+					}
+
+					if(nRightSplit >= (size_t)kPdqSortBlockSize)
+					{
+						for(size_t i = 0; i < (size_t)kPdqSortBlockSize; )
+						{
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+						}
+					}
+					else
+					{
+						for(size_t i = 0; i < nRightSplit; )
+						{
+							offsetsRight[nRight] = (unsigned char)++i; nRight += compare(*--last, pivot);
+						}
+					}
+
+					// Swap elements and update block sizes and first/last boundaries.
+					const size_t nSwap = eastl::minAlt(nLeft, nRight);
+
+					Internal::pdqSort_swapOffsets(offsetsLeftBase, offsetsRightBase, offsetsLeft + nStartLeft, offsetsRight + nStartRight, nSwap, nLeft == nRight);
+					nLeft  -= nSwap; nRight      -= nSwap;
+					nStartLeft += nSwap; nStartRight += nSwap;
+
+					if(nLeft == 0)
+					{
+						nStartLeft = 0;
+						offsetsLeftBase = first;
+					}
+
+					if(nRight == 0)
+					{
+						nStartRight = 0;
+						offsetsRightBase = last;
+					}
+				}
+
+				// We have now fully identified [first, last)'s proper position. Swap the last elements.
+				if(nLeft)
+				{
+					const unsigned char* const pOffsets = offsetsLeft + nStartLeft;
+
+					while(nLeft--)
+						eastl::iterSwap(offsetsLeftBase + pOffsets[nLeft], --last);
+					first = last;
+				}
 
-		while((last - first) > 5)
+				if(nRight)
+				{
+					const unsigned char* const pOffsets = offsetsRight + nStartRight;
+
+					while(nRight--)
+						eastl::iterSwap(offsetsRightBase - pOffsets[nRight], first++);
+					last = first;
+				}
+			}
+
+			const RandomAccessIterator pivotPosition(first - 1);
+			*begin = eastl::move(*pivotPosition);
+			*pivotPosition = eastl::move(pivot);
+
+			return eastl::pair<RandomAccessIterator, bool>(pivotPosition, bAlreadyPartitioned);
+		}
+
+
+		// Partitions [begin, end) around the pivot *begin, with elements equal to the pivot going to the left. Returns
+		// the position of the pivot. This is used only when there are many equal elements, in which case pdqSort is
+		// O(n) anyway, so it has no branchless variant.
+		template <typename RandomAccessIterator, typename Compare>
+		inline RandomAccessIterator pdqSort_partitionLeft(RandomAccessIterator begin, RandomAccessIterator end, Compare& compare)
 		{
-			const value_type           midValue(eastl::median<value_type>(*first, *(first + (last - first) / 2), *(last - 1)));
-			const RandomAccessIterator midPos(eastl::getPartition<RandomAccessIterator, value_type>(first, last, midValue));
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type pivot(eastl::move(*begin));
+			RandomAccessIterator first(begin), last(end);
+
+			while(compare(pivot, *--last))
+				{ }
+
+			if((last + 1) == end)
+				while((first < last) && !compare(pivot, *++first)) { }
+			else
+				while(!compare(pivot, *++first)) { }
+
+			while(first < last)
+			{
+				eastl::iterSwap(first, last);
+				while(compare(pivot, *--last)) { }
+				while(!compare(pivot, *++first)) { }
+			}
+
+			*begin = eastl::move(*last);
+			*last = eastl::move(pivot);
+
+			return last;
+		}
+
+
+		// Swaps a few elements of each side of an unbalanced partition into other positions, which breaks up
+		// the patterns that caused it.
+		template <typename RandomAccessIterator>
+		inline void pdqSort_shuffle(RandomAccessIterator begin, RandomAccessIterator pivotPosition, RandomAccessIterator end)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const difference_type nLeftSize  = pivotPosition - begin;
+			const difference_type nRightSize = end - (pivotPosition + 1);
+
+			if(nLeftSize >= kPdqSortInsertionSortLimit)
+			{
+				eastl::iterSwap(begin,             begin + nLeftSize / 4);
+				eastl::iterSwap(pivotPosition - 1, pivotPosition - nLeftSize / 4);
+
+				if(nLeftSize > kPdqSortNintherLimit)
+				{
+					eastl::iterSwap(begin + 1,         begin + (nLeftSize / 4 + 1));
+					eastl::iterSwap(begin + 2,         begin + (nLeftSize / 4 + 2));
+					eastl::iterSwap(pivotPosition - 2, pivotPosition - (nLeftSize / 4 + 1));
+					eastl::iterSwap(pivotPosition - 3, pivotPosition - (nLeftSize / 4 + 2));
+				}
+			}
+
+			if(nRightSize >= kPdqSortInsertionSortLimit)
+			{
+				eastl::iterSwap(pivotPosition + 1, pivotPosition + (1 + nRightSize / 4));
+				eastl::iterSwap(end - 1,           end - nRightSize / 4);
 
-			if(midPos <= nth)
-				first = midPos;
+				if(nRightSize > kPdqSortNintherLimit)
+				{
+					eastl::iterSwap(pivotPosition + 2, pivotPosition + (2 + nRightSize / 4));
+					eastl::iterSwap(pivotPosition + 3, pivotPosition + (3 + nRightSize / 4));
+					eastl::iterSwap(end - 2,           end - (1 + nRightSize / 4));
+					eastl::iterSwap(end - 3,           end - (2 + nRightSize / 4));
+				}
+			}
+		}
+
+
+		// Whether [first, last) can be sorted by compare with a sorting network (see internal/sort_network.h).
+		template <typename RandomAccessIterator, typename Compare>
+		struct sort_network_applicable
+			: public eastl::integral_constant<bool, eastl::is_pointer<RandomAccessIterator>::value &&
+			                                        sort_network_traits<typename eastl::iterator_traits<RandomAccessIterator>::value_type>::value &&
+			                                        (sort_network_order<Compare, typename eastl::iterator_traits<RandomAccessIterator>::value_type>::value != 0)> { };
+
+		template <typename RandomAccessIterator, typename Compare>
+		inline void pdqSort_leaf(RandomAccessIterator begin, RandomAccessIterator end, Compare& compare, bool bLeftmost, eastl::false_type)
+		{
+			if(bLeftmost)
+				Internal::pdqSort_insertionSort<true>(begin, end, compare);
 			else
-				last = midPos;
+				Internal::pdqSort_insertionSort<false>(begin, end, compare);
 		}
 
-		eastl::insertionSort<RandomAccessIterator>(first, last);
+		#if EASTL_SORT_NETWORK_ENABLED
+			template <typename RandomAccessIterator, typename Compare>
+			inline void pdqSort_leaf(RandomAccessIterator begin, RandomAccessIterator end, Compare&, bool, eastl::true_type)
+			{
+				typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+				if(begin != end)
+				{
+					Internal::sort_network(begin, (size_t)(end - begin));
+
+					if(sort_network_order<Compare, value_type>::value < 0)
+						eastl::reverse(begin, end);
+				}
+			}
+		#endif
+
+
+		template <typename RandomAccessIterator, typename Compare, typename Branchless>
+		void pdqSort_loop(RandomAccessIterator begin, RandomAccessIterator end, Compare& compare, int nBadAllowed, bool bLeftmost)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+			typedef sort_network_applicable<RandomAccessIterator, Compare>                   network;
+
+			const difference_type nLeafLimit = network::value ? (kPdqSortNetworkLimit + 1) : kPdqSortInsertionSortLimit;
+
+			// Use a while loop for tail recursion elimination.
+			for(;;)
+			{
+				const difference_type nSize = end - begin;
+
+				if(nSize < nLeafLimit)
+				{
+					Internal::pdqSort_leaf(begin, end, compare, bLeftmost, typename network::type());
+					return;
+				}
+
+				Internal::pdqSort_choosePivot(begin, end, compare);
+
+				// If *(begin - 1) is the end of the right partition of a previous partition operation there is no
+				// element in [begin, end) that is smaller than *(begin - 1). Then if our pivot compares equal to
+				// *(begin - 1) we change strategy, putting equal elements in the left partition, greater elements
+				// in the right partition. We do not have to recurse on the left partition, since it's sorted (all equal).
+				if(!bLeftmost && !compare(*(begin - 1), *begin))
+				{
+					begin = Internal::pdqSort_partitionLeft(begin, end, compare) + 1;
+					continue;
+				}
+
+				const eastl::pair<RandomAccessIterator, bool> result = Internal::pdqSort_partitionRight(begin, end, compare, Branchless());
+				const RandomAccessIterator pivotPosition(result.first);
+
+				const difference_type nLeftSize  = pivotPosition - begin;
+				const difference_type nRightSize = end - (pivotPosition + 1);
+
+				if((nLeftSize < (nSize / 8)) || (nRightSize < (nSize / 8)))
+				{
+					// If we had too many bad partitions, switch to heapSort to guarantee O(n log n).
+					if(--nBadAllowed == 0)
+					{
+						eastl::heapSort(begin, end, compare);
+						return;
+					}
+
+					Internal::pdqSort_shuffle(begin, pivotPosition, end);
+				}
+				else if(result.second && Internal::pdqSort_partialInsertionSort(begin, pivotPosition, compare)
+				                      && Internal::pdqSort_partialInsertionSort(pivotPosition + 1, end, compare))
+				{
+					// We were decently balanced and the range already was partitioned, so likely it was sorted.
+					return;
+				}
+
+				// Sort the left partition first using recursion and do tail recursion elimination for the right-hand partition.
+				Internal::pdqSort_loop<RandomAccessIterator, Compare, Branchless>(begin, pivotPosition, compare, nBadAllowed, bLeftmost);
+				begin = pivotPosition + 1;
+				bLeftmost = false;
+			}
+		}
+
+
+		// The selection counterpart of pdqSort_loop: it only continues into the partition which holds nth, and falls
+		// back to a heap selection (O(n log k)) after too many bad partitions.
+		template <typename RandomAccessIterator, typename Compare, typename Branchless>
+		void pdqSort_selectLoop(RandomAccessIterator begin, RandomAccessIterator nth, RandomAccessIterator end, Compare& compare)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const RandomAccessIterator leftmost(begin);
+			int nBadAllowed = Internal::Log2(end - begin);
+
+			for(;;)
+			{
+				const difference_type nSize = end - begin;
+
+				if(nSize < kPdqSortInsertionSortLimit)
+				{
+					Internal::pdqSort_insertionSort<true>(begin, end, compare);
+					return;
+				}
+
+				Internal::pdqSort_choosePivot(begin, end, compare);
+
+				if((begin != leftmost) && !compare(*(begin - 1), *begin))
+				{
+					// [begin, pivot] are all equal, and so in their final place.
+					const RandomAccessIterator pivotPosition(Internal::pdqSort_partitionLeft(begin, end, compare));
+
+					if(nth <= pivotPosition)
+						return;
+					begin = pivotPosition + 1;
+					continue;
+				}
+
+				const RandomAccessIterator pivotPosition(Internal::pdqSort_partitionRight(begin, end, compare, Branchless()).first);
+
+				if(pivotPosition == nth)
+					return;
+
+				const difference_type nLeftSize  = pivotPosition - begin;
+				const difference_type nRightSize = end - (pivotPosition + 1);
+
+				if((nLeftSize < (nSize / 8)) || (nRightSize < (nSize / 8)))
+				{
+					if(--nBadAllowed == 0)
+					{
+						Internal::partialSort_heap(begin, nth + 1, end, compare);
+						return;
+					}
+
+					Internal::pdqSort_shuffle(begin, pivotPosition, end);
+				}
+
+				if(nth < pivotPosition)
+					end = pivotPosition;
+				else
+					begin = pivotPosition + 1;
+			}
+		}
+
+	} // namespace Internal
+
+
+	/// pdqSort
+	///
+	/// This is an unstable sort, and the default implementation of sort.
+	/// See the pdqSort comment above for details. pdqSort is O(n log n) in the worst
+	/// case, O(n) for sorted, reverse sorted and nearly sorted input, and typically
+	/// about twice as fast as quickSort for arithmetic types with random values.
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	void pdqSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		typedef Internal::pdqSort_is_branchless<value_type, Compare>              branchless;
+
+		if(first != last)
+			eastl::Internal::pdqSort_loop<RandomAccessIterator, Compare, typename branchless::type>(first, last, compare, Internal::Log2(last - first), true);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void pdqSort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::pdqSort<RandomAccessIterator, Less>(first, last, Less());
 	}
 
 
+	/// small_sort
+	///
+	/// Sorts [first, last) like sort, but is meant for small ranges which are sorted very often,
+	/// such as the top-K candidates of a search. Ranges of up to EASTL_SORT_NETWORK_MAX (64)
+	/// elements of 32 or 64 bit integers, float or double, given as pointers and sorted with
+	/// less or greater, are sorted by a SIMD sorting network if EASTL_SORT_NETWORK_ENABLED (see
+	/// internal/sort_network.h). Everything else is sorted by pdqSort.
+	///
+	/// Example usage:
+	///     float candidates[32];
+	///     small_sort(candidates, candidates + nCandidateCount, greater<float>());
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	inline void small_sort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef Internal::sort_network_applicable<RandomAccessIterator, Compare> network;
+
+		if(network::value && ((last - first) <= EASTL_SORT_NETWORK_MAX))
+			eastl::Internal::pdqSort_leaf(first, last, compare, true, typename network::type());
+		else
+			eastl::pdqSort<RandomAccessIterator, Compare>(first, last, compare);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void small_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::small_sort<RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+	/// nthElement
+	///
+	/// Rearranges [first, last) such that *nth is the element which would be there if the
+	/// range were sorted, no element in [first, nth) is greater than it and no element in
+	/// (nth, last) is less than it.
+	///
+	/// This is an introselect built from the partitioning of pdqSort: it is O(n) on average
+	/// and for input with patterns or many equal elements, and falls back to a heap selection
+	/// for O(n log n) in the worst case.
+	///
 	template<typename RandomAccessIterator, typename Compare>
 	inline void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare compare)
 	{
-		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+		typedef Internal::pdqSort_is_branchless<value_type, Compare>              branchless;
 
-		while((last - first) > 5)
-		{
-			const value_type           midValue(eastl::median<value_type, Compare>(*first, *(first + (last - first) / 2), *(last - 1), compare));
-			const RandomAccessIterator midPos(eastl::getPartition<RandomAccessIterator, value_type, Compare>(first, last, midValue, compare));
+		if(nth != last)
+			eastl::Internal::pdqSort_selectLoop<RandomAccessIterator, Compare, typename branchless::type>(first, nth, last, compare);
+	}
 
-			if(midPos <= nth)
-				first = midPos;
-			else
-				last = midPos;
+	template<typename RandomAccessIterator>
+	inline void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::nthElement<RandomAccessIterator, Less>(first, nth, last, Less());
+	}
+
+
+	/// partialSort
+	///
+	/// Sorts the (middle - first) smallest elements of [first, last) into [first, middle),
+	/// leaving the remaining elements in [middle, last) in unspecified order.
+	///
+	/// Selecting with a heap costs about n + 2 k log2(k) ln(n / k) comparisons for k = (middle - first)
+	/// on random input, selecting with nthElement and sorting with pdqSort about 3 n + k log2(k).
+	/// We use the heap for small k only.
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare compare)
+	{
+		if(first == middle)
+			return;
+
+		if((middle - first) <= ((last - first) / 64))
+			eastl::Internal::partialSort_heap<RandomAccessIterator, Compare>(first, middle, last, compare);
+		else
+		{
+			eastl::nthElement<RandomAccessIterator, Compare>(first, middle - 1, last, compare);
+			eastl::pdqSort<RandomAccessIterator, Compare>(first, middle - 1, compare);
 		}
+	}
+
+	template <typename RandomAccessIterator>
+	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
 
-		eastl::insertionSort<RandomAccessIterator, Compare>(first, last, compare);
+		eastl::partialSort<RandomAccessIterator, Less>(first, middle, last, Less());
 	}
 
 
@@ -976,7 +1628,7 @@ namespace eastl
 			}
 
 			if(kRecursionCount == 0)
-				eastl::partialSort<RandomAccessIterator>(first, last, last);
+				eastl::heapSort<RandomAccessIterator>(first, last);
 		}
 
 		template <typename RandomAccessIterator, typename Size, typename Compare, typename PivotValueType>
@@ -994,7 +1646,7 @@ namespace eastl
 			}
 
 			if(kRecursionCount == 0)
-				eastl::partialSort<RandomAccessIterator, Compare>(first, last, last, compare);
+				eastl::heapSort<RandomAccessIterator, Compare>(first, last, compare);
 		}
 		EA_RESTORE_VC_WARNING()
 
@@ -1615,17 +2267,125 @@ namespace eastl
 
 
 
+	/// radix_key
+	///
+	/// Maps an arithmetic key to an unsigned radix_type whose unsigned order is the
+	/// order of the key, so that radixSort can sort keys other than unsigned integers:
+	///     - unsigned integers are used as they are;
+	///     - signed integers get their sign bit flipped;
+	///     - float and double get their sign bit flipped if they are positive, and all
+	///       their bits flipped if they are negative. This orders -0.0 before +0.0, and
+	///       NaNs after +infinity (or before -infinity, if their sign bit is set);
+	///     - a pair of arithmetic keys which fit in 64 bits in total is mapped to the
+	///       key of first followed by the key of second.
+	///
+	/// radix_key<T> is the default ExtractKey of radixSort when sorting arithmetic
+	/// values or such pairs.
+	///
+	/// Example usage:
+	///     float data[1000], buffer[1000];
+	///     radixSort(data, data + 1000, buffer);
+	///
+	template <typename T, typename Enable = void>
+	struct radix_key; // Not defined for types which have no radix key.
+
+	template <typename T>
+	struct radix_key<T, typename eastl::enable_if<eastl::is_integral<T>::value && eastl::is_unsigned<T>::value>::type>
+	{
+		typedef T radix_type;
+
+		radix_type operator()(T x) const
+			{ return x; }
+	};
+
+	template <typename T>
+	struct radix_key<T, typename eastl::enable_if<eastl::is_integral<T>::value && eastl::is_signed<T>::value>::type>
+	{
+		typedef typename eastl::make_unsigned<T>::type radix_type;
+
+		radix_type operator()(T x) const
+			{ return (radix_type)((radix_type)x ^ ((radix_type)1 << ((sizeof(T) * 8) - 1))); }
+	};
+
+	template <>
+	struct radix_key<float>
+	{
+		typedef uint32_t radix_type;
+
+		radix_type operator()(float x) const
+		{
+			const uint32_t u = eastl::bit_cast<uint32_t>(x);
+			return u ^ ((uint32_t)((int32_t)u >> 31) | UINT32_C(0x80000000));
+		}
+	};
+
+	template <>
+	struct radix_key<double>
+	{
+		typedef uint64_t radix_type;
+
+		radix_type operator()(double x) const
+		{
+			const uint64_t u = eastl::bit_cast<uint64_t>(x);
+			return u ^ ((uint64_t)((int64_t)u >> 63) | UINT64_C(0x8000000000000000));
+		}
+	};
+
+	template <typename T1, typename T2>
+	struct radix_key<eastl::pair<T1, T2>, typename eastl::enable_if<(sizeof(typename radix_key<T1>::radix_type) + sizeof(typename radix_key<T2>::radix_type)) <= sizeof(uint64_t)>::type>
+	{
+		typedef typename radix_key<T1>::radix_type first_radix_type;
+		typedef typename radix_key<T2>::radix_type second_radix_type;
+		typedef typename eastl::conditional<(sizeof(first_radix_type) + sizeof(second_radix_type)) <= sizeof(uint32_t), uint32_t, uint64_t>::type radix_type;
+
+		radix_type operator()(const eastl::pair<T1, T2>& x) const
+		{
+			return ((radix_type)radix_key<T1>()(x.first) << (sizeof(second_radix_type) * 8)) | (radix_type)radix_key<T2>()(x.second);
+		}
+	};
+
+
+	/// radix_key_adapter
+	///
+	/// Adapts an ExtractKey for radixSort whose radix_type is signed or floating-point
+	/// (or any other type radix_key supports) by passing the keys it returns through
+	/// radix_key. Before, such an ExtractKey sorted negative keys after positive ones.
+	///
+	/// Example usage:
+	///     struct Particle {
+	///         typedef float radix_type;
+	///         float mKey;         // The depth.
+	///         ...
+	///     };
+	///
+	///     radixSort<Particle*, radix_key_adapter<Internal::extractRadixKey<Particle> > >(particles, particles + n, buffer);
+	///
+	template <typename ExtractKey>
+	struct radix_key_adapter
+	{
+		typedef typename ExtractKey::radix_type                   key_type;
+		typedef typename radix_key<key_type>::radix_type          radix_type;
+
+		template <typename T>
+		radix_type operator()(const T& x) const
+			{ return radix_key<key_type>()(ExtractKey()(x)); }
+	};
+
+
+
 	/// radixSort
 	///
 	/// Implements a classic LSD (least significant digit) radix sort.
 	/// See http://en.wikipedia.org/wiki/Radix_sort.
-	/// This sort requires that the sorted data be of a type that has a member
-	/// radix_type typedef and an mKey member of that type. The type must be
-	/// an integral type. This limits what can be sorted, but radixSort is 
+	/// This sort requires an ExtractKey which returns an unsigned integral radix_type
+	/// key for each element. By default it is radix_key<value_type>, which supports
+	/// integers, float, double and small pairs of them. Alternatively, the sorted data 
+	/// can be of a type that has a member radix_type typedef and an mKey member of that
+	/// type, read by extractRadixKey. This limits what can be sorted, but radixSort is 
 	/// very fast -- typically faster than any other sort.
 	/// For example:
 	///     struct Sortable {
-	///         typedef int radix_type;
+	///         typedef unsigned radix_type;
 	///         radix_type mKey;
 	///         // User data goes here, or the user can inherit from Sortable.
 	///     };
@@ -1635,6 +2395,7 @@ namespace eastl
 	///         typedef Integer radix_type;
 	///         Integer mKey;
 	///     };
+	/// If radix_type is signed or floating-point, wrap the ExtractKey in radix_key_adapter.
 	/// 
 	/// Example usage:
 	///     struct Element {
@@ -1648,6 +2409,9 @@ namespace eastl
 	///
 	///     radixSort<Element*, extractRadixKey<Element> >(elementArray, elementArray + 100, buffer);
 	///
+	///     int64_t keys[100], keyBuffer[100];
+	///     radixSort(keys, keys + 100, keyBuffer);
+	///
 	/// To consider: A static linked-list implementation may be faster than the version here.
 
 	namespace Internal
@@ -1667,18 +2431,89 @@ namespace eastl
 		};
 
 		// The radixSort implementation uses two optimizations that are not part of a typical radix sort implementation.
-		// 1. Computing a histogram (i.e. finding the number of elements per bucket) for the next pass is done in parallel with the loop that "scatters"
-		//    elements in the current pass.  The advantage is that it avoids the memory traffic / cache pressure of reading keys in a separate operation.
-		//    Note: It would also be possible to compute all histograms in a single pass.  However, that would increase the amount of stack space used and
-		//    also increase cache pressure slightly.  However, it could still be faster under some situations.
-		// 2. If all elements are mapped to a single bucket, then there is no need to perform a scatter operation.  Instead the elements are left in place
-		//    and only copied if they need to be copied to the final output buffer.
+		// 1. The histograms of all digits are computed in a single pass over the keys before any element is moved,
+		//    which reads each key once instead of once per digit.
+		// 2. If all elements are mapped to a single bucket, then there is no need to perform a scatter operation.  The
+		//    histograms tell this up front, so such digits (e.g. the high bytes of small keys) cost nothing.
+		// This needs a histogram per digit on the stack; for large DigitBits radixSort_impl below instead computes the
+		// histogram of the next digit while it scatters the elements of the current one.
 		template <typename RandomAccessIterator, typename ExtractKey, int DigitBits, typename IntegerType>
 		void radixSort_impl(RandomAccessIterator first,
 			RandomAccessIterator last,
 			RandomAccessIterator buffer,
 			ExtractKey extractKey,
-			IntegerType)
+			IntegerType,
+			eastl::true_type) // All histograms in one pass.
+		{
+			EA_CONSTEXPR_OR_CONST size_t numBuckets = 1 << DigitBits;
+			EA_CONSTEXPR_OR_CONST IntegerType bucketMask = numBuckets - 1;
+			EA_CONSTEXPR_OR_CONST uint32_t kMaxDigitBits = 8 * sizeof(IntegerType);
+			EA_CONSTEXPR_OR_CONST uint32_t kDigitCount = (kMaxDigitBits + DigitBits - 1) / DigitBits;
+
+			const uint32_t nCount = uint32_t(last - first);
+
+			if (nCount < 2)
+				return;
+
+			// The alignment of this variable isn't required; it merely allows the code below to be faster on some platforms.
+			uint32_t EASTL_PREFIX_ALIGN(EASTL_PLATFORM_PREFERRED_ALIGNMENT) bucketSize[kDigitCount][numBuckets];
+			memset(bucketSize, 0, sizeof(bucketSize));
+
+			RandomAccessIterator temp;
+
+			for (temp = first; temp != last; ++temp)
+			{
+				const IntegerType key = extractKey(*temp);
+
+				for (uint32_t d = 0; d < kDigitCount; d++)
+					++bucketSize[d][(key >> (d * DigitBits)) & bucketMask];
+			}
+
+			// Any element tells whether all elements share a digit, whatever their order.
+			const IntegerType firstKey = extractKey(*first);
+			RandomAccessIterator srcFirst = first;
+
+			for (uint32_t d = 0; d < kDigitCount; d++)
+			{
+				const uint32_t j = d * DigitBits;
+				uint32_t* const bucketPosition = bucketSize[d];
+
+				if (bucketPosition[(firstKey >> j) & bucketMask] == nCount)
+					continue;
+
+				for (uint32_t i = 0, position = 0; i < numBuckets; i++)
+				{
+					const uint32_t size = bucketPosition[i];
+					bucketPosition[i] = position;
+					position += size;
+				}
+
+				temp = srcFirst;
+				for (uint32_t i = 0; i < nCount; i++, ++temp)
+					buffer[bucketPosition[(extractKey(*temp) >> j) & bucketMask]++] = eastl::move(*temp);
+
+				temp = srcFirst;
+				srcFirst = buffer;
+				buffer = temp;
+			}
+
+			if (srcFirst != first)
+			{
+				// Move values back into the expected buffer
+				eastl::move(srcFirst, srcFirst + nCount, first);
+			}
+		}
+
+		// Computing a histogram (i.e. finding the number of elements per bucket) for the next pass is done in parallel with the
+		// loop that "scatters" elements in the current pass.  The advantage is that it avoids the memory traffic / cache pressure
+		// of reading keys in a separate operation, with two histograms on the stack only.
+		template <typename RandomAccessIterator, typename ExtractKey, int DigitBits, typename IntegerType>
+		void radixSort_impl(RandomAccessIterator first,
+			RandomAccessIterator last,
+			RandomAccessIterator buffer,
+			ExtractKey extractKey,
+			IntegerType,
+			eastl::false_type) // A histogram per pass.
 		{
 			RandomAccessIterator srcFirst = first;
 			EA_CONSTEXPR_OR_CONST size_t numBuckets = 1 << DigitBits;
@@ -1770,12 +2605,174 @@ namespace eastl
 		}
 	} // namespace Internal
 
-	template <typename RandomAccessIterator, typename ExtractKey, int DigitBits = 8>
+	template <typename RandomAccessIterator, typename ExtractKey = radix_key<typename eastl::iterator_traits<RandomAccessIterator>::value_type>, int DigitBits = 8>
 	void radixSort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer)
 	{
+		typedef typename ExtractKey::radix_type radix_type;
+
 		static_assert(DigitBits > 0, "DigitBits must be > 0");
-		static_assert(DigitBits <= (sizeof(typename ExtractKey::radix_type) * 8), "DigitBits must be <= the size of the key (in bits)");
-		eastl::Internal::radixSort_impl<RandomAccessIterator, ExtractKey, DigitBits>(first, last, buffer, ExtractKey(), typename ExtractKey::radix_type());
+		static_assert(DigitBits <= (sizeof(radix_type) * 8), "DigitBits must be <= the size of the key (in bits)");
+
+		// Histograms of all digits in one pass, as long as they take at most 32 KB of stack.
+		typedef eastl::integral_constant<bool, ((((sizeof(radix_type) * 8) + DigitBits - 1) / DigitBits) << DigitBits) <= 8192> one_pass_histograms;
+
+		if (first != last)
+			eastl::Internal::radixSort_impl<RandomAccessIterator, ExtractKey, DigitBits>(first, last, buffer, ExtractKey(), radix_type(), one_pass_histograms());
+	}
+
+
+
+	/// msdRadixSort
+	///
+	/// Implements an in-place MSD (most significant digit) radix sort, also known as
+	/// American flag sort, for strings and other variable-length keys. It sorts keys
+	/// byte by byte from the front: it counts the elements per byte value, permutes
+	/// them in place into their buckets and then sorts each bucket by the next byte.
+	/// Keys which end sort before longer keys with the same prefix, so the order is
+	/// that of memcmp followed by length, as for basicString. Small buckets and
+	/// long common prefixes are handled by insertion sort and by skipping bytes which
+	/// all keys share. This is an unstable sort which doesn't allocate.
+	///
+	/// ExtractKey returns, for an element, a key with data() and size() members whose
+	/// data() points to bytes, e.g. a basicString<char>, a string_view or a
+	/// vector<uint8_t>. By default the element itself is the key.
+	///
+	/// Example usage:
+	///     vector<string> names;
+	///     msdRadixSort(names.begin(), names.end());
+	///
+	///     struct Entry { string mName; int mValue; };
+	///     msdRadixSort(entries.begin(), entries.end(), [](const Entry& e) -> const string& { return e.mName; });
+	///
+	namespace Internal
+	{
+		struct extractRadixString
+		{
+			template <typename T>
+			const T& operator()(const T& x) const
+				{ return x; }
+		};
+
+		// The bucket of the key at a depth: 0 if the key ends before it, else the byte + 1.
+		template <typename Key>
+		inline size_t msdRadixSort_bucket(const Key& key, size_t depth)
+		{
+			static_assert(sizeof(*key.data()) == 1, "msdRadixSort sorts keys of bytes");
+			return (depth < (size_t)key.size()) ? ((size_t)(unsigned char)key.data()[depth] + 1) : 0;
+		}
+
+		// Compares keys which share their first depth bytes.
+		template <typename ExtractKey>
+		struct msdRadixSort_compare
+		{
+			ExtractKey& mExtractKey;
+			size_t      mDepth;
+
+			template <typename T>
+			bool operator()(const T& a, const T& b) const
+			{
+				const auto& keyA = mExtractKey(a);
+				const auto& keyB = mExtractKey(b);
+				const size_t sizeA = (size_t)keyA.size() - mDepth;
+				const size_t sizeB = (size_t)keyB.size() - mDepth;
+				const size_t sizeMin = (sizeA < sizeB) ? sizeA : sizeB;
+				const int result = sizeMin ? memcmp(keyA.data() + mDepth, keyB.data() + mDepth, sizeMin) : 0;
+
+				return (result < 0) || ((result == 0) && (sizeA < sizeB));
+			}
+		};
+
+		template <typename RandomAccessIterator, typename ExtractKey>
+		void msdRadixSort_impl(RandomAccessIterator first, RandomAccessIterator last, ExtractKey& extractKey, size_t depth)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			EA_CONSTEXPR_OR_CONST size_t numBuckets = 257;
+			EA_CONSTEXPR_OR_CONST difference_type kInsertionSortLimit = 32;
+
+			for (;;)
+			{
+				const difference_type nCount = last - first;
+
+				if (nCount <= kInsertionSortLimit)
+				{
+					const msdRadixSort_compare<ExtractKey> compare = { extractKey, depth };
+					eastl::insertionSort(first, last, compare);
+					return;
+				}
+
+				difference_type bucketSize[numBuckets] = {};
+
+				for (RandomAccessIterator temp = first; temp != last; ++temp)
+					++bucketSize[msdRadixSort_bucket(extractKey(*temp), depth)];
+
+				const size_t firstBucket = msdRadixSort_bucket(extractKey(*first), depth);
+
+				if (bucketSize[firstBucket] == nCount) // All keys share this byte, or all of them end here.
+				{
+					if (firstBucket == 0)
+						return;
+					++depth;
+					continue;
+				}
+
+				difference_type bucketPosition[numBuckets], bucketEnd[numBuckets];
+
+				for (size_t i = 0, position = 0; i < numBuckets; i++)
+				{
+					bucketPosition[i] = (difference_type)position;
+					position += (size_t)bucketSize[i];
+					bucketEnd[i] = (difference_type)position;
+				}
+
+				// Each swap moves an element into its bucket for good.
+				for (size_t i = 0; i < numBuckets; i++)
+				{
+					while (bucketPosition[i] != bucketEnd[i])
+					{
+						const size_t bucket = msdRadixSort_bucket(extractKey(*(first + bucketPosition[i])), depth);
+
+						if (bucket == i)
+							++bucketPosition[i];
+						else
+							eastl::iterSwap(first + bucketPosition[i], first + bucketPosition[bucket]++);
+					}
+				}
+
+				// The keys of bucket 0 are equal. We recurse into all other buckets but the largest and then loop on that
+				// one, so the recursion is at most log2(last - first) deep.
+				size_t largest = 1;
+
+				for (size_t i = 2; i < numBuckets; i++)
+				{
+					if (bucketSize[i] > bucketSize[largest])
+						largest = i;
+				}
+
+				for (size_t i = 1; i < numBuckets; i++)
+				{
+					if ((i != largest) && (bucketSize[i] > 1))
+						msdRadixSort_impl(first + (bucketEnd[i] - bucketSize[i]), first + bucketEnd[i], extractKey, depth + 1);
+				}
+
+				last  = first + bucketEnd[largest];
+				first = last - bucketSize[largest];
+				++depth;
+			}
+		}
+	} // namespace Internal
+
+	template <typename RandomAccessIterator, typename ExtractKey>
+	void msdRadixSort(RandomAccessIterator first, RandomAccessIterator last, ExtractKey extractKey)
+	{
+		eastl::Internal::msdRadixSort_impl(first, last, extractKey, 0);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void msdRadixSort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		eastl::Internal::extractRadixString extractKey;
+		eastl::Internal::msdRadixSort_impl(first, last, extractKey, 0);
 	}
 
 
@@ -1914,7 +2911,7 @@ namespace eastl
 	/// We use quickSort by default. See quickSort for details.
 	///
 	/// EASTL_DEFAULT_SORT_FUNCTION
-	/// If a default sort function is specified then call it, otherwise use EASTL's default quickSort.
+	/// If a default sort function is specified then call it, otherwise use EASTL's default pdqSort.
 	/// EASTL_DEFAULT_SORT_FUNCTION must be namespace-qualified and include any necessary template
 	/// parameters (e.g. eastl::combSort instead of just combSort), and it must be visible to this code. 
 	/// The EASTL_DEFAULT_SORT_FUNCTION must be provided in two versions: 
@@ -1930,7 +2927,7 @@ namespace eastl
 		#if defined(EASTL_DEFAULT_SORT_FUNCTION)
 			EASTL_DEFAULT_SORT_FUNCTION(first, last);
 		#else
-			eastl::quickSort<RandomAccessIterator>(first, last);
+			eastl::pdqSort<RandomAccessIterator>(first, last);
 		#endif
 	}
 
@@ -1940,7 +2937,7 @@ namespace eastl
 		#if defined(EASTL_DEFAULT_SORT_FUNCTION)
 			EASTL_DEFAULT_SORT_FUNCTION(first, last, compare);
 		#else
-			eastl::quickSort<RandomAccessIterator, Compare>(first, last, compare);
+			eastl::pdqSort<RandomAccessIterator, Compare>(first, last, compare);
 		#endif
 	}
 
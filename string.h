@@ -31,6 +31,9 @@
 //    - basicString has a forceSize() function, which unilaterally moves the string
 //      end position (mpEnd) to the given location. Useful for when the user writes
 //      into the string via some external means such as C strcpy or sprintf.
+//    - basicString has resizeUninitialized(), appendUninitialized() and
+//      resizeAndOverwrite() functions which grow the string without filling
+//      the new characters, for when they are about to be overwritten anyway.
 //    - basicString substr() deviates from the standard and returns a string with
 //		a copy of this->getAllocator()
 ///////////////////////////////////////////////////////////////////////////////
@@ -604,6 +607,13 @@ namespace eastl
 		void      reserve(size_type = 0);
 		void      setCapacity(size_type n = npos); // Revises the capacity to the user-specified value. Resizes the container to match the capacity if the requested capacity n is less than the current size. If n == npos then the capacity is reallocated (if necessary) such that capacity == size.
 		void      forceSize(size_type n);          // Unilaterally moves the string end position (mpEnd) to the given location. Useful for when the user writes into the string via some extenal means such as C strcpy or sprintf. This allows for more efficient use than using resize to achieve this.
+		void      resizeUninitialized(size_type n); // Same as resize(n), except that new characters are left uninitialized. The trailing 0 is still written.
+		pointer   appendUninitialized(size_type n); // Grows the size by n without initializing the new characters and returns a pointer to the first of them.
+
+		// C++23 resize_and_overwrite: ensures room for n characters, then calls op(data(), n), which must
+		// write the characters it wants to keep and return the resulting size (<= n).
+		template <typename Operation>
+		void      resizeAndOverwrite(size_type n, Operation op);
 		void shrink_to_fit();
 
 		// Raw access
@@ -1449,6 +1459,63 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	inline void basicString<T, Allocator>::resizeUninitialized(size_type n)
+	{
+		const size_type s = internalLayout().GetSize();
+
+		if(n < s)
+			erase(internalLayout().BeginPtr() + n, internalLayout().EndPtr());
+		else if(n > s)
+			appendUninitialized(n - s);
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename basicString<T, Allocator>::pointer
+	basicString<T, Allocator>::appendUninitialized(size_type n)
+	{
+		const size_type nSize = internalLayout().GetSize();
+		const size_type nCapacity = capacity();
+
+		#if EASTL_STRING_OPT_LENGTH_ERRORS
+			if(EASTL_UNLIKELY(n > (maxSize() - nSize)))
+				ThrowLengthException();
+		#endif
+
+		if((nSize + n) > nCapacity)
+			reserve(GetNewCapacity(nCapacity, (nSize + n) - nCapacity));
+
+		pointer const pAppended = internalLayout().BeginPtr() + nSize;
+		internalLayout().SetSize(nSize + n);
+		*internalLayout().EndPtr() = 0;
+
+		return pAppended;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename Operation>
+	inline void basicString<T, Allocator>::resizeAndOverwrite(size_type n, Operation op)
+	{
+		if(n > capacity())
+			reserve(n);
+
+		const size_type nNewSize = (size_type)op(internalLayout().BeginPtr(), n);
+
+		#if EASTL_STRING_OPT_RANGE_ERRORS
+			if(EASTL_UNLIKELY(nNewSize > n))
+				ThrowRangeException();
+		#elif EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(nNewSize > n))
+				EASTL_FAIL_MSG("basicString::resizeAndOverwrite -- operation returned a size larger than requested");
+		#endif
+
+		internalLayout().SetSize(nNewSize);
+		*internalLayout().EndPtr() = 0;
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void basicString<T, Allocator>::clear() EASTL_NOEXCEPT
 	{
@@ -2651,7 +2718,7 @@ namespace eastl
 
 		if(EASTL_LIKELY(((npos - n) >= position) && (position + n) <= internalLayout().GetSize())) // If the range is valid...
 		{
-			const value_type* const pTemp = eastl::search(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), p, p + n);
+			const value_type* const pTemp = CharTypeStringSearch(internalLayout().BeginPtr() + position, internalLayout().EndPtr(), p, p + n);
 
 			if((pTemp != internalLayout().EndPtr()) || (n == 0))
 				return (size_type)(pTemp - internalLayout().BeginPtr());
@@ -214,6 +214,20 @@ namespace eastl
 			auto* pEnd = mpBegin + mnCount;
 			if (EASTL_LIKELY(((npos - sw.size()) >= pos) && (pos + sw.size()) <= mnCount))
 			{
+				if (sw.empty())
+					return pos;
+
+				#if defined(__cpp_lib_is_constant_evaluated)
+				// The manual search below is only needed in constant evaluation; at runtime use
+				// the vectorized search of CharTypeStringSearch (see internal/string_search.h).
+				if (!eastl::is_constant_evaluated())
+				{
+					const value_type* const pResult = CharTypeStringSearch(mpBegin + pos, pEnd, sw.mpBegin, sw.mpBegin + sw.mnCount);
+
+					return (pResult != pEnd) ? (size_type)(pResult - mpBegin) : npos;
+				}
+				#endif
+
 				for (size_type i =pos;i<=mnCount-sw.size();i++)
 				{
 					if(mpBegin[i]==sw[0])
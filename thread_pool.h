@@ -0,0 +1,522 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// thread_pool is a small work-stealing thread pool for fork-join parallelism,
+// as used by the parallel algorithms (see parallel_sort.h).
+//
+// Its single primitive is invoke(f1, f2), which runs f1 and f2, possibly in
+// parallel, and returns when both are done. Divide and conquer algorithms
+// call it recursively, which yields a tree of tasks that the pool balances
+// over its threads by itself.
+//
+// Each worker thread owns a deque of tasks. invoke pushes f2 to the back of
+// the deque of the calling thread and runs f1 right away; idle workers steal
+// from the front of other deques, which holds the oldest and thus largest
+// tasks. When f1 is done, the caller takes f2 back if nobody stole it, and
+// otherwise runs other tasks until the thief has finished f2. The task for
+// f2 lives on the stack of invoke, so the pool never allocates after
+// construction. Threads which aren't workers of the pool share one extra
+// deque. Workers without work sleep on a condition variable.
+//
+// Other pools, for example one that wraps the job system of an engine, can
+// be used with the parallel algorithms if they provide the same two
+// members:
+//     size_t concurrency() const;          // Number of threads which run tasks, including the caller.
+//     void   invoke(F1&& f1, F2&& f2);     // Runs both, returns when both are done.
+//
+// As with the standard parallel algorithms, an exception which escapes a
+// task calls std::terminate.
+//
+// Where the C++11 thread library is not available (EASTL_THREAD_POOL_ENABLED
+// is 0) thread_pool has no threads and invoke runs f1 and then f2.
+//
+// Example usage:
+//     eastl::thread_pool pool(7);  // 7 workers plus the calling thread.
+//
+//     void Sum(const int* p, size_t n, int64_t& result)
+//     {
+//         if(n < 10000)
+//             result = eastl::accumulate(p, p + n, int64_t(0));
+//         else
+//         {
+//             int64_t a, b;
+//             pool.invoke([&]{ Sum(p, n / 2, a); }, [&]{ Sum(p + n / 2, n - n / 2, b); });
+//             result = a + b;
+//         }
+//     }
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_THREAD_POOL_H
+#define EASTL_THREAD_POOL_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/thread_support.h>
+#include <eastl/allocator.h>
+#include <eastl/atomic.h>
+#include <eastl/memory.h>
+#include <eastl/type_traits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+/// EASTL_THREAD_POOL_ENABLED
+///
+/// Defined as 0 or 1. If 0, thread_pool runs everything on the calling thread.
+///
+#ifndef EASTL_THREAD_POOL_ENABLED
+	#if EASTL_CPP11_MUTEX_ENABLED && defined(EA_HAVE_CPP11_THREAD) && defined(EA_HAVE_CPP11_CONDITION_VARIABLE) && !defined(EA_COMPILER_NO_THREAD_LOCAL)
+		#define EASTL_THREAD_POOL_ENABLED 1
+	#else
+		#define EASTL_THREAD_POOL_ENABLED 0
+	#endif
+#endif
+
+#if EASTL_THREAD_POOL_ENABLED
+	EA_DISABLE_ALL_VC_WARNINGS()
+	#include <condition_variable>
+	#include <thread>
+	EA_RESTORE_ALL_VC_WARNINGS()
+#endif
+
+
+
+namespace eastl
+{
+	/// EASTL_THREAD_POOL_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_THREAD_POOL_DEFAULT_NAME
+		#define EASTL_THREAD_POOL_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " thread_pool" // Unless the user overrides something, this is "EASTL thread_pool".
+	#endif
+
+	/// EASTL_THREAD_POOL_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_THREAD_POOL_DEFAULT_ALLOCATOR
+		#define EASTL_THREAD_POOL_DEFAULT_ALLOCATOR allocator_type(EASTL_THREAD_POOL_DEFAULT_NAME)
+	#endif
+
+
+	namespace Internal
+	{
+		// A task which waits in a deque of a thread_pool. It is owned by the invoke call which pushed it.
+		struct thread_pool_task
+		{
+			void (*mpExecute)(thread_pool_task*);
+			eastl::atomic<bool> mbDone;
+		};
+
+		template <typename Function>
+		struct thread_pool_function_task : public thread_pool_task
+		{
+			explicit thread_pool_function_task(Function& function)
+				: mpFunction(&function)
+			{
+				mpExecute = &execute;
+				mbDone.store(false, eastl::memory_order_relaxed);
+			}
+
+			static void execute(thread_pool_task* pTask)
+			{
+				thread_pool_function_task* const pThis = static_cast<thread_pool_function_task*>(pTask);
+
+				(*pThis->mpFunction)();
+				pThis->mbDone.store(true, eastl::memory_order_release);
+			}
+
+			Function* mpFunction;
+		};
+	}
+
+
+	/// thread_pool
+	///
+	/// invoke and concurrency may be called concurrently from any number of
+	/// threads, including from within tasks.
+	///
+	class thread_pool
+	{
+	public:
+		typedef EASTLAllocatorType allocator_type;
+
+		static const size_t kDequeCapacity = 256; // Tasks per deque; invoke runs f2 itself when its deque is full.
+
+	public:
+		/// Starts nThreadCount worker threads. By default it starts one per hardware thread, less one for
+		/// the thread which calls invoke.
+		explicit thread_pool(size_t nThreadCount = kDefaultThreadCount, const allocator_type& allocator = EASTL_THREAD_POOL_DEFAULT_ALLOCATOR);
+		~thread_pool();
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		/// Runs f1 and f2, possibly in parallel, and returns when both are done. f1 runs on the calling thread.
+		template <typename F1, typename F2>
+		void invoke(F1&& f1, F2&& f2) EASTL_NOEXCEPT;
+
+		/// The number of threads which run tasks: the workers and the thread which calls invoke.
+		size_t concurrency() const EASTL_NOEXCEPT;
+
+		size_t threadCount() const EASTL_NOEXCEPT;
+
+	protected:
+		static const size_t kDefaultThreadCount = (size_t)-1;
+
+		#if EASTL_THREAD_POOL_ENABLED
+			struct Worker
+			{
+				alignas(EASTL_DESTRUCTIVE_INTERFERENCE_SIZE) std::mutex mMutex;
+				Internal::thread_pool_task* mTasks[kDequeCapacity];
+				size_t                mnFront;    // Thieves take tasks from the front,
+				size_t                mnBack;     // the owner pushes and pops them at the back.
+				eastl::atomic<size_t> mnSize;     // mnBack - mnFront, which thieves read without the lock.
+				thread_pool*          mpPool;
+				uint32_t              mnRandom;   // Picks the victims of this worker.
+				std::thread           mThread;
+			};
+
+			static Worker*& DoGetCurrentWorker();
+
+			Worker& DoGetLocalDeque();
+			bool    DoPush(Worker& deque, Internal::thread_pool_task* pTask);
+			bool    DoPopBack(Worker& deque, Internal::thread_pool_task* pTask);
+			Internal::thread_pool_task* DoSteal(uint32_t& nRandom);
+			void    DoWait(Internal::thread_pool_task* pTask);
+			void    DoWorkerMain(Worker& worker);
+		#endif
+
+	protected:
+		#if EASTL_THREAD_POOL_ENABLED
+			Worker*                 mpWorkers;        // mnThreadCount workers, followed by the deque shared by outside threads.
+			size_t                  mnThreadCount;
+			allocator_type          mAllocator;
+
+			std::mutex              mSleepMutex;
+			std::condition_variable mWakeCondition;
+			eastl::atomic<size_t>   mnQueued;         // Tasks in all deques.
+			eastl::atomic<size_t>   mnSleeping;       // Workers which wait, or are about to wait, on mWakeCondition.
+			bool                    mbStopping;
+		#endif
+	};
+
+
+	/// getDefaultThreadPool
+	///
+	/// Returns the pool which the parallel algorithms use when none is given.
+	/// It is created on first use, with a worker per hardware thread less one.
+	///
+	thread_pool& getDefaultThreadPool();
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// thread_pool
+	///////////////////////////////////////////////////////////////////////
+
+	#if EASTL_THREAD_POOL_ENABLED
+
+		inline thread_pool::thread_pool(size_t nThreadCount, const allocator_type& allocator)
+			: mpWorkers(nullptr), mnThreadCount(0), mAllocator(allocator), mnQueued(0), mnSleeping(0), mbStopping(false)
+		{
+			if(nThreadCount == kDefaultThreadCount)
+			{
+				const size_t nHardwareCount = (size_t)std::thread::hardware_concurrency();
+				nThreadCount = (nHardwareCount > 1) ? (nHardwareCount - 1) : 0;
+			}
+
+			mpWorkers = (Worker*)allocate_memory(mAllocator, (nThreadCount + 1) * sizeof(Worker), EASTL_ALIGN_OF(Worker), 0);
+
+			for(size_t i = 0; i <= nThreadCount; ++i)
+			{
+				Worker* const pWorker = ::new(&mpWorkers[i]) Worker;
+				pWorker->mnFront  = 0;
+				pWorker->mnBack   = 0;
+				pWorker->mnSize.store(0, eastl::memory_order_relaxed);
+				pWorker->mpPool   = this;
+				pWorker->mnRandom = (uint32_t)(i * 0x9e3779b9u) | 1u;
+			}
+
+			mnThreadCount = nThreadCount;
+
+			for(size_t i = 0; i < nThreadCount; ++i)
+				mpWorkers[i].mThread = std::thread(&thread_pool::DoWorkerMain, this, eastl::ref(mpWorkers[i]));
+		}
+
+
+		inline thread_pool::~thread_pool()
+		{
+			{
+				std::unique_lock<std::mutex> lock(mSleepMutex);
+				mbStopping = true;
+			}
+			mWakeCondition.notify_all();
+
+			for(size_t i = 0; i <= mnThreadCount; ++i)
+			{
+				if(mpWorkers[i].mThread.joinable())
+					mpWorkers[i].mThread.join();
+				mpWorkers[i].~Worker();
+			}
+
+			EASTLFree(mAllocator, mpWorkers, (mnThreadCount + 1) * sizeof(Worker));
+		}
+
+
+		template <typename F1, typename F2>
+		inline void thread_pool::invoke(F1&& f1, F2&& f2) EASTL_NOEXCEPT
+		{
+			typedef typename eastl::remove_reference<F2>::type function_type;
+
+			Internal::thread_pool_function_task<function_type> task(f2);
+			Worker& deque = DoGetLocalDeque();
+
+			if((mnThreadCount == 0) || !DoPush(deque, &task))
+			{
+				f1();
+				f2();
+				return;
+			}
+
+			f1();
+
+			if(DoPopBack(deque, &task))
+				f2();
+			else
+				DoWait(&task); // It was stolen.
+		}
+
+
+		inline thread_pool::Worker*& thread_pool::DoGetCurrentWorker()
+		{
+			static thread_local Worker* pCurrentWorker = nullptr;
+			return pCurrentWorker;
+		}
+
+
+		inline thread_pool::Worker& thread_pool::DoGetLocalDeque()
+		{
+			Worker* const pWorker = DoGetCurrentWorker();
+
+			if(pWorker && (pWorker->mpPool == this))
+				return *pWorker;
+			return mpWorkers[mnThreadCount];
+		}
+
+
+		inline bool thread_pool::DoPush(Worker& deque, Internal::thread_pool_task* pTask)
+		{
+			{
+				std::unique_lock<std::mutex> lock(deque.mMutex);
+
+				if((deque.mnBack - deque.mnFront) == kDequeCapacity)
+					return false;
+				deque.mTasks[deque.mnBack++ % kDequeCapacity] = pTask;
+				deque.mnSize.store(deque.mnBack - deque.mnFront, eastl::memory_order_relaxed);
+			}
+
+			// Pairs with the check in DoWorkerMain: either the worker sees the task, or we see the worker.
+			mnQueued.fetch_add(1, eastl::memory_order_seq_cst);
+
+			if(mnSleeping.load(eastl::memory_order_seq_cst) != 0)
+			{
+				std::unique_lock<std::mutex> lock(mSleepMutex);
+				mWakeCondition.notify_one();
+			}
+
+			return true;
+		}
+
+
+		// Takes pTask back if it is still the last task of the deque, which it is unless it was stolen.
+		// The shared deque of outside threads may have other tasks after it; these are left to workers.
+		inline bool thread_pool::DoPopBack(Worker& deque, Internal::thread_pool_task* pTask)
+		{
+			std::unique_lock<std::mutex> lock(deque.mMutex);
+
+			if((deque.mnBack != deque.mnFront) && (deque.mTasks[(deque.mnBack - 1) % kDequeCapacity] == pTask))
+			{
+				--deque.mnBack;
+				deque.mnSize.store(deque.mnBack - deque.mnFront, eastl::memory_order_relaxed);
+				mnQueued.fetch_sub(1, eastl::memory_order_relaxed);
+				return true;
+			}
+
+			return false;
+		}
+
+
+		inline Internal::thread_pool_task* thread_pool::DoSteal(uint32_t& nRandom)
+		{
+			const size_t nDequeCount = mnThreadCount + 1;
+
+			nRandom ^= nRandom << 13; // xorshift32
+			nRandom ^= nRandom >> 17;
+			nRandom ^= nRandom << 5;
+
+			for(size_t i = 0, nStart = nRandom % nDequeCount; i < nDequeCount; ++i)
+			{
+				Worker& victim = mpWorkers[(nStart + i) % nDequeCount];
+
+				if(victim.mnSize.load(eastl::memory_order_relaxed) == 0) // Skips empty deques without locking them.
+					continue;
+
+				std::unique_lock<std::mutex> lock(victim.mMutex);
+
+				if(victim.mnBack != victim.mnFront)
+				{
+					Internal::thread_pool_task* const pTask = victim.mTasks[victim.mnFront++ % kDequeCapacity];
+
+					victim.mnSize.store(victim.mnBack - victim.mnFront, eastl::memory_order_relaxed);
+					mnQueued.fetch_sub(1, eastl::memory_order_relaxed);
+					return pTask;
+				}
+			}
+
+			return nullptr;
+		}
+
+
+		// Runs other tasks until pTask, which another thread runs, is done.
+		inline void thread_pool::DoWait(Internal::thread_pool_task* pTask)
+		{
+			Worker* const pWorker = DoGetCurrentWorker();
+			uint32_t nRandom = (pWorker && (pWorker->mpPool == this)) ? pWorker->mnRandom : (uint32_t)(uintptr_t)pTask | 1u;
+
+			for(unsigned nIdle = 0; !pTask->mbDone.load(eastl::memory_order_acquire); )
+			{
+				if(Internal::thread_pool_task* pOther = DoSteal(nRandom))
+				{
+					pOther->mpExecute(pOther);
+					nIdle = 0;
+				}
+				else if(++nIdle > 64)
+					std::this_thread::yield();
+			}
+
+			if(pWorker && (pWorker->mpPool == this))
+				pWorker->mnRandom = nRandom;
+		}
+
+
+		inline void thread_pool::DoWorkerMain(Worker& worker)
+		{
+			DoGetCurrentWorker() = &worker;
+
+			for(;;)
+			{
+				Internal::thread_pool_task* pTask = nullptr;
+
+				for(unsigned nAttempt = 0; !pTask && (nAttempt < 64); ++nAttempt)
+				{
+					pTask = DoSteal(worker.mnRandom);
+
+					if(!pTask)
+						std::this_thread::yield();
+				}
+
+				if(pTask)
+				{
+					pTask->mpExecute(pTask);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(mSleepMutex);
+
+				if(mbStopping)
+					break;
+
+				mnSleeping.fetch_add(1, eastl::memory_order_seq_cst);
+				if(mnQueued.load(eastl::memory_order_seq_cst) == 0)
+					mWakeCondition.wait(lock);
+				mnSleeping.fetch_sub(1, eastl::memory_order_relaxed);
+
+				if(mbStopping)
+					break;
+			}
+
+			DoGetCurrentWorker() = nullptr;
+		}
+
+
+		inline size_t thread_pool::concurrency() const EASTL_NOEXCEPT
+		{
+			return mnThreadCount + 1;
+		}
+
+
+		inline size_t thread_pool::threadCount() const EASTL_NOEXCEPT
+		{
+			return mnThreadCount;
+		}
+
+	#else
+
+		inline thread_pool::thread_pool(size_t, const allocator_type&)
+		{
+		}
+
+
+		inline thread_pool::~thread_pool()
+		{
+		}
+
+
+		template <typename F1, typename F2>
+		inline void thread_pool::invoke(F1&& f1, F2&& f2) EASTL_NOEXCEPT
+		{
+			f1();
+			f2();
+		}
+
+
+		inline size_t thread_pool::concurrency() const EASTL_NOEXCEPT
+		{
+			return 1;
+		}
+
+
+		inline size_t thread_pool::threadCount() const EASTL_NOEXCEPT
+		{
+			return 0;
+		}
+
+	#endif
+
+
+	inline thread_pool& getDefaultThreadPool()
+	{
+		static thread_pool sDefaultThreadPool;
+		return sDefaultThreadPool;
+	}
+
+
+	namespace Internal
+	{
+		// Calls function(i) for each i in [nBegin, nEnd), splitting the range in halves over the pool.
+		template <typename ThreadPool, typename Function>
+		void thread_pool_for(ThreadPool& pool, size_t nBegin, size_t nEnd, Function& function)
+		{
+			if((nEnd - nBegin) > 1)
+			{
+				const size_t nMid = nBegin + ((nEnd - nBegin) / 2);
+
+				pool.invoke([&] { Internal::thread_pool_for(pool, nBegin, nMid, function); },
+				            [&] { Internal::thread_pool_for(pool, nMid, nEnd, function); });
+			}
+			else if(nBegin != nEnd)
+				function(nBegin);
+		}
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
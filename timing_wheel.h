@@ -0,0 +1,560 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// timing_wheel is a hierarchical hashed timing wheel: a container of timers
+// which supports scheduling and cancelling a timer in O(1) and collecting the
+// expired ones in O(1) per timer. It is meant for very large numbers of
+// timeouts, most of which are cancelled before they expire, such as
+// connection or request timeouts, where a priority_queue or multimap would
+// spend O(log n) on every arm and cancel.
+//
+// Time is measured in ticks of TickDuration. The wheel has LevelCount levels
+// of 2^SlotBits slots each. Level 0 has a slot per tick; each slot of level l
+// spans 2^(SlotBits * l) ticks. A timer goes to the lowest level whose slot
+// holds its expiry tick alone, relative to the current tick. As time reaches
+// the slot of a higher level, its timers are redistributed to lower levels
+// (cascaded), so each timer moves at most LevelCount times. Timers further
+// out than the wheel spans wait in an overflow list. Occupancy bitmaps let
+// advance skip over empty slots, so advancing over a long idle period costs
+// little.
+//
+// Like intrusive_list, the wheel does no allocation: timers derive from
+// timing_wheel_node and are linked through it. Expired timers are handed out
+// in batches, by splicing whole slots into an intrusive_list supplied by the
+// caller.
+//
+// Example usage:
+//     struct Connection : public eastl::timing_wheel_node { ... };
+//
+//     eastl::timing_wheel<Connection> timeouts;          // millisecond ticks
+//     timeouts.scheduleAfter(connection, eastl::chrono::seconds(30));
+//     timeouts.schedule(connection, timeouts.now() + 30000); // Rearms it.
+//     timeouts.cancel(connection);
+//
+//     eastl::intrusive_list<Connection> expired;
+//     timeouts.advance(elapsedMilliseconds, expired);
+//     while(!expired.empty())
+//     {
+//         Connection& c = expired.front();
+//         expired.popFront();
+//         OnTimeout(c);
+//     }
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_TIMING_WHEEL_H
+#define EASTL_TIMING_WHEEL_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/bitset.h>
+#include <eastl/chrono.h>
+#include <eastl/intrusive_list.h>
+#include <eastl/type_traits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// timing_wheel_node
+	///
+	/// The hook through which timing_wheel links its timers. It records the
+	/// expiry tick and where in the wheel the timer is.
+	///
+	struct timing_wheel_node : public intrusive_list_node
+	{
+		static const uint8_t kLevelNone     = 0xff;  // Not scheduled.
+		static const uint8_t kLevelDue      = 0xfe;  // Expiry is at or before the wheel's current tick.
+		static const uint8_t kLevelOverflow = 0xfd;  // Expiry is beyond the span of the wheel.
+
+		uint64_t mExpiry;
+		uint8_t  mnLevel;
+
+		timing_wheel_node()
+			: mExpiry(0), mnLevel(kLevelNone)
+		{
+			mpNext = mpPrev = nullptr;
+		}
+
+		// Copying a node doesn't copy its scheduling, as that belongs to the wheel.
+		timing_wheel_node(const timing_wheel_node&)
+			: intrusive_list_node(), mExpiry(0), mnLevel(kLevelNone)
+		{
+			mpNext = mpPrev = nullptr;
+		}
+
+		timing_wheel_node& operator=(const timing_wheel_node&) { return *this; }
+
+		bool     isScheduled() const { return mnLevel != kLevelNone; }
+		uint64_t expiry() const      { return mExpiry; }
+	};
+
+
+
+	/// timing_wheel
+	///
+	/// T must derive from timing_wheel_node. The default configuration has
+	/// four levels of 256 slots with millisecond ticks, which spans 2^32 ticks
+	/// (about 50 days) before timers go to the overflow list.
+	///
+	/// A timing_wheel object holds LevelCount * 2^SlotBits list heads, which
+	/// is 16 KB for the default configuration on 64-bit platforms.
+	///
+	template <typename T = timing_wheel_node, typename TickDuration = chrono::milliseconds, size_t SlotBits = 8, size_t LevelCount = 4>
+	class timing_wheel
+	{
+	public:
+		typedef timing_wheel<T, TickDuration, SlotBits, LevelCount>  this_type;
+		typedef T                                                     value_type;
+		typedef T                                                     node_type;
+		typedef intrusive_list<T>                                     list_type;
+		typedef TickDuration                                          tick_duration;
+		typedef uint64_t                                              tick_type;
+		typedef eastl_size_t                                          size_type;
+
+		static const size_type kSlotCount = (size_type)1 << SlotBits;
+		static const tick_type kSlotMask  = (tick_type)kSlotCount - 1;
+
+		static_assert(is_base_of<timing_wheel_node, T>::value, "timing_wheel elements must derive from timing_wheel_node.");
+		static_assert((SlotBits >= 1) && (LevelCount >= 1) && (SlotBits * LevelCount < 64), "timing_wheel must span fewer than 2^64 ticks.");
+		static_assert(LevelCount < timing_wheel_node::kLevelOverflow, "timing_wheel has too many levels.");
+
+	public:
+		explicit timing_wheel(tick_type startTick = 0);
+		~timing_wheel();
+
+		// Not copyable, as the timers are linked into the wheel.
+		timing_wheel(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		// Schedules the timer to expire at the given tick, or rearms it if it's already scheduled.
+		// A tick at or before now() expires with the next call to advance. A timer handed out by
+		// advance must be removed from the expired list (e.g. with popFront) before it is scheduled
+		// again, as scheduling relinks it. This is asserted if EASTL_VALIDATE_INTRUSIVE_LIST is enabled.
+		void schedule(value_type& value, tick_type expiryTick);
+
+		// Schedules the timer to expire after delay, which is rounded up to whole ticks.
+		template <typename Rep, typename Period>
+		void scheduleAfter(value_type& value, const chrono::duration<Rep, Period>& delay);
+
+		// Returns false (and does nothing) if the timer isn't scheduled. A timer that has been
+		// handed out by advance is no longer scheduled.
+		bool cancel(value_type& value);
+
+		// Advances the current tick to now, and moves all timers which expire at or before it to
+		// the back of expired. They come in order of expiry tick, except that timers which were
+		// scheduled for a tick that had already passed come first. Does nothing if now is before now().
+		void advance(tick_type now, list_type& expired);
+
+		// As above, with now given as the time since tick 0, rounded down to whole ticks.
+		template <typename Rep, typename Period>
+		void advance(const chrono::duration<Rep, Period>& sinceStart, list_type& expired);
+
+		// Returns the tick of the earliest pending slot, which is no later than the earliest
+		// expiry, or tick_type(-1) if no timers are scheduled. An event loop can sleep until then.
+		tick_type nextTick() const;
+
+		// Unschedules all timers; O(n).
+		void clear();
+
+		tick_type now() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;
+		bool      empty() const EASTL_NOEXCEPT;
+
+		// Converts a duration to ticks, rounding up.
+		template <typename Rep, typename Period>
+		static tick_type toTicks(const chrono::duration<Rep, Period>& d);
+
+		bool validate() const;
+
+	protected:
+		typedef bitset<kSlotCount> occupancy_type;
+
+		static timing_wheel_node& DoNode(value_type& value) { return static_cast<timing_wheel_node&>(value); }
+
+		void DoInsert(value_type& value);
+		void DoCascade(list_type& list);
+		void DoExpire(list_type& list, list_type& expired);
+		void DoUnlinkAll(list_type& list);
+		tick_type DoGetNextEventTick() const;
+
+	protected:
+		list_type      mSlots[LevelCount][kSlotCount];
+		occupancy_type mOccupied[LevelCount];
+		list_type      mDue;         // Timers which expire at or before mnNow.
+		list_type      mOverflow;    // Timers beyond the span of the wheel.
+		tick_type      mnNow;
+		size_type      mnSize;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// timing_wheel
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline timing_wheel<T, TickDuration, SlotBits, LevelCount>::timing_wheel(tick_type startTick)
+		: mnNow(startTick)
+		, mnSize(0)
+	{
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline timing_wheel<T, TickDuration, SlotBits, LevelCount>::~timing_wheel()
+	{
+		clear();
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline void timing_wheel<T, TickDuration, SlotBits, LevelCount>::schedule(value_type& value, tick_type expiryTick)
+	{
+		#if EASTL_VALIDATE_INTRUSIVE_LIST && EASTL_ASSERT_ENABLED
+			// intrusive_list clears the links of the nodes it removes, so a linked unscheduled timer is in another list.
+			if(EASTL_UNLIKELY(!DoNode(value).isScheduled() && DoNode(value).mpNext))
+				EASTL_FAIL_MSG("timing_wheel::schedule -- timer is still in a list, such as the expired list from advance; remove it first");
+		#endif
+
+		if(DoNode(value).isScheduled())
+			cancel(value);
+
+		DoNode(value).mExpiry = expiryTick;
+		DoInsert(value);
+		++mnSize;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	template <typename Rep, typename Period>
+	inline void timing_wheel<T, TickDuration, SlotBits, LevelCount>::scheduleAfter(value_type& value, const chrono::duration<Rep, Period>& delay)
+	{
+		schedule(value, mnNow + toTicks(delay));
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	bool timing_wheel<T, TickDuration, SlotBits, LevelCount>::cancel(value_type& value)
+	{
+		timing_wheel_node& node = DoNode(value);
+
+		if(!node.isScheduled())
+			return false;
+
+		list_type::remove(value);
+		node.mpNext = node.mpPrev = nullptr;
+
+		if(node.mnLevel < LevelCount)
+		{
+			const size_type slot = (size_type)((node.mExpiry >> (SlotBits * node.mnLevel)) & kSlotMask);
+
+			if(mSlots[node.mnLevel][slot].empty())
+				mOccupied[node.mnLevel].reset(slot);
+		}
+
+		node.mnLevel = timing_wheel_node::kLevelNone;
+		--mnSize;
+		return true;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	void timing_wheel<T, TickDuration, SlotBits, LevelCount>::advance(tick_type now, list_type& expired)
+	{
+		if(now < mnNow)
+			return;
+
+		// Timers scheduled at or before the current tick since the last advance.
+		DoExpire(mDue, expired);
+
+		for(;;)
+		{
+			const tick_type eventTick = DoGetNextEventTick();
+
+			if(eventTick > now)
+			{
+				// No slot starts in (mnNow, now], so every timer stays where it is. The invariants
+				// of DoInsert still hold, as no occupied slot has been reached.
+				mnNow = now;
+				break;
+			}
+
+			mnNow = eventTick;
+
+			if(!mOverflow.empty() && ((eventTick & (((tick_type)1 << (SlotBits * LevelCount)) - 1)) == 0))
+			{
+				list_type temp;
+				temp.splice(temp.end(), mOverflow);
+				DoCascade(temp);
+			}
+
+			// Cascade the slots which begin at eventTick, from the top down, as a cascade can fill
+			// a lower level slot that begins later, but never one that begins at eventTick.
+			for(size_t level = LevelCount - 1; level >= 1; --level)
+			{
+				const tick_type levelShift = SlotBits * level;
+
+				if((eventTick & (((tick_type)1 << levelShift) - 1)) == 0)
+				{
+					const size_type slot = (size_type)((eventTick >> levelShift) & kSlotMask);
+
+					if(mOccupied[level].test(slot))
+					{
+						list_type temp;
+						temp.splice(temp.end(), mSlots[level][slot]);
+						mOccupied[level].reset(slot);
+						DoCascade(temp);
+					}
+				}
+			}
+
+			const size_type slot = (size_type)(eventTick & kSlotMask);
+
+			if(mOccupied[0].test(slot))
+			{
+				DoExpire(mSlots[0][slot], expired);
+				mOccupied[0].reset(slot);
+			}
+
+			DoExpire(mDue, expired); // Cascaded timers which expire exactly at eventTick.
+		}
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	template <typename Rep, typename Period>
+	inline void timing_wheel<T, TickDuration, SlotBits, LevelCount>::advance(const chrono::duration<Rep, Period>& sinceStart, list_type& expired)
+	{
+		advance((tick_type)chrono::duration_cast<tick_duration>(sinceStart).count(), expired);
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline typename timing_wheel<T, TickDuration, SlotBits, LevelCount>::tick_type
+	timing_wheel<T, TickDuration, SlotBits, LevelCount>::nextTick() const
+	{
+		return mDue.empty() ? DoGetNextEventTick() : mnNow;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	void timing_wheel<T, TickDuration, SlotBits, LevelCount>::clear()
+	{
+		for(size_t level = 0; level < LevelCount; ++level)
+		{
+			for(size_type slot = mOccupied[level].findFirst(); slot != kSlotCount; slot = mOccupied[level].findNext(slot))
+				DoUnlinkAll(mSlots[level][slot]);
+
+			mOccupied[level].reset();
+		}
+
+		DoUnlinkAll(mDue);
+		DoUnlinkAll(mOverflow);
+		mnSize = 0;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline typename timing_wheel<T, TickDuration, SlotBits, LevelCount>::tick_type
+	timing_wheel<T, TickDuration, SlotBits, LevelCount>::now() const EASTL_NOEXCEPT
+	{
+		return mnNow;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline typename timing_wheel<T, TickDuration, SlotBits, LevelCount>::size_type
+	timing_wheel<T, TickDuration, SlotBits, LevelCount>::size() const EASTL_NOEXCEPT
+	{
+		return mnSize;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	inline bool timing_wheel<T, TickDuration, SlotBits, LevelCount>::empty() const EASTL_NOEXCEPT
+	{
+		return mnSize == 0;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	template <typename Rep, typename Period>
+	inline typename timing_wheel<T, TickDuration, SlotBits, LevelCount>::tick_type
+	timing_wheel<T, TickDuration, SlotBits, LevelCount>::toTicks(const chrono::duration<Rep, Period>& d)
+	{
+		tick_duration ticks = chrono::duration_cast<tick_duration>(d);
+
+		if(ticks < d)
+			++ticks;
+
+		return (ticks.count() > 0) ? (tick_type)ticks.count() : 0;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	bool timing_wheel<T, TickDuration, SlotBits, LevelCount>::validate() const
+	{
+		size_type nCount = 0;
+
+		for(size_t level = 0; level < LevelCount; ++level)
+		{
+			const tick_type levelShift = SlotBits * level;
+			const tick_type currentSlot = (mnNow >> levelShift) & kSlotMask;
+
+			for(size_type slot = 0; slot < kSlotCount; ++slot)
+			{
+				const list_type& list = mSlots[level][slot];
+
+				if(list.empty() == mOccupied[level].test(slot))
+					return false;
+
+				for(typename list_type::const_iterator it = list.begin(); it != list.end(); ++it, ++nCount)
+				{
+					const timing_wheel_node& node = *it;
+
+					// A timer sits in a later slot of the current revolution of its level.
+					if((node.mnLevel != level) || (((node.mExpiry >> levelShift) & kSlotMask) != slot) || (slot <= currentSlot) ||
+					   ((node.mExpiry >> (levelShift + SlotBits)) != (mnNow >> (levelShift + SlotBits))))
+						return false;
+				}
+			}
+		}
+
+		for(typename list_type::const_iterator it = mDue.begin(); it != mDue.end(); ++it, ++nCount)
+		{
+			if((it->mnLevel != timing_wheel_node::kLevelDue) || (it->mExpiry > mnNow))
+				return false;
+		}
+
+		for(typename list_type::const_iterator it = mOverflow.begin(); it != mOverflow.end(); ++it, ++nCount)
+		{
+			if((it->mnLevel != timing_wheel_node::kLevelOverflow) || ((it->mExpiry >> (SlotBits * LevelCount)) == (mnNow >> (SlotBits * LevelCount))))
+				return false;
+		}
+
+		return nCount == mnSize;
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	void timing_wheel<T, TickDuration, SlotBits, LevelCount>::DoInsert(value_type& value)
+	{
+		timing_wheel_node& node = DoNode(value);
+
+		if(node.mExpiry <= mnNow)
+		{
+			node.mnLevel = timing_wheel_node::kLevelDue;
+			mDue.pushBack(value);
+			return;
+		}
+
+		// The level is given by the highest bit in which the expiry differs from the current
+		// tick. The timer's slot in that level is then after the current one.
+		const size_t level = (size_t)GetLastBit(node.mExpiry ^ mnNow) / SlotBits;
+
+		if(level >= LevelCount)
+		{
+			node.mnLevel = timing_wheel_node::kLevelOverflow;
+			mOverflow.pushBack(value);
+			return;
+		}
+
+		const size_type slot = (size_type)((node.mExpiry >> (SlotBits * level)) & kSlotMask);
+
+		node.mnLevel = (uint8_t)level;
+		mSlots[level][slot].pushBack(value);
+		mOccupied[level].set(slot);
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	void timing_wheel<T, TickDuration, SlotBits, LevelCount>::DoCascade(list_type& list)
+	{
+		while(!list.empty())
+		{
+			value_type& value = list.front();
+			list.popFront();
+			DoInsert(value);
+		}
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	void timing_wheel<T, TickDuration, SlotBits, LevelCount>::DoExpire(list_type& list, list_type& expired)
+	{
+		for(typename list_type::iterator it = list.begin(); it != list.end(); ++it)
+		{
+			DoNode(*it).mnLevel = timing_wheel_node::kLevelNone;
+			--mnSize;
+		}
+
+		expired.splice(expired.end(), list);
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	void timing_wheel<T, TickDuration, SlotBits, LevelCount>::DoUnlinkAll(list_type& list)
+	{
+		while(!list.empty())
+		{
+			timing_wheel_node& node = DoNode(list.front());
+			list.popFront();
+			node.mpNext = node.mpPrev = nullptr;
+			node.mnLevel = timing_wheel_node::kLevelNone;
+		}
+	}
+
+
+	template <typename T, typename TickDuration, size_t SlotBits, size_t LevelCount>
+	typename timing_wheel<T, TickDuration, SlotBits, LevelCount>::tick_type
+	timing_wheel<T, TickDuration, SlotBits, LevelCount>::DoGetNextEventTick() const
+	{
+		// The next tick at which a slot begins that holds timers, which may be a level 0 slot that
+		// expires or a higher level slot that cascades. Occupied slots are always later in the
+		// current revolution of their level, so there is no wrapping to consider.
+		tick_type nextTick = (tick_type)-1;
+
+		for(size_t level = 0; level < LevelCount; ++level)
+		{
+			const tick_type levelShift = SlotBits * level;
+			const size_type currentSlot = (size_type)((mnNow >> levelShift) & kSlotMask);
+			const size_type slot = mOccupied[level].findNext(currentSlot);
+
+			if(slot != kSlotCount)
+			{
+				const tick_type revolutionStart = (mnNow >> (levelShift + SlotBits)) << (levelShift + SlotBits);
+				const tick_type slotTick = revolutionStart | ((tick_type)slot << levelShift);
+
+				if(slotTick < nextTick)
+					nextTick = slotTick;
+			}
+		}
+
+		if(!mOverflow.empty())
+		{
+			const tick_type spanShift = SlotBits * LevelCount;
+			const tick_type spanTick  = ((mnNow >> spanShift) + 1) << spanShift;
+
+			if(spanTick < nextTick)
+				nextTick = spanTick;
+		}
+
+		return nextTick;
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
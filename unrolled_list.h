@@ -0,0 +1,1589 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements unrolled_list, a doubly-linked list whose nodes each
+// hold a small array of up to NodeCapacity elements.
+//
+// Compared to list:
+//    - There is one allocation and two pointers per node instead of per
+//      element, and iteration walks contiguous memory for NodeCapacity
+//      elements at a time. Algorithms which understand segmented iterators
+//      (see segmented_iterator_traits) run over each node as a plain array.
+//    - Inserting into or erasing from the middle only shifts elements within
+//      a single node. A full node is split in two; an under-full node is
+//      merged with a neighbor when the two fit into one node.
+//    - splice moves whole nodes and is O(1), apart from splitting the node
+//      at the splice position if it isn't at a node boundary.
+//    - Insertion and erasure invalidate iterators to elements of the nodes
+//      involved (and of any node they get merged with), not just iterators
+//      to the erased element.
+//
+// The elements of a node are always stored at its beginning, and the list
+// never contains an empty node.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_UNROLLED_LIST_H
+#define EASTL_UNROLLED_LIST_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/type_traits.h>
+#include <eastl/iterator.h>
+#include <eastl/algorithm.h>
+#include <eastl/memory.h>
+#include <eastl/initializer_list.h>
+#include <eastl/internal/segmented_iterator.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <new>
+#include <stddef.h>
+#include <string.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_UNROLLED_LIST_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_UNROLLED_LIST_DEFAULT_NAME
+		#define EASTL_UNROLLED_LIST_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " unrolled_list" // Unless the user overrides something, this is "EASTL unrolled_list".
+	#endif
+
+
+	/// EASTL_UNROLLED_LIST_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_UNROLLED_LIST_DEFAULT_ALLOCATOR
+		#define EASTL_UNROLLED_LIST_DEFAULT_ALLOCATOR allocator_type(EASTL_UNROLLED_LIST_DEFAULT_NAME)
+	#endif
+
+
+	/// UNROLLED_LIST_DEFAULT_NODE_CAPACITY
+	///
+	/// Defines the default number of elements per node, which keeps the
+	/// element storage of a node at around 256 bytes.
+	///
+	#define UNROLLED_LIST_DEFAULT_NODE_CAPACITY(T) ((sizeof(T) <= 4) ? 64 : ((sizeof(T) <= 8) ? 32 : ((sizeof(T) <= 16) ? 16 : ((sizeof(T) <= 32) ? 8 : 4))))
+
+
+
+	/// UnrolledListNodeBase
+	///
+	/// The part of a node which doesn't depend on the element type. The list
+	/// anchor is a bare UnrolledListNodeBase with a size of zero.
+	///
+	struct UnrolledListNodeBase
+	{
+		UnrolledListNodeBase* mpNext;
+		UnrolledListNodeBase* mpPrev;
+		eastl_size_t          mnSize;  // The number of elements in the node. They occupy the first mnSize slots.
+	};
+
+
+	template <typename T, size_t NodeCapacity>
+	struct UnrolledListNode : public UnrolledListNodeBase
+	{
+		typename aligned_storage<sizeof(T), alignof(T)>::type mData[NodeCapacity];
+	};
+
+
+
+	/// UnrolledListIterator
+	///
+	/// Refers to an element by its node and its index within the node. The
+	/// end iterator refers to the list anchor with an index of zero.
+	///
+	template <typename T, typename Pointer, typename Reference, size_t NodeCapacity>
+	struct UnrolledListIterator
+	{
+		typedef UnrolledListIterator<T, Pointer, Reference, NodeCapacity>  this_type;
+		typedef UnrolledListIterator<T, T*, T&, NodeCapacity>              iterator;
+		typedef UnrolledListIterator<T, const T*, const T&, NodeCapacity>  const_iterator;
+		typedef eastl_size_t                                               size_type;
+		typedef ptrdiff_t                                                  difference_type;
+		typedef T                                                          value_type;
+		typedef UnrolledListNodeBase                                       base_node_type;
+		typedef UnrolledListNode<T, NodeCapacity>                          node_type;
+		typedef Pointer                                                    pointer;
+		typedef Reference                                                  reference;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                   iterator_category;
+
+	public:
+		base_node_type* mpNode;
+		size_type       mnIndex;
+
+	public:
+		UnrolledListIterator() EASTL_NOEXCEPT
+			: mpNode(NULL), mnIndex(0) { }
+
+		UnrolledListIterator(const base_node_type* pNode, size_type nIndex) EASTL_NOEXCEPT
+			: mpNode(const_cast<base_node_type*>(pNode)), mnIndex(nIndex) { }
+
+		UnrolledListIterator(const iterator& x) EASTL_NOEXCEPT
+			: mpNode(x.mpNode), mnIndex(x.mnIndex) { }
+
+		this_type& operator=(const iterator& x) EASTL_NOEXCEPT
+			{ mpNode = x.mpNode; mnIndex = x.mnIndex; return *this; }
+
+		static pointer GetData(const base_node_type* pNode) EASTL_NOEXCEPT
+			{ return reinterpret_cast<pointer>(static_cast<node_type*>(const_cast<base_node_type*>(pNode))->mData); }
+
+		reference operator*() const EASTL_NOEXCEPT
+			{ return GetData(mpNode)[mnIndex]; }
+
+		pointer operator->() const EASTL_NOEXCEPT
+			{ return GetData(mpNode) + mnIndex; }
+
+		this_type& operator++() EASTL_NOEXCEPT
+		{
+			if(++mnIndex == mpNode->mnSize)
+			{
+				mpNode  = mpNode->mpNext;
+				mnIndex = 0;
+			}
+			return *this;
+		}
+
+		this_type operator++(int) EASTL_NOEXCEPT
+			{ this_type temp(*this); ++*this; return temp; }
+
+		this_type& operator--() EASTL_NOEXCEPT
+		{
+			if(mnIndex == 0)
+			{
+				mpNode  = mpNode->mpPrev;
+				mnIndex = mpNode->mnSize;
+			}
+			--mnIndex;
+			return *this;
+		}
+
+		this_type operator--(int) EASTL_NOEXCEPT
+			{ this_type temp(*this); --*this; return temp; }
+	};
+
+
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, size_t NodeCapacity>
+	inline bool operator==(const UnrolledListIterator<T, PointerA, ReferenceA, NodeCapacity>& a,
+						   const UnrolledListIterator<T, PointerB, ReferenceB, NodeCapacity>& b) EASTL_NOEXCEPT
+	{
+		return (a.mpNode == b.mpNode) && (a.mnIndex == b.mnIndex);
+	}
+
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, size_t NodeCapacity>
+	inline bool operator!=(const UnrolledListIterator<T, PointerA, ReferenceA, NodeCapacity>& a,
+						   const UnrolledListIterator<T, PointerB, ReferenceB, NodeCapacity>& b) EASTL_NOEXCEPT
+	{
+		return (a.mpNode != b.mpNode) || (a.mnIndex != b.mnIndex);
+	}
+
+
+
+	/// segmented_iterator_traits<UnrolledListIterator>
+	///
+	/// Exposes the elements of each node as a contiguous segment.
+	///
+	template <typename T, typename Pointer, typename Reference, size_t NodeCapacity>
+	struct segmented_iterator_traits< UnrolledListIterator<T, Pointer, Reference, NodeCapacity> >
+	{
+		typedef UnrolledListIterator<T, Pointer, Reference, NodeCapacity> iterator_type;
+		typedef true_type                                                 is_segmented_iterator;
+		typedef UnrolledListNodeBase*                                     segment_iterator;
+		typedef Pointer                                                   local_iterator;
+
+		static segment_iterator segment(const iterator_type& it)                                { return it.mpNode; }
+		static local_iterator   local(const iterator_type& it)                                  { return iterator_type::GetData(it.mpNode) + it.mnIndex; }
+		static local_iterator   segment_begin(segment_iterator s)                               { return iterator_type::GetData(s); }
+		static local_iterator   segment_end(segment_iterator s)                                 { return iterator_type::GetData(s) + s->mnSize; }
+		static local_iterator   segment_end(segment_iterator s, const iterator_type& last)      { return iterator_type::GetData(s) + ((s == last.mpNode) ? last.mnIndex : s->mnSize); }
+		static bool             is_final_segment(segment_iterator s, const iterator_type& last) { return (s == last.mpNode) || ((last.mnIndex == 0) && (s->mpNext == last.mpNode)); }
+		static segment_iterator next_segment(segment_iterator s)                                { return s->mpNext; }
+
+		static iterator_type compose(segment_iterator s, local_iterator l)
+		{
+			const eastl_size_t nIndex = (eastl_size_t)(l - iterator_type::GetData(s));
+
+			if(nIndex == s->mnSize)
+				return iterator_type(s->mpNext, 0);
+			return iterator_type(s, nIndex);
+		}
+	};
+
+
+
+	/// unrolled_list
+	///
+	/// Example usage:
+	///     unrolled_list<int> intList;
+	///     intList.pushBack(37);
+	///     intList.insert(intList.begin(), 17);
+	///
+	///     unrolled_list<Widget, 8> widgetList; // Eight widgets per node.
+	///
+	template <typename T, size_t NodeCapacity = UNROLLED_LIST_DEFAULT_NODE_CAPACITY(T), typename Allocator = EASTLAllocatorType>
+	class unrolled_list
+	{
+		typedef unrolled_list<T, NodeCapacity, Allocator>  this_type;
+
+	public:
+		typedef T                                                                value_type;
+		typedef T*                                                               pointer;
+		typedef const T*                                                         const_pointer;
+		typedef T&                                                               reference;
+		typedef const T&                                                         const_reference;
+		typedef UnrolledListIterator<T, T*, T&, NodeCapacity>                    iterator;
+		typedef UnrolledListIterator<T, const T*, const T&, NodeCapacity>        const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                          const_reverse_iterator;
+		typedef eastl_size_t                                                     size_type;
+		typedef ptrdiff_t                                                        difference_type;
+		typedef Allocator                                                        allocator_type;
+		typedef UnrolledListNode<T, NodeCapacity>                                node_type;
+		typedef UnrolledListNodeBase                                             base_node_type;
+
+		static_assert(NodeCapacity >= 2, "unrolled_list nodes must be able to hold at least two elements.");
+
+		static const size_type kNodeCapacity = (size_type)NodeCapacity;
+
+	public:
+		unrolled_list();
+		explicit unrolled_list(const allocator_type& allocator);
+		explicit unrolled_list(size_type n, const allocator_type& allocator = EASTL_UNROLLED_LIST_DEFAULT_ALLOCATOR);
+		unrolled_list(size_type n, const value_type& value, const allocator_type& allocator = EASTL_UNROLLED_LIST_DEFAULT_ALLOCATOR);
+		unrolled_list(const this_type& x);
+		unrolled_list(this_type&& x);
+		unrolled_list(std::initializer_list<value_type> ilist, const allocator_type& allocator = EASTL_UNROLLED_LIST_DEFAULT_ALLOCATOR);
+
+		template <typename InputIterator>
+		unrolled_list(InputIterator first, InputIterator last);
+
+	   ~unrolled_list();
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		this_type& operator=(this_type&& x);
+
+		// In the case that the two containers' allocators are unequal, swap copies elements instead
+		// of replacing them in place. In this case swap is an O(n) operation instead of O(1).
+		void swap(this_type& x);
+
+		void assign(size_type n, const value_type& value);
+
+		template <typename InputIterator>
+		void assign(InputIterator first, InputIterator last);
+
+		void assign(std::initializer_list<value_type> ilist);
+
+		iterator       begin() EASTL_NOEXCEPT;
+		const_iterator begin() const EASTL_NOEXCEPT;
+		const_iterator cbegin() const EASTL_NOEXCEPT;
+
+		iterator       end() EASTL_NOEXCEPT;
+		const_iterator end() const EASTL_NOEXCEPT;
+		const_iterator cend() const EASTL_NOEXCEPT;
+
+		reverse_iterator       rbegin() EASTL_NOEXCEPT;
+		const_reverse_iterator rbegin() const EASTL_NOEXCEPT;
+		const_reverse_iterator crbegin() const EASTL_NOEXCEPT;
+
+		reverse_iterator       rend() EASTL_NOEXCEPT;
+		const_reverse_iterator rend() const EASTL_NOEXCEPT;
+		const_reverse_iterator crend() const EASTL_NOEXCEPT;
+
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;
+
+		void resize(size_type n, const value_type& value);
+		void resize(size_type n);
+
+		reference       front();
+		const_reference front() const;
+
+		reference       back();
+		const_reference back() const;
+
+		template <typename... Args>
+		reference emplace_front(Args&&... args);
+
+		template <typename... Args>
+		reference emplace_back(Args&&... args);
+
+		void pushFront(const value_type& value);
+		void pushFront(value_type&& value);
+
+		void pushBack(const value_type& value);
+		void pushBack(value_type&& value);
+
+		void popFront();
+		void popBack();
+
+		template <typename... Args>
+		iterator emplace(const_iterator position, Args&&... args);
+
+		iterator insert(const_iterator position, const value_type& value);
+		iterator insert(const_iterator position, value_type&& value);
+		iterator insert(const_iterator position, size_type n, const value_type& value);
+		iterator insert(const_iterator position, std::initializer_list<value_type> ilist);
+
+		template <typename InputIterator>
+		iterator insert(const_iterator position, InputIterator first, InputIterator last);
+
+		iterator erase(const_iterator position);
+		iterator erase(const_iterator first, const_iterator last);
+
+		void clear() EASTL_NOEXCEPT;
+
+		// Moves the nodes of x (or of [first, last) in x) into this list before position. Only the nodes at
+		// position, first and last are split if those aren't at node boundaries; all other nodes are relinked.
+		void splice(const_iterator position, this_type& x);
+		void splice(const_iterator position, this_type&& x);
+		void splice(const_iterator position, this_type& x, const_iterator first, const_iterator last);
+		void splice(const_iterator position, this_type&& x, const_iterator first, const_iterator last);
+
+		// Packs the elements into as few nodes as possible and frees the rest.
+		void shrink_to_fit();
+
+		size_type node_count() const EASTL_NOEXCEPT;
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+		allocator_type&       getAllocator() EASTL_NOEXCEPT;
+		void                  setAllocator(const allocator_type& allocator);
+
+		bool validate() const;
+
+	protected:
+		static pointer GetData(const base_node_type* pNode) EASTL_NOEXCEPT { return iterator::GetData(pNode); }
+
+		node_type*      DoAllocateNode();
+		void            DoFreeNode(base_node_type* pNode);
+		base_node_type* DoInsertNodeBefore(base_node_type* pNext);
+		void            DoUnlinkAndFreeNode(base_node_type* pNode);
+
+		base_node_type* DoSplitNode(base_node_type* pNode, size_type nIndex);
+		iterator        DoSplitAt(const_iterator position);
+		iterator        DoMakeRoom(const_iterator position);
+		void            DoMergeUnderfull(base_node_type* pNode, iterator& result);
+		iterator        DoAdvance(size_type n);
+
+		static void DoRelocate(T* pDest, T* pSource, size_type n, true_type);
+		static void DoRelocate(T* pDest, T* pSource, size_type n, false_type);
+		static void DoRelocate(T* pDest, T* pSource, size_type n);
+		static void DoShiftRight(T* p, size_type n, true_type);
+		static void DoShiftRight(T* p, size_type n, false_type);
+		static void DoShiftRight(T* p, size_type n);
+
+		template <typename Integer>
+		void DoAssign(Integer n, Integer value, true_type);
+
+		template <typename InputIterator>
+		void DoAssign(InputIterator first, InputIterator last, false_type);
+
+		void DoInitAnchor() EASTL_NOEXCEPT;
+		void DoSwap(this_type& x);
+
+	protected:
+		base_node_type mAnchor;
+		size_type      mnSize;
+		allocator_type mAllocator;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// unrolled_list
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list()
+		: mnSize(0)
+		, mAllocator(EASTL_UNROLLED_LIST_DEFAULT_NAME)
+	{
+		DoInitAnchor();
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(const allocator_type& allocator)
+		: mnSize(0)
+		, mAllocator(allocator)
+	{
+		DoInitAnchor();
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(size_type n, const allocator_type& allocator)
+		: mnSize(0)
+		, mAllocator(allocator)
+	{
+		DoInitAnchor();
+		resize(n);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(size_type n, const value_type& value, const allocator_type& allocator)
+		: mnSize(0)
+		, mAllocator(allocator)
+	{
+		DoInitAnchor();
+		DoAssign<size_type>(n, value, true_type());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(const this_type& x)
+		: mnSize(0)
+		, mAllocator(x.mAllocator)
+	{
+		DoInitAnchor();
+		DoAssign(x.begin(), x.end(), false_type());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(this_type&& x)
+		: mnSize(0)
+		, mAllocator(x.mAllocator)
+	{
+		DoInitAnchor();
+		DoSwap(x);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: mnSize(0)
+		, mAllocator(allocator)
+	{
+		DoInitAnchor();
+		DoAssign(ilist.begin(), ilist.end(), false_type());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename InputIterator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::unrolled_list(InputIterator first, InputIterator last)
+		: mnSize(0)
+		, mAllocator(EASTL_UNROLLED_LIST_DEFAULT_NAME)
+	{
+		DoInitAnchor();
+		DoAssign(first, last, is_integral<InputIterator>());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline unrolled_list<T, NodeCapacity, Allocator>::~unrolled_list()
+	{
+		clear();
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::this_type&
+	unrolled_list<T, NodeCapacity, Allocator>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				mAllocator = x.mAllocator;
+			#endif
+
+			DoAssign(x.begin(), x.end(), false_type());
+		}
+		return *this;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::this_type&
+	unrolled_list<T, NodeCapacity, Allocator>::operator=(std::initializer_list<value_type> ilist)
+	{
+		DoAssign(ilist.begin(), ilist.end(), false_type());
+		return *this;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::this_type&
+	unrolled_list<T, NodeCapacity, Allocator>::operator=(this_type&& x)
+	{
+		if(this != &x)
+		{
+			clear();
+			swap(x);
+		}
+		return *this;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::swap(this_type& x)
+	{
+		if(mAllocator == x.mAllocator) // If allocators are equivalent...
+			DoSwap(x);
+		else // else swap the contents.
+		{
+			const this_type temp(*this); // Can't call eastl::swap because that would
+			*this = x;                   // itself call this member swap function.
+			x     = temp;
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::assign(size_type n, const value_type& value)
+	{
+		DoAssign<size_type>(n, value, true_type());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename InputIterator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::assign(InputIterator first, InputIterator last)
+	{
+		DoAssign(first, last, is_integral<InputIterator>());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::assign(std::initializer_list<value_type> ilist)
+	{
+		DoAssign(ilist.begin(), ilist.end(), false_type());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::begin() EASTL_NOEXCEPT
+	{
+		return iterator(mAnchor.mpNext, 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::begin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(mAnchor.mpNext, 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::cbegin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(mAnchor.mpNext, 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::end() EASTL_NOEXCEPT
+	{
+		return iterator(&mAnchor, 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::end() const EASTL_NOEXCEPT
+	{
+		return const_iterator(&mAnchor, 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::cend() const EASTL_NOEXCEPT
+	{
+		return const_iterator(&mAnchor, 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::reverse_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::rbegin() EASTL_NOEXCEPT
+	{
+		return reverse_iterator(end());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_reverse_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::rbegin() const EASTL_NOEXCEPT
+	{
+		return const_reverse_iterator(end());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_reverse_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::crbegin() const EASTL_NOEXCEPT
+	{
+		return const_reverse_iterator(end());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::reverse_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::rend() EASTL_NOEXCEPT
+	{
+		return reverse_iterator(begin());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_reverse_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::rend() const EASTL_NOEXCEPT
+	{
+		return const_reverse_iterator(begin());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_reverse_iterator
+	unrolled_list<T, NodeCapacity, Allocator>::crend() const EASTL_NOEXCEPT
+	{
+		return const_reverse_iterator(begin());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline bool unrolled_list<T, NodeCapacity, Allocator>::empty() const EASTL_NOEXCEPT
+	{
+		return (mnSize == 0);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::size_type
+	unrolled_list<T, NodeCapacity, Allocator>::size() const EASTL_NOEXCEPT
+	{
+		return mnSize;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::resize(size_type n, const value_type& value)
+	{
+		if(n < mnSize)
+			erase(DoAdvance(n), end());
+		else
+		{
+			for(size_type i = mnSize; i < n; ++i)
+				pushBack(value);
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::resize(size_type n)
+	{
+		if(n < mnSize)
+			erase(DoAdvance(n), end());
+		else
+		{
+			for(size_type i = mnSize; i < n; ++i)
+				emplace_back();
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::reference
+	unrolled_list<T, NodeCapacity, Allocator>::front()
+	{
+		#if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mnSize == 0))
+				EASTL_FAIL_MSG("unrolled_list::front -- empty container");
+		#endif
+
+		return GetData(mAnchor.mpNext)[0];
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_reference
+	unrolled_list<T, NodeCapacity, Allocator>::front() const
+	{
+		#if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mnSize == 0))
+				EASTL_FAIL_MSG("unrolled_list::front -- empty container");
+		#endif
+
+		return GetData(mAnchor.mpNext)[0];
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::reference
+	unrolled_list<T, NodeCapacity, Allocator>::back()
+	{
+		#if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mnSize == 0))
+				EASTL_FAIL_MSG("unrolled_list::back -- empty container");
+		#endif
+
+		return GetData(mAnchor.mpPrev)[mAnchor.mpPrev->mnSize - 1];
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::const_reference
+	unrolled_list<T, NodeCapacity, Allocator>::back() const
+	{
+		#if EASTL_ASSERT_ENABLED && EASTL_EMPTY_REFERENCE_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mnSize == 0))
+				EASTL_FAIL_MSG("unrolled_list::back -- empty container");
+		#endif
+
+		return GetData(mAnchor.mpPrev)[mAnchor.mpPrev->mnSize - 1];
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename... Args>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::reference
+	unrolled_list<T, NodeCapacity, Allocator>::emplace_front(Args&&... args)
+	{
+		return *emplace(begin(), eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename... Args>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::reference
+	unrolled_list<T, NodeCapacity, Allocator>::emplace_back(Args&&... args)
+	{
+		base_node_type* pNode = mAnchor.mpPrev;
+
+		if((pNode == &mAnchor) || (pNode->mnSize == kNodeCapacity))
+			pNode = DoInsertNodeBefore(&mAnchor);
+
+		// Appending doesn't move any existing element, so args may safely refer into the list.
+		pointer const p = GetData(pNode) + pNode->mnSize;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)p) value_type(eastl::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				if(pNode->mnSize == 0)
+					DoUnlinkAndFreeNode(pNode);
+				throw;
+			}
+		#else
+			::new((void*)p) value_type(eastl::forward<Args>(args)...);
+		#endif
+
+		++pNode->mnSize;
+		++mnSize;
+		return *p;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::pushFront(const value_type& value)
+	{
+		emplace(begin(), value);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::pushFront(value_type&& value)
+	{
+		emplace(begin(), eastl::move(value));
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::pushBack(const value_type& value)
+	{
+		emplace_back(value);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::pushBack(value_type&& value)
+	{
+		emplace_back(eastl::move(value));
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::popFront()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mnSize == 0))
+				EASTL_FAIL_MSG("unrolled_list::popFront -- empty container");
+		#endif
+
+		erase(begin());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::popBack()
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(mnSize == 0))
+				EASTL_FAIL_MSG("unrolled_list::popBack -- empty container");
+		#endif
+
+		base_node_type* const pNode = mAnchor.mpPrev;
+
+		GetData(pNode)[--pNode->mnSize].~value_type();
+		--mnSize;
+
+		if(pNode->mnSize == 0)
+			DoUnlinkAndFreeNode(pNode);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename... Args>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::emplace(const_iterator position, Args&&... args)
+	{
+		if(position.mpNode == &mAnchor)
+		{
+			emplace_back(eastl::forward<Args>(args)...);
+			return iterator(mAnchor.mpPrev, mAnchor.mpPrev->mnSize - 1);
+		}
+
+		// Making room shifts elements, which args may refer to, so we construct the value up front.
+		value_type value(eastl::forward<Args>(args)...);
+
+		const iterator it(DoMakeRoom(position));
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)it.operator->()) value_type(eastl::move(value));
+			}
+			catch(...)
+			{
+				// Close the hole again. A split done by DoMakeRoom is kept, as both halves are non-empty.
+				base_node_type* const pNode = it.mpNode;
+
+				DoRelocate(GetData(pNode) + it.mnIndex, GetData(pNode) + it.mnIndex + 1, pNode->mnSize - it.mnIndex - 1);
+				--pNode->mnSize;
+				--mnSize;
+
+				if(pNode->mnSize == 0)
+					DoUnlinkAndFreeNode(pNode);
+				throw;
+			}
+		#else
+			::new((void*)it.operator->()) value_type(eastl::move(value));
+		#endif
+
+		return it;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::insert(const_iterator position, const value_type& value)
+	{
+		return emplace(position, value);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::insert(const_iterator position, value_type&& value)
+	{
+		return emplace(position, eastl::move(value));
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::insert(const_iterator position, size_type n, const value_type& value)
+	{
+		const value_type temp(value); // value may refer to an element which gets moved by the insertions.
+		iterator it(position.mpNode, position.mnIndex);
+
+		for(size_type i = 0; i < n; ++i)
+			it = ++emplace(it, temp);
+
+		// Inserting may have split the nodes the earlier elements went into, so we walk back to the first one.
+		for(size_type i = 0; i < n; ++i)
+			--it;
+		return it;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::insert(const_iterator position, std::initializer_list<value_type> ilist)
+	{
+		return insert(position, ilist.begin(), ilist.end());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename InputIterator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::insert(const_iterator position, InputIterator first, InputIterator last)
+	{
+		iterator  it(position.mpNode, position.mnIndex);
+		size_type n = 0;
+
+		for(; first != last; ++first, ++n)
+			it = ++emplace(it, *first);
+
+		for(; n; --n)
+			--it;
+		return it;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::erase(const_iterator position)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(position.mpNode == &mAnchor))
+				EASTL_FAIL_MSG("unrolled_list::erase -- invalid iterator");
+		#endif
+
+		base_node_type* const pNode = position.mpNode;
+		pointer const         pData = GetData(pNode);
+		const size_type       i     = position.mnIndex;
+
+		eastl::move(pData + i + 1, pData + pNode->mnSize, pData + i);
+		pData[--pNode->mnSize].~value_type();
+		--mnSize;
+
+		iterator result(pNode, i);
+
+		if(pNode->mnSize == 0)
+		{
+			result = iterator(pNode->mpNext, 0);
+			DoUnlinkAndFreeNode(pNode);
+		}
+		else
+		{
+			if(i == pNode->mnSize)
+				result = iterator(pNode->mpNext, 0);
+			DoMergeUnderfull(pNode, result);
+		}
+
+		return result;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::erase(const_iterator first, const_iterator last)
+	{
+		if(first == last)
+			return iterator(last.mpNode, last.mnIndex);
+
+		base_node_type* pNode     = first.mpNode;
+		size_type       i         = first.mnIndex;
+		base_node_type* pSurvivor = NULL; // The first node, if it keeps some of its elements.
+
+		// Drop the tails (or the entirety) of the nodes before the last one.
+		while(pNode != last.mpNode)
+		{
+			base_node_type* const pNext = pNode->mpNext;
+			pointer const         pData = GetData(pNode);
+
+			eastl::destruct(pData + i, pData + pNode->mnSize);
+			mnSize -= (pNode->mnSize - i);
+			pNode->mnSize = i;
+
+			if(i)
+				pSurvivor = pNode;
+			else
+				DoUnlinkAndFreeNode(pNode);
+
+			pNode = pNext;
+			i     = 0;
+		}
+
+		iterator result(pNode, i);
+
+		// Erase [i, last.mnIndex) from the last node.
+		if(last.mnIndex > i)
+		{
+			pointer const   pData = GetData(pNode);
+			const size_type n     = last.mnIndex - i;
+
+			eastl::move(pData + last.mnIndex, pData + pNode->mnSize, pData + i);
+			eastl::destruct(pData + pNode->mnSize - n, pData + pNode->mnSize);
+			pNode->mnSize -= n;
+			mnSize        -= n;
+
+			if(pNode->mnSize == 0)
+			{
+				result = iterator(pNode->mpNext, 0);
+				DoUnlinkAndFreeNode(pNode);
+			}
+			else
+			{
+				if(i == pNode->mnSize)
+					result = iterator(pNode->mpNext, 0);
+				DoMergeUnderfull(pNode, result);
+			}
+		}
+
+		// The last node may have been merged into the survivor above, which is fine, as
+		// DoMergeUnderfull keeps result pointing at the same element.
+		if(pSurvivor)
+			DoMergeUnderfull(pSurvivor, result);
+
+		return result;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::clear() EASTL_NOEXCEPT
+	{
+		for(base_node_type* pNode = mAnchor.mpNext; pNode != &mAnchor; )
+		{
+			base_node_type* const pNext = pNode->mpNext;
+			pointer const         pData = GetData(pNode);
+
+			eastl::destruct(pData, pData + pNode->mnSize);
+			DoFreeNode(pNode);
+			pNode = pNext;
+		}
+
+		DoInitAnchor();
+		mnSize = 0;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::splice(const_iterator position, this_type&& x)
+	{
+		splice(position, x);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::splice(const_iterator position, this_type& x)
+	{
+		// Splicing operations cannot succeed if the two containers use unequal allocators.
+		// In that case we copy the elements from the source to the dest and remove them from the source.
+
+		if((this == &x) || x.empty())
+			return;
+
+		if(mAllocator == x.mAllocator)
+		{
+			base_node_type* const pNext  = DoSplitAt(position).mpNode;
+			base_node_type* const pFirst = x.mAnchor.mpNext;
+			base_node_type* const pLast  = x.mAnchor.mpPrev;
+
+			pFirst->mpPrev        = pNext->mpPrev;
+			pLast->mpNext         = pNext;
+			pNext->mpPrev->mpNext = pFirst;
+			pNext->mpPrev         = pLast;
+
+			mnSize += x.mnSize;
+			x.DoInitAnchor();
+			x.mnSize = 0;
+		}
+		else
+		{
+			insert(position, x.begin(), x.end());
+			x.clear();
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::splice(const_iterator position, this_type&& x, const_iterator first, const_iterator last)
+	{
+		splice(position, x, first, last);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::splice(const_iterator position, this_type& x, const_iterator first, const_iterator last)
+	{
+		if(first == last)
+			return;
+
+		if(mAllocator == x.mAllocator)
+		{
+			// Turn first and last into node boundaries. Splitting a node moves the elements at and after
+			// the split point into a new node, so we fix up the other iterators that pointed into them.
+			const base_node_type* const pFirstNode  = first.mpNode;
+			const size_type             nFirstIndex = first.mnIndex;
+
+			first = x.DoSplitAt(first);
+
+			if(nFirstIndex)
+			{
+				if((last.mpNode == pFirstNode) && (last.mnIndex >= nFirstIndex))
+					last = const_iterator(first.mpNode, last.mnIndex - nFirstIndex);
+				if((position.mpNode == pFirstNode) && (position.mnIndex >= nFirstIndex))
+					position = const_iterator(first.mpNode, position.mnIndex - nFirstIndex);
+			}
+
+			const base_node_type* const pLastNode  = last.mpNode;
+			const size_type             nLastIndex = last.mnIndex;
+
+			last = x.DoSplitAt(last);
+
+			if(nLastIndex && (position.mpNode == pLastNode) && (position.mnIndex >= nLastIndex))
+				position = const_iterator(last.mpNode, position.mnIndex - nLastIndex);
+
+			// Splitting at position leaves first and last alone, as they are now at index zero.
+			base_node_type* const pNext   = DoSplitAt(position).mpNode;
+			base_node_type* const pFirst  = first.mpNode;
+			base_node_type* const pLast   = last.mpNode->mpPrev;
+
+			if(this != &x)
+			{
+				size_type n = 0;
+
+				for(const base_node_type* pNode = pFirst; pNode != last.mpNode; pNode = pNode->mpNext)
+					n += pNode->mnSize;
+
+				x.mnSize -= n;
+				mnSize   += n;
+			}
+
+			if((pNext == pFirst) || (pNext == last.mpNode)) // Splicing a range before itself or right after itself is a no-op.
+				return;
+
+			// Unlink [pFirst, pLast] from x.
+			pFirst->mpPrev->mpNext = last.mpNode;
+			last.mpNode->mpPrev    = pFirst->mpPrev;
+
+			// Link it before pNext.
+			pFirst->mpPrev        = pNext->mpPrev;
+			pLast->mpNext         = pNext;
+			pNext->mpPrev->mpNext = pFirst;
+			pNext->mpPrev         = pLast;
+		}
+		else
+		{
+			insert(position, first, last);
+			x.erase(first, last);
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::shrink_to_fit()
+	{
+		base_node_type* pDest = mAnchor.mpNext;
+		base_node_type* pSource;
+
+		// Each element is moved at most twice: once to the front of its own node, once into the node before.
+		while((pDest != &mAnchor) && ((pSource = pDest->mpNext) != &mAnchor))
+		{
+			if(pDest->mnSize == kNodeCapacity)
+			{
+				pDest = pSource;
+				continue;
+			}
+
+			const size_type n = eastl::minAlt(kNodeCapacity - pDest->mnSize, pSource->mnSize);
+
+			DoRelocate(GetData(pDest) + pDest->mnSize, GetData(pSource), n);
+			pDest->mnSize   += n;
+			pSource->mnSize -= n;
+
+			if(pSource->mnSize == 0)
+				DoUnlinkAndFreeNode(pSource);
+			else
+			{
+				DoRelocate(GetData(pSource), GetData(pSource) + n, pSource->mnSize);
+				pDest = pSource;
+			}
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::size_type
+	unrolled_list<T, NodeCapacity, Allocator>::node_count() const EASTL_NOEXCEPT
+	{
+		size_type n = 0;
+
+		for(const base_node_type* pNode = mAnchor.mpNext; pNode != &mAnchor; pNode = pNode->mpNext)
+			++n;
+		return n;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline const typename unrolled_list<T, NodeCapacity, Allocator>::allocator_type&
+	unrolled_list<T, NodeCapacity, Allocator>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::allocator_type&
+	unrolled_list<T, NodeCapacity, Allocator>::getAllocator() EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::setAllocator(const allocator_type& allocator)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(!empty() && !(mAllocator == allocator)))
+				EASTL_FAIL_MSG("unrolled_list::setAllocator -- cannot change allocator after allocations have been made.");
+		#endif
+
+		mAllocator = allocator;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	bool unrolled_list<T, NodeCapacity, Allocator>::validate() const
+	{
+		size_type n = 0;
+
+		if(mAnchor.mnSize != 0)
+			return false;
+
+		for(const base_node_type* pNode = mAnchor.mpNext; pNode != &mAnchor; pNode = pNode->mpNext)
+		{
+			if((pNode->mnSize == 0) || (pNode->mnSize > kNodeCapacity))
+				return false;
+			if(pNode->mpNext->mpPrev != pNode)
+				return false;
+			n += pNode->mnSize;
+		}
+
+		return (n == mnSize) && (mAnchor.mpPrev->mpNext == &mAnchor);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::node_type*
+	unrolled_list<T, NodeCapacity, Allocator>::DoAllocateNode()
+	{
+		node_type* const pNode = (node_type*)allocate_memory(mAllocator, sizeof(node_type), EASTL_ALIGN_OF(node_type), 0);
+		EASTL_ASSERT_MSG(pNode != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+		pNode->mnSize = 0;
+		return pNode;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoFreeNode(base_node_type* pNode)
+	{
+		EASTLFree(mAllocator, static_cast<node_type*>(pNode), sizeof(node_type));
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::base_node_type*
+	unrolled_list<T, NodeCapacity, Allocator>::DoInsertNodeBefore(base_node_type* pNext)
+	{
+		base_node_type* const pNode = DoAllocateNode();
+
+		pNode->mpNext         = pNext;
+		pNode->mpPrev         = pNext->mpPrev;
+		pNext->mpPrev->mpNext = pNode;
+		pNext->mpPrev         = pNode;
+		return pNode;
+	}
+
+
+	// The node's elements must have already been destroyed or moved out.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoUnlinkAndFreeNode(base_node_type* pNode)
+	{
+		pNode->mpPrev->mpNext = pNode->mpNext;
+		pNode->mpNext->mpPrev = pNode->mpPrev;
+		DoFreeNode(pNode);
+	}
+
+
+	// Moves the elements [nIndex, size) of pNode into a new node which is linked after it,
+	// and returns the new node.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::base_node_type*
+	unrolled_list<T, NodeCapacity, Allocator>::DoSplitNode(base_node_type* pNode, size_type nIndex)
+	{
+		base_node_type* const pNewNode = DoInsertNodeBefore(pNode->mpNext);
+
+		DoRelocate(GetData(pNewNode), GetData(pNode) + nIndex, pNode->mnSize - nIndex);
+		pNewNode->mnSize = pNode->mnSize - nIndex;
+		pNode->mnSize    = nIndex;
+		return pNewNode;
+	}
+
+
+	// Returns an iterator equal to position which is at the start of a node (or is end()).
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::DoSplitAt(const_iterator position)
+	{
+		if(position.mnIndex == 0)
+			return iterator(position.mpNode, position.mnIndex);
+		return iterator(DoSplitNode(position.mpNode, position.mnIndex), 0);
+	}
+
+
+	// Opens an uninitialized slot at position, splitting its node if it is full, and
+	// returns an iterator to the slot. The slot is already counted in the sizes.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::DoMakeRoom(const_iterator position)
+	{
+		base_node_type* pNode = position.mpNode;
+		size_type       i     = position.mnIndex;
+
+		if(pNode == &mAnchor)
+		{
+			pNode = mAnchor.mpPrev;
+
+			if((pNode == &mAnchor) || (pNode->mnSize == kNodeCapacity))
+				pNode = DoInsertNodeBefore(&mAnchor);
+			i = pNode->mnSize;
+		}
+		else if(pNode->mnSize == kNodeCapacity)
+		{
+			if((i == 0) && (pNode->mpPrev != &mAnchor) && (pNode->mpPrev->mnSize < kNodeCapacity))
+			{
+				// Append to the previous node instead, which doesn't require shifting anything.
+				pNode = pNode->mpPrev;
+				i     = pNode->mnSize;
+			}
+			else
+			{
+				const size_type nMid     = kNodeCapacity / 2;
+				base_node_type* pNewNode = DoSplitNode(pNode, nMid);
+
+				if(i > nMid)
+				{
+					pNode = pNewNode;
+					i    -= nMid;
+				}
+			}
+		}
+
+		DoShiftRight(GetData(pNode) + i, pNode->mnSize - i);
+		++pNode->mnSize;
+		++mnSize;
+		return iterator(pNode, i);
+	}
+
+
+	// If pNode is less than half full, merges it with its next or previous node, provided the
+	// two fit into one node. result is adjusted if it refers to an element which moves.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	void unrolled_list<T, NodeCapacity, Allocator>::DoMergeUnderfull(base_node_type* pNode, iterator& result)
+	{
+		if((pNode->mnSize * 2) >= kNodeCapacity)
+			return;
+
+		base_node_type* const pNext = pNode->mpNext;
+
+		if((pNext != &mAnchor) && ((pNode->mnSize + pNext->mnSize) <= kNodeCapacity))
+		{
+			DoRelocate(GetData(pNode) + pNode->mnSize, GetData(pNext), pNext->mnSize);
+
+			if(result.mpNode == pNext)
+				result = iterator(pNode, pNode->mnSize + result.mnIndex);
+
+			pNode->mnSize += pNext->mnSize;
+			DoUnlinkAndFreeNode(pNext);
+			return;
+		}
+
+		base_node_type* const pPrev = pNode->mpPrev;
+
+		if((pPrev != &mAnchor) && ((pPrev->mnSize + pNode->mnSize) <= kNodeCapacity))
+		{
+			DoRelocate(GetData(pPrev) + pPrev->mnSize, GetData(pNode), pNode->mnSize);
+
+			if(result.mpNode == pNode)
+				result = iterator(pPrev, pPrev->mnSize + result.mnIndex);
+
+			pPrev->mnSize += pNode->mnSize;
+			DoUnlinkAndFreeNode(pNode);
+		}
+	}
+
+
+	// Returns an iterator to the element at index n, walking whole nodes where possible.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	typename unrolled_list<T, NodeCapacity, Allocator>::iterator
+	unrolled_list<T, NodeCapacity, Allocator>::DoAdvance(size_type n)
+	{
+		base_node_type* pNode = mAnchor.mpNext;
+
+		while((pNode != &mAnchor) && (n >= pNode->mnSize))
+		{
+			n    -= pNode->mnSize;
+			pNode = pNode->mpNext;
+		}
+
+		return iterator(pNode, n);
+	}
+
+
+	// Moves n elements from pSource to uninitialized memory at pDest and destroys the
+	// originals. The ranges may overlap as long as pDest comes first.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoRelocate(T* pDest, T* pSource, size_type n, true_type)
+	{
+		if(n)
+			memmove(pDest, pSource, n * sizeof(T));
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoRelocate(T* pDest, T* pSource, size_type n, false_type)
+	{
+		for(; n; --n, ++pDest, ++pSource)
+		{
+			::new((void*)pDest) value_type(eastl::move(*pSource));
+			pSource->~value_type();
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoRelocate(T* pDest, T* pSource, size_type n)
+	{
+		DoRelocate(pDest, pSource, n, is_trivially_copyable<T>());
+	}
+
+
+	// Moves the n elements at p one slot up, leaving p uninitialized.
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoShiftRight(T* p, size_type n, true_type)
+	{
+		if(n)
+			memmove(p + 1, p, n * sizeof(T));
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoShiftRight(T* p, size_type n, false_type)
+	{
+		for(T* pCurrent = p + n; pCurrent != p; --pCurrent)
+		{
+			::new((void*)pCurrent) value_type(eastl::move(pCurrent[-1]));
+			pCurrent[-1].~value_type();
+		}
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoShiftRight(T* p, size_type n)
+	{
+		DoShiftRight(p, n, is_trivially_copyable<T>());
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename Integer>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoAssign(Integer n, Integer value, true_type)
+	{
+		clear();
+
+		for(; n > 0; --n)
+			emplace_back(value);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	template <typename InputIterator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoAssign(InputIterator first, InputIterator last, false_type)
+	{
+		clear();
+
+		for(; first != last; ++first)
+			emplace_back(*first);
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoInitAnchor() EASTL_NOEXCEPT
+	{
+		mAnchor.mpNext = &mAnchor;
+		mAnchor.mpPrev = &mAnchor;
+		mAnchor.mnSize = 0;
+	}
+
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void unrolled_list<T, NodeCapacity, Allocator>::DoSwap(this_type& x)
+	{
+		eastl::swap(mAnchor, x.mAnchor);
+		eastl::swap(mnSize, x.mnSize);
+		eastl::swap(mAllocator, x.mAllocator);
+
+		// The nodes at either end of each list still point at the other list's anchor.
+		if(mAnchor.mpNext == &x.mAnchor)
+			DoInitAnchor();
+		else
+			mAnchor.mpNext->mpPrev = mAnchor.mpPrev->mpNext = &mAnchor;
+
+		if(x.mAnchor.mpNext == &mAnchor)
+			x.DoInitAnchor();
+		else
+			x.mAnchor.mpNext->mpPrev = x.mAnchor.mpPrev->mpNext = &x.mAnchor;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline bool operator==(const unrolled_list<T, NodeCapacity, Allocator>& a, const unrolled_list<T, NodeCapacity, Allocator>& b)
+	{
+		return (a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin());
+	}
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline bool operator!=(const unrolled_list<T, NodeCapacity, Allocator>& a, const unrolled_list<T, NodeCapacity, Allocator>& b)
+	{
+		return !(a == b);
+	}
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline bool operator<(const unrolled_list<T, NodeCapacity, Allocator>& a, const unrolled_list<T, NodeCapacity, Allocator>& b)
+	{
+		return eastl::lexicographicalCompare(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	template <typename T, size_t NodeCapacity, typename Allocator>
+	inline void swap(unrolled_list<T, NodeCapacity, Allocator>& a, unrolled_list<T, NodeCapacity, Allocator>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -26,6 +26,9 @@
 //    - vector has a setCapacity() function which frees excess capacity. 
 //      The only way to do this with std::vector is via the cryptic non-obvious 
 //      trick of using: vector<SomeClass>(x).swap(x);
+//    - vector has resizeUninitialized(), appendUninitialized() and 
+//      resizeAndOverwrite() functions which grow the vector without 
+//      value-initializing the new elements of trivial types.
 ///////////////////////////////////////////////////////////////////////////////
 
 
@@ -270,6 +273,7 @@ namespace eastl
 
 		void resize(size_type n, const value_type& value);
 		void resize(size_type n);
+		void resizeUninitialized(size_type n);              // Same as resize(n), except that new elements are left uninitialized. Requires a trivially default constructible value_type.
 		void reserve(size_type n);
 		void setCapacity(size_type n = base_type::npos);   // Revises the capacity to the user-specified value. Resizes the container to match the capacity if the requested capacity n is less than the current size. If n == npos then the capacity is reallocated (if necessary) such that capacity == size.
 		void shrink_to_fit();                               // C++11 function which is the same as setCapacity().
@@ -292,9 +296,16 @@ namespace eastl
 		void      pushBack(const value_type& value);
 		reference pushBack();
 		void*     pushBackUninitialized();
+		pointer   appendUninitialized(size_type n);        // Grows the size by n without initializing the new elements and returns a pointer to the first of them. Requires a trivially default constructible value_type.
 		void      pushBack(value_type&& value);
 		void      popBack();
 
+		// C++23-style resize_and_overwrite: ensures room for n elements, then calls op(data(), n), which must
+		// write the elements it wants to keep and return the resulting size (<= n). The elements in
+		// [0, min(size(), n)) are preserved before op is called; the rest are left uninitialized.
+		template <typename Operation>
+		void      resizeAndOverwrite(size_type n, Operation op);
+
 		template<class... Args>
 		iterator emplace(const_iterator position, Args&&... args);
 
@@ -507,8 +518,9 @@ namespace eastl
 	inline typename VectorBase<T, Allocator>::size_type
 	VectorBase<T, Allocator>::GetNewCapacity(size_type currentCapacity)
 	{
-		// This needs to return a value of at least currentCapacity and at least 1.
-		return (currentCapacity > 0) ? (size_type)(1.618f * (float)currentCapacity) : 1;
+		// This needs to return a value greater than currentCapacity, as callers use it to make room
+		// for at least one more element. 1.618 * 1 truncates to 1, hence the + 1 floor.
+		return (currentCapacity > 0) ? eastl::max((size_type)(1.618f * (float)currentCapacity), (size_type)(currentCapacity + 1)) : 1;
 	}
 
 
@@ -848,6 +860,21 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::resizeUninitialized(size_type n)
+	{
+		static_assert(eastl::is_trivially_default_constructible<value_type>::value, "vector::resizeUninitialized requires a trivially default constructible value_type.");
+
+		if(n > (size_type)(mpEnd - mpBegin))
+			appendUninitialized(n - (size_type)(mpEnd - mpBegin));
+		else
+		{
+			eastl::destruct(mpBegin + n, mpEnd);
+			mpEnd = mpBegin + n;
+		}
+	}
+
+
 	template <typename T, typename Allocator>
 	void vector<T, Allocator>::reserve(size_type n)
 	{
@@ -1086,6 +1113,46 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	inline typename vector<T, Allocator>::pointer
+	vector<T, Allocator>::appendUninitialized(size_type n)
+	{
+		static_assert(eastl::is_trivially_default_constructible<value_type>::value, "vector::appendUninitialized requires a trivially default constructible value_type.");
+
+		if(n > size_type(internalCapacityPtr() - mpEnd))
+		{
+			const size_type nPrevSize = size_type(mpEnd - mpBegin);
+			const size_type nGrowSize = GetNewCapacity(nPrevSize);
+			DoGrow(eastl::max(nGrowSize, nPrevSize + n));
+		}
+
+		pointer const pAppended = mpEnd;
+		mpEnd += n;
+		return pAppended;
+	}
+
+
+	template <typename T, typename Allocator>
+	template <typename Operation>
+	inline void vector<T, Allocator>::resizeAndOverwrite(size_type n, Operation op)
+	{
+		static_assert(eastl::is_trivially_default_constructible<value_type>::value && eastl::is_trivially_destructible<value_type>::value,
+		              "vector::resizeAndOverwrite requires a trivially default constructible and destructible value_type.");
+
+		if(n > size_type(internalCapacityPtr() - mpBegin))
+			DoGrow(eastl::max(GetNewCapacity(size_type(mpEnd - mpBegin)), n));
+
+		const size_type nNewSize = (size_type)op(mpBegin, n);
+
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(nNewSize > n))
+				EASTL_FAIL_MSG("vector::resizeAndOverwrite -- operation returned a size larger than requested");
+		#endif
+
+		mpEnd = mpBegin + nNewSize;
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void vector<T, Allocator>::popBack()
 	{